@@ -126,7 +126,6 @@ namespace neat
 
         void copy(const CFastVector& vecDatas_)
         {
-            m_vecDatas.reserve(m_vecDatas.size() + vecDatas_.size());
             for (size_type i = 0, _nSize = vecDatas_.size(); i < _nSize; ++i) {
                 push_back(vecDatas_[i]);
             }
@@ -24,6 +24,13 @@ namespace neat
     typedef CAxisPoint<double, 2> DPOINT2;
     typedef CAxisPoint<double, 3> DPOINT3;
 
+    /**
+     * Point or vector types in multi-axis coordinates, such as the position and tool orientation of 5-axis machining
+     */
+    typedef CAxisPoint<double, 4> DPOINT4;
+    typedef CAxisPoint<double, 5> DPOINT5;
+    typedef CAxisPoint<double, 6> DPOINT6;
+
     typedef std::vector<double> VECDOUBLE;
     typedef std::vector<DPOINT2> VECDPOINT2;
     typedef std::vector<DPOINT3> VECDPOINT3;
@@ -42,6 +49,9 @@ namespace neat
     typedef NurbsNode<double> NurbsNode1D;
     typedef NurbsNode<DPOINT2> NurbsNode2D;
     typedef NurbsNode<DPOINT3> NurbsNode3D;
+    typedef NurbsNode<DPOINT4> NurbsNode4D;
+    typedef NurbsNode<DPOINT5> NurbsNode5D;
+    typedef NurbsNode<DPOINT6> NurbsNode6D;
 
     /**
      * Bezier node
@@ -70,6 +80,9 @@ namespace neat
     };
     typedef ScatterNode<DPOINT2> ScatterNode2D;
     typedef ScatterNode<DPOINT3> ScatterNode3D;
+    typedef ScatterNode<DPOINT4> ScatterNode4D;
+    typedef ScatterNode<DPOINT5> ScatterNode5D;
+    typedef ScatterNode<DPOINT6> ScatterNode6D;
 
 } // End namespace neat
 
@@ -43,4 +43,25 @@ double CAxisPoint<double, 3>::GetSquareLength() const
     return m_ptPoint[axis::x] * m_ptPoint[axis::x]
         + m_ptPoint[axis::y] * m_ptPoint[axis::y]
         + m_ptPoint[axis::z] * m_ptPoint[axis::z];
-}
\ No newline at end of file
+}
+
+// The length of the multi-axis point sums the squares of all the axes, which is defined for the double coordinates from 4D to 6D.
+#define DEFINE_AXIS_POINT_LENGTH(N) \
+    template<> \
+    double CAxisPoint<double, N>::GetSquareLength() const \
+    { \
+        double _nSquareLength = 0.0; \
+        for (int i = 0; i < N; ++i) { \
+            _nSquareLength += m_ptPoint[i] * m_ptPoint[i]; \
+        } \
+        return _nSquareLength; \
+    } \
+    template<> \
+    double CAxisPoint<double, N>::GetLength() const \
+    { \
+        return sqrt(GetSquareLength()); \
+    }
+
+DEFINE_AXIS_POINT_LENGTH(4)
+DEFINE_AXIS_POINT_LENGTH(5)
+DEFINE_AXIS_POINT_LENGTH(6)
\ No newline at end of file
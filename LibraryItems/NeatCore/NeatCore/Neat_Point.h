@@ -84,7 +84,7 @@ namespace neat
         {
             static_assert(!std::is_same<TYPE, bool>::value, "This type does not support this operator");
             for (int i = 0; i < N; ++i) {
-                m_ptPoint[i] += ptPoint_[i];
+                m_ptPoint[i] += ptPoint_.m_ptPoint[i];
             }
 
             return *this;
@@ -94,7 +94,7 @@ namespace neat
         {
             static_assert(!std::is_same<TYPE, bool>::value, "This type does not support this operator");
             for (int i = 0; i < N; ++i) {
-                m_ptPoint[i] -= ptPoint_[i];
+                m_ptPoint[i] -= ptPoint_.m_ptPoint[i];
             }
 
             return *this;
@@ -121,10 +121,10 @@ namespace neat
             return *this;
         }
 
-        // Point-to-origin length: only supports 2D and 3D Cartesian coordinate systems
+        // Point-to-origin length: only supports the double coordinates from 2D to 6D
         double GetLength() const;
 
-        // The square of the length of the point to the origin: only supports 2D and 3D Cartesian coordinate systems
+        // The square of the length of the point to the origin: only supports the double coordinates from 2D to 6D
         double GetSquareLength() const;
     };
 
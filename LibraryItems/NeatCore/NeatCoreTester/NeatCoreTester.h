@@ -16,9 +16,6 @@
 /**
  * Type definition
  */
-typedef neat::CAxisPoint<double, 4> DPOINT4;
-typedef neat::CAxisPoint<double, 5> DPOINT5;
-typedef neat::CAxisPoint<double, 6> DPOINT6;
 typedef neat::CAxisPoint<int, 2> IPOINT2;
 typedef neat::CAxisPoint<int, 3> IPOINT3;
 typedef neat::CAxisPoint<bool, 2> BPOINT2;
@@ -142,4 +142,24 @@ TEST(NeatFastVectorUT, CopyElement)
         EXPECT_EQ(_vecTesterEx[i][axis::z], _vecTester[i][axis::z]);
         EXPECT_EQ(_vecTesterEx[i][axis::z], i * i * i);
     }
+}
+
+TEST(NeatFastVectorUT, ReuseCopyElement)
+{
+    CFastVector<int> _vecSource;
+    for (int i = 0; i < 1000; ++i) {
+        _vecSource.push_back(i);
+    }
+
+    // The cleared vector copies the elements to its retained storage, which isn't reallocated
+    CFastVector<int> _vecTester;
+    _vecTester.copy(_vecSource);
+    const int* _pFirst = &_vecTester[0];
+    for (int i = 0; i < 10; ++i) {
+        _vecTester.clear();
+        _vecTester.copy(_vecSource);
+        ASSERT_EQ(_vecTester.size(), 1000);
+        EXPECT_EQ(&_vecTester[0], _pFirst);
+        EXPECT_EQ(_vecTester.back(), 999);
+    }
 }
\ No newline at end of file
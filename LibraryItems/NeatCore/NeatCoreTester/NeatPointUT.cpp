@@ -99,6 +99,9 @@ TEST(NeatPointUT, DPOINT4)
     for (int i = 0; i < 4; ++i) {
         EXPECT_NEAR(_ptTemp[i], 2.0, Precision::RealTolerance());
     }
+
+    EXPECT_NEAR(_ptPoint1.GetLength(), 10.0, Precision::RealTolerance());
+    EXPECT_NEAR(_ptPoint2.GetSquareLength(), 3600.0, Precision::RealTolerance());
 }
 
 TEST(NeatPointUT, DPOINT5)
@@ -129,6 +132,9 @@ TEST(NeatPointUT, DPOINT5)
     for (int i = 0; i < 5; ++i) {
         EXPECT_NEAR(_ptTemp[i], 4.002, Precision::RealTolerance());
     }
+
+    EXPECT_NEAR(_ptPoint1.GetLength(), 10.32 * sqrt(5.0), Precision::RealTolerance());
+    EXPECT_NEAR(_ptPoint2.GetSquareLength(), 5.0 * 20.01 * 20.01, Precision::RealTolerance());
 }
 
 TEST(NeatPointUT, DPOINT6)
@@ -160,6 +166,9 @@ TEST(NeatPointUT, DPOINT6)
     for (int i = 0; i < 6; ++i) {
         EXPECT_NEAR(_ptTemp[i], 1.08, Precision::RealTolerance());
     }
+
+    EXPECT_NEAR(_ptPoint1.GetLength(), 5.4 * sqrt(6.0), Precision::RealTolerance());
+    EXPECT_NEAR(_ptPoint2.GetSquareLength(), 6.0 * 1.7 * 1.7, Precision::RealTolerance());
 }
 
 TEST(NeatPointUT, IPOINT2)
@@ -0,0 +1,656 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __BEZIER_DEFLECTION_H_20200302__
+#define __BEZIER_DEFLECTION_H_20200302__
+
+/**
+ * This file defines the control polygon flatness deflection for bezier spans.
+ */
+namespace neat
+{
+    /**
+     * The control polygon flatness deflection for nurbs node.
+     * The nurbs node is decomposed to bezier spans one by one, and every bezier span is divided by de Casteljau until its
+     * control points are within deflection from the chord. The curve with positive weights is in the convex hull of its
+     * control points, so the chord error is certainly within deflection, and the curve is never evaluated.
+     * The polynomial piece is tested by the bound of second differences first, which is divided to uniform pieces within
+     * deflection without testing them again, and the conic piece is tested by its shoulder point. If only the points are got,
+     * the uniform pieces are output by forward differencing instead of de Casteljau algorithm.
+     */
+    template<typename TYPE>
+    class CBezierFlatnessDeflection
+    {
+    public:
+        CBezierFlatnessDeflection();
+        ~CBezierFlatnessDeflection();
+
+        // If you only get the point coordinates, the derivatives of scatter nodes are not calculated.
+        void SetOnlyGetPoints(bool bOnlyGetPoints_) { m_bOnlyGetPoints = bOnlyGetPoints_; }
+
+        // Set the max length of chord and the max angle between the tangents at both ends of piece, zero means no constraint.
+        void SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_);
+
+        // Set the token to interrupt scattering, which is checked every 64 steps. The scatter nodes of interrupted scatter cover
+        // the front part of nurbs nodes, and the status is got by GetScatterStatus.
+        void SetScatterToken(const ScatterToken* pScatterToken_) { m_pScatterToken = pScatterToken_; }
+        int GetScatterStatus() const { return m_nScatterStatus; }
+
+        // Scatter the clamped nurbs nodes by given deflection, and output the scatter nodes.
+        // The end node of every bezier span is replaced by the start node of next span. If pScatterSink_ is not null, the finalized
+        // scatter nodes are sent to it after every span, and only the last scatter node is retained in vecScatterNodes_.
+        void ScatterNurbs(const CFastVector<NurbsNode<TYPE>>& vecNurbsNodes_, double nDeflection_,
+            CFastVector<ScatterNode<TYPE>>& vecScatterNodes_, const ScatterSink<TYPE>* pScatterSink_);
+
+        // Start to scatter the nurbs nodes step by step, every step appends no more than one scatter node to vecScatterNodes_,
+        // and the last scatter node may be replaced by next step. The nurbs nodes must be valid until all steps are done.
+        void StartNurbs(const CFastVector<NurbsNode<TYPE>>& vecNurbsNodes_, double nDeflection_,
+            CFastVector<ScatterNode<TYPE>>& vecScatterNodes_);
+
+        // Scatter one step, which accepts or divides the top piece of bezier span. Returns false if all nodes are scattered.
+        bool ScatterStep();
+
+    private:
+        // Extract next bezier span of nurbs node by knot insertion, and replace the last scatter node by its start node.
+        void StartNurbsNode();
+        void SetNextPole(int nIndex_, int nPoleIndex_);
+        void StartBezierSpan();
+
+        // Output the end node of the top piece if it's flat enough, otherwise divide it.
+        void StepBezierSpan();
+
+        // Get the square flatness of piece. nPieceCount_ is the number of uniform pieces within deflection by the bound of
+        // second differences, which is 1 if the piece is within deflection, or 0 if it isn't known.
+        double GetSquareFlatness(int nPieceIndex_, int& nPieceCount_);
+        const TYPE* GetControlPoints(int nPieceIndex_);
+
+        // Output the end point of next uniform piece of the top piece by forward differencing.
+        void StepForwardDiffs(int nPieceIndex_);
+
+        // Get the larger ratio of the chord length and the angle between end tangents to their constraints. The end tangents
+        // of piece are along its first and last legs of control polygon, which are skipped if they are degenerate.
+        double GetConstraintRatio(int nPieceIndex_);
+
+        // Divide the top piece at the ratio of its knot length by de Casteljau algorithm, and set the piece counts of both parts.
+        void DivideBezierPiece(double nRatio_, int nLeftCount_, int nRightCount_);
+        template<typename POINT>
+        void DivideControlPoints(POINT* pPoints_, double nRatio_) const;
+
+        // Get the scatter node at the start or end of the piece from its homogeneous control points.
+        void GetScatterNode(int nPieceIndex_, bool bEndNode_, ScatterNode<TYPE>& ScatterNode_) const;
+
+        // Send the scatter nodes except the last one to the sink, the last one is replaced by next span.
+        void FlushScatterNodes();
+
+    private:
+        // The piece shorter than 2^-MAX_DIVIDE_DEPTH of its span is not divided, which only stops the degenerate spans.
+        // The piece which needs more uniform pieces than MAX_PIECE_COUNT is tested again after dividing.
+        enum { MAX_DIVIDE_DEPTH = 32, MAX_PIECE_COUNT = 65536 };
+
+        // The undivided piece of bezier span, the control points of piece i are from i * (m_nDegree + 1) in pole buffers.
+        // The piece is divided to nPieceCount uniform pieces within deflection, zero means that it isn't tested.
+        struct BezierPiece
+        {
+            double nStartKnot = 0.0;
+            double nEndKnot = 0.0;
+            int nPieceCount = 0;
+        };
+
+        const CFastVector<NurbsNode<TYPE>>* m_pvecNurbsNodes;
+        CFastVector<ScatterNode<TYPE>>* m_pvecScatterNodes;
+        const ScatterSink<TYPE>* m_pScatterSink;
+        double m_nDeflection;
+
+        // The nurbs node being decomposed, the next bezier span is from knot m_nStartIndex to knot m_nEndIndex.
+        const NurbsNode<TYPE>* m_pNurbsNode;
+        int m_nNodeIndex;
+        int m_nDegree;
+        int m_nStartIndex;
+        int m_nEndIndex;
+        double m_nMinDeltaKnot;
+
+        // The weights of non-rational nurbs node are all 1, which are not stored in the weight buffers.
+        bool m_bRational;
+
+        // The stack of undivided pieces, the top of stack is the back.
+        CFastVector<BezierPiece> m_vecBezierPieces;
+
+        // The homogeneous control points are the weighted poles and the weights.
+        CFastVector<TYPE> m_vecWeightedPoles;
+        CFastVector<double> m_vecWeights;
+
+        // The control points of next bezier span, whose front ones are set by the knot insertion of current span.
+        CFastVector<TYPE> m_vecNextPoles;
+        CFastVector<double> m_vecNextWeights;
+
+        // The power coefficients and forward differences of the top piece, and the uniform pieces of it which are output.
+        CFastVector<TYPE> m_vecPowerCoefficients;
+        CFastVector<TYPE> m_vecForwardDiffs;
+        int m_nForwardIndex;
+
+        // temporary variable reutilization
+        CFastVector<double> m_vecAlphas;
+        CFastVector<TYPE> m_vecTempPoles;
+        bool m_bOnlyGetPoints;
+
+        // The constraints of chord, zero means no constraint.
+        double m_nMaxSegmentLength;
+        double m_nMaxTurningAngle;
+
+        // The token to interrupt scattering, and the status of the last scatter.
+        const ScatterToken* m_pScatterToken;
+        int m_nScatterStatus;
+    };
+
+    /**
+     * The implementation of template class.
+     */
+    template<typename TYPE>
+    CBezierFlatnessDeflection<TYPE>::CBezierFlatnessDeflection()
+        : m_pvecNurbsNodes(nullptr)
+        , m_pvecScatterNodes(nullptr)
+        , m_pScatterSink(nullptr)
+        , m_nDeflection(0.0)
+        , m_pNurbsNode(nullptr)
+        , m_nNodeIndex(0)
+        , m_nDegree(0)
+        , m_nStartIndex(0)
+        , m_nEndIndex(0)
+        , m_nMinDeltaKnot(0.0)
+        , m_bRational(false)
+        , m_nForwardIndex(0)
+        , m_bOnlyGetPoints(false)
+        , m_nMaxSegmentLength(0.0)
+        , m_nMaxTurningAngle(0.0)
+        , m_pScatterToken(nullptr)
+        , m_nScatterStatus(scatter_status::finished)
+    {
+    }
+
+    template<typename TYPE>
+    CBezierFlatnessDeflection<TYPE>::~CBezierFlatnessDeflection()
+    {
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_)
+    {
+        NEAT_RAISE_IF(nMaxSegmentLength_ < 0.0 || nMaxTurningAngle_ < 0.0, g_strWrongSegmentConstraints);
+        m_nMaxSegmentLength = nMaxSegmentLength_;
+        m_nMaxTurningAngle = nMaxTurningAngle_;
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::ScatterNurbs(const CFastVector<NurbsNode<TYPE>>& vecNurbsNodes_, double nDeflection_,
+        CFastVector<ScatterNode<TYPE>>& vecScatterNodes_, const ScatterSink<TYPE>* pScatterSink_)
+    {
+        m_pScatterSink = pScatterSink_;
+        StartNurbs(vecNurbsNodes_, nDeflection_, vecScatterNodes_);
+        int _nStepCount = 0;
+        while (ScatterStep()) {
+            // no undivided piece means that one span is scattered
+            if (m_pScatterSink != nullptr && m_vecBezierPieces.empty()) {
+                FlushScatterNodes();
+            }
+
+            // the last scatter node is the end of accepted pieces, so the undivided pieces are dropped when it's interrupted
+            if (m_pScatterToken != nullptr && (++_nStepCount & 0x3F) == 0) {
+                m_nScatterStatus = m_pScatterToken->GetStatus();
+                if (m_nScatterStatus != scatter_status::finished) {
+                    m_vecBezierPieces.clear();
+                    break;
+                }
+            }
+        }
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::StartNurbs(const CFastVector<NurbsNode<TYPE>>& vecNurbsNodes_, double nDeflection_,
+        CFastVector<ScatterNode<TYPE>>& vecScatterNodes_)
+    {
+        NEAT_RAISE_IF(nDeflection_ <= 0.0, g_strWrongDeflection);
+
+        m_pvecNurbsNodes = &vecNurbsNodes_;
+        m_nDeflection = nDeflection_;
+        m_nScatterStatus = scatter_status::finished;
+        m_pNurbsNode = nullptr;
+        m_nNodeIndex = 0;
+        m_nForwardIndex = 0;
+        m_vecBezierPieces.clear();
+
+        m_pvecScatterNodes = &vecScatterNodes_;
+        m_pvecScatterNodes->clear();
+        m_pvecScatterNodes->push_back(ScatterNode<TYPE>());
+    }
+
+    template<typename TYPE>
+    bool CBezierFlatnessDeflection<TYPE>::ScatterStep()
+    {
+        if (!m_vecBezierPieces.empty()) {
+            StepBezierSpan();
+            return true;
+        }
+
+        // the last span of nurbs node has been extracted
+        if (m_pNurbsNode == nullptr || m_nEndIndex >= static_cast<int>(m_pNurbsNode->vecKnots.size()) - 1) {
+            if (m_nNodeIndex >= static_cast<int>(m_pvecNurbsNodes->size())) {
+                return false;
+            }
+
+            m_pNurbsNode = &(*m_pvecNurbsNodes)[m_nNodeIndex++];
+            StartNurbsNode();
+        }
+
+        StartBezierSpan();
+        return true;
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::StartNurbsNode()
+    {
+        m_nDegree = m_pNurbsNode->nDegree;
+        NEAT_RAISE_IF(static_cast<int>(m_pNurbsNode->vecKnots.size()) < (m_nDegree + 1) * 2, g_strNurbsParamsError);
+        NEAT_RAISE_IF(m_pNurbsNode->vecKnots.size() != m_pNurbsNode->vecPoles.size() + m_nDegree + 1, g_strNurbsParamsError);
+        NEAT_RAISE_IF(!m_pNurbsNode->vecWeights.empty() && m_pNurbsNode->vecWeights.size() != m_pNurbsNode->vecPoles.size(),
+            g_strNurbsParamsError);
+
+        const VECDOUBLE& _vecWeights = m_pNurbsNode->vecWeights;
+        m_bRational = false;
+        for (size_t i = 1, _nSize = _vecWeights.size(); i < _nSize && !m_bRational; ++i) {
+            m_bRational = !DOUBLE_EQU(_vecWeights[0], _vecWeights[i]);
+        }
+
+        // the first bezier span starts from the clamped start knot
+        m_nStartIndex = m_nDegree;
+        m_nEndIndex = m_nDegree + 1;
+        m_vecNextPoles.resize(m_nDegree + 1);
+        m_vecNextWeights.resize(m_nDegree + 1);
+        for (int i = 0; i <= m_nDegree; ++i) {
+            SetNextPole(i, i);
+        }
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::SetNextPole(int nIndex_, int nPoleIndex_)
+    {
+        if (!m_bRational) {
+            m_vecNextPoles[nIndex_] = m_pNurbsNode->vecPoles[nPoleIndex_];
+            return;
+        }
+
+        m_vecNextWeights[nIndex_] = m_pNurbsNode->vecWeights[nPoleIndex_];
+        NEAT_RAISE_IF(m_vecNextWeights[nIndex_] <= 0.0, g_strNurbsParamsError);
+        m_vecNextPoles[nIndex_] = m_pNurbsNode->vecPoles[nPoleIndex_] * m_vecNextWeights[nIndex_];
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::StartBezierSpan()
+    {
+        // Decompose the nurbs node to bezier spans by knot insertion, see "The NURBS Book" A5.6.
+        const VECDOUBLE& _vecKnots = m_pNurbsNode->vecKnots;
+        const int _nLastIndex = static_cast<int>(_vecKnots.size()) - 1;
+        m_vecWeightedPoles.clear();
+        m_vecWeights.clear();
+        m_vecWeightedPoles.copy(m_vecNextPoles);
+        if (m_bRational) {
+            m_vecWeights.copy(m_vecNextWeights);
+        }
+
+        int _nIndex = m_nEndIndex;
+        while (m_nEndIndex < _nLastIndex && DOUBLE_EQU(_vecKnots[m_nEndIndex + 1], _vecKnots[m_nEndIndex])) {
+            ++m_nEndIndex;
+        }
+
+        int _nMultiplicity = m_nEndIndex - _nIndex + 1;
+        if (_nMultiplicity < m_nDegree) {
+            double _nNumerator = _vecKnots[m_nEndIndex] - _vecKnots[m_nStartIndex];
+            m_vecAlphas.resize(m_nDegree);
+            for (int j = m_nDegree; j > _nMultiplicity; --j) {
+                m_vecAlphas[j - _nMultiplicity - 1] = _nNumerator / (_vecKnots[m_nStartIndex + j] - _vecKnots[m_nStartIndex]);
+            }
+
+            int _nInsertCount = m_nDegree - _nMultiplicity;
+            for (int j = 1; j <= _nInsertCount; ++j) {
+                int _nSave = _nInsertCount - j;
+                int _nStart = _nMultiplicity + j;
+                for (int k = m_nDegree; k >= _nStart; --k) {
+                    double _nAlpha = m_vecAlphas[k - _nStart];
+                    m_vecWeightedPoles[k] = m_vecWeightedPoles[k] * _nAlpha + m_vecWeightedPoles[k - 1] * (1.0 - _nAlpha);
+                    if (m_bRational) {
+                        m_vecWeights[k] = m_vecWeights[k] * _nAlpha + m_vecWeights[k - 1] * (1.0 - _nAlpha);
+                    }
+                }
+
+                if (m_nEndIndex < _nLastIndex) {
+                    m_vecNextPoles[_nSave] = m_vecWeightedPoles[m_nDegree];
+                    if (m_bRational) {
+                        m_vecNextWeights[_nSave] = m_vecWeights[m_nDegree];
+                    }
+                }
+            }
+        }
+
+        BezierPiece _BezierPiece;
+        _BezierPiece.nStartKnot = _vecKnots[m_nStartIndex];
+        _BezierPiece.nEndKnot = _vecKnots[m_nEndIndex];
+        m_vecBezierPieces.push_back(_BezierPiece);
+        m_nMinDeltaKnot = ldexp(_BezierPiece.nEndKnot - _BezierPiece.nStartKnot, -MAX_DIVIDE_DEPTH);
+
+        // the rest control points of next span are the poles of nurbs node
+        if (m_nEndIndex < _nLastIndex) {
+            for (int i = m_nDegree - _nMultiplicity; i <= m_nDegree; ++i) {
+                SetNextPole(i, m_nEndIndex - m_nDegree + i);
+            }
+
+            m_nStartIndex = m_nEndIndex;
+            ++m_nEndIndex;
+        }
+
+        m_pvecScatterNodes->pop_back();
+        m_pvecScatterNodes->push_back(ScatterNode<TYPE>());
+        GetScatterNode(0, false, m_pvecScatterNodes->back());
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::StepBezierSpan()
+    {
+        // The chord error is nearly proportional to the square of knot length, so the piece is divided to quasi uniform
+        // pieces whose chord errors are close to deflection, instead of halves.
+        int _nPieceIndex = static_cast<int>(m_vecBezierPieces.size()) - 1;
+        BezierPiece& _BezierPiece = m_vecBezierPieces.back();
+        if (_BezierPiece.nEndKnot - _BezierPiece.nStartKnot > m_nMinDeltaKnot) {
+            if (_BezierPiece.nPieceCount == 0) {
+                double _nSquareFlatness = GetSquareFlatness(_nPieceIndex, _BezierPiece.nPieceCount);
+                if (_BezierPiece.nPieceCount == 0 && _nSquareFlatness > m_nDeflection * m_nDeflection) {
+                    double _nPieceCount = ceil(sqrt(sqrt(_nSquareFlatness) / m_nDeflection));
+                    DivideBezierPiece(1.0 / max(2.0, _nPieceCount), 0, 0);
+                    return;
+                }
+            }
+
+            // The left one of uniform pieces is within deflection, and the right one is divided again. If only the points are got
+            // without the constraints, the uniform pieces are output by forward differencing, and the last one is accepted.
+            const bool _bForwardDiffs = m_bOnlyGetPoints && m_nMaxSegmentLength <= 0.0 && m_nMaxTurningAngle <= 0.0;
+            if (_BezierPiece.nPieceCount > 1 && !_bForwardDiffs) {
+                DivideBezierPiece(1.0 / _BezierPiece.nPieceCount, 1, _BezierPiece.nPieceCount - 1);
+                return;
+            }
+
+            if (_BezierPiece.nPieceCount > 1) {
+                if (m_nForwardIndex + 1 < _BezierPiece.nPieceCount) {
+                    StepForwardDiffs(_nPieceIndex);
+                    return;
+                }
+
+                m_nForwardIndex = 0;
+            }
+            else {
+                double _nConstraintRatio = GetConstraintRatio(_nPieceIndex);
+                if (_nConstraintRatio > 1.0) {
+                    DivideBezierPiece(1.0 / ceil(min(_nConstraintRatio, 1024.0)), _BezierPiece.nPieceCount, _BezierPiece.nPieceCount);
+                    return;
+                }
+            }
+        }
+
+        m_pvecScatterNodes->push_back(ScatterNode<TYPE>());
+        GetScatterNode(_nPieceIndex, true, m_pvecScatterNodes->back());
+
+        m_vecBezierPieces.pop_back();
+        m_vecWeightedPoles.resize(_nPieceIndex * (m_nDegree + 1));
+        if (m_bRational) {
+            m_vecWeights.resize(_nPieceIndex * (m_nDegree + 1));
+        }
+    }
+
+    template<typename TYPE>
+    double CBezierFlatnessDeflection<TYPE>::GetSquareFlatness(int nPieceIndex_, int& nPieceCount_)
+    {
+        const TYPE* _pPoints = GetControlPoints(nPieceIndex_);
+        const TYPE& _ptStartPoint = _pPoints[0];
+        const TYPE& _ptEndPoint = _pPoints[m_nDegree];
+
+        // The distance between the polynomial curve and its chord is no more than n(n-1)/8 times the maximum second difference
+        // of control points. The second differences of the uniform piece in 1/k of knot length are within 1/k^2 of the piece,
+        // so the k uniform pieces are all within deflection if the bound is within k^2 times deflection.
+        nPieceCount_ = 0;
+        double _nSquareBound = 0.0;
+        if (!m_bRational) {
+            double _nSquareDifference = 0.0;
+            for (int i = 2; i <= m_nDegree; ++i) {
+                _nSquareDifference = max(_nSquareDifference, (_pPoints[i] - _pPoints[i - 1] * 2.0 + _pPoints[i - 2]).GetSquareLength());
+            }
+
+            const double _nRatio = m_nDegree * (m_nDegree - 1) / 8.0;
+            _nSquareBound = _nSquareDifference * _nRatio * _nRatio;
+            double _nPieceCount = max(1.0, ceil(sqrt(sqrt(_nSquareBound) / m_nDeflection)));
+            if (_nPieceCount == 1.0) {
+                nPieceCount_ = 1;
+                return _nSquareBound;
+            }
+
+            if (_nPieceCount <= MAX_PIECE_COUNT) {
+                nPieceCount_ = static_cast<int>(_nPieceCount);
+            }
+        }
+
+        if (m_nDegree == 2) {
+            // The conic arc is farthest from the chord at its shoulder point, where the tangent is parallel to the chord.
+            // It's exact if the middle control point is projected within the chord, so is the whole arc.
+            TYPE _ptChord = _ptEndPoint - _ptStartPoint;
+            double _nProjection = DotProduct(_pPoints[1] - _ptStartPoint, _ptChord);
+            if (_nProjection >= 0.0 && _nProjection <= _ptChord.GetSquareLength()) {
+                double _nWeight = 1.0;
+                if (m_bRational) {
+                    const int _nOffset = nPieceIndex_ * (m_nDegree + 1);
+                    _nWeight = m_vecWeights[_nOffset + 1] / sqrt(m_vecWeights[_nOffset] * m_vecWeights[_nOffset + 2]);
+                }
+
+                TYPE _ptShoulderPoint = ((_ptStartPoint + _ptEndPoint) * 0.5 + _pPoints[1] * _nWeight) / (1.0 + _nWeight);
+                double _nSquareFlatness = GetSquareSegmentDistance(_ptShoulderPoint, _ptStartPoint, _ptEndPoint);
+                if (_nSquareFlatness <= m_nDeflection * m_nDeflection) {
+                    nPieceCount_ = 1;
+                }
+
+                return _nSquareFlatness;
+            }
+        }
+
+        double _nSquareFlatness = 0.0;
+        for (int i = 1; i < m_nDegree; ++i) {
+            _nSquareFlatness = max(_nSquareFlatness, GetSquareSegmentDistance(_pPoints[i], _ptStartPoint, _ptEndPoint));
+        }
+
+        // The convex hull is tighter than the second differences, but the uniform pieces are only proved by the second differences.
+        if (_nSquareFlatness <= m_nDeflection * m_nDeflection) {
+            nPieceCount_ = 1;
+        }
+
+        return (m_bRational || _nSquareFlatness < _nSquareBound) ? _nSquareFlatness : _nSquareBound;
+    }
+
+    template<typename TYPE>
+    const TYPE* CBezierFlatnessDeflection<TYPE>::GetControlPoints(int nPieceIndex_)
+    {
+        const int _nOffset = nPieceIndex_ * (m_nDegree + 1);
+        if (!m_bRational) {
+            return &m_vecWeightedPoles[_nOffset];
+        }
+
+        // the control points of rational piece are projected from homogeneous coordinates
+        m_vecTempPoles.resize(m_nDegree + 1);
+        for (int i = 0; i <= m_nDegree; ++i) {
+            m_vecTempPoles[i] = m_vecWeightedPoles[_nOffset + i] * (1.0 / m_vecWeights[_nOffset + i]);
+        }
+
+        return &m_vecTempPoles[0];
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::StepForwardDiffs(int nPieceIndex_)
+    {
+        // The forward differences are seeded again by Horner scheme to bound the accumulated rounding error
+        const int _nReseedSteps = 64;
+        const BezierPiece& _BezierPiece = m_vecBezierPieces[nPieceIndex_];
+        const double _nStep = 1.0 / _BezierPiece.nPieceCount;
+        if (m_nForwardIndex == 0) {
+            m_vecPowerCoefficients.resize(m_nDegree + 1);
+            m_vecForwardDiffs.resize(m_nDegree + 1);
+            ConvertBezierToPower(&m_vecWeightedPoles[nPieceIndex_ * (m_nDegree + 1)], m_nDegree, &m_vecPowerCoefficients[0]);
+        }
+
+        if (m_nForwardIndex % _nReseedSteps == 0) {
+            InitForwardDiffs(&m_vecPowerCoefficients[0], m_nDegree, m_nForwardIndex * _nStep, _nStep, &m_vecForwardDiffs[0]);
+        }
+
+        for (int k = 0; k < m_nDegree; ++k) {
+            m_vecForwardDiffs[k] += m_vecForwardDiffs[k + 1];
+        }
+
+        ++m_nForwardIndex;
+        m_pvecScatterNodes->push_back(ScatterNode<TYPE>());
+        ScatterNode<TYPE>& _ScatterNode = m_pvecScatterNodes->back();
+        _ScatterNode.nKnot = _BezierPiece.nStartKnot + (_BezierPiece.nEndKnot - _BezierPiece.nStartKnot) * (m_nForwardIndex * _nStep);
+        _ScatterNode.ptPoint = m_vecForwardDiffs[0];
+    }
+
+    template<typename TYPE>
+    double CBezierFlatnessDeflection<TYPE>::GetConstraintRatio(int nPieceIndex_)
+    {
+        if (m_nMaxSegmentLength <= 0.0 && m_nMaxTurningAngle <= 0.0) {
+            return 0.0;
+        }
+
+        const double _nSquareTolerance = Precision::SquareRealTolerance();
+        const TYPE* _pPoints = GetControlPoints(nPieceIndex_);
+        double _nRatio = 0.0;
+        if (m_nMaxSegmentLength > 0.0) {
+            _nRatio = (_pPoints[m_nDegree] - _pPoints[0]).GetLength() / m_nMaxSegmentLength;
+        }
+
+        if (m_nMaxTurningAngle > 0.0) {
+            TYPE _ptStartTangent = _pPoints[1] - _pPoints[0];
+            TYPE _ptEndTangent = _pPoints[m_nDegree] - _pPoints[m_nDegree - 1];
+            double _nNorme = sqrt(_ptStartTangent.GetSquareLength() * _ptEndTangent.GetSquareLength());
+            if (_nNorme > _nSquareTolerance) {
+                double _nAngle = acos(max(-1.0, min(1.0, DotProduct(_ptStartTangent, _ptEndTangent) / _nNorme)));
+                _nRatio = max(_nRatio, _nAngle / m_nMaxTurningAngle);
+            }
+        }
+
+        return _nRatio;
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::DivideBezierPiece(double nRatio_, int nLeftCount_, int nRightCount_)
+    {
+        // The top piece is replaced by the right part, and the left part is pushed to be scattered first.
+        const int _nPieceIndex = static_cast<int>(m_vecBezierPieces.size()) - 1;
+        const int _nRightOffset = _nPieceIndex * (m_nDegree + 1);
+        const int _nLeftOffset = _nRightOffset + m_nDegree + 1;
+        m_vecWeightedPoles.resize(_nLeftOffset + m_nDegree + 1);
+        DivideControlPoints(&m_vecWeightedPoles[_nRightOffset], nRatio_);
+        if (m_bRational) {
+            m_vecWeights.resize(_nLeftOffset + m_nDegree + 1);
+            DivideControlPoints(&m_vecWeights[_nRightOffset], nRatio_);
+        }
+
+        BezierPiece& _RightPiece = m_vecBezierPieces.back();
+        BezierPiece _LeftPiece = _RightPiece;
+        _LeftPiece.nEndKnot = _RightPiece.nStartKnot + (_RightPiece.nEndKnot - _RightPiece.nStartKnot) * nRatio_;
+        _RightPiece.nStartKnot = _LeftPiece.nEndKnot;
+        _RightPiece.nPieceCount = nRightCount_;
+        _LeftPiece.nPieceCount = nLeftCount_;
+
+        // the reference of right piece is invalid after pushing
+        m_vecBezierPieces.push_back(_LeftPiece);
+    }
+
+    template<typename TYPE>
+    template<typename POINT>
+    void CBezierFlatnessDeflection<TYPE>::DivideControlPoints(POINT* pPoints_, double nRatio_) const
+    {
+        // The de Casteljau algorithm is done in place of the left part, whose control point i is final after level i,
+        // and the last control point of level r is the control point m_nDegree - r of the right part.
+        POINT* _pLeftPoints = pPoints_ + m_nDegree + 1;
+        for (int i = 0; i <= m_nDegree; ++i) {
+            _pLeftPoints[i] = pPoints_[i];
+        }
+
+        for (int r = 1; r <= m_nDegree; ++r) {
+            for (int i = m_nDegree; i >= r; --i) {
+                _pLeftPoints[i] = _pLeftPoints[i - 1] * (1.0 - nRatio_) + _pLeftPoints[i] * nRatio_;
+            }
+
+            pPoints_[m_nDegree - r] = _pLeftPoints[m_nDegree];
+        }
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::GetScatterNode(int nPieceIndex_, bool bEndNode_, ScatterNode<TYPE>& ScatterNode_) const
+    {
+        const BezierPiece& _BezierPiece = m_vecBezierPieces[nPieceIndex_];
+        const int _nOffset = nPieceIndex_ * (m_nDegree + 1);
+        const int _nIndex0 = _nOffset + (bEndNode_ ? m_nDegree : 0);
+        const double _nInverseWeight = m_bRational ? 1.0 / m_vecWeights[_nIndex0] : 1.0;
+        ScatterNode_.nKnot = bEndNode_ ? _BezierPiece.nEndKnot : _BezierPiece.nStartKnot;
+        ScatterNode_.ptPoint = m_bRational ? m_vecWeightedPoles[_nIndex0] * _nInverseWeight : m_vecWeightedPoles[_nIndex0];
+        if (m_bOnlyGetPoints) {
+            return;
+        }
+
+        // The derivatives of homogeneous curve at the end are the differences of its control points, and then
+        // the derivatives of curve are got by the quotient rule: C' = (A' - w'C) / w, C'' = (A'' - 2w'C' - w''C) / w.
+        const int _nIndex1 = _nOffset + (bEndNode_ ? m_nDegree - 1 : 1);
+        const double _nDeltaKnot = _BezierPiece.nEndKnot - _BezierPiece.nStartKnot;
+        const double _nRatio1 = (bEndNode_ ? m_nDegree : -m_nDegree) / _nDeltaKnot;
+        ScatterNode_.ptDeriv1 = (m_vecWeightedPoles[_nIndex0] - m_vecWeightedPoles[_nIndex1]) * _nRatio1;
+        double _nWeightDeriv1 = 0.0;
+        if (m_bRational) {
+            _nWeightDeriv1 = (m_vecWeights[_nIndex0] - m_vecWeights[_nIndex1]) * _nRatio1;
+            ScatterNode_.ptDeriv1 = (ScatterNode_.ptDeriv1 - ScatterNode_.ptPoint * _nWeightDeriv1) * _nInverseWeight;
+        }
+
+        TYPE _ptDeriv2;
+        double _nWeightDeriv2 = 0.0;
+        if (m_nDegree > 1) {
+            const int _nIndex2 = _nOffset + (bEndNode_ ? m_nDegree - 2 : 2);
+            const double _nRatio2 = m_nDegree * (m_nDegree - 1) / (_nDeltaKnot * _nDeltaKnot);
+            _ptDeriv2 = (m_vecWeightedPoles[_nIndex0] - m_vecWeightedPoles[_nIndex1] * 2.0 + m_vecWeightedPoles[_nIndex2]) * _nRatio2;
+            if (m_bRational) {
+                _nWeightDeriv2 = (m_vecWeights[_nIndex0] - m_vecWeights[_nIndex1] * 2.0 + m_vecWeights[_nIndex2]) * _nRatio2;
+            }
+        }
+
+        ScatterNode_.ptDeriv2 = _ptDeriv2;
+        if (m_bRational) {
+            ScatterNode_.ptDeriv2 = (_ptDeriv2 - ScatterNode_.ptDeriv1 * (2.0 * _nWeightDeriv1) - ScatterNode_.ptPoint * _nWeightDeriv2)
+                * _nInverseWeight;
+        }
+    }
+
+    template<typename TYPE>
+    void CBezierFlatnessDeflection<TYPE>::FlushScatterNodes()
+    {
+        const int _nSize = static_cast<int>(m_pvecScatterNodes->size());
+        for (int i = 0; i < _nSize - 1; ++i) {
+            (*m_pScatterSink)((*m_pvecScatterNodes)[i]);
+        }
+
+        ScatterNode<TYPE> _LastScatterNode = m_pvecScatterNodes->back();
+        m_pvecScatterNodes->clear();
+        m_pvecScatterNodes->push_back(_LastScatterNode);
+    }
+
+} // End namespace neat
+
+#endif // __BEZIER_DEFLECTION_H_20200302__
\ No newline at end of file
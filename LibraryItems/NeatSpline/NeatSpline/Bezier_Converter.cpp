@@ -24,26 +24,38 @@ CBezierConverter2D::~CBezierConverter2D()
 {
 }
 
-void CBezierConverter2D::ConvertBezierToPolyline(const BezierNode2D* pBezierNode_, double nDeflection_, Polyline2D& Polyline2D_)
+int CBezierConverter2D::ConvertBezierToPolyline(const BezierNode2D* pBezierNode_, double nDeflection_, Polyline2D& Polyline2D_)
 {
     NEAT_RAISE(pBezierNode_ == nullptr, g_strEmptyPointer);
 
     // If the Bezier node is one-degree, output directly
     if (pBezierNode_->vecPoles.size() == 2) {
         OutputSegment(pBezierNode_->vecPoles.front(), pBezierNode_->vecPoles.back(), Polyline2D_);
-        return;
+        return scatter_status::finished;
+    }
+
+    // Scatter bezier node into scattered points for checking the result of biarc fit, which is interrupted by the token as well
+    if (m_pScatterToken != nullptr) {
+        int _nStatus = m_pScatterToken->GetStatus();
+        if (_nStatus != scatter_status::finished) {
+            return _nStatus;
+        }
     }
 
-    // Scatter bezier node into scattered points for checking the result of biarc fit
     m_nDeflection = nDeflection_;
     m_vecScatterNodes.clear();
-    ScatterBezier(pBezierNode_, nDeflection_ * 0.5, m_vecScatterNodes);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode);
+    m_NurbsScatter.SetScatterToken(m_pScatterToken);
+    m_NurbsScatter.ScatterNurbs(&m_NurbsNode, nDeflection_ * 0.5, m_vecScatterNodes);
+    if (m_NurbsScatter.GetScatterStatus() != scatter_status::finished) {
+        return m_NurbsScatter.GetScatterStatus();
+    }
 
     // Check the scatter result : if it can be approximated with a straight line, output directly
     if (m_vecScatterNodes.size() < 3) {
         NEAT_RAISE_IF(m_vecScatterNodes.empty(), g_strBezierParamsError);
         OutputSegment(m_vecScatterNodes.front().ptPoint, m_vecScatterNodes.back().ptPoint, Polyline2D_);
-        return;
+        return scatter_status::finished;
     }
 
     // Check if the scatter bezier node is reversed and divide at the reverse
@@ -68,6 +80,14 @@ void CBezierConverter2D::ConvertBezierToPolyline(const BezierNode2D* pBezierNode
     _listKnotIntervals.emplace_back(KnotInterval{ _nStartKnot, pBezierNode_->nEndKnot });
 
     while (!_listKnotIntervals.empty()) {
+        // the knot intervals before the front one are converted when the token interrupts the conversion
+        if (m_pScatterToken != nullptr) {
+            int _nStatus = m_pScatterToken->GetStatus();
+            if (_nStatus != scatter_status::finished) {
+                return _nStatus;
+            }
+        }
+
         double _nDivideKnot = 0.0;
         const KnotInterval& _KnotInterval = _listKnotIntervals.front();
         if (ConvertBezierToPolyline(_KnotInterval.nStartKnot, _KnotInterval.nEndKnot, _nDivideKnot, Polyline2D_)) {
@@ -81,6 +101,8 @@ void CBezierConverter2D::ConvertBezierToPolyline(const BezierNode2D* pBezierNode
             _listKnotIntervals.emplace_front(KnotInterval{ _nOrigStartKnot, _nDivideKnot });
         }
     }
+
+    return scatter_status::finished;
 }
 
 void CBezierConverter2D::OutputSegment(const DPOINT2& ptStart_, const DPOINT2& ptEnd_, Polyline2D& Polyline2D_)
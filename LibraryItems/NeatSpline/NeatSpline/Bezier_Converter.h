@@ -27,7 +27,11 @@ namespace neat
         CBezierConverter2D();
         ~CBezierConverter2D();
 
-        void ConvertBezierToPolyline(const BezierNode2D* pBezierNode_, double nDeflection_, Polyline2D& Polyline2D_);
+        // Set the token to interrupt the conversion, which is checked by the scatter and before fitting every knot interval.
+        void SetScatterToken(const ScatterToken* pScatterToken_) { m_pScatterToken = pScatterToken_; }
+
+        // Convert bezier node to polyline, and return the value of scatter_status. The interrupted polyline covers the front part.
+        int ConvertBezierToPolyline(const BezierNode2D* pBezierNode_, double nDeflection_, Polyline2D& Polyline2D_);
 
     private:
         CBezierConverter2D(const CBezierConverter2D&) = delete;
@@ -80,8 +84,11 @@ namespace neat
         double DistPointToArc(const DPOINT2& ptStartPoint_, const ArcNode2D& ArcNode_, const DPOINT2& ptAimPoint_) const;
 
     private:
+        NurbsNode2D m_NurbsNode;
+        CNurbsScatter<DPOINT2, DPOINT3> m_NurbsScatter;
         std::vector<ScatterNode2D> m_vecScatterNodes;
         double m_nDeflection = 0.0;
+        const ScatterToken* m_pScatterToken = nullptr;
     };
 
 } // End namespace neat
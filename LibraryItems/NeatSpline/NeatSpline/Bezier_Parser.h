@@ -0,0 +1,255 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __BEZIER_PARSER_H_20200302__
+#define __BEZIER_PARSER_H_20200302__
+
+/**
+ * This file defines the parser for bezier node.
+ */
+namespace neat
+{
+    /**
+     * The bezier node has only one span, so it is evaluated by the Bernstein polynomials directly.
+     * The control points of the curve and its first and second hodographs are multiplied by the binomial coefficients
+     * when the bezier node is set, and the evaluation is a Horner scheme without span search or allocation.
+     * The rational curve is evaluated in homogeneous space and projected by the quotient rule.
+     */
+    template<typename TYPE>
+    class CBezierParser
+    {
+    public:
+        CBezierParser();
+        ~CBezierParser();
+
+        // Set the information for bezier node.
+        void SetBezierNode(const BezierNode<TYPE>* pBezierNode_);
+
+        // Returns in ptPoint_ the point of parameter nKnot_.
+        void GetBezierPoint(double nKnot_, TYPE& ptPoint_);
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetBezierDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        void GetBezierDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
+
+    private:
+        // Returns the normalized parameter of nKnot_ in [0, 1].
+        double NormalizeKnot(double nKnot_) const;
+
+        // Construct the control points of the derivative curve without the parameter scale.
+        template<typename VALUE>
+        static void ConstructHodograph(const std::vector<VALUE>& vecPoles_, std::vector<VALUE>& vecHodograph_);
+
+        // Multiply the control points by the binomial coefficients of their degree.
+        template<typename VALUE>
+        static void MultiplyBinomials(std::vector<VALUE>& vecPoles_);
+
+        // Returns the sum of Bernstein polynomials of the control points multiplied by the binomial coefficients.
+        template<typename VALUE>
+        static VALUE CalculateBernstein(const std::vector<VALUE>& vecPoles_, double nParam_);
+
+    private:
+        double m_nStartKnot;
+        double m_nEndKnot;
+        double m_nAlpha;
+        bool m_bRational;
+
+        // The control points of the curve and hodographs, which are weighted for rational bezier node
+        std::vector<TYPE> m_vecPoles;
+        std::vector<TYPE> m_vecDeriv1Poles;
+        std::vector<TYPE> m_vecDeriv2Poles;
+
+        // The weights of the curve and hodographs, which are empty for non rational bezier node
+        VECDOUBLE m_vecWeights;
+        VECDOUBLE m_vecDeriv1Weights;
+        VECDOUBLE m_vecDeriv2Weights;
+    };
+
+    /**
+     * The implementation of template class.
+     */
+    template<typename TYPE>
+    CBezierParser<TYPE>::CBezierParser()
+        : m_nStartKnot(0.0)
+        , m_nEndKnot(0.0)
+        , m_nAlpha(0.0)
+        , m_bRational(false)
+    {
+    }
+
+    template<typename TYPE>
+    CBezierParser<TYPE>::~CBezierParser()
+    {
+    }
+
+    template<typename TYPE>
+    void CBezierParser<TYPE>::SetBezierNode(const BezierNode<TYPE>* pBezierNode_)
+    {
+        NEAT_RAISE(pBezierNode_ == nullptr, g_strEmptyPointer);
+
+        // Check if bezier node is legal
+        const std::vector<TYPE>& _vecPoles = pBezierNode_->vecPoles;
+        const VECDOUBLE& _vecWeights = pBezierNode_->vecWeights;
+        NEAT_RAISE(_vecPoles.size() < 2 || pBezierNode_->nStartKnot >= pBezierNode_->nEndKnot, g_strBezierParamsError);
+        NEAT_RAISE(!_vecWeights.empty() && _vecWeights.size() != _vecPoles.size(), g_strBezierParamsError);
+
+        m_nStartKnot = pBezierNode_->nStartKnot;
+        m_nEndKnot = pBezierNode_->nEndKnot;
+        m_nAlpha = 1.0 / (m_nEndKnot - m_nStartKnot);
+
+        // Check if bezier node is rational
+        m_bRational = false;
+        for (size_t i = 1, _nSize = _vecWeights.size(); i < _nSize && !m_bRational; ++i) {
+            m_bRational = !DOUBLE_EQU(_vecWeights[0], _vecWeights[i]);
+        }
+
+        // The containers keep their capacity, so setting bezier nodes of the same degree does not allocate
+        m_vecPoles.assign(_vecPoles.begin(), _vecPoles.end());
+        m_vecWeights.clear();
+        if (m_bRational) {
+            m_vecWeights.assign(_vecWeights.begin(), _vecWeights.end());
+            for (size_t i = 0, _nSize = m_vecPoles.size(); i < _nSize; ++i) {
+                m_vecPoles[i] *= m_vecWeights[i];
+            }
+        }
+
+        ConstructHodograph(m_vecPoles, m_vecDeriv1Poles);
+        ConstructHodograph(m_vecDeriv1Poles, m_vecDeriv2Poles);
+        MultiplyBinomials(m_vecPoles);
+        MultiplyBinomials(m_vecDeriv1Poles);
+        MultiplyBinomials(m_vecDeriv2Poles);
+
+        ConstructHodograph(m_vecWeights, m_vecDeriv1Weights);
+        ConstructHodograph(m_vecDeriv1Weights, m_vecDeriv2Weights);
+        MultiplyBinomials(m_vecWeights);
+        MultiplyBinomials(m_vecDeriv1Weights);
+        MultiplyBinomials(m_vecDeriv2Weights);
+    }
+
+    template<typename TYPE>
+    void CBezierParser<TYPE>::GetBezierPoint(double nKnot_, TYPE& ptPoint_)
+    {
+        NEAT_RAISE(m_vecPoles.empty(), g_strEmptyPointer);
+
+        double _nParam = NormalizeKnot(nKnot_);
+        ptPoint_ = CalculateBernstein(m_vecPoles, _nParam);
+        if (m_bRational) {
+            ptPoint_ /= CalculateBernstein(m_vecWeights, _nParam);
+        }
+    }
+
+    template<typename TYPE>
+    void CBezierParser<TYPE>::GetBezierDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_)
+    {
+        NEAT_RAISE(m_vecPoles.empty(), g_strEmptyPointer);
+
+        double _nParam = NormalizeKnot(nKnot_);
+        ptPoint_ = CalculateBernstein(m_vecPoles, _nParam);
+        ptDeriv1_ = CalculateBernstein(m_vecDeriv1Poles, _nParam) * m_nAlpha;
+        if (m_bRational) {
+            double _nWeight = 1.0 / CalculateBernstein(m_vecWeights, _nParam);
+            ptPoint_ *= _nWeight;
+            ptDeriv1_ = (ptDeriv1_ - ptPoint_ * (CalculateBernstein(m_vecDeriv1Weights, _nParam) * m_nAlpha)) * _nWeight;
+        }
+    }
+
+    template<typename TYPE>
+    void CBezierParser<TYPE>::GetBezierDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
+    {
+        NEAT_RAISE(m_vecPoles.empty(), g_strEmptyPointer);
+
+        double _nParam = NormalizeKnot(nKnot_);
+        ptPoint_ = CalculateBernstein(m_vecPoles, _nParam);
+        ptDeriv1_ = CalculateBernstein(m_vecDeriv1Poles, _nParam) * m_nAlpha;
+        ptDeriv2_ = CalculateBernstein(m_vecDeriv2Poles, _nParam) * (m_nAlpha * m_nAlpha);
+        if (m_bRational) {
+            double _nWeight = 1.0 / CalculateBernstein(m_vecWeights, _nParam);
+            double _nDeriv1Weight = CalculateBernstein(m_vecDeriv1Weights, _nParam) * m_nAlpha;
+            double _nDeriv2Weight = CalculateBernstein(m_vecDeriv2Weights, _nParam) * (m_nAlpha * m_nAlpha);
+            ptPoint_ *= _nWeight;
+            ptDeriv1_ = (ptDeriv1_ - ptPoint_ * _nDeriv1Weight) * _nWeight;
+            ptDeriv2_ = (ptDeriv2_ - ptDeriv1_ * (2.0 * _nDeriv1Weight) - ptPoint_ * _nDeriv2Weight) * _nWeight;
+        }
+    }
+
+    template<typename TYPE>
+    double CBezierParser<TYPE>::NormalizeKnot(double nKnot_) const
+    {
+        NEAT_RAISE(nKnot_ < m_nStartKnot || nKnot_ > m_nEndKnot, g_strBezierParamsError);
+        return (nKnot_ - m_nStartKnot) * m_nAlpha;
+    }
+
+    template<typename TYPE>
+    template<typename VALUE>
+    void CBezierParser<TYPE>::ConstructHodograph(const std::vector<VALUE>& vecPoles_, std::vector<VALUE>& vecHodograph_)
+    {
+        // The hodograph of degree n curve is n * (P[i + 1] - P[i])
+        vecHodograph_.clear();
+        double _nDegree = static_cast<double>(vecPoles_.size()) - 1.0;
+        for (size_t i = 1, _nSize = vecPoles_.size(); i < _nSize; ++i) {
+            vecHodograph_.push_back((vecPoles_[i] - vecPoles_[i - 1]) * _nDegree);
+        }
+    }
+
+    template<typename TYPE>
+    template<typename VALUE>
+    void CBezierParser<TYPE>::MultiplyBinomials(std::vector<VALUE>& vecPoles_)
+    {
+        // C(n, i) = C(n, i - 1) * (n - i + 1) / i
+        int _nDegree = static_cast<int>(vecPoles_.size()) - 1;
+        double _nBinomial = 1.0;
+        for (int i = 1; i < _nDegree; ++i) {
+            _nBinomial = _nBinomial * (_nDegree - i + 1) / i;
+            vecPoles_[i] *= _nBinomial;
+        }
+    }
+
+    template<typename TYPE>
+    template<typename VALUE>
+    VALUE CBezierParser<TYPE>::CalculateBernstein(const std::vector<VALUE>& vecPoles_, double nParam_)
+    {
+        // The zero hodograph of low degree curve
+        if (vecPoles_.empty()) {
+            return VALUE();
+        }
+
+        // Horner scheme in t / (1 - t) or (1 - t) / t, whichever is no more than one
+        const VALUE* _pPoles = vecPoles_.data();
+        int _nDegree = static_cast<int>(vecPoles_.size()) - 1;
+        double _nParam1 = 1.0 - nParam_;
+        double _nPower = 1.0;
+        VALUE _Result;
+        if (nParam_ < 0.5) {
+            double _nRatio = nParam_ / _nParam1;
+            _Result = _pPoles[_nDegree];
+            for (int i = _nDegree - 1; i >= 0; --i) {
+                _Result = _Result * _nRatio + _pPoles[i];
+                _nPower *= _nParam1;
+            }
+        }
+        else {
+            double _nRatio = _nParam1 / nParam_;
+            _Result = _pPoles[0];
+            for (int i = 1; i <= _nDegree; ++i) {
+                _Result = _Result * _nRatio + _pPoles[i];
+                _nPower *= nParam_;
+            }
+        }
+
+        return _Result * _nPower;
+    }
+
+} // End namespace neat
+
+#endif // __BEZIER_PARSER_H_20200302__
\ No newline at end of file
@@ -0,0 +1,410 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __DEBOOR_KERNEL_H_20200302__
+#define __DEBOOR_KERNEL_H_20200302__
+
+/**
+ * This file defines the De-Boor kernels specialized by degree.
+ */
+namespace neat
+{
+    /**
+     * This class calculates the De-Boor algorithm of the fixed degree.
+     * The valid poles are copied to the stack and all iterations have the compile-time bounds,
+     * so the loops are unrolled by compiler and no range checked container is accessed.
+     * The pKnots_, pPoles_ and pWeights_ point to the first element of the knots, poles and weights.
+     */
+    template<typename TYPE, int DEGREE>
+    class CDeBoorKernel
+    {
+    public:
+        // Calculate the point, first-order derivative and second-order derivative of Non-rational B-spline curve.
+        static void CalculatePoint(const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_, TYPE& ptPoint_);
+        static void CalculateDeriv(const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+            TYPE& ptPoint_, TYPE& ptDeriv1_);
+        static void CalculateDeriv(const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+            TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
+
+        // Calculate the point and first-order derivative of rational B-spline curve with poles and weights.
+        static void CalculateRationalPoint(const double* pKnots_, const TYPE* pPoles_, const double* pWeights_, int nKnotIndex_,
+            double nKnot_, TYPE& ptPoint_);
+        static void CalculateRationalDeriv(const double* pKnots_, const TYPE* pPoles_, const double* pWeights_, int nKnotIndex_,
+            double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_);
+
+        // Calculate the derivatives of numerator and denominator of rational B-spline curve with weighted poles and weights.
+        static void CalculateHomogeneousDeriv(const double* pKnots_, const TYPE* pWeightedPoles_, const double* pWeights_,
+            int nKnotIndex_, double nKnot_, TYPE* pNumeratorDeriv_, double* pDenominatorDeriv_);
+
+    private:
+        // De-Boor recursive algorithm from level START + 1 to level END, pKnots_ points to the knot of span.
+        template<int START, int END>
+        static void DeBoorAlgorithm(const double* pKnots_, double nKnot_, TYPE* pPoles_);
+
+        template<int START, int END>
+        static void DeBoorAlgorithm(const double* pKnots_, double nKnot_, TYPE* pPoles_, double* pWeights_);
+
+        template<int START, int END>
+        static void HomogeneousDeBoorAlgorithm(const double* pKnots_, double nKnot_, TYPE* pPoles_, double* pWeights_);
+    };
+
+    /**
+     * The dispatchers of De-Boor kernels, which return false if the degree has no specialized kernel.
+     */
+    template<typename TYPE>
+    bool DeBoorKernelPoint(int nDegree_, const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_);
+
+    template<typename TYPE>
+    bool DeBoorKernelDeriv(int nDegree_, const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_, TYPE& ptDeriv1_);
+
+    template<typename TYPE>
+    bool DeBoorKernelDeriv(int nDegree_, const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
+
+    template<typename TYPE>
+    bool DeBoorKernelRationalPoint(int nDegree_, const double* pKnots_, const TYPE* pPoles_, const double* pWeights_,
+        int nKnotIndex_, double nKnot_, TYPE& ptPoint_);
+
+    template<typename TYPE>
+    bool DeBoorKernelRationalDeriv(int nDegree_, const double* pKnots_, const TYPE* pPoles_, const double* pWeights_,
+        int nKnotIndex_, double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_);
+
+    template<typename TYPE>
+    bool DeBoorKernelHomogeneousDeriv(int nDegree_, const double* pKnots_, const TYPE* pWeightedPoles_, const double* pWeights_,
+        int nKnotIndex_, double nKnot_, TYPE* pNumeratorDeriv_, double* pDenominatorDeriv_);
+
+    /**
+     * The implementation of template class.
+     */
+    template<typename TYPE, int DEGREE>
+    void CDeBoorKernel<TYPE, DEGREE>::CalculatePoint(const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_)
+    {
+        TYPE _ptxPoles[DEGREE + 1];
+        for (int i = 0; i <= DEGREE; ++i) {
+            _ptxPoles[i] = pPoles_[nKnotIndex_ - DEGREE + i];
+        }
+
+        DeBoorAlgorithm<0, DEGREE>(pKnots_ + nKnotIndex_, nKnot_, _ptxPoles);
+        ptPoint_ = _ptxPoles[DEGREE];
+    }
+
+    template<typename TYPE, int DEGREE>
+    void CDeBoorKernel<TYPE, DEGREE>::CalculateDeriv(const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_, TYPE& ptDeriv1_)
+    {
+        const double* _pKnots = pKnots_ + nKnotIndex_;
+        TYPE _ptxPoles[DEGREE + 1];
+        for (int i = 0; i <= DEGREE; ++i) {
+            _ptxPoles[i] = pPoles_[nKnotIndex_ - DEGREE + i];
+        }
+
+        DeBoorAlgorithm<0, DEGREE - 1>(_pKnots, nKnot_, _ptxPoles);
+        ptDeriv1_ = (_ptxPoles[DEGREE] - _ptxPoles[DEGREE - 1]) * static_cast<double>(DEGREE) / (_pKnots[1] - _pKnots[0]);
+
+        DeBoorAlgorithm<DEGREE - 1, DEGREE>(_pKnots, nKnot_, _ptxPoles);
+        ptPoint_ = _ptxPoles[DEGREE];
+    }
+
+    template<typename TYPE, int DEGREE>
+    void CDeBoorKernel<TYPE, DEGREE>::CalculateDeriv(const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
+    {
+        static_assert(DEGREE >= 2, "The degree is too low to calculate second-order derivative");
+
+        const double* _pKnots = pKnots_ + nKnotIndex_;
+        TYPE _ptxPoles[DEGREE + 1];
+        for (int i = 0; i <= DEGREE; ++i) {
+            _ptxPoles[i] = pPoles_[nKnotIndex_ - DEGREE + i];
+        }
+
+        DeBoorAlgorithm<0, DEGREE - 2>(_pKnots, nKnot_, _ptxPoles);
+
+        double _nAlpha = DEGREE / (_pKnots[1] - _pKnots[0]);
+        ptDeriv2_ = _nAlpha * (DEGREE - 1) * ((_ptxPoles[DEGREE] - _ptxPoles[DEGREE - 1]) / (_pKnots[2] - _pKnots[0])
+            - (_ptxPoles[DEGREE - 1] - _ptxPoles[DEGREE - 2]) / (_pKnots[1] - _pKnots[-1]));
+
+        DeBoorAlgorithm<DEGREE - 2, DEGREE - 1>(_pKnots, nKnot_, _ptxPoles);
+        ptDeriv1_ = _nAlpha * (_ptxPoles[DEGREE] - _ptxPoles[DEGREE - 1]);
+
+        DeBoorAlgorithm<DEGREE - 1, DEGREE>(_pKnots, nKnot_, _ptxPoles);
+        ptPoint_ = _ptxPoles[DEGREE];
+    }
+
+    template<typename TYPE, int DEGREE>
+    void CDeBoorKernel<TYPE, DEGREE>::CalculateRationalPoint(const double* pKnots_, const TYPE* pPoles_, const double* pWeights_,
+        int nKnotIndex_, double nKnot_, TYPE& ptPoint_)
+    {
+        TYPE _ptxPoles[DEGREE + 1];
+        double _nxWeights[DEGREE + 1];
+        for (int i = 0; i <= DEGREE; ++i) {
+            _ptxPoles[i] = pPoles_[nKnotIndex_ - DEGREE + i];
+            _nxWeights[i] = pWeights_[nKnotIndex_ - DEGREE + i];
+        }
+
+        DeBoorAlgorithm<0, DEGREE>(pKnots_ + nKnotIndex_, nKnot_, _ptxPoles, _nxWeights);
+        ptPoint_ = _ptxPoles[DEGREE];
+    }
+
+    template<typename TYPE, int DEGREE>
+    void CDeBoorKernel<TYPE, DEGREE>::CalculateRationalDeriv(const double* pKnots_, const TYPE* pPoles_, const double* pWeights_,
+        int nKnotIndex_, double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_)
+    {
+        const double* _pKnots = pKnots_ + nKnotIndex_;
+        TYPE _ptxPoles[DEGREE + 1];
+        double _nxWeights[DEGREE + 1];
+        for (int i = 0; i <= DEGREE; ++i) {
+            _ptxPoles[i] = pPoles_[nKnotIndex_ - DEGREE + i];
+            _nxWeights[i] = pWeights_[nKnotIndex_ - DEGREE + i];
+        }
+
+        DeBoorAlgorithm<0, DEGREE - 1>(_pKnots, nKnot_, _ptxPoles, _nxWeights);
+
+        double _nAlpha = 1.0 / (_pKnots[1] - _pKnots[0]);
+        double _nBeta = (nKnot_ - _pKnots[0]) * _nAlpha;
+        double _nWeight = (1.0 - _nBeta) * _nxWeights[DEGREE - 1] + _nBeta * _nxWeights[DEGREE];
+        ptDeriv1_ = (_ptxPoles[DEGREE] - _ptxPoles[DEGREE - 1]) * static_cast<double>(DEGREE) * _nAlpha
+            * _nxWeights[DEGREE] * _nxWeights[DEGREE - 1] / (_nWeight * _nWeight);
+
+        DeBoorAlgorithm<DEGREE - 1, DEGREE>(_pKnots, nKnot_, _ptxPoles, _nxWeights);
+        ptPoint_ = _ptxPoles[DEGREE];
+    }
+
+    template<typename TYPE, int DEGREE>
+    void CDeBoorKernel<TYPE, DEGREE>::CalculateHomogeneousDeriv(const double* pKnots_, const TYPE* pWeightedPoles_,
+        const double* pWeights_, int nKnotIndex_, double nKnot_, TYPE* pNumeratorDeriv_, double* pDenominatorDeriv_)
+    {
+        static_assert(DEGREE >= 2, "The degree is too low to calculate second-order derivative");
+
+        const double* _pKnots = pKnots_ + nKnotIndex_;
+        TYPE _ptxPoles[DEGREE + 1];
+        double _nxWeights[DEGREE + 1];
+        for (int i = 0; i <= DEGREE; ++i) {
+            _ptxPoles[i] = pWeightedPoles_[nKnotIndex_ - DEGREE + i];
+            _nxWeights[i] = pWeights_[nKnotIndex_ - DEGREE + i];
+        }
+
+        HomogeneousDeBoorAlgorithm<0, DEGREE - 2>(_pKnots, nKnot_, _ptxPoles, _nxWeights);
+
+        double _nAlpha1 = DEGREE / (_pKnots[1] - _pKnots[0]);
+        double _nAlpha2 = 1.0 / (_pKnots[2] - _pKnots[0]);
+        double _nAlpha3 = 1.0 / (_pKnots[1] - _pKnots[-1]);
+        pNumeratorDeriv_[2] = _nAlpha1 * (DEGREE - 1) * ((_ptxPoles[DEGREE] - _ptxPoles[DEGREE - 1]) * _nAlpha2
+            - (_ptxPoles[DEGREE - 1] - _ptxPoles[DEGREE - 2]) * _nAlpha3);
+        pDenominatorDeriv_[2] = _nAlpha1 * (DEGREE - 1) * ((_nxWeights[DEGREE] - _nxWeights[DEGREE - 1]) * _nAlpha2
+            - (_nxWeights[DEGREE - 1] - _nxWeights[DEGREE - 2]) * _nAlpha3);
+
+        HomogeneousDeBoorAlgorithm<DEGREE - 2, DEGREE - 1>(_pKnots, nKnot_, _ptxPoles, _nxWeights);
+        pNumeratorDeriv_[1] = _nAlpha1 * (_ptxPoles[DEGREE] - _ptxPoles[DEGREE - 1]);
+        pDenominatorDeriv_[1] = _nAlpha1 * (_nxWeights[DEGREE] - _nxWeights[DEGREE - 1]);
+
+        HomogeneousDeBoorAlgorithm<DEGREE - 1, DEGREE>(_pKnots, nKnot_, _ptxPoles, _nxWeights);
+        pNumeratorDeriv_[0] = _ptxPoles[DEGREE];
+        pDenominatorDeriv_[0] = _nxWeights[DEGREE];
+    }
+
+    template<typename TYPE, int DEGREE>
+    template<int START, int END>
+    void CDeBoorKernel<TYPE, DEGREE>::DeBoorAlgorithm(const double* pKnots_, double nKnot_, TYPE* pPoles_)
+    {
+        // The poles are updated from back to front, so only one array is needed
+        for (int i = START + 1; i <= END; ++i) {
+            for (int j = DEGREE; j >= i; --j) {
+                double _nAlpha = (nKnot_ - pKnots_[j - DEGREE]) / (pKnots_[j + 1 - i] - pKnots_[j - DEGREE]);
+                pPoles_[j] = pPoles_[j - 1] * (1.0 - _nAlpha) + pPoles_[j] * _nAlpha;
+            }
+        }
+    }
+
+    template<typename TYPE, int DEGREE>
+    template<int START, int END>
+    void CDeBoorKernel<TYPE, DEGREE>::DeBoorAlgorithm(const double* pKnots_, double nKnot_, TYPE* pPoles_, double* pWeights_)
+    {
+        for (int i = START + 1; i <= END; ++i) {
+            for (int j = DEGREE; j >= i; --j) {
+                double _nAlpha = (nKnot_ - pKnots_[j - DEGREE]) / (pKnots_[j + 1 - i] - pKnots_[j - DEGREE]);
+                double _nWeight = (1.0 - _nAlpha) * pWeights_[j - 1] + _nAlpha * pWeights_[j];
+                pPoles_[j] = pPoles_[j - 1] * (1.0 - _nAlpha) * pWeights_[j - 1] / _nWeight
+                    + pPoles_[j] * _nAlpha * pWeights_[j] / _nWeight;
+                pWeights_[j] = _nWeight;
+            }
+        }
+    }
+
+    template<typename TYPE, int DEGREE>
+    template<int START, int END>
+    void CDeBoorKernel<TYPE, DEGREE>::HomogeneousDeBoorAlgorithm(const double* pKnots_, double nKnot_, TYPE* pPoles_,
+        double* pWeights_)
+    {
+        for (int i = START + 1; i <= END; ++i) {
+            for (int j = DEGREE; j >= i; --j) {
+                double _nAlpha = (nKnot_ - pKnots_[j - DEGREE]) / (pKnots_[j + 1 - i] - pKnots_[j - DEGREE]);
+                pPoles_[j] = pPoles_[j - 1] * (1.0 - _nAlpha) + pPoles_[j] * _nAlpha;
+                pWeights_[j] = pWeights_[j - 1] * (1.0 - _nAlpha) + pWeights_[j] * _nAlpha;
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template<typename TYPE>
+    bool DeBoorKernelPoint(int nDegree_, const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_)
+    {
+        switch (nDegree_) {
+        case 1:
+            CDeBoorKernel<TYPE, 1>::CalculatePoint(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        case 2:
+            CDeBoorKernel<TYPE, 2>::CalculatePoint(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        case 3:
+            CDeBoorKernel<TYPE, 3>::CalculatePoint(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        case 4:
+            CDeBoorKernel<TYPE, 4>::CalculatePoint(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        case 5:
+            CDeBoorKernel<TYPE, 5>::CalculatePoint(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    template<typename TYPE>
+    bool DeBoorKernelDeriv(int nDegree_, const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_, TYPE& ptDeriv1_)
+    {
+        switch (nDegree_) {
+        case 1:
+            CDeBoorKernel<TYPE, 1>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        case 2:
+            CDeBoorKernel<TYPE, 2>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        case 3:
+            CDeBoorKernel<TYPE, 3>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        case 4:
+            CDeBoorKernel<TYPE, 4>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        case 5:
+            CDeBoorKernel<TYPE, 5>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    template<typename TYPE>
+    bool DeBoorKernelDeriv(int nDegree_, const double* pKnots_, const TYPE* pPoles_, int nKnotIndex_, double nKnot_,
+        TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
+    {
+        switch (nDegree_) {
+        case 2:
+            CDeBoorKernel<TYPE, 2>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+            return true;
+        case 3:
+            CDeBoorKernel<TYPE, 3>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+            return true;
+        case 4:
+            CDeBoorKernel<TYPE, 4>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+            return true;
+        case 5:
+            CDeBoorKernel<TYPE, 5>::CalculateDeriv(pKnots_, pPoles_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    template<typename TYPE>
+    bool DeBoorKernelRationalPoint(int nDegree_, const double* pKnots_, const TYPE* pPoles_, const double* pWeights_,
+        int nKnotIndex_, double nKnot_, TYPE& ptPoint_)
+    {
+        switch (nDegree_) {
+        case 1:
+            CDeBoorKernel<TYPE, 1>::CalculateRationalPoint(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        case 2:
+            CDeBoorKernel<TYPE, 2>::CalculateRationalPoint(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        case 3:
+            CDeBoorKernel<TYPE, 3>::CalculateRationalPoint(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        case 4:
+            CDeBoorKernel<TYPE, 4>::CalculateRationalPoint(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        case 5:
+            CDeBoorKernel<TYPE, 5>::CalculateRationalPoint(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    template<typename TYPE>
+    bool DeBoorKernelRationalDeriv(int nDegree_, const double* pKnots_, const TYPE* pPoles_, const double* pWeights_,
+        int nKnotIndex_, double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_)
+    {
+        switch (nDegree_) {
+        case 1:
+            CDeBoorKernel<TYPE, 1>::CalculateRationalDeriv(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        case 2:
+            CDeBoorKernel<TYPE, 2>::CalculateRationalDeriv(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        case 3:
+            CDeBoorKernel<TYPE, 3>::CalculateRationalDeriv(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        case 4:
+            CDeBoorKernel<TYPE, 4>::CalculateRationalDeriv(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        case 5:
+            CDeBoorKernel<TYPE, 5>::CalculateRationalDeriv(pKnots_, pPoles_, pWeights_, nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    template<typename TYPE>
+    bool DeBoorKernelHomogeneousDeriv(int nDegree_, const double* pKnots_, const TYPE* pWeightedPoles_, const double* pWeights_,
+        int nKnotIndex_, double nKnot_, TYPE* pNumeratorDeriv_, double* pDenominatorDeriv_)
+    {
+        switch (nDegree_) {
+        case 2:
+            CDeBoorKernel<TYPE, 2>::CalculateHomogeneousDeriv(pKnots_, pWeightedPoles_, pWeights_, nKnotIndex_, nKnot_,
+                pNumeratorDeriv_, pDenominatorDeriv_);
+            return true;
+        case 3:
+            CDeBoorKernel<TYPE, 3>::CalculateHomogeneousDeriv(pKnots_, pWeightedPoles_, pWeights_, nKnotIndex_, nKnot_,
+                pNumeratorDeriv_, pDenominatorDeriv_);
+            return true;
+        case 4:
+            CDeBoorKernel<TYPE, 4>::CalculateHomogeneousDeriv(pKnots_, pWeightedPoles_, pWeights_, nKnotIndex_, nKnot_,
+                pNumeratorDeriv_, pDenominatorDeriv_);
+            return true;
+        case 5:
+            CDeBoorKernel<TYPE, 5>::CalculateHomogeneousDeriv(pKnots_, pWeightedPoles_, pWeights_, nKnotIndex_, nKnot_,
+                pNumeratorDeriv_, pDenominatorDeriv_);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+} // End namespace neat
+
+#endif // __DEBOOR_KERNEL_H_20200302__
\ No newline at end of file
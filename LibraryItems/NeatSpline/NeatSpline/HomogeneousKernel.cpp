@@ -0,0 +1,238 @@
+/***************************************************************************************************
+ Created on: 2020-01-30
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#include "pch.h"
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define NEAT_VECTOR_KERNEL
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define NEAT_TARGET_AVX2
+    #else
+        #define NEAT_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#endif
+#include <atomic>
+
+using namespace neat;
+
+/**
+ * The highest degree of vectorized kernel, the poles are copied to the registers on stack.
+ */
+static const int g_nVectorDegreeMax = 15;
+
+/**
+ * The AVX2 kernel is used only if it is supported and enabled.
+ */
+static const bool g_bAvx2Support = CheckAvx2Support();
+static std::atomic<bool> g_bVectorKernel(g_bAvx2Support);
+
+/**
+ * Calculate in pDerivs_ the homogeneous derivatives up to nOrder_ (no more than 2) by AVX2, 4 doubles for every order.
+ */
+static void CalculateHomogeneousDeriv(int nDegree_, const double* pKnots_, const DPOINT4* pHomogeneousPoles_, int nKnotIndex_,
+    double nKnot_, int nOrder_, double* pDerivs_);
+
+/**
+ * Project the homogeneous derivatives up to nOrder_ to the derivatives of three-dimensional curve.
+ */
+static void ProjectHomogeneousDeriv(const double* pDerivs_, int nOrder_, DPOINT3* pProjectDerivs_);
+
+/**
+ * Returns true if the vectorized kernel can calculate the homogeneous derivatives.
+ */
+static bool CheckVectorKernelDegree(int nDegree_, const DPOINT4* pHomogeneousPoles_);
+
+//////////////////////////////////////////////////////////////////////////
+bool neat::CheckAvx2Support()
+{
+#ifndef NEAT_VECTOR_KERNEL
+    return false;
+#elif defined(_MSC_VER)
+    // CPUID.1:ECX.FMA[12], OSXSAVE[27], AVX[28] and CPUID.7:EBX.AVX2[5]
+    int _nxRegisters[4] = { 0 };
+    __cpuid(_nxRegisters, 0);
+    if (_nxRegisters[0] < 7) {
+        return false;
+    }
+
+    __cpuid(_nxRegisters, 1);
+    const int _nFeatures = (1 << 12) | (1 << 27) | (1 << 28);
+    if ((_nxRegisters[2] & _nFeatures) != _nFeatures) {
+        return false;
+    }
+
+    // The operating system saves the XMM and YMM registers
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(_nxRegisters, 7, 0);
+    return (_nxRegisters[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+bool neat::CheckVectorKernel()
+{
+    return g_bVectorKernel.load(std::memory_order_relaxed);
+}
+
+void neat::EnableVectorKernel(bool bEnable_)
+{
+    g_bVectorKernel.store(bEnable_ && g_bAvx2Support, std::memory_order_relaxed);
+}
+
+void neat::UpgradeHomogeneousPoles(const NurbsNode3D& NurbsNode_, std::vector<DPOINT4>& vecHomogeneousPoles_)
+{
+    vecHomogeneousPoles_.resize(NurbsNode_.vecPoles.size());
+    for (size_t i = 0, _nSize = NurbsNode_.vecPoles.size(); i < _nSize; ++i) {
+        const DPOINT3& _ptPole = NurbsNode_.vecPoles[i];
+        const double& _nWeight = NurbsNode_.vecWeights[i];
+        DPOINT4& _ptHomogeneousPole = vecHomogeneousPoles_[i];
+        _ptHomogeneousPole[axis::x] = _ptPole[axis::x] * _nWeight;
+        _ptHomogeneousPole[axis::y] = _ptPole[axis::y] * _nWeight;
+        _ptHomogeneousPole[axis::z] = _ptPole[axis::z] * _nWeight;
+        _ptHomogeneousPole[3] = _nWeight;
+    }
+}
+
+bool neat::HomogeneousKernelPoint(int nDegree_, const double* pKnots_, const DPOINT4* pHomogeneousPoles_, int nKnotIndex_,
+    double nKnot_, DPOINT3& ptPoint_)
+{
+    if (!CheckVectorKernelDegree(nDegree_, pHomogeneousPoles_)) {
+        return false;
+    }
+
+    double _nxDerivs[4];
+    CalculateHomogeneousDeriv(nDegree_, pKnots_, pHomogeneousPoles_, nKnotIndex_, nKnot_, 0, _nxDerivs);
+    ProjectHomogeneousDeriv(_nxDerivs, 0, &ptPoint_);
+    return true;
+}
+
+bool neat::HomogeneousKernelDeriv(int nDegree_, const double* pKnots_, const DPOINT4* pHomogeneousPoles_, int nKnotIndex_,
+    double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+{
+    if (!CheckVectorKernelDegree(nDegree_, pHomogeneousPoles_)) {
+        return false;
+    }
+
+    double _nxDerivs[8];
+    DPOINT3 _ptxDerivs[2];
+    CalculateHomogeneousDeriv(nDegree_, pKnots_, pHomogeneousPoles_, nKnotIndex_, nKnot_, 1, _nxDerivs);
+    ProjectHomogeneousDeriv(_nxDerivs, 1, _ptxDerivs);
+    ptPoint_ = _ptxDerivs[0];
+    ptDeriv1_ = _ptxDerivs[1];
+    return true;
+}
+
+bool neat::HomogeneousKernelDeriv(int nDegree_, const double* pKnots_, const DPOINT4* pHomogeneousPoles_, int nKnotIndex_,
+    double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
+{
+    if (!CheckVectorKernelDegree(nDegree_, pHomogeneousPoles_)) {
+        return false;
+    }
+
+    double _nxDerivs[12];
+    DPOINT3 _ptxDerivs[3];
+    CalculateHomogeneousDeriv(nDegree_, pKnots_, pHomogeneousPoles_, nKnotIndex_, nKnot_, 2, _nxDerivs);
+    ProjectHomogeneousDeriv(_nxDerivs, 2, _ptxDerivs);
+    ptPoint_ = _ptxDerivs[0];
+    ptDeriv1_ = _ptxDerivs[1];
+    ptDeriv2_ = _ptxDerivs[2];
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool CheckVectorKernelDegree(int nDegree_, const DPOINT4* pHomogeneousPoles_)
+{
+    return pHomogeneousPoles_ != nullptr && nDegree_ <= g_nVectorDegreeMax && g_bVectorKernel.load(std::memory_order_relaxed);
+}
+
+#ifdef NEAT_VECTOR_KERNEL
+NEAT_TARGET_AVX2
+static void VectorDeBoorAlgorithm(const double* pKnots_, double nKnot_, int nDegree_, int nStartLevel_, int nEndLevel_,
+    __m256d* pPoles_)
+{
+    // P[j] = P[j - 1] + alpha * (P[j] - P[j - 1]), pKnots_ points to the knot of span
+    for (int i = nStartLevel_ + 1; i <= nEndLevel_; ++i) {
+        for (int j = nDegree_; j >= i; --j) {
+            double _nAlpha = (nKnot_ - pKnots_[j - nDegree_]) / (pKnots_[j + 1 - i] - pKnots_[j - nDegree_]);
+            pPoles_[j] = _mm256_fmadd_pd(_mm256_set1_pd(_nAlpha), _mm256_sub_pd(pPoles_[j], pPoles_[j - 1]), pPoles_[j - 1]);
+        }
+    }
+}
+
+NEAT_TARGET_AVX2
+static void CalculateHomogeneousDeriv(int nDegree_, const double* pKnots_, const DPOINT4* pHomogeneousPoles_, int nKnotIndex_,
+    double nKnot_, int nOrder_, double* pDerivs_)
+{
+    // The homogeneous pole (wx, wy, wz, w) is one register
+    __m256d _vxPoles[g_nVectorDegreeMax + 1];
+    const double* _pPoles = reinterpret_cast<const double*>(pHomogeneousPoles_ + nKnotIndex_ - nDegree_);
+    for (int i = 0; i <= nDegree_; ++i) {
+        _vxPoles[i] = _mm256_loadu_pd(_pPoles + 4 * i);
+    }
+
+    const double* _pKnots = pKnots_ + nKnotIndex_;
+    int _nLevel = 0;
+    __m256d _vAlpha1 = _mm256_set1_pd(nDegree_ / (_pKnots[1] - _pKnots[0]));
+    if (nOrder_ >= 2) {
+        __m256d _vDeriv2 = _mm256_setzero_pd();
+        if (nDegree_ >= 2) {
+            VectorDeBoorAlgorithm(_pKnots, nKnot_, nDegree_, _nLevel, nDegree_ - 2, _vxPoles);
+            _nLevel = nDegree_ - 2;
+
+            __m256d _vAlpha2 = _mm256_set1_pd(1.0 / (_pKnots[2] - _pKnots[0]));
+            __m256d _vAlpha3 = _mm256_set1_pd(1.0 / (_pKnots[1] - _pKnots[-1]));
+            __m256d _vDiff1 = _mm256_mul_pd(_mm256_sub_pd(_vxPoles[nDegree_], _vxPoles[nDegree_ - 1]), _vAlpha2);
+            __m256d _vDiff2 = _mm256_mul_pd(_mm256_sub_pd(_vxPoles[nDegree_ - 1], _vxPoles[nDegree_ - 2]), _vAlpha3);
+            _vDeriv2 = _mm256_mul_pd(_mm256_mul_pd(_vAlpha1, _mm256_set1_pd(nDegree_ - 1.0)), _mm256_sub_pd(_vDiff1, _vDiff2));
+        }
+        _mm256_storeu_pd(pDerivs_ + 8, _vDeriv2);
+    }
+
+    if (nOrder_ >= 1) {
+        VectorDeBoorAlgorithm(_pKnots, nKnot_, nDegree_, _nLevel, nDegree_ - 1, _vxPoles);
+        _nLevel = nDegree_ - 1;
+        _mm256_storeu_pd(pDerivs_ + 4, _mm256_mul_pd(_vAlpha1, _mm256_sub_pd(_vxPoles[nDegree_], _vxPoles[nDegree_ - 1])));
+    }
+
+    VectorDeBoorAlgorithm(_pKnots, nKnot_, nDegree_, _nLevel, nDegree_, _vxPoles);
+    _mm256_storeu_pd(pDerivs_, _vxPoles[nDegree_]);
+}
+#else
+static void CalculateHomogeneousDeriv(int, const double*, const DPOINT4*, int, double, int, double*)
+{
+    // The vectorized kernel is never enabled without AVX2
+    NEAT_RAISE(!g_bAvx2Support, g_strFunctionNotImplemented);
+}
+#endif
+
+static void ProjectHomogeneousDeriv(const double* pDerivs_, int nOrder_, DPOINT3* pProjectDerivs_)
+{
+    // C = A / w, C' = (A' - w' * C) / w, C'' = (A'' - 2 * w' * C' - w'' * C) / w
+    double _nAlpha = 1.0 / pDerivs_[3];
+    for (int k = 0; k <= nOrder_; ++k) {
+        const double* _pDeriv = pDerivs_ + 4 * k;
+        DPOINT3 _ptDeriv(_pDeriv[0], _pDeriv[1], _pDeriv[2]);
+        if (k >= 1) {
+            _ptDeriv -= pProjectDerivs_[k - 1] * (k * pDerivs_[7]);
+        }
+        if (k >= 2) {
+            _ptDeriv -= pProjectDerivs_[0] * pDerivs_[11];
+        }
+        pProjectDerivs_[k] = _ptDeriv * _nAlpha;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __HOMOGENEOUS_KERNEL_H_20200302__
+#define __HOMOGENEOUS_KERNEL_H_20200302__
+
+/**
+ * This file defines the vectorized De-Boor kernel for rational three-dimensional nurbs curve.
+ */
+namespace neat
+{
+    /**
+     * The homogeneous pole (wx, wy, wz, w) of rational three-dimensional nurbs curve is held in one 4-wide register,
+     * so every step of De-Boor algorithm is one fused multiply-add for the pole and weight together.
+     * The AVX2 kernel is selected by the processor at runtime, and the dispatchers return false if it is not supported
+     * or disabled, then the caller falls back to the scalar kernels.
+     */
+
+    // Returns true if the processor and operating system support AVX2 and FMA.
+    bool CheckAvx2Support();
+
+    // Construct the homogeneous poles for the vectorized kernel.
+    void UpgradeHomogeneousPoles(const NurbsNode3D& NurbsNode_, std::vector<DPOINT4>& vecHomogeneousPoles_);
+
+    /**
+     * The dispatchers of vectorized kernel, pHomogeneousPoles_ points to the first homogeneous pole.
+     */
+    bool HomogeneousKernelPoint(int nDegree_, const double* pKnots_, const DPOINT4* pHomogeneousPoles_, int nKnotIndex_, double nKnot_,
+        DPOINT3& ptPoint_);
+
+    bool HomogeneousKernelDeriv(int nDegree_, const double* pKnots_, const DPOINT4* pHomogeneousPoles_, int nKnotIndex_, double nKnot_,
+        DPOINT3& ptPoint_, DPOINT3& ptDeriv1_);
+
+    bool HomogeneousKernelDeriv(int nDegree_, const double* pKnots_, const DPOINT4* pHomogeneousPoles_, int nKnotIndex_, double nKnot_,
+        DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_);
+
+    /**
+     * The other dimensions have no vectorized kernel.
+     */
+    template<typename TYPE>
+    void UpgradeHomogeneousPoles(const NurbsNode<TYPE>&, std::vector<DPOINT4>& vecHomogeneousPoles_)
+    {
+        vecHomogeneousPoles_.clear();
+    }
+
+    template<typename TYPE>
+    bool HomogeneousKernelPoint(int, const double*, const DPOINT4*, int, double, TYPE&)
+    {
+        return false;
+    }
+
+    template<typename TYPE>
+    bool HomogeneousKernelDeriv(int, const double*, const DPOINT4*, int, double, TYPE&, TYPE&)
+    {
+        return false;
+    }
+
+    template<typename TYPE>
+    bool HomogeneousKernelDeriv(int, const double*, const DPOINT4*, int, double, TYPE&, TYPE&, TYPE&)
+    {
+        return false;
+    }
+
+} // End namespace neat
+
+#endif // __HOMOGENEOUS_KERNEL_H_20200302__
\ No newline at end of file
@@ -31,6 +31,9 @@ namespace neat
         // Set the information for nurbs node.
         void SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_, bool bRational_);
 
+        // Set the information for compiled nurbs curve, which is not checked any more.
+        void SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_);
+
         // Returns in ptPoint_ the point of parameter nKnot_.
         void GetNurbsPoint(double nKnot_, TYPE& ptPoint_);
 
@@ -40,22 +43,43 @@ namespace neat
         // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
         void GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
 
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, TYPE* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_, TYPE* pDeriv2s_);
+
     private:
-        // Record valid poles.
-        void RecordValidPoles(int nKnotIndex_);
+        // Initialize the knot index to the first nonempty span.
+        void InitKnotIndex();
+
+        // Find the span of nKnot_ from the last knot index.
+        int LocateKnotIndex(double nKnot_);
+
+        // Copy the valid poles of the span nKnotIndex_ to the iteration poles of the generic De-Boor algorithm.
+        void CopyValidPoles(int nKnotIndex_);
+
+        // Calculate the point, first-order derivative and second-order derivative in the span nKnotIndex_.
+        void CalculatePoint(double nKnot_, int nKnotIndex_, TYPE& ptPoint_);
+        void CalculateDeriv(double nKnot_, int nKnotIndex_, TYPE& ptPoint_, TYPE& ptDeriv1_);
+        void CalculateDeriv(double nKnot_, int nKnotIndex_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
 
         // De-Boor recursive algorithm to calculate iteration poles.
         void DeBoorAlgorithm(double nKnot_, int nKnotIndex_, int nStartIndex_, int nEndIndex_);
 
     private:
         NurbsNode<TYPE>* m_pNurbsNode;
+        const CNurbsCurve<TYPE>* m_pNurbsCurve;
         int m_nStartIndex;
         int m_nEndIndex;
         int m_nKnotIndex;
+        UniformKnots m_UniformKnots;
         bool m_bRational;
 
-        // Record the effective control points corresponding to m_nKnotIndex
-        CFastVector<TYPE> m_vecValidPoles;
+        // The iteration poles of the generic De-Boor algorithm
         CFastVector<TYPE> m_vecTempPoles1;
         CFastVector<TYPE> m_vecTempPoles2;
     };
@@ -66,6 +90,7 @@ namespace neat
     template<typename TYPE>
     CNRBSplineParser<TYPE>::CNRBSplineParser()
         : m_pNurbsNode(nullptr)
+        , m_pNurbsCurve(nullptr)
         , m_nStartIndex(0)
         , m_nEndIndex(0)
         , m_nKnotIndex(0)
@@ -85,118 +110,190 @@ namespace neat
         NEAT_RAISE_IF(CheckNurbsNodeRational(pNurbsNode_) || bRational_, g_strNurbsParamsError);
 
         m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsNode_;
+        m_pNurbsCurve = nullptr;
         m_bRational = bRational_;
 
         // Initialize the knot index limit value
         m_nStartIndex = m_pNurbsNode->nDegree;
         m_nEndIndex = static_cast<int>(m_pNurbsNode->vecKnots.size()) - m_pNurbsNode->nDegree - 1;
         NEAT_RAISE(DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nStartIndex], m_pNurbsNode->vecKnots[m_nEndIndex]), g_strNurbsParamsError);
+        CheckUniformKnots(m_pNurbsNode->vecKnots, m_nStartIndex, m_nEndIndex, m_UniformKnots);
+
+        InitKnotIndex();
+    }
 
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_)
+    {
+        NEAT_RAISE_IF(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE_IF(pNurbsCurve_->IsRational(), g_strNurbsParamsError);
+
+        m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsCurve_->GetNurbsNode();
+        m_pNurbsCurve = pNurbsCurve_;
+        m_bRational = pNurbsCurve_->IsRational();
+
+        // The compiled nurbs curve has been checked
+        m_nStartIndex = pNurbsCurve_->GetStartIndex();
+        m_nEndIndex = pNurbsCurve_->GetEndIndex();
+        m_UniformKnots = pNurbsCurve_->GetUniformKnots();
+        InitKnotIndex();
+    }
+
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::InitKnotIndex()
+    {
         m_nKnotIndex = m_nStartIndex;
         while (DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nKnotIndex + 1], m_pNurbsNode->vecKnots[m_nStartIndex])) {
             ++m_nKnotIndex;
         }
-
-        RecordValidPoles(m_nKnotIndex);
     }
 
     template<typename TYPE>
     void CNRBSplineParser<TYPE>::GetNurbsPoint(double nKnot_, TYPE& ptPoint_)
     {
         NEAT_RAISE_IF(m_pNurbsNode == nullptr, g_strEmptyPointer);
-        NEAT_RAISE_IF(CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
 
-        int _nLastKnotIndex = m_nKnotIndex;
-        int _nCurKnotIndex = FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_nKnotIndex);
-        if (_nCurKnotIndex != _nLastKnotIndex) {
-            RecordValidPoles(_nCurKnotIndex);
-        }
+        CalculatePoint(nKnot_, LocateKnotIndex(nKnot_), ptPoint_);
+    }
 
-        m_vecTempPoles1.clear();
-        m_vecTempPoles2.clear();
-        m_vecTempPoles1.copy(m_vecValidPoles);
-        m_vecTempPoles2.copy(m_vecValidPoles);
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_)
+    {
+        NEAT_RAISE_IF(m_pNurbsNode == nullptr, g_strEmptyPointer);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, 0, m_pNurbsNode->nDegree);
-        ptPoint_ = m_vecTempPoles1[m_pNurbsNode->nDegree];
+        CalculateDeriv(nKnot_, LocateKnotIndex(nKnot_), ptPoint_, ptDeriv1_);
     }
 
     template<typename TYPE>
-    void CNRBSplineParser<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_)
+    void CNRBSplineParser<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
     {
         NEAT_RAISE_IF(m_pNurbsNode == nullptr, g_strEmptyPointer);
-        NEAT_RAISE_IF(CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        NEAT_RAISE_IF(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+
+        CalculateDeriv(nKnot_, LocateKnotIndex(nKnot_), ptPoint_, ptDeriv1_, ptDeriv2_);
+    }
+
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::GetNurbsPoints(const double* pKnots_, size_t nCount_, TYPE* pPoints_)
+    {
+        NEAT_RAISE(m_pNurbsNode == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr), g_strEmptyPointer);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        CheckBatchKnots(m_pNurbsNode->vecKnots, pKnots_, nCount_, m_nStartIndex, m_nEndIndex);
+
+        // The span is searched from the last one since the parameters are ascending
+        for (size_t i = 0; i < nCount_; ++i) {
+            CalculatePoint(pKnots_[i], LocateKnotIndex(pKnots_[i]), pPoints_[i]);
+        }
+    }
+
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_)
+    {
+        NEAT_RAISE(m_pNurbsNode == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr || pDeriv1s_ == nullptr), g_strEmptyPointer);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        CheckBatchKnots(m_pNurbsNode->vecKnots, pKnots_, nCount_, m_nStartIndex, m_nEndIndex);
 
-        int _nLastKnotIndex = m_nKnotIndex;
-        int _nCurKnotIndex = FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_nKnotIndex);
-        if (_nCurKnotIndex != _nLastKnotIndex) {
-            RecordValidPoles(_nCurKnotIndex);
+        for (size_t i = 0; i < nCount_; ++i) {
+            CalculateDeriv(pKnots_[i], LocateKnotIndex(pKnots_[i]), pPoints_[i], pDeriv1s_[i]);
         }
+    }
+
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_, TYPE* pDeriv2s_)
+    {
+        NEAT_RAISE(m_pNurbsNode == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr || pDeriv1s_ == nullptr || pDeriv2s_ == nullptr),
+            g_strEmptyPointer);
+        NEAT_RAISE(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        CheckBatchKnots(m_pNurbsNode->vecKnots, pKnots_, nCount_, m_nStartIndex, m_nEndIndex);
+
+        for (size_t i = 0; i < nCount_; ++i) {
+            CalculateDeriv(pKnots_[i], LocateKnotIndex(pKnots_[i]), pPoints_[i], pDeriv1s_[i], pDeriv2s_[i]);
+        }
+    }
+
+    template<typename TYPE>
+    int CNRBSplineParser<TYPE>::LocateKnotIndex(double nKnot_)
+    {
+        return FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_UniformKnots, m_nKnotIndex);
+    }
+
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::CopyValidPoles(int nKnotIndex_)
+    {
+        NEAT_RAISE_IF(nKnotIndex_ < m_nStartIndex || nKnotIndex_ > m_nEndIndex, g_strNurbsParamsError);
 
         m_vecTempPoles1.clear();
         m_vecTempPoles2.clear();
-        m_vecTempPoles1.copy(m_vecValidPoles);
-        m_vecTempPoles2.copy(m_vecValidPoles);
+        for (int i = nKnotIndex_ - m_pNurbsNode->nDegree; i <= nKnotIndex_; ++i) {
+            m_vecTempPoles1.push_back(m_pNurbsNode->vecPoles[i]);
+            m_vecTempPoles2.push_back(m_pNurbsNode->vecPoles[i]);
+        }
+    }
+
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::CalculatePoint(double nKnot_, int nKnotIndex_, TYPE& ptPoint_)
+    {
+        // Low degree is calculated by the specialized kernel
+        if (DeBoorKernelPoint(m_pNurbsNode->nDegree, m_pNurbsNode->vecKnots.data(), m_pNurbsNode->vecPoles.data(),
+            nKnotIndex_, nKnot_, ptPoint_)) {
+            return;
+        }
+
+        CopyValidPoles(nKnotIndex_);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, 0, m_pNurbsNode->nDegree);
+        ptPoint_ = m_vecTempPoles1[m_pNurbsNode->nDegree];
+    }
 
+    template<typename TYPE>
+    void CNRBSplineParser<TYPE>::CalculateDeriv(double nKnot_, int nKnotIndex_, TYPE& ptPoint_, TYPE& ptDeriv1_)
+    {
         const int& _nDegree = m_pNurbsNode->nDegree;
         const VECDOUBLE& _vecKnots = m_pNurbsNode->vecKnots;
+        if (DeBoorKernelDeriv(_nDegree, _vecKnots.data(), m_pNurbsNode->vecPoles.data(), nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_)) {
+            return;
+        }
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, 0, _nDegree - 1);
+        CopyValidPoles(nKnotIndex_);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, 0, _nDegree - 1);
         ptDeriv1_ = (m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1]) * static_cast<double>(_nDegree)
-            / (_vecKnots[_nCurKnotIndex + 1] - _vecKnots[_nCurKnotIndex]);
+            / (_vecKnots[nKnotIndex_ + 1] - _vecKnots[nKnotIndex_]);
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, _nDegree - 1, _nDegree);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, _nDegree - 1, _nDegree);
         ptPoint_ = m_vecTempPoles1[_nDegree];
     }
 
     template<typename TYPE>
-    void CNRBSplineParser<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
+    void CNRBSplineParser<TYPE>::CalculateDeriv(double nKnot_, int nKnotIndex_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
     {
-        NEAT_RAISE_IF(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
-        NEAT_RAISE_IF(m_pNurbsNode == nullptr, g_strEmptyPointer);
-        NEAT_RAISE_IF(CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
-
-        int _nLastKnotIndex = m_nKnotIndex;
-        int _nCurKnotIndex = FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_nKnotIndex);
-        if (_nCurKnotIndex != _nLastKnotIndex) {
-            RecordValidPoles(_nCurKnotIndex);
-        }
-
-        m_vecTempPoles1.clear();
-        m_vecTempPoles2.clear();
-        m_vecTempPoles1.copy(m_vecValidPoles);
-        m_vecTempPoles2.copy(m_vecValidPoles);
-
         const int& _nDegree = m_pNurbsNode->nDegree;
         const VECDOUBLE& _vecKnots = m_pNurbsNode->vecKnots;
+        if (DeBoorKernelDeriv(_nDegree, _vecKnots.data(), m_pNurbsNode->vecPoles.data(), nKnotIndex_, nKnot_,
+            ptPoint_, ptDeriv1_, ptDeriv2_)) {
+            return;
+        }
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, 0, _nDegree - 2);
+        CopyValidPoles(nKnotIndex_);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, 0, _nDegree - 2);
 
-        double _nAlpha = _nDegree / (_vecKnots[_nCurKnotIndex + 1] - _vecKnots[_nCurKnotIndex]);
+        double _nAlpha = _nDegree / (_vecKnots[nKnotIndex_ + 1] - _vecKnots[nKnotIndex_]);
         ptDeriv2_ = _nAlpha * (_nDegree - 1) * ((m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1])
-            / (_vecKnots[_nCurKnotIndex + 2] - _vecKnots[_nCurKnotIndex]) - (m_vecTempPoles1[_nDegree - 1] - m_vecTempPoles1[_nDegree - 2])
-            / (_vecKnots[_nCurKnotIndex + 1] - _vecKnots[_nCurKnotIndex - 1]));
+            / (_vecKnots[nKnotIndex_ + 2] - _vecKnots[nKnotIndex_]) - (m_vecTempPoles1[_nDegree - 1] - m_vecTempPoles1[_nDegree - 2])
+            / (_vecKnots[nKnotIndex_ + 1] - _vecKnots[nKnotIndex_ - 1]));
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, _nDegree - 2, _nDegree - 1);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, _nDegree - 2, _nDegree - 1);
         ptDeriv1_ = _nAlpha * (m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1]);
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, _nDegree - 1, _nDegree);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, _nDegree - 1, _nDegree);
         ptPoint_ = m_vecTempPoles1[_nDegree];
     }
 
-    template<typename TYPE>
-    void CNRBSplineParser<TYPE>::RecordValidPoles(int nKnotIndex_)
-    {
-        NEAT_RAISE_IF(nKnotIndex_ < m_nStartIndex || nKnotIndex_ > m_nEndIndex, g_strNurbsParamsError);
-
-        m_vecValidPoles.clear();
-        auto _iterBegin = m_pNurbsNode->vecPoles.begin() + nKnotIndex_ - m_pNurbsNode->nDegree;
-        auto _iterEnd = m_pNurbsNode->vecPoles.begin() + nKnotIndex_ + 1;
-        for (; _iterBegin != _iterEnd; ++_iterBegin) {
-            m_vecValidPoles.push_back(*_iterBegin);
-        }
-    }
-
     template<typename TYPE>
     void CNRBSplineParser<TYPE>::DeBoorAlgorithm(double nKnot_, int nKnotIndex_, int nStartIndex_, int nEndIndex_)
     {
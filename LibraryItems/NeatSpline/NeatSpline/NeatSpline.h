@@ -27,6 +27,7 @@
  * In order to facilitate external reference of this library, you only need to include this header file.
  */
 #include "Spline_ErrorID.h"
+#include "Neat_Curve.h"
 #include "Neat_Parser.h"
 #include "Neat_Scatter.h"
 #include "Neat_Converter.h"
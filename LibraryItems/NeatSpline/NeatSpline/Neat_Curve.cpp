@@ -0,0 +1,146 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#include "pch.h"
+
+using namespace neat;
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsCurve2D
+CNurbsCurve2D::CNurbsCurve2D(const NurbsNode2D* pNurbsNode_)
+{
+    m_pCurvePointer = new CNurbsCurvePointer(pNurbsNode_);
+}
+
+CNurbsCurve2D::~CNurbsCurve2D()
+{
+    delete m_pCurvePointer;
+}
+
+const NurbsNode2D* CNurbsCurve2D::GetNurbsNode() const
+{
+    return CNurbsCurvePointer::GetNurbsCurve(this)->GetNurbsNode();
+}
+
+bool CNurbsCurve2D::IsRational() const
+{
+    return CNurbsCurvePointer::GetNurbsCurve(this)->IsRational();
+}
+
+void CNurbsCurve2D::GetUniqueKnots(VECDOUBLE& vecKnots_, std::vector<int>& vecMultiplicities_) const
+{
+    const CNurbsCurve<DPOINT2>* _pNurbsCurve = CNurbsCurvePointer::GetNurbsCurve(this);
+    vecKnots_ = _pNurbsCurve->GetUniqueKnots();
+    vecMultiplicities_ = _pNurbsCurve->GetMultiplicities();
+}
+
+void CNurbsCurve2D::GetNurbsPoint(double nKnot_, NurbsContext2D& NurbsContext_, DPOINT2& ptPoint_) const
+{
+    CNurbsCurvePointer::GetNurbsCurve(this)->GetNurbsPoint(nKnot_, NurbsContext_, ptPoint_);
+}
+
+void CNurbsCurve2D::GetNurbsDeriv(double nKnot_, NurbsContext2D& NurbsContext_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_) const
+{
+    CNurbsCurvePointer::GetNurbsCurve(this)->GetNurbsDeriv(nKnot_, NurbsContext_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsCurve2D::GetNurbsDeriv(double nKnot_, NurbsContext2D& NurbsContext_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_,
+    DPOINT2& ptDeriv2_) const
+{
+    CNurbsCurvePointer::GetNurbsCurve(this)->GetNurbsDeriv(nKnot_, NurbsContext_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsCurve3D
+CNurbsCurve3D::CNurbsCurve3D(const NurbsNode3D* pNurbsNode_)
+{
+    m_pCurvePointer = new CNurbsCurvePointer(pNurbsNode_);
+}
+
+CNurbsCurve3D::~CNurbsCurve3D()
+{
+    delete m_pCurvePointer;
+}
+
+const NurbsNode3D* CNurbsCurve3D::GetNurbsNode() const
+{
+    return CNurbsCurvePointer::GetNurbsCurve(this)->GetNurbsNode();
+}
+
+bool CNurbsCurve3D::IsRational() const
+{
+    return CNurbsCurvePointer::GetNurbsCurve(this)->IsRational();
+}
+
+void CNurbsCurve3D::GetUniqueKnots(VECDOUBLE& vecKnots_, std::vector<int>& vecMultiplicities_) const
+{
+    const CNurbsCurve<DPOINT3>* _pNurbsCurve = CNurbsCurvePointer::GetNurbsCurve(this);
+    vecKnots_ = _pNurbsCurve->GetUniqueKnots();
+    vecMultiplicities_ = _pNurbsCurve->GetMultiplicities();
+}
+
+void CNurbsCurve3D::GetNurbsPoint(double nKnot_, NurbsContext3D& NurbsContext_, DPOINT3& ptPoint_) const
+{
+    CNurbsCurvePointer::GetNurbsCurve(this)->GetNurbsPoint(nKnot_, NurbsContext_, ptPoint_);
+}
+
+void CNurbsCurve3D::GetNurbsDeriv(double nKnot_, NurbsContext3D& NurbsContext_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_) const
+{
+    CNurbsCurvePointer::GetNurbsCurve(this)->GetNurbsDeriv(nKnot_, NurbsContext_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsCurve3D::GetNurbsDeriv(double nKnot_, NurbsContext3D& NurbsContext_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_,
+    DPOINT3& ptDeriv2_) const
+{
+    CNurbsCurvePointer::GetNurbsCurve(this)->GetNurbsDeriv(nKnot_, NurbsContext_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsCurvePointer
+CNurbsCurvePointer::CNurbsCurvePointer(const NurbsNode2D* pNurbsNode_)
+    : m_pNurbsCurve2D(nullptr)
+    , m_pNurbsCurve3D(nullptr)
+{
+    m_pNurbsCurve2D = new CNurbsCurve<DPOINT2>(pNurbsNode_);
+}
+
+CNurbsCurvePointer::CNurbsCurvePointer(const NurbsNode3D* pNurbsNode_)
+    : m_pNurbsCurve2D(nullptr)
+    , m_pNurbsCurve3D(nullptr)
+{
+    m_pNurbsCurve3D = new CNurbsCurve<DPOINT3>(pNurbsNode_);
+}
+
+CNurbsCurvePointer::~CNurbsCurvePointer()
+{
+    if (m_pNurbsCurve2D != nullptr) {
+        delete m_pNurbsCurve2D;
+    }
+
+    if (m_pNurbsCurve3D != nullptr) {
+        delete m_pNurbsCurve3D;
+    }
+}
+
+const CNurbsCurve<DPOINT2>* CNurbsCurvePointer::GetNurbsCurve(const CNurbsCurve2D* pNurbsCurve_)
+{
+    NEAT_RAISE(pNurbsCurve_ == nullptr || pNurbsCurve_->m_pCurvePointer == nullptr, g_strEmptyPointer);
+    NEAT_RAISE(pNurbsCurve_->m_pCurvePointer->m_pNurbsCurve2D == nullptr, g_strEmptyPointer);
+    return pNurbsCurve_->m_pCurvePointer->m_pNurbsCurve2D;
+}
+
+const CNurbsCurve<DPOINT3>* CNurbsCurvePointer::GetNurbsCurve(const CNurbsCurve3D* pNurbsCurve_)
+{
+    NEAT_RAISE(pNurbsCurve_ == nullptr || pNurbsCurve_->m_pCurvePointer == nullptr, g_strEmptyPointer);
+    NEAT_RAISE(pNurbsCurve_->m_pCurvePointer->m_pNurbsCurve3D == nullptr, g_strEmptyPointer);
+    return pNurbsCurve_->m_pCurvePointer->m_pNurbsCurve3D;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __NEAT_CURVE_H_20200302__
+#define __NEAT_CURVE_H_20200302__
+
+/**
+ * This file defines the interface for compiling splines.
+ */
+namespace neat
+{
+    class CNurbsCurvePointer;
+
+    /**
+     * The evaluation context of compiled nurbs curve, which is owned by the caller.
+     * The compiled curve is not changed by evaluation, so it can be evaluated by several threads at the same time
+     * if every thread uses its own context.
+     */
+    template<typename TYPE>
+    struct NurbsContext
+    {
+        std::vector<TYPE> vecPoles; // The scratch poles of the degree without specialized kernel
+        VECDOUBLE vecWeights;       // The scratch weights of the degree without specialized kernel
+        int nKnotIndex = -1;        // The span of the last evaluated knot
+    };
+    typedef NurbsContext<DPOINT2> NurbsContext2D;
+    typedef NurbsContext<DPOINT3> NurbsContext3D;
+
+    /**
+     * The rational three-dimensional compiled curve is evaluated by the AVX2 kernel in homogeneous space
+     * if the processor supports it, otherwise by the scalar kernels.
+     */
+    // Returns true if the AVX2 kernel is supported and enabled.
+    NEATSPLINE_API bool CheckVectorKernel();
+
+    // Enable or disable the AVX2 kernel, which is enabled by default if the processor supports it.
+    NEATSPLINE_API void EnableVectorKernel(bool bEnable_);
+
+    /**
+     * The compiled two-dimensional nurbs node.
+     * The nurbs node is copied and validated once, and the parsers and scatters accept it without checking it again.
+     */
+    class NEATSPLINE_API CNurbsCurve2D final
+    {
+    public:
+        explicit CNurbsCurve2D(const NurbsNode2D* pNurbsNode_);
+        ~CNurbsCurve2D();
+
+        // Returns the compiled nurbs node.
+        const NurbsNode2D* GetNurbsNode() const;
+
+        // Returns true if the nurbs node is rational.
+        bool IsRational() const;
+
+        // Returns in vecKnots_ the unique knots and vecMultiplicities_ their multiplicities.
+        void GetUniqueKnots(VECDOUBLE& vecKnots_, std::vector<int>& vecMultiplicities_) const;
+
+        // Returns in ptPoint_ the point of parameter nKnot_, the span and scratch poles are kept in NurbsContext_.
+        void GetNurbsPoint(double nKnot_, NurbsContext2D& NurbsContext_, DPOINT2& ptPoint_) const;
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, NurbsContext2D& NurbsContext_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_) const;
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative.
+        void GetNurbsDeriv(double nKnot_, NurbsContext2D& NurbsContext_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_) const;
+
+    private:
+        CNurbsCurve2D(const CNurbsCurve2D&) = delete;
+        CNurbsCurve2D& operator=(const CNurbsCurve2D&) = delete;
+
+        friend class CNurbsCurvePointer;
+        CNurbsCurvePointer* m_pCurvePointer;
+    };
+
+    /**
+     * The compiled three-dimensional nurbs node.
+     * The nurbs node is copied and validated once, and the parsers and scatters accept it without checking it again.
+     */
+    class NEATSPLINE_API CNurbsCurve3D final
+    {
+    public:
+        explicit CNurbsCurve3D(const NurbsNode3D* pNurbsNode_);
+        ~CNurbsCurve3D();
+
+        // Returns the compiled nurbs node.
+        const NurbsNode3D* GetNurbsNode() const;
+
+        // Returns true if the nurbs node is rational.
+        bool IsRational() const;
+
+        // Returns in vecKnots_ the unique knots and vecMultiplicities_ their multiplicities.
+        void GetUniqueKnots(VECDOUBLE& vecKnots_, std::vector<int>& vecMultiplicities_) const;
+
+        // Returns in ptPoint_ the point of parameter nKnot_, the span and scratch poles are kept in NurbsContext_.
+        void GetNurbsPoint(double nKnot_, NurbsContext3D& NurbsContext_, DPOINT3& ptPoint_) const;
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, NurbsContext3D& NurbsContext_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_) const;
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative.
+        void GetNurbsDeriv(double nKnot_, NurbsContext3D& NurbsContext_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_) const;
+
+    private:
+        CNurbsCurve3D(const CNurbsCurve3D&) = delete;
+        CNurbsCurve3D& operator=(const CNurbsCurve3D&) = delete;
+
+        friend class CNurbsCurvePointer;
+        CNurbsCurvePointer* m_pCurvePointer;
+    };
+
+} // End namespace neat
+
+#endif // __NEAT_CURVE_H_20200302__
\ No newline at end of file
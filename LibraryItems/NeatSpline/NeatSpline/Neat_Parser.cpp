@@ -31,16 +31,54 @@ namespace neat
         void GetNurbsPoint(double nKnot_, double& nPoint_);
         void GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_);
         void GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_, double& nDeriv2_);
+        void GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_, double& nDeriv2_, double& nDeriv3_);
+        void GetNurbsDeriv(double nKnot_, int nOrder_, double* pDerivs_);
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, double* pPoints_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, double* pPoints_, double* pDeriv1s_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, double* pPoints_, double* pDeriv1s_, double* pDeriv2s_);
 
         void SetNurbsNode(const NurbsNode2D* pNurbsNode_);
+        void SetNurbsCurve(const CNurbsCurve<DPOINT2>* pNurbsCurve_);
         void GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_);
         void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_);
         void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_);
+        void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_, DPOINT2& ptDeriv3_);
+        void GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT2* pDerivs_);
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_, DPOINT2* pDeriv2s_);
 
         void SetNurbsNode(const NurbsNode3D* pNurbsNode_);
+        void SetNurbsCurve(const CNurbsCurve<DPOINT3>* pNurbsCurve_);
         void GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_);
         void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_);
         void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_);
+        void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_, DPOINT3& ptDeriv3_);
+        void GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT3* pDerivs_);
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_, DPOINT3* pDeriv2s_);
+
+        void SetNurbsNode(const NurbsNode4D* pNurbsNode_);
+        void GetNurbsPoint(double nKnot_, DPOINT4& ptPoint_);
+        void GetNurbsDeriv(double nKnot_, DPOINT4& ptPoint_, DPOINT4& ptDeriv1_);
+        void GetNurbsDeriv(double nKnot_, DPOINT4& ptPoint_, DPOINT4& ptDeriv1_, DPOINT4& ptDeriv2_);
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT4* pPoints_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT4* pPoints_, DPOINT4* pDeriv1s_, DPOINT4* pDeriv2s_);
+
+        void SetNurbsNode(const NurbsNode5D* pNurbsNode_);
+        void GetNurbsPoint(double nKnot_, DPOINT5& ptPoint_);
+        void GetNurbsDeriv(double nKnot_, DPOINT5& ptPoint_, DPOINT5& ptDeriv1_);
+        void GetNurbsDeriv(double nKnot_, DPOINT5& ptPoint_, DPOINT5& ptDeriv1_, DPOINT5& ptDeriv2_);
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT5* pPoints_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT5* pPoints_, DPOINT5* pDeriv1s_, DPOINT5* pDeriv2s_);
+
+        void SetNurbsNode(const NurbsNode6D* pNurbsNode_);
+        void GetNurbsPoint(double nKnot_, DPOINT6& ptPoint_);
+        void GetNurbsDeriv(double nKnot_, DPOINT6& ptPoint_, DPOINT6& ptDeriv1_);
+        void GetNurbsDeriv(double nKnot_, DPOINT6& ptPoint_, DPOINT6& ptDeriv1_, DPOINT6& ptDeriv2_);
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT6* pPoints_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT6* pPoints_, DPOINT6* pDeriv1s_, DPOINT6* pDeriv2s_);
 
     private:
         CNurbsParserPointer(const CNurbsParserPointer&) = delete;
@@ -49,6 +87,9 @@ namespace neat
         CNurbsParser<double>* m_pParser1D;
         CNurbsParser<DPOINT2>* m_pParser2D;
         CNurbsParser<DPOINT3>* m_pParser3D;
+        CNurbsParser<DPOINT4>* m_pParser4D;
+        CNurbsParser<DPOINT5>* m_pParser5D;
+        CNurbsParser<DPOINT6>* m_pParser6D;
     };
 
     /**
@@ -74,10 +115,52 @@ namespace neat
         CBezierParserPointer(const CBezierParserPointer&) = delete;
         CBezierParserPointer& operator=(const CBezierParserPointer&) = delete;
 
-        NurbsNode2D* m_pNurbsNode2D;
-        NurbsNode3D* m_pNurbsNode3D;
-        CNurbsParser<DPOINT2>* m_pParser2D;
-        CNurbsParser<DPOINT3>* m_pParser3D;
+        CBezierParser<DPOINT2>* m_pParser2D;
+        CBezierParser<DPOINT3>* m_pParser3D;
+    };
+
+    /**
+     * The implementation pointer of power basis parser.
+     */
+    class CNurbsPowerParserPointer final
+    {
+    public:
+        CNurbsPowerParserPointer(int nDimension_);
+        ~CNurbsPowerParserPointer();
+
+        void SetNurbsNode(const NurbsNode2D* pNurbsNode_);
+        void SetNurbsCurve(const CNurbsCurve<DPOINT2>* pNurbsCurve_);
+        void GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_);
+        void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_);
+        void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_);
+        void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_, DPOINT2& ptDeriv3_);
+        void GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT2* pDerivs_);
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_, DPOINT2* pDeriv2s_);
+        void GetSamplePoints(int nSteps_, std::vector<DPOINT2>& vecPoints_);
+
+        void SetNurbsNode(const NurbsNode3D* pNurbsNode_);
+        void SetNurbsCurve(const CNurbsCurve<DPOINT3>* pNurbsCurve_);
+        void GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_);
+        void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_);
+        void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_);
+        void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_, DPOINT3& ptDeriv3_);
+        void GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT3* pDerivs_);
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_);
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_, DPOINT3* pDeriv2s_);
+        void GetSamplePoints(int nSteps_, std::vector<DPOINT3>& vecPoints_);
+
+        int GetSpanCount() const;
+        size_t GetSpanMemory() const;
+
+    private:
+        CNurbsPowerParserPointer(const CNurbsPowerParserPointer&) = delete;
+        CNurbsPowerParserPointer& operator=(const CNurbsPowerParserPointer&) = delete;
+
+        CNurbsPowerParser<DPOINT2, DPOINT3>* m_pParser2D;
+        CNurbsPowerParser<DPOINT3, DPOINT4>* m_pParser3D;
     };
 
 } // End namespace neat
@@ -118,6 +201,36 @@ void CNurbsParser1D::GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeri
     m_pParserPointer->GetNurbsDeriv(nKnot_, nPoint_, nDeriv1_, nDeriv2_);
 }
 
+void CNurbsParser1D::GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_, double& nDeriv2_, double& nDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, nPoint_, nDeriv1_, nDeriv2_, nDeriv3_);
+}
+
+void CNurbsParser1D::GetNurbsDeriv(double nKnot_, int nOrder_, double* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsParser1D::GetNurbsPoints(const double* pKnots_, size_t nCount_, double* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsParser1D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, double* pPoints_, double* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsParser1D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, double* pPoints_, double* pDeriv1s_, double* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // class CNurbsParser2D
 CNurbsParser2D::CNurbsParser2D()
@@ -136,6 +249,12 @@ void CNurbsParser2D::SetNurbsNode(const NurbsNode2D* pNurbNode_)
     m_pParserPointer->SetNurbsNode(pNurbNode_);
 }
 
+void CNurbsParser2D::SetNurbsCurve(const CNurbsCurve2D* pNurbsCurve_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetNurbsCurve(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_));
+}
+
 void CNurbsParser2D::GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
@@ -154,6 +273,36 @@ void CNurbsParser2D::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& pt
     m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
 }
 
+void CNurbsParser2D::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_, DPOINT2& ptDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_, ptDeriv3_);
+}
+
+void CNurbsParser2D::GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT2* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsParser2D::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsParser2D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsParser2D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_, DPOINT2* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // class CNurbsParser3D
 CNurbsParser3D::CNurbsParser3D()
@@ -172,6 +321,12 @@ void CNurbsParser3D::SetNurbsNode(const NurbsNode3D* pNurbsNode_)
     m_pParserPointer->SetNurbsNode(pNurbsNode_);
 }
 
+void CNurbsParser3D::SetNurbsCurve(const CNurbsCurve3D* pNurbsCurve_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetNurbsCurve(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_));
+}
+
 void CNurbsParser3D::GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
@@ -190,278 +345,1018 @@ void CNurbsParser3D::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& pt
     m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
 }
 
-//////////////////////////////////////////////////////////////////////////
-// class CBezierParser2D
-CBezierParser2D::CBezierParser2D()
-{
-    m_pParserPointer = new CBezierParserPointer(2);
-}
-
-CBezierParser2D::~CBezierParser2D()
+void CNurbsParser3D::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_, DPOINT3& ptDeriv3_)
 {
-    delete m_pParserPointer;
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_, ptDeriv3_);
 }
 
-void CBezierParser2D::SetBezierNode(const BezierNode2D* pBezierNode_)
+void CNurbsParser3D::GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT3* pDerivs_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
-    m_pParserPointer->SetBezierNode(pBezierNode_);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
 }
 
-void CBezierParser2D::GetBezierPoint(double nKnot_, DPOINT2& ptPoint_)
+void CNurbsParser3D::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
-    m_pParserPointer->GetBezierPoint(nKnot_, ptPoint_);
+    m_pParserPointer->GetNurbsPoints(pKnots_, nCount_, pPoints_);
 }
 
-void CBezierParser2D::GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_)
+void CNurbsParser3D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
-    m_pParserPointer->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
 }
 
-void CBezierParser2D::GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_)
+void CNurbsParser3D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_, DPOINT3* pDeriv2s_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
-    m_pParserPointer->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
 }
 
 //////////////////////////////////////////////////////////////////////////
-// class CBezierParser3D
-CBezierParser3D::CBezierParser3D()
+// class CNurbsParser4D
+CNurbsParser4D::CNurbsParser4D()
 {
-    m_pParserPointer = new CBezierParserPointer(3);
+    m_pParserPointer = new CNurbsParserPointer(4);
 }
 
-CBezierParser3D::~CBezierParser3D()
+CNurbsParser4D::~CNurbsParser4D()
 {
     delete m_pParserPointer;
 }
 
-void CBezierParser3D::SetBezierNode(const BezierNode3D* pBezierNode_)
+void CNurbsParser4D::SetNurbsNode(const NurbsNode4D* pNurbsNode_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
-    m_pParserPointer->SetBezierNode(pBezierNode_);
+    m_pParserPointer->SetNurbsNode(pNurbsNode_);
 }
 
-void CBezierParser3D::GetBezierPoint(double nKnot_, DPOINT3& ptPoint_)
+void CNurbsParser4D::GetNurbsPoint(double nKnot_, DPOINT4& ptPoint_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
-    m_pParserPointer->GetBezierPoint(nKnot_, ptPoint_);
+    m_pParserPointer->GetNurbsPoint(nKnot_, ptPoint_);
 }
 
-void CBezierParser3D::GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+void CNurbsParser4D::GetNurbsDeriv(double nKnot_, DPOINT4& ptPoint_, DPOINT4& ptDeriv1_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
-    m_pParserPointer->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
 }
 
-void CBezierParser3D::GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
+void CNurbsParser4D::GetNurbsDeriv(double nKnot_, DPOINT4& ptPoint_, DPOINT4& ptDeriv1_, DPOINT4& ptDeriv2_)
 {
     NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
-    m_pParserPointer->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
 }
 
-//////////////////////////////////////////////////////////////////////////
-// local class CNurbsParserPointer
-CNurbsParserPointer::CNurbsParserPointer(int nDimension_)
+void CNurbsParser4D::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT4* pPoints_)
 {
-    NEAT_RAISE(nDimension_ != 1 && nDimension_ != 2 && nDimension_ != 3, g_strWrongDimension);
-
-    switch (nDimension_)
-    {
-    case 1:
-        m_pParser1D = new CNurbsParser<double>();
-        m_pParser2D = nullptr;
-        m_pParser3D = nullptr;
-        break;
-    case 2:
-        m_pParser2D = new CNurbsParser<DPOINT2>();
-        m_pParser1D = nullptr;
-        m_pParser3D = nullptr;
-        break;
-    case 3:
-        m_pParser3D = new CNurbsParser<DPOINT3>();
-        m_pParser1D = nullptr;
-        m_pParser2D = nullptr;
-        break;
-    default:
-        break;
-    }
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoints(pKnots_, nCount_, pPoints_);
 }
 
-CNurbsParserPointer::~CNurbsParserPointer()
+void CNurbsParser4D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT4* pPoints_, DPOINT4* pDeriv1s_, DPOINT4* pDeriv2s_)
 {
-    if (m_pParser1D != nullptr) {
-        delete m_pParser1D;
-    }
-
-    if (m_pParser2D != nullptr) {
-        delete m_pParser2D;
-    }
-
-    if (m_pParser3D != nullptr) {
-        delete m_pParser3D;
-    }
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
 }
 
-void CNurbsParserPointer::SetNurbsNode(const NurbsNode1D* pNurbsNode_)
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsParser5D
+CNurbsParser5D::CNurbsParser5D()
 {
-    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
-    m_pParser1D->SetNurbsNode(pNurbsNode_);
+    m_pParserPointer = new CNurbsParserPointer(5);
 }
 
-void CNurbsParserPointer::GetNurbsPoint(double nKnot_, double& nPoint_)
+CNurbsParser5D::~CNurbsParser5D()
 {
-    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
-    m_pParser1D->GetNurbsPoint(nKnot_, nPoint_);
+    delete m_pParserPointer;
 }
 
-void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_)
+void CNurbsParser5D::SetNurbsNode(const NurbsNode5D* pNurbsNode_)
 {
-    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
-    m_pParser1D->GetNurbsDeriv(nKnot_, nPoint_, nDeriv1_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetNurbsNode(pNurbsNode_);
 }
 
-void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_, double& nDeriv2_)
+void CNurbsParser5D::GetNurbsPoint(double nKnot_, DPOINT5& ptPoint_)
 {
-    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
-    m_pParser1D->GetNurbsDeriv(nKnot_, nPoint_, nDeriv1_, nDeriv2_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoint(nKnot_, ptPoint_);
 }
 
-void CNurbsParserPointer::SetNurbsNode(const NurbsNode2D* pNurbsNode_)
+void CNurbsParser5D::GetNurbsDeriv(double nKnot_, DPOINT5& ptPoint_, DPOINT5& ptDeriv1_)
 {
-    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
-    m_pParser2D->SetNurbsNode(pNurbsNode_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
 }
 
-void CNurbsParserPointer::GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_)
+void CNurbsParser5D::GetNurbsDeriv(double nKnot_, DPOINT5& ptPoint_, DPOINT5& ptDeriv1_, DPOINT5& ptDeriv2_)
 {
-    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
-    m_pParser2D->GetNurbsPoint(nKnot_, ptPoint_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
 }
 
-void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_)
+void CNurbsParser5D::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT5* pPoints_)
 {
-    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
-    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoints(pKnots_, nCount_, pPoints_);
 }
 
-void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_)
+void CNurbsParser5D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT5* pPoints_, DPOINT5* pDeriv1s_, DPOINT5* pDeriv2s_)
 {
-    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
-    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
 }
 
-void CNurbsParserPointer::SetNurbsNode(const NurbsNode3D* pNurbsNode_)
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsParser6D
+CNurbsParser6D::CNurbsParser6D()
 {
-    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
-    m_pParser3D->SetNurbsNode(pNurbsNode_);
+    m_pParserPointer = new CNurbsParserPointer(6);
 }
 
-void CNurbsParserPointer::GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_)
+CNurbsParser6D::~CNurbsParser6D()
 {
-    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
-    m_pParser3D->GetNurbsPoint(nKnot_, ptPoint_);
+    delete m_pParserPointer;
 }
 
-void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+void CNurbsParser6D::SetNurbsNode(const NurbsNode6D* pNurbsNode_)
 {
-    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
-    m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetNurbsNode(pNurbsNode_);
 }
 
-void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
+void CNurbsParser6D::GetNurbsPoint(double nKnot_, DPOINT6& ptPoint_)
 {
-    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
-    m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoint(nKnot_, ptPoint_);
 }
 
-//////////////////////////////////////////////////////////////////////////
-// local class CBezierParserPointer
-CBezierParserPointer::CBezierParserPointer(int nDimension_)
+void CNurbsParser6D::GetNurbsDeriv(double nKnot_, DPOINT6& ptPoint_, DPOINT6& ptDeriv1_)
 {
-    NEAT_RAISE(nDimension_ != 2 && nDimension_ != 3, g_strWrongDimension);
-
-    if (nDimension_ == 2) {
-        m_pNurbsNode2D = new NurbsNode2D;
-        m_pParser2D = new CNurbsParser<DPOINT2>();
-        m_pNurbsNode3D = nullptr;
-        m_pParser3D = nullptr;
-    }
-    else if (nDimension_ == 3) {
-        m_pNurbsNode3D = new NurbsNode3D;
-        m_pParser3D = new CNurbsParser<DPOINT3>();
-        m_pNurbsNode2D = nullptr;
-        m_pParser2D = nullptr;
-    }
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
 }
 
-CBezierParserPointer::~CBezierParserPointer()
+void CNurbsParser6D::GetNurbsDeriv(double nKnot_, DPOINT6& ptPoint_, DPOINT6& ptDeriv1_, DPOINT6& ptDeriv2_)
 {
-    if (m_pNurbsNode2D != nullptr) {
-        delete m_pNurbsNode2D;
-    }
-
-    if (m_pNurbsNode3D != nullptr) {
-        delete m_pNurbsNode3D;
-    }
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
 
-    if (m_pParser2D != nullptr) {
-        delete m_pParser2D;
-    }
+void CNurbsParser6D::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT6* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
 
-    if (m_pParser3D != nullptr) {
-        delete m_pParser3D;
-    }
+void CNurbsParser6D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT6* pPoints_, DPOINT6* pDeriv1s_, DPOINT6* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
 }
 
-void CBezierParserPointer::SetBezierNode(const BezierNode2D* pBezierNode_)
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsPowerParser2D
+CNurbsPowerParser2D::CNurbsPowerParser2D()
 {
-    NEAT_RAISE_IF(m_pNurbsNode2D == nullptr || m_pParser2D == nullptr, g_strEmptyPointer);
-    ConvertBezierToNurbs(pBezierNode_, m_pNurbsNode2D);
-    m_pParser2D->SetNurbsNode(m_pNurbsNode2D);
+    m_pParserPointer = new CNurbsPowerParserPointer(2);
 }
 
-void CBezierParserPointer::GetBezierPoint(double nKnot_, DPOINT2& ptPoint_)
+CNurbsPowerParser2D::~CNurbsPowerParser2D()
 {
-    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
-    m_pParser2D->GetNurbsPoint(nKnot_, ptPoint_);
+    delete m_pParserPointer;
 }
 
-void CBezierParserPointer::GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_)
+void CNurbsPowerParser2D::SetNurbsNode(const NurbsNode2D* pNurbsNode_)
 {
-    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
-    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetNurbsNode(pNurbsNode_);
 }
 
-void CBezierParserPointer::GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_)
+void CNurbsPowerParser2D::SetNurbsCurve(const CNurbsCurve2D* pNurbsCurve_)
 {
-    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
-    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetNurbsCurve(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_));
 }
 
-void CBezierParserPointer::SetBezierNode(const BezierNode3D* pBezierNode_)
+void CNurbsPowerParser2D::GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_)
 {
-    NEAT_RAISE_IF(m_pNurbsNode3D == nullptr || m_pParser3D == nullptr, g_strEmptyPointer);
-    ConvertBezierToNurbs(pBezierNode_, m_pNurbsNode3D);
-    m_pParser3D->SetNurbsNode(m_pNurbsNode3D);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoint(nKnot_, ptPoint_);
 }
 
-void CBezierParserPointer::GetBezierPoint(double nKnot_, DPOINT3& ptPoint_)
+void CNurbsPowerParser2D::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_)
 {
-    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
-    m_pParser3D->GetNurbsPoint(nKnot_, ptPoint_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
 }
 
-void CBezierParserPointer::GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+void CNurbsPowerParser2D::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_)
 {
-    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
-    m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
 }
 
-void CBezierParserPointer::GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
+void CNurbsPowerParser2D::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_, DPOINT2& ptDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_, ptDeriv3_);
+}
+
+void CNurbsPowerParser2D::GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT2* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsPowerParser2D::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsPowerParser2D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsPowerParser2D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_, DPOINT2* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsPowerParser2D::GetSamplePoints(int nSteps_, std::vector<DPOINT2>& vecPoints_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetSamplePoints(nSteps_, vecPoints_);
+}
+
+int CNurbsPowerParser2D::GetSpanCount() const
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    return m_pParserPointer->GetSpanCount();
+}
+
+size_t CNurbsPowerParser2D::GetSpanMemory() const
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    return m_pParserPointer->GetSpanMemory();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsPowerParser3D
+CNurbsPowerParser3D::CNurbsPowerParser3D()
+{
+    m_pParserPointer = new CNurbsPowerParserPointer(3);
+}
+
+CNurbsPowerParser3D::~CNurbsPowerParser3D()
+{
+    delete m_pParserPointer;
+}
+
+void CNurbsPowerParser3D::SetNurbsNode(const NurbsNode3D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsPowerParser3D::SetNurbsCurve(const CNurbsCurve3D* pNurbsCurve_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetNurbsCurve(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_));
+}
+
+void CNurbsPowerParser3D::GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoint(nKnot_, ptPoint_);
+}
+
+void CNurbsPowerParser3D::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsPowerParser3D::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CNurbsPowerParser3D::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_, DPOINT3& ptDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_, ptDeriv3_);
+}
+
+void CNurbsPowerParser3D::GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT3* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsPowerParser3D::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsPowerParser3D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsPowerParser3D::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_, DPOINT3* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsPowerParser3D::GetSamplePoints(int nSteps_, std::vector<DPOINT3>& vecPoints_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetSamplePoints(nSteps_, vecPoints_);
+}
+
+int CNurbsPowerParser3D::GetSpanCount() const
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    return m_pParserPointer->GetSpanCount();
+}
+
+size_t CNurbsPowerParser3D::GetSpanMemory() const
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    return m_pParserPointer->GetSpanMemory();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CBezierParser2D
+CBezierParser2D::CBezierParser2D()
+{
+    m_pParserPointer = new CBezierParserPointer(2);
+}
+
+CBezierParser2D::~CBezierParser2D()
+{
+    delete m_pParserPointer;
+}
+
+void CBezierParser2D::SetBezierNode(const BezierNode2D* pBezierNode_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetBezierNode(pBezierNode_);
+}
+
+void CBezierParser2D::GetBezierPoint(double nKnot_, DPOINT2& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetBezierPoint(nKnot_, ptPoint_);
+}
+
+void CBezierParser2D::GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CBezierParser2D::GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CBezierParser3D
+CBezierParser3D::CBezierParser3D()
+{
+    m_pParserPointer = new CBezierParserPointer(3);
+}
+
+CBezierParser3D::~CBezierParser3D()
+{
+    delete m_pParserPointer;
+}
+
+void CBezierParser3D::SetBezierNode(const BezierNode3D* pBezierNode_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->SetBezierNode(pBezierNode_);
+}
+
+void CBezierParser3D::GetBezierPoint(double nKnot_, DPOINT3& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetBezierPoint(nKnot_, ptPoint_);
+}
+
+void CBezierParser3D::GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CBezierParser3D::GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParserPointer == nullptr, g_strEmptyPointer);
+    m_pParserPointer->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// local class CNurbsParserPointer
+CNurbsParserPointer::CNurbsParserPointer(int nDimension_)
+    : m_pParser1D(nullptr)
+    , m_pParser2D(nullptr)
+    , m_pParser3D(nullptr)
+    , m_pParser4D(nullptr)
+    , m_pParser5D(nullptr)
+    , m_pParser6D(nullptr)
+{
+    NEAT_RAISE(nDimension_ < 1 || nDimension_ > 6, g_strWrongDimension);
+
+    switch (nDimension_)
+    {
+    case 1:
+        m_pParser1D = new CNurbsParser<double>();
+        break;
+    case 2:
+        m_pParser2D = new CNurbsParser<DPOINT2>();
+        break;
+    case 3:
+        m_pParser3D = new CNurbsParser<DPOINT3>();
+        break;
+    case 4:
+        m_pParser4D = new CNurbsParser<DPOINT4>();
+        break;
+    case 5:
+        m_pParser5D = new CNurbsParser<DPOINT5>();
+        break;
+    case 6:
+        m_pParser6D = new CNurbsParser<DPOINT6>();
+        break;
+    default:
+        break;
+    }
+}
+
+CNurbsParserPointer::~CNurbsParserPointer()
+{
+    if (m_pParser1D != nullptr) {
+        delete m_pParser1D;
+    }
+
+    if (m_pParser2D != nullptr) {
+        delete m_pParser2D;
+    }
+
+    if (m_pParser3D != nullptr) {
+        delete m_pParser3D;
+    }
+
+    if (m_pParser4D != nullptr) {
+        delete m_pParser4D;
+    }
+
+    if (m_pParser5D != nullptr) {
+        delete m_pParser5D;
+    }
+
+    if (m_pParser6D != nullptr) {
+        delete m_pParser6D;
+    }
+}
+
+void CNurbsParserPointer::SetNurbsNode(const NurbsNode1D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsParserPointer::GetNurbsPoint(double nKnot_, double& nPoint_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->GetNurbsPoint(nKnot_, nPoint_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->GetNurbsDeriv(nKnot_, nPoint_, nDeriv1_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_, double& nDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->GetNurbsDeriv(nKnot_, nPoint_, nDeriv1_, nDeriv2_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_, double& nDeriv2_, double& nDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->GetNurbsDeriv(nKnot_, nPoint_, nDeriv1_, nDeriv2_, nDeriv3_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, int nOrder_, double* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsParserPointer::GetNurbsPoints(const double* pKnots_, size_t nCount_, double* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, double* pPoints_, double* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, double* pPoints_, double* pDeriv1s_, double* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParser1D == nullptr, g_strEmptyPointer);
+    m_pParser1D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsParserPointer::SetNurbsNode(const NurbsNode2D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsParserPointer::SetNurbsCurve(const CNurbsCurve<DPOINT2>* pNurbsCurve_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->SetNurbsCurve(pNurbsCurve_);
+}
+
+void CNurbsParserPointer::GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsPoint(nKnot_, ptPoint_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_, DPOINT2& ptDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_, ptDeriv3_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT2* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsParserPointer::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_, DPOINT2* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsParserPointer::SetNurbsNode(const NurbsNode3D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsParserPointer::SetNurbsCurve(const CNurbsCurve<DPOINT3>* pNurbsCurve_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->SetNurbsCurve(pNurbsCurve_);
+}
+
+void CNurbsParserPointer::GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsPoint(nKnot_, ptPoint_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_, DPOINT3& ptDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_, ptDeriv3_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT3* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsParserPointer::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_, DPOINT3* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsParserPointer::SetNurbsNode(const NurbsNode4D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParser4D == nullptr, g_strEmptyPointer);
+    m_pParser4D->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsParserPointer::GetNurbsPoint(double nKnot_, DPOINT4& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser4D == nullptr, g_strEmptyPointer);
+    m_pParser4D->GetNurbsPoint(nKnot_, ptPoint_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT4& ptPoint_, DPOINT4& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser4D == nullptr, g_strEmptyPointer);
+    m_pParser4D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT4& ptPoint_, DPOINT4& ptDeriv1_, DPOINT4& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser4D == nullptr, g_strEmptyPointer);
+    m_pParser4D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CNurbsParserPointer::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT4* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParser4D == nullptr, g_strEmptyPointer);
+    m_pParser4D->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT4* pPoints_, DPOINT4* pDeriv1s_, DPOINT4* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParser4D == nullptr, g_strEmptyPointer);
+    m_pParser4D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsParserPointer::SetNurbsNode(const NurbsNode5D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParser5D == nullptr, g_strEmptyPointer);
+    m_pParser5D->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsParserPointer::GetNurbsPoint(double nKnot_, DPOINT5& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser5D == nullptr, g_strEmptyPointer);
+    m_pParser5D->GetNurbsPoint(nKnot_, ptPoint_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT5& ptPoint_, DPOINT5& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser5D == nullptr, g_strEmptyPointer);
+    m_pParser5D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT5& ptPoint_, DPOINT5& ptDeriv1_, DPOINT5& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser5D == nullptr, g_strEmptyPointer);
+    m_pParser5D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CNurbsParserPointer::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT5* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParser5D == nullptr, g_strEmptyPointer);
+    m_pParser5D->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT5* pPoints_, DPOINT5* pDeriv1s_, DPOINT5* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParser5D == nullptr, g_strEmptyPointer);
+    m_pParser5D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsParserPointer::SetNurbsNode(const NurbsNode6D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParser6D == nullptr, g_strEmptyPointer);
+    m_pParser6D->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsParserPointer::GetNurbsPoint(double nKnot_, DPOINT6& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser6D == nullptr, g_strEmptyPointer);
+    m_pParser6D->GetNurbsPoint(nKnot_, ptPoint_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT6& ptPoint_, DPOINT6& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser6D == nullptr, g_strEmptyPointer);
+    m_pParser6D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsParserPointer::GetNurbsDeriv(double nKnot_, DPOINT6& ptPoint_, DPOINT6& ptDeriv1_, DPOINT6& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser6D == nullptr, g_strEmptyPointer);
+    m_pParser6D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CNurbsParserPointer::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT6* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParser6D == nullptr, g_strEmptyPointer);
+    m_pParser6D->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT6* pPoints_, DPOINT6* pDeriv1s_, DPOINT6* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParser6D == nullptr, g_strEmptyPointer);
+    m_pParser6D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// local class CBezierParserPointer
+CBezierParserPointer::CBezierParserPointer(int nDimension_)
+{
+    NEAT_RAISE(nDimension_ != 2 && nDimension_ != 3, g_strWrongDimension);
+
+    if (nDimension_ == 2) {
+        m_pParser2D = new CBezierParser<DPOINT2>();
+        m_pParser3D = nullptr;
+    }
+    else if (nDimension_ == 3) {
+        m_pParser3D = new CBezierParser<DPOINT3>();
+        m_pParser2D = nullptr;
+    }
+}
+
+CBezierParserPointer::~CBezierParserPointer()
+{
+    if (m_pParser2D != nullptr) {
+        delete m_pParser2D;
+    }
+
+    if (m_pParser3D != nullptr) {
+        delete m_pParser3D;
+    }
+}
+
+void CBezierParserPointer::SetBezierNode(const BezierNode2D* pBezierNode_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->SetBezierNode(pBezierNode_);
+}
+
+void CBezierParserPointer::GetBezierPoint(double nKnot_, DPOINT2& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetBezierPoint(nKnot_, ptPoint_);
+}
+
+void CBezierParserPointer::GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CBezierParserPointer::GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CBezierParserPointer::SetBezierNode(const BezierNode3D* pBezierNode_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->SetBezierNode(pBezierNode_);
+}
+
+void CBezierParserPointer::GetBezierPoint(double nKnot_, DPOINT3& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetBezierPoint(nKnot_, ptPoint_);
+}
+
+void CBezierParserPointer::GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CBezierParserPointer::GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetBezierDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// local class CNurbsPowerParserPointer
+CNurbsPowerParserPointer::CNurbsPowerParserPointer(int nDimension_)
+{
+    NEAT_RAISE(nDimension_ != 2 && nDimension_ != 3, g_strWrongDimension);
+
+    if (nDimension_ == 2) {
+        m_pParser2D = new CNurbsPowerParser<DPOINT2, DPOINT3>();
+        m_pParser3D = nullptr;
+    }
+    else if (nDimension_ == 3) {
+        m_pParser3D = new CNurbsPowerParser<DPOINT3, DPOINT4>();
+        m_pParser2D = nullptr;
+    }
+}
+
+CNurbsPowerParserPointer::~CNurbsPowerParserPointer()
+{
+    if (m_pParser2D != nullptr) {
+        delete m_pParser2D;
+    }
+
+    if (m_pParser3D != nullptr) {
+        delete m_pParser3D;
+    }
+}
+
+void CNurbsPowerParserPointer::SetNurbsNode(const NurbsNode2D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsPowerParserPointer::SetNurbsCurve(const CNurbsCurve<DPOINT2>* pNurbsCurve_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->SetNurbsCurve(pNurbsCurve_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsPoint(nKnot_, ptPoint_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_, DPOINT2& ptDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_, ptDeriv3_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT2* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_, DPOINT2* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsPowerParserPointer::GetSamplePoints(int nSteps_, std::vector<DPOINT2>& vecPoints_)
+{
+    NEAT_RAISE_IF(m_pParser2D == nullptr, g_strEmptyPointer);
+    m_pParser2D->GetSamplePoints(nSteps_, vecPoints_);
+}
+
+void CNurbsPowerParserPointer::SetNurbsNode(const NurbsNode3D* pNurbsNode_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->SetNurbsNode(pNurbsNode_);
+}
+
+void CNurbsPowerParserPointer::SetNurbsCurve(const CNurbsCurve<DPOINT3>* pNurbsCurve_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->SetNurbsCurve(pNurbsCurve_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsPoint(nKnot_, ptPoint_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_)
 {
     NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
     m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_, DPOINT3& ptDeriv3_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_, ptDeriv3_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT3* pDerivs_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+}
+
+void CNurbsPowerParserPointer::GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_, DPOINT3* pDeriv2s_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+}
+
+void CNurbsPowerParserPointer::GetSamplePoints(int nSteps_, std::vector<DPOINT3>& vecPoints_)
+{
+    NEAT_RAISE_IF(m_pParser3D == nullptr, g_strEmptyPointer);
+    m_pParser3D->GetSamplePoints(nSteps_, vecPoints_);
+}
+
+int CNurbsPowerParserPointer::GetSpanCount() const
+{
+    return m_pParser2D != nullptr ? m_pParser2D->GetSpanCount() : m_pParser3D->GetSpanCount();
+}
+
+size_t CNurbsPowerParserPointer::GetSpanMemory() const
+{
+    return m_pParser2D != nullptr ? m_pParser2D->GetSpanMemory() : m_pParser3D->GetSpanMemory();
 }
\ No newline at end of file
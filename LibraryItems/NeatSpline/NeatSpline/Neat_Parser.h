@@ -20,6 +20,7 @@ namespace neat
 {
     class CNurbsParserPointer;
     class CBezierParserPointer;
+    class CNurbsPowerParserPointer;
 
     /**
      * The parser for one-dimensional nurbs node
@@ -42,6 +43,22 @@ namespace neat
         // Returns in nPoint_ the point, nDeriv1_ the first-order derivative and nDeriv2_ the second-order derivative of parameter nKnot_.
         void GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_, double& nDeriv2_);
 
+        // Returns in nPoint_ the point, nDeriv1_ the first-order derivative, nDeriv2_ the second-order derivative
+        // and nDeriv3_ the third-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, double& nPoint_, double& nDeriv1_, double& nDeriv2_, double& nDeriv3_);
+
+        // Returns in pDerivs_[0] the point and pDerivs_[k] the k-order derivative (k <= nOrder_) of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, int nOrder_, double* pDerivs_);
+
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, double* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, double* pPoints_, double* pDeriv1s_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, double* pPoints_, double* pDeriv1s_, double* pDeriv2s_);
+
     private:
         CNurbsParser1D(const CNurbsParser1D&) = delete;
         CNurbsParser1D& operator=(const CNurbsParser1D&) = delete;
@@ -61,6 +78,9 @@ namespace neat
         // Set the information for two-dimensional nurbs node.
         void SetNurbsNode(const NurbsNode2D* pNurbsNode_);
 
+        // Set the information for compiled two-dimensional nurbs curve.
+        void SetNurbsCurve(const CNurbsCurve2D* pNurbsCurve_);
+
         // Returns in ptPoint_ the point of parameter nKnot_.
         void GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_);
 
@@ -70,6 +90,22 @@ namespace neat
         // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
         void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_);
 
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative, ptDeriv2_ the second-order derivative
+        // and ptDeriv3_ the third-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_, DPOINT2& ptDeriv3_);
+
+        // Returns in pDerivs_[0] the point and pDerivs_[k] the k-order derivative (k <= nOrder_) of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT2* pDerivs_);
+
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_, DPOINT2* pDeriv2s_);
+
     private:
         CNurbsParser2D(const CNurbsParser2D&) = delete;
         CNurbsParser2D& operator=(const CNurbsParser2D&) = delete;
@@ -89,6 +125,9 @@ namespace neat
         // Set the information for two-dimensional nurbs node.
         void SetNurbsNode(const NurbsNode3D* pNurbsNode_);
 
+        // Set the information for compiled three-dimensional nurbs curve.
+        void SetNurbsCurve(const CNurbsCurve3D* pNurbsCurve_);
+
         // Returns in ptPoint_ the point of parameter nKnot_.
         void GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_);
 
@@ -98,6 +137,22 @@ namespace neat
         // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
         void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_);
 
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative, ptDeriv2_ the second-order derivative
+        // and ptDeriv3_ the third-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_, DPOINT3& ptDeriv3_);
+
+        // Returns in pDerivs_[0] the point and pDerivs_[k] the k-order derivative (k <= nOrder_) of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT3* pDerivs_);
+
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_, DPOINT3* pDeriv2s_);
+
     private:
         CNurbsParser3D(const CNurbsParser3D&) = delete;
         CNurbsParser3D& operator=(const CNurbsParser3D&) = delete;
@@ -105,6 +160,229 @@ namespace neat
         CNurbsParserPointer* m_pParserPointer;
     };
 
+    /**
+     * The parser for four-dimensional nurbs node, such as the position and tool orientation of 4-axis machining.
+     * Every axis is evaluated by the same basis functions.
+     */
+    class NEATSPLINE_API CNurbsParser4D final
+    {
+    public:
+        CNurbsParser4D();
+        ~CNurbsParser4D();
+
+        // Set the information for four-dimensional nurbs node.
+        void SetNurbsNode(const NurbsNode4D* pNurbsNode_);
+
+        // Returns in ptPoint_ the point of parameter nKnot_.
+        void GetNurbsPoint(double nKnot_, DPOINT4& ptPoint_);
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT4& ptPoint_, DPOINT4& ptDeriv1_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT4& ptPoint_, DPOINT4& ptDeriv1_, DPOINT4& ptDeriv2_);
+
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT4* pPoints_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT4* pPoints_, DPOINT4* pDeriv1s_, DPOINT4* pDeriv2s_);
+
+    private:
+        CNurbsParser4D(const CNurbsParser4D&) = delete;
+        CNurbsParser4D& operator=(const CNurbsParser4D&) = delete;
+
+        CNurbsParserPointer* m_pParserPointer;
+    };
+
+    /**
+     * The parser for five-dimensional nurbs node, such as the position and tool orientation of 5-axis machining.
+     * Every axis is evaluated by the same basis functions.
+     */
+    class NEATSPLINE_API CNurbsParser5D final
+    {
+    public:
+        CNurbsParser5D();
+        ~CNurbsParser5D();
+
+        // Set the information for five-dimensional nurbs node.
+        void SetNurbsNode(const NurbsNode5D* pNurbsNode_);
+
+        // Returns in ptPoint_ the point of parameter nKnot_.
+        void GetNurbsPoint(double nKnot_, DPOINT5& ptPoint_);
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT5& ptPoint_, DPOINT5& ptDeriv1_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT5& ptPoint_, DPOINT5& ptDeriv1_, DPOINT5& ptDeriv2_);
+
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT5* pPoints_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT5* pPoints_, DPOINT5* pDeriv1s_, DPOINT5* pDeriv2s_);
+
+    private:
+        CNurbsParser5D(const CNurbsParser5D&) = delete;
+        CNurbsParser5D& operator=(const CNurbsParser5D&) = delete;
+
+        CNurbsParserPointer* m_pParserPointer;
+    };
+
+    /**
+     * The parser for six-dimensional nurbs node, such as the position and tool orientation of 6-axis machining.
+     * Every axis is evaluated by the same basis functions.
+     */
+    class NEATSPLINE_API CNurbsParser6D final
+    {
+    public:
+        CNurbsParser6D();
+        ~CNurbsParser6D();
+
+        // Set the information for six-dimensional nurbs node.
+        void SetNurbsNode(const NurbsNode6D* pNurbsNode_);
+
+        // Returns in ptPoint_ the point of parameter nKnot_.
+        void GetNurbsPoint(double nKnot_, DPOINT6& ptPoint_);
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT6& ptPoint_, DPOINT6& ptDeriv1_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT6& ptPoint_, DPOINT6& ptDeriv1_, DPOINT6& ptDeriv2_);
+
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT6* pPoints_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT6* pPoints_, DPOINT6* pDeriv1s_, DPOINT6* pDeriv2s_);
+
+    private:
+        CNurbsParser6D(const CNurbsParser6D&) = delete;
+        CNurbsParser6D& operator=(const CNurbsParser6D&) = delete;
+
+        CNurbsParserPointer* m_pParserPointer;
+    };
+
+    /**
+     * The power basis parser for two-dimensional nurbs node.
+     * Every span is converted to the coefficients of power basis when the nurbs node is set, and then evaluated by Horner scheme,
+     * which is faster than De-Boor algorithm for the curve evaluated many times but costs GetSpanMemory bytes for every span.
+     */
+    class NEATSPLINE_API CNurbsPowerParser2D final
+    {
+    public:
+        CNurbsPowerParser2D();
+        ~CNurbsPowerParser2D();
+
+        // Set the information for two-dimensional nurbs node.
+        void SetNurbsNode(const NurbsNode2D* pNurbsNode_);
+
+        // Set the information for compiled two-dimensional nurbs curve.
+        void SetNurbsCurve(const CNurbsCurve2D* pNurbsCurve_);
+
+        // Returns in ptPoint_ the point of parameter nKnot_.
+        void GetNurbsPoint(double nKnot_, DPOINT2& ptPoint_);
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative, ptDeriv2_ the second-order derivative
+        // and ptDeriv3_ the third-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_, DPOINT2& ptDeriv3_);
+
+        // Returns in pDerivs_[0] the point and pDerivs_[k] the k-order derivative (k <= nOrder_) of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT2* pDerivs_);
+
+        // Returns in pPoints_ the points of the parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT2* pPoints_, DPOINT2* pDeriv1s_, DPOINT2* pDeriv2s_);
+
+        // Returns in vecPoints_ the points of every span sampled by nSteps_ uniform parameter steps, and the end point of curve.
+        // The points are generated by forward differencing, GetSpanCount() * nSteps_ + 1 points in total.
+        void GetSamplePoints(int nSteps_, std::vector<DPOINT2>& vecPoints_);
+
+        // Returns the number of spans.
+        int GetSpanCount() const;
+
+        // Returns the bytes of coefficients and knots for one span.
+        size_t GetSpanMemory() const;
+
+    private:
+        CNurbsPowerParser2D(const CNurbsPowerParser2D&) = delete;
+        CNurbsPowerParser2D& operator=(const CNurbsPowerParser2D&) = delete;
+
+        CNurbsPowerParserPointer* m_pParserPointer;
+    };
+
+    /**
+     * The power basis parser for three-dimensional nurbs node.
+     * Every span is converted to the coefficients of power basis when the nurbs node is set, and then evaluated by Horner scheme,
+     * which is faster than De-Boor algorithm for the curve evaluated many times but costs GetSpanMemory bytes for every span.
+     */
+    class NEATSPLINE_API CNurbsPowerParser3D final
+    {
+    public:
+        CNurbsPowerParser3D();
+        ~CNurbsPowerParser3D();
+
+        // Set the information for three-dimensional nurbs node.
+        void SetNurbsNode(const NurbsNode3D* pNurbsNode_);
+
+        // Set the information for compiled three-dimensional nurbs curve.
+        void SetNurbsCurve(const CNurbsCurve3D* pNurbsCurve_);
+
+        // Returns in ptPoint_ the point of parameter nKnot_.
+        void GetNurbsPoint(double nKnot_, DPOINT3& ptPoint_);
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative, ptDeriv2_ the second-order derivative
+        // and ptDeriv3_ the third-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_, DPOINT3& ptDeriv3_);
+
+        // Returns in pDerivs_[0] the point and pDerivs_[k] the k-order derivative (k <= nOrder_) of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, int nOrder_, DPOINT3* pDerivs_);
+
+        // Returns in pPoints_ the points of the parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, DPOINT3* pPoints_, DPOINT3* pDeriv1s_, DPOINT3* pDeriv2s_);
+
+        // Returns in vecPoints_ the points of every span sampled by nSteps_ uniform parameter steps, and the end point of curve.
+        // The points are generated by forward differencing, GetSpanCount() * nSteps_ + 1 points in total.
+        void GetSamplePoints(int nSteps_, std::vector<DPOINT3>& vecPoints_);
+
+        // Returns the number of spans.
+        int GetSpanCount() const;
+
+        // Returns the bytes of coefficients and knots for one span.
+        size_t GetSpanMemory() const;
+
+    private:
+        CNurbsPowerParser3D(const CNurbsPowerParser3D&) = delete;
+        CNurbsPowerParser3D& operator=(const CNurbsPowerParser3D&) = delete;
+
+        CNurbsPowerParserPointer* m_pParserPointer;
+    };
+
     /**
      * The parser for two-dimensional bezier node
      */
@@ -124,6 +402,7 @@ namespace neat
         void GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_);
 
         // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        // The second-order derivative of degree one bezier node is zero.
         void GetBezierDeriv(double nKnot_, DPOINT2& ptPoint_, DPOINT2& ptDeriv1_, DPOINT2& ptDeriv2_);
 
     private:
@@ -152,6 +431,7 @@ namespace neat
         void GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_);
 
         // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        // The second-order derivative of degree one bezier node is zero.
         void GetBezierDeriv(double nKnot_, DPOINT3& ptPoint_, DPOINT3& ptDeriv1_, DPOINT3& ptDeriv2_);
 
     private:
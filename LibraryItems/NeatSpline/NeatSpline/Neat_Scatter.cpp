@@ -14,6 +14,109 @@
 
 using namespace neat;
 
+//////////////////////////////////////////////////////////////////////////
+// local class 
+namespace neat
+{
+    /**
+     * The implementation pointer of reusable scatter.
+     */
+    class CNurbsScatterPointer final
+    {
+    public:
+        CNurbsScatterPointer(int nDimension_);
+        ~CNurbsScatterPointer();
+
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_);
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_);
+        void ScatterNurbs(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_, VECDPOINT2& vecScatterPoints_);
+        void ScatterNurbs(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_);
+        void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_);
+        void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_);
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const ScatterSink2D& ScatterSink_);
+        void ScatterNurbs(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_, const ScatterSink2D& ScatterSink_);
+        void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, const ScatterSink2D& ScatterSink_);
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_);
+        void ScatterNurbs(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_);
+        void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_);
+
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
+        void ScatterNurbs(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_, VECDPOINT3& vecScatterPoints_);
+        void ScatterNurbs(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
+        void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_);
+        void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, const ScatterSink3D& ScatterSink_);
+        void ScatterNurbs(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_, const ScatterSink3D& ScatterSink_);
+        void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, const ScatterSink3D& ScatterSink_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_);
+        void ScatterNurbs(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_);
+        void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_);
+
+        void ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, double nDeflection_, VECDPOINT2& vecScatterPoints_,
+            std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_,
+            std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, double nDeflection_, VECDPOINT3& vecScatterPoints_,
+            std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_,
+            std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            VECDPOINT2& vecScatterPoints_, std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            std::vector<ScatterNode2D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, const VECDOUBLE& vecDeflections_, VECDPOINT2& vecScatterPoints_,
+            std::vector<int>& vecLevels_);
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, const VECDOUBLE& vecDeflections_, std::vector<ScatterNode2D>& vecScatterNodes_,
+            std::vector<int>& vecLevels_);
+        void RescatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+            std::vector<ScatterNode2D>& vecScatterNodes_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            VECDPOINT3& vecScatterPoints_, std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            std::vector<ScatterNode3D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, const VECDOUBLE& vecDeflections_, VECDPOINT3& vecScatterPoints_,
+            std::vector<int>& vecLevels_);
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, const VECDOUBLE& vecDeflections_, std::vector<ScatterNode3D>& vecScatterNodes_,
+            std::vector<int>& vecLevels_);
+        void RescatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+            std::vector<ScatterNode3D>& vecScatterNodes_);
+
+        void StartScatter(const NurbsNode2D* pNurbsNode_, double nDeflection_);
+        void StartScatter(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_);
+        void StartScatter(const BezierNode2D* pBezierNode_, double nDeflection_);
+        bool NextScatterNode(ScatterNode2D& ScatterNode_);
+
+        void StartScatter(const NurbsNode3D* pNurbsNode_, double nDeflection_);
+        void StartScatter(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_);
+        void StartScatter(const BezierNode3D* pBezierNode_, double nDeflection_);
+        bool NextScatterNode(ScatterNode3D& ScatterNode_);
+
+        void SetThreadCount(int nThreadCount_);
+        void SetSimplifyRatio(double nSimplifyRatio_);
+        void EnableFlatnessScatter(bool bEnable_);
+        void SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_);
+        void SetScatterToken(const ScatterToken* pScatterToken_);
+        int GetScatterStatus() const;
+
+    private:
+        CNurbsScatterPointer(const CNurbsScatterPointer&) = delete;
+        CNurbsScatterPointer& operator=(const CNurbsScatterPointer&) = delete;
+
+        CNurbsScatter<DPOINT2, DPOINT3>* m_pScatter2D;
+        CNurbsScatter<DPOINT3, DPOINT4>* m_pScatter3D;
+        CNurbsBatchScatter<DPOINT2, DPOINT3>* m_pBatchScatter2D;
+        CNurbsBatchScatter<DPOINT3, DPOINT4>* m_pBatchScatter3D;
+
+        // The threads which are shared by all scatters, and kept alive between scatters.
+        CScatterThreadPool m_ThreadPool;
+
+        // The bezier node is converted to this nurbs node, whose capacity is reused by next bezier node.
+        NurbsNode2D m_NurbsNode2D;
+        NurbsNode3D m_NurbsNode3D;
+    };
+} // End namespace neat
+
 //////////////////////////////////////////////////////////////////////////
 // global function interfaces
 void neat::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
@@ -29,15 +132,27 @@ void neat::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, std
 }
 
 void neat::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, Polyline2D& Polyline2D_)
+{
+    ScatterToken _ScatterToken;
+    ScatterNurbs(pNurbsNode_, nDeflection_, _ScatterToken, Polyline2D_);
+}
+
+int neat::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const ScatterToken& ScatterToken_, Polyline2D& Polyline2D_)
 {
     // First convert the nurbs spline to bezier splines, and then convert each bezier spline to polyline
     std::vector<BezierNode2D> _vecBezierNodes;
     ConvertNurbsToBezier(pNurbsNode_, _vecBezierNodes);
 
+    CBezierConverter2D _Converter2D;
+    _Converter2D.SetScatterToken(&ScatterToken_);
     Polyline2D _Polyline2D;
-    for (const auto& _BezierNode : _vecBezierNodes) {
+    int _nStatus = scatter_status::finished;
+    for (size_t i = 0; i < _vecBezierNodes.size() && _nStatus == scatter_status::finished; ++i) {
         _Polyline2D.vecNodes.clear();
-        ScatterBezier(&_BezierNode, nDeflection_, _Polyline2D);
+        _nStatus = _Converter2D.ConvertBezierToPolyline(&_vecBezierNodes[i], nDeflection_, _Polyline2D);
+        if (_Polyline2D.vecNodes.empty()) {
+            continue;
+        }
 
         if (Polyline2D_.vecNodes.empty()) {
             Polyline2D_.nStartX = _Polyline2D.nStartX;
@@ -48,6 +163,20 @@ void neat::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, Pol
             Polyline2D_.vecNodes.emplace_back(_node);
         }
     }
+
+    return _nStatus;
+}
+
+void neat::ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
+{
+    CNurbsScatter<DPOINT2, DPOINT3> _Scatter2D;
+    _Scatter2D.ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, vecScatterPoints_);
+}
+
+void neat::ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    CNurbsScatter<DPOINT2, DPOINT3> _Scatter2D;
+    _Scatter2D.ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, vecScatterNodes_);
 }
 
 void neat::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
@@ -62,6 +191,18 @@ void neat::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, std
     _Scatter3D.ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterNodes_);
 }
 
+void neat::ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
+{
+    CNurbsScatter<DPOINT3, DPOINT4> _Scatter3D;
+    _Scatter3D.ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, vecScatterPoints_);
+}
+
+void neat::ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    CNurbsScatter<DPOINT3, DPOINT4> _Scatter3D;
+    _Scatter3D.ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, vecScatterNodes_);
+}
+
 void neat::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
 {
     NurbsNode2D _NurbsNode2D;
@@ -86,6 +227,13 @@ void neat::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_,
     _Converter2D.ConvertBezierToPolyline(pBezierNode_, nDeflection_, Polyline2D_);
 }
 
+int neat::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, const ScatterToken& ScatterToken_, Polyline2D& Polyline2D_)
+{
+    CBezierConverter2D _Converter2D;
+    _Converter2D.SetScatterToken(&ScatterToken_);
+    return _Converter2D.ConvertBezierToPolyline(pBezierNode_, nDeflection_, Polyline2D_);
+}
+
 void neat::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
 {
     NurbsNode3D _NurbsNode3D;
@@ -102,4 +250,887 @@ void neat::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_,
 
     CNurbsScatter<DPOINT3, DPOINT4> _Scatter3D;
     _Scatter3D.ScatterNurbs(&_NurbsNode3D, nDeflection_, vecScatterNodes_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsScatter2D
+CNurbsScatter2D::CNurbsScatter2D()
+{
+    m_pScatterPointer = new CNurbsScatterPointer(2);
+}
+
+CNurbsScatter2D::~CNurbsScatter2D()
+{
+    delete m_pScatterPointer;
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatter2D::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterBezier(pBezierNode_, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatter2D::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterBezier(pBezierNode_, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const ScatterSink2D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, const ScatterSink2D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatter2D::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, const ScatterSink2D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterBezier(pBezierNode_, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatter2D::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterBezier(pBezierNode_, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, double nDeflection_, VECDPOINT2& vecScatterPoints_,
+    std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNodes_, nCount_, nDeflection_, vecScatterPoints_, vecOffsets_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, double nDeflection_,
+    std::vector<ScatterNode2D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNodes_, nCount_, nDeflection_, vecScatterNodes_, vecOffsets_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+    VECDPOINT2& vecScatterPoints_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecScatterPoints_, vecOffsets_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+    std::vector<ScatterNode2D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecScatterNodes_, vecOffsets_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNode_, const VECDOUBLE& vecDeflections_, VECDPOINT2& vecScatterPoints_,
+    std::vector<int>& vecLevels_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, vecDeflections_, vecScatterPoints_, vecLevels_);
+}
+
+void CNurbsScatter2D::ScatterNurbs(const NurbsNode2D* pNurbsNode_, const VECDOUBLE& vecDeflections_,
+    std::vector<ScatterNode2D>& vecScatterNodes_, std::vector<int>& vecLevels_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, vecDeflections_, vecScatterNodes_, vecLevels_);
+}
+
+void CNurbsScatter2D::RescatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+    std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->RescatterNurbs(pNurbsNode_, nDeflection_, vecPoleIndexes_, vecScatterNodes_);
+}
+
+void CNurbsScatter2D::SetThreadCount(int nThreadCount_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->SetThreadCount(nThreadCount_);
+}
+
+void CNurbsScatter2D::SetSimplifyRatio(double nSimplifyRatio_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->SetSimplifyRatio(nSimplifyRatio_);
+}
+
+void CNurbsScatter2D::EnableFlatnessScatter(bool bEnable_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->EnableFlatnessScatter(bEnable_);
+}
+
+void CNurbsScatter2D::SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->SetSegmentConstraints(nMaxSegmentLength_, nMaxTurningAngle_);
+}
+
+void CNurbsScatter2D::SetScatterToken(const ScatterToken* pScatterToken_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->SetScatterToken(pScatterToken_);
+}
+
+int CNurbsScatter2D::GetScatterStatus() const
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    return m_pScatterPointer->GetScatterStatus();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsScatterIterator2D
+CNurbsScatterIterator2D::CNurbsScatterIterator2D()
+{
+    m_pScatterPointer = new CNurbsScatterPointer(2);
+}
+
+CNurbsScatterIterator2D::~CNurbsScatterIterator2D()
+{
+    delete m_pScatterPointer;
+}
+
+void CNurbsScatterIterator2D::Start(const NurbsNode2D* pNurbsNode_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->StartScatter(pNurbsNode_, nDeflection_);
+}
+
+void CNurbsScatterIterator2D::Start(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->StartScatter(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_);
+}
+
+void CNurbsScatterIterator2D::Start(const BezierNode2D* pBezierNode_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->StartScatter(pBezierNode_, nDeflection_);
+}
+
+bool CNurbsScatterIterator2D::Next(ScatterNode2D& ScatterNode_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    return m_pScatterPointer->NextScatterNode(ScatterNode_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsScatter3D
+CNurbsScatter3D::CNurbsScatter3D()
+{
+    m_pScatterPointer = new CNurbsScatterPointer(3);
+}
+
+CNurbsScatter3D::~CNurbsScatter3D()
+{
+    delete m_pScatterPointer;
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatter3D::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterBezier(pBezierNode_, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatter3D::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterBezier(pBezierNode_, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, const ScatterSink3D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, const ScatterSink3D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatter3D::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, const ScatterSink3D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterBezier(pBezierNode_, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatter3D::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterBezier(pBezierNode_, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, double nDeflection_, VECDPOINT3& vecScatterPoints_,
+    std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNodes_, nCount_, nDeflection_, vecScatterPoints_, vecOffsets_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, double nDeflection_,
+    std::vector<ScatterNode3D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNodes_, nCount_, nDeflection_, vecScatterNodes_, vecOffsets_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+    VECDPOINT3& vecScatterPoints_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecScatterPoints_, vecOffsets_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+    std::vector<ScatterNode3D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecScatterNodes_, vecOffsets_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNode_, const VECDOUBLE& vecDeflections_, VECDPOINT3& vecScatterPoints_,
+    std::vector<int>& vecLevels_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, vecDeflections_, vecScatterPoints_, vecLevels_);
+}
+
+void CNurbsScatter3D::ScatterNurbs(const NurbsNode3D* pNurbsNode_, const VECDOUBLE& vecDeflections_,
+    std::vector<ScatterNode3D>& vecScatterNodes_, std::vector<int>& vecLevels_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->ScatterNurbs(pNurbsNode_, vecDeflections_, vecScatterNodes_, vecLevels_);
+}
+
+void CNurbsScatter3D::RescatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+    std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->RescatterNurbs(pNurbsNode_, nDeflection_, vecPoleIndexes_, vecScatterNodes_);
+}
+
+void CNurbsScatter3D::SetThreadCount(int nThreadCount_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->SetThreadCount(nThreadCount_);
+}
+
+void CNurbsScatter3D::SetSimplifyRatio(double nSimplifyRatio_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->SetSimplifyRatio(nSimplifyRatio_);
+}
+
+void CNurbsScatter3D::EnableFlatnessScatter(bool bEnable_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->EnableFlatnessScatter(bEnable_);
+}
+
+void CNurbsScatter3D::SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->SetSegmentConstraints(nMaxSegmentLength_, nMaxTurningAngle_);
+}
+
+void CNurbsScatter3D::SetScatterToken(const ScatterToken* pScatterToken_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->SetScatterToken(pScatterToken_);
+}
+
+int CNurbsScatter3D::GetScatterStatus() const
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    return m_pScatterPointer->GetScatterStatus();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsScatterIterator3D
+CNurbsScatterIterator3D::CNurbsScatterIterator3D()
+{
+    m_pScatterPointer = new CNurbsScatterPointer(3);
+}
+
+CNurbsScatterIterator3D::~CNurbsScatterIterator3D()
+{
+    delete m_pScatterPointer;
+}
+
+void CNurbsScatterIterator3D::Start(const NurbsNode3D* pNurbsNode_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->StartScatter(pNurbsNode_, nDeflection_);
+}
+
+void CNurbsScatterIterator3D::Start(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->StartScatter(CNurbsCurvePointer::GetNurbsCurve(pNurbsCurve_), nDeflection_);
+}
+
+void CNurbsScatterIterator3D::Start(const BezierNode3D* pBezierNode_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    m_pScatterPointer->StartScatter(pBezierNode_, nDeflection_);
+}
+
+bool CNurbsScatterIterator3D::Next(ScatterNode3D& ScatterNode_)
+{
+    NEAT_RAISE_IF(m_pScatterPointer == nullptr, g_strEmptyPointer);
+    return m_pScatterPointer->NextScatterNode(ScatterNode_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class CNurbsScatterND
+template<int N>
+CNurbsScatterND<N>::CNurbsScatterND()
+{
+    m_pAxisScatter = new CNurbsAxisScatter<N>();
+}
+
+template<int N>
+CNurbsScatterND<N>::~CNurbsScatterND()
+{
+    delete m_pAxisScatter;
+}
+
+template<int N>
+void CNurbsScatterND<N>::SetDeflectionAxes(const std::vector<int>& vecAxes_)
+{
+    NEAT_RAISE_IF(m_pAxisScatter == nullptr, g_strEmptyPointer);
+    m_pAxisScatter->SetDeflectionAxes(vecAxes_);
+}
+
+template<int N>
+void CNurbsScatterND<N>::SetOrientationDeflection(double nOrientationDeflection_)
+{
+    NEAT_RAISE_IF(m_pAxisScatter == nullptr, g_strEmptyPointer);
+    m_pAxisScatter->SetOrientationDeflection(nOrientationDeflection_);
+}
+
+template<int N>
+void CNurbsScatterND<N>::ScatterNurbs(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_,
+    std::vector<CAxisPoint<double, N>>& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pAxisScatter == nullptr, g_strEmptyPointer);
+    m_pAxisScatter->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterPoints_);
+}
+
+template<int N>
+void CNurbsScatterND<N>::ScatterNurbs(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_,
+    std::vector<ScatterNode<CAxisPoint<double, N>>>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pAxisScatter == nullptr, g_strEmptyPointer);
+    m_pAxisScatter->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterNodes_);
+}
+
+template<int N>
+void CNurbsScatterND<N>::SetThreadCount(int nThreadCount_)
+{
+    NEAT_RAISE_IF(m_pAxisScatter == nullptr, g_strEmptyPointer);
+    m_pAxisScatter->SetThreadCount(nThreadCount_);
+}
+
+template class NEATSPLINE_API neat::CNurbsScatterND<4>;
+template class NEATSPLINE_API neat::CNurbsScatterND<5>;
+template class NEATSPLINE_API neat::CNurbsScatterND<6>;
+
+//////////////////////////////////////////////////////////////////////////
+// local class CNurbsScatterPointer
+CNurbsScatterPointer::CNurbsScatterPointer(int nDimension_)
+{
+    NEAT_RAISE(nDimension_ != 2 && nDimension_ != 3, g_strWrongDimension);
+
+    if (nDimension_ == 2) {
+        m_pScatter2D = new CNurbsScatter<DPOINT2, DPOINT3>();
+        m_pBatchScatter2D = new CNurbsBatchScatter<DPOINT2, DPOINT3>();
+        m_pScatter3D = nullptr;
+        m_pBatchScatter3D = nullptr;
+        m_pScatter2D->SetThreadPool(&m_ThreadPool);
+        m_pBatchScatter2D->SetThreadPool(&m_ThreadPool);
+    }
+    else if (nDimension_ == 3) {
+        m_pScatter3D = new CNurbsScatter<DPOINT3, DPOINT4>();
+        m_pBatchScatter3D = new CNurbsBatchScatter<DPOINT3, DPOINT4>();
+        m_pScatter2D = nullptr;
+        m_pBatchScatter2D = nullptr;
+        m_pScatter3D->SetThreadPool(&m_ThreadPool);
+        m_pBatchScatter3D->SetThreadPool(&m_ThreadPool);
+    }
+}
+
+CNurbsScatterPointer::~CNurbsScatterPointer()
+{
+    if (m_pScatter2D != nullptr) {
+        delete m_pScatter2D;
+    }
+
+    if (m_pScatter3D != nullptr) {
+        delete m_pScatter3D;
+    }
+
+    if (m_pBatchScatter2D != nullptr) {
+        delete m_pBatchScatter2D;
+    }
+
+    if (m_pBatchScatter3D != nullptr) {
+        delete m_pBatchScatter3D;
+    }
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsCurve_, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsCurve_, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatterPointer::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode2D);
+    m_pScatter2D->ScatterNurbs(&m_NurbsNode2D, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatterPointer::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode2D);
+    m_pScatter2D->ScatterNurbs(&m_NurbsNode2D, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const ScatterSink2D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsNode_, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_, const ScatterSink2D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsCurve_, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatterPointer::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, const ScatterSink2D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode2D);
+    m_pScatter2D->ScatterNurbs(&m_NurbsNode2D, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsNode_, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_, int nFields_,
+    ScatterArrays2D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsCurve_, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatterPointer::ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode2D);
+    m_pScatter2D->ScatterNurbs(&m_NurbsNode2D, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsNode_, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsCurve_, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsCurve_, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatterPointer::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode3D);
+    m_pScatter3D->ScatterNurbs(&m_NurbsNode3D, nDeflection_, vecScatterPoints_);
+}
+
+void CNurbsScatterPointer::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode3D);
+    m_pScatter3D->ScatterNurbs(&m_NurbsNode3D, nDeflection_, vecScatterNodes_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, const ScatterSink3D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsNode_, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_, const ScatterSink3D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsCurve_, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatterPointer::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, const ScatterSink3D& ScatterSink_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode3D);
+    m_pScatter3D->ScatterNurbs(&m_NurbsNode3D, nDeflection_, ScatterSink_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsNode_, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_, int nFields_,
+    ScatterArrays3D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsCurve_, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatterPointer::ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode3D);
+    m_pScatter3D->ScatterNurbs(&m_NurbsNode3D, nDeflection_, nFields_, ScatterArrays_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, double nDeflection_, VECDPOINT2& vecScatterPoints_,
+    std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pBatchScatter2D == nullptr, g_strEmptyPointer);
+    m_pBatchScatter2D->ScatterNurbs(pNurbsNodes_, nCount_, nDeflection_, vecScatterPoints_, vecOffsets_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, double nDeflection_,
+    std::vector<ScatterNode2D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pBatchScatter2D == nullptr, g_strEmptyPointer);
+    m_pBatchScatter2D->ScatterNurbs(pNurbsNodes_, nCount_, nDeflection_, vecScatterNodes_, vecOffsets_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, double nDeflection_, VECDPOINT3& vecScatterPoints_,
+    std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pBatchScatter3D == nullptr, g_strEmptyPointer);
+    m_pBatchScatter3D->ScatterNurbs(pNurbsNodes_, nCount_, nDeflection_, vecScatterPoints_, vecOffsets_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, double nDeflection_,
+    std::vector<ScatterNode3D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pBatchScatter3D == nullptr, g_strEmptyPointer);
+    m_pBatchScatter3D->ScatterNurbs(pNurbsNodes_, nCount_, nDeflection_, vecScatterNodes_, vecOffsets_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+    VECDPOINT2& vecScatterPoints_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecScatterPoints_, vecOffsets_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+    std::vector<ScatterNode2D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecScatterNodes_, vecOffsets_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNode_, const VECDOUBLE& vecDeflections_, VECDPOINT2& vecScatterPoints_,
+    std::vector<int>& vecLevels_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsNode_, vecDeflections_, vecScatterPoints_, vecLevels_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode2D* pNurbsNode_, const VECDOUBLE& vecDeflections_,
+    std::vector<ScatterNode2D>& vecScatterNodes_, std::vector<int>& vecLevels_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->ScatterNurbs(pNurbsNode_, vecDeflections_, vecScatterNodes_, vecLevels_);
+}
+
+void CNurbsScatterPointer::RescatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+    std::vector<ScatterNode2D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->RescatterNurbs(pNurbsNode_, nDeflection_, vecPoleIndexes_, vecScatterNodes_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+    VECDPOINT3& vecScatterPoints_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecScatterPoints_, vecOffsets_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+    std::vector<ScatterNode3D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecScatterNodes_, vecOffsets_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNode_, const VECDOUBLE& vecDeflections_, VECDPOINT3& vecScatterPoints_,
+    std::vector<int>& vecLevels_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsNode_, vecDeflections_, vecScatterPoints_, vecLevels_);
+}
+
+void CNurbsScatterPointer::ScatterNurbs(const NurbsNode3D* pNurbsNode_, const VECDOUBLE& vecDeflections_,
+    std::vector<ScatterNode3D>& vecScatterNodes_, std::vector<int>& vecLevels_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->ScatterNurbs(pNurbsNode_, vecDeflections_, vecScatterNodes_, vecLevels_);
+}
+
+void CNurbsScatterPointer::RescatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+    std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->RescatterNurbs(pNurbsNode_, nDeflection_, vecPoleIndexes_, vecScatterNodes_);
+}
+
+void CNurbsScatterPointer::StartScatter(const NurbsNode2D* pNurbsNode_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->StartScatter(pNurbsNode_, nDeflection_);
+}
+
+void CNurbsScatterPointer::StartScatter(const CNurbsCurve<DPOINT2>* pNurbsCurve_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    m_pScatter2D->StartScatter(pNurbsCurve_, nDeflection_);
+}
+
+void CNurbsScatterPointer::StartScatter(const BezierNode2D* pBezierNode_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode2D);
+    m_pScatter2D->StartScatter(&m_NurbsNode2D, nDeflection_);
+}
+
+bool CNurbsScatterPointer::NextScatterNode(ScatterNode2D& ScatterNode_)
+{
+    NEAT_RAISE_IF(m_pScatter2D == nullptr, g_strEmptyPointer);
+    return m_pScatter2D->NextScatterNode(ScatterNode_);
+}
+
+void CNurbsScatterPointer::StartScatter(const NurbsNode3D* pNurbsNode_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->StartScatter(pNurbsNode_, nDeflection_);
+}
+
+void CNurbsScatterPointer::StartScatter(const CNurbsCurve<DPOINT3>* pNurbsCurve_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    m_pScatter3D->StartScatter(pNurbsCurve_, nDeflection_);
+}
+
+void CNurbsScatterPointer::StartScatter(const BezierNode3D* pBezierNode_, double nDeflection_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    ConvertBezierToNurbs(pBezierNode_, &m_NurbsNode3D);
+    m_pScatter3D->StartScatter(&m_NurbsNode3D, nDeflection_);
+}
+
+bool CNurbsScatterPointer::NextScatterNode(ScatterNode3D& ScatterNode_)
+{
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    return m_pScatter3D->NextScatterNode(ScatterNode_);
+}
+
+void CNurbsScatterPointer::SetThreadCount(int nThreadCount_)
+{
+    if (m_pScatter2D != nullptr) {
+        m_pScatter2D->SetThreadCount(nThreadCount_);
+        m_pBatchScatter2D->SetThreadCount(nThreadCount_);
+    }
+
+    if (m_pScatter3D != nullptr) {
+        m_pScatter3D->SetThreadCount(nThreadCount_);
+        m_pBatchScatter3D->SetThreadCount(nThreadCount_);
+    }
+}
+
+void CNurbsScatterPointer::SetSimplifyRatio(double nSimplifyRatio_)
+{
+    if (m_pScatter2D != nullptr) {
+        m_pScatter2D->SetSimplifyRatio(nSimplifyRatio_);
+        m_pBatchScatter2D->SetSimplifyRatio(nSimplifyRatio_);
+    }
+
+    if (m_pScatter3D != nullptr) {
+        m_pScatter3D->SetSimplifyRatio(nSimplifyRatio_);
+        m_pBatchScatter3D->SetSimplifyRatio(nSimplifyRatio_);
+    }
+}
+
+void CNurbsScatterPointer::EnableFlatnessScatter(bool bEnable_)
+{
+    if (m_pScatter2D != nullptr) {
+        m_pScatter2D->EnableFlatnessScatter(bEnable_);
+        m_pBatchScatter2D->EnableFlatnessScatter(bEnable_);
+    }
+
+    if (m_pScatter3D != nullptr) {
+        m_pScatter3D->EnableFlatnessScatter(bEnable_);
+        m_pBatchScatter3D->EnableFlatnessScatter(bEnable_);
+    }
+}
+
+void CNurbsScatterPointer::SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_)
+{
+    if (m_pScatter2D != nullptr) {
+        m_pScatter2D->SetSegmentConstraints(nMaxSegmentLength_, nMaxTurningAngle_);
+        m_pBatchScatter2D->SetSegmentConstraints(nMaxSegmentLength_, nMaxTurningAngle_);
+    }
+
+    if (m_pScatter3D != nullptr) {
+        m_pScatter3D->SetSegmentConstraints(nMaxSegmentLength_, nMaxTurningAngle_);
+        m_pBatchScatter3D->SetSegmentConstraints(nMaxSegmentLength_, nMaxTurningAngle_);
+    }
+}
+
+void CNurbsScatterPointer::SetScatterToken(const ScatterToken* pScatterToken_)
+{
+    if (m_pScatter2D != nullptr) {
+        m_pScatter2D->SetScatterToken(pScatterToken_);
+    }
+
+    if (m_pScatter3D != nullptr) {
+        m_pScatter3D->SetScatterToken(pScatterToken_);
+    }
+}
+
+int CNurbsScatterPointer::GetScatterStatus() const
+{
+    if (m_pScatter2D != nullptr) {
+        return m_pScatter2D->GetScatterStatus();
+    }
+
+    NEAT_RAISE_IF(m_pScatter3D == nullptr, g_strEmptyPointer);
+    return m_pScatter3D->GetScatterStatus();
 }
\ No newline at end of file
@@ -13,11 +13,84 @@
 #ifndef __NEAT_SCATTER_H_20200130__
 #define __NEAT_SCATTER_H_20200130__
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+
 /**
  * This file defines the interface for scatting splines.
  */
 namespace neat
 {
+    class CNurbsScatterPointer;
+
+    template<int N>
+    class CNurbsAxisScatter;
+
+    /**
+     * The sink of scatter nodes, it is called with every scatter node in order as soon as the node is finalized.
+     */
+    template<typename TYPE>
+    using ScatterSink = std::function<void(const ScatterNode<TYPE>&)>;
+    typedef ScatterSink<DPOINT2> ScatterSink2D;
+    typedef ScatterSink<DPOINT3> ScatterSink3D;
+
+    /**
+     * The fields of scatter nodes, which are combined by bitwise or to select the output arrays.
+     */
+    struct scatter_field
+    {
+        enum { point = 0x01, knot = 0x02, deriv1 = 0x04, deriv2 = 0x08, curvature = 0x10, arc_length = 0x20, all = 0x3F };
+    };
+
+    /**
+     * The scatter nodes in structure of arrays, only the arrays of selected fields are filled, and the others are cleared.
+     */
+    template<typename TYPE>
+    struct ScatterArrays
+    {
+        std::vector<TYPE> vecPoints;    // The points of scatter nodes
+        VECDOUBLE vecKnots;             // The knots of scatter nodes
+        std::vector<TYPE> vecDeriv1s;   // The first-order derivatives of scatter nodes
+        std::vector<TYPE> vecDeriv2s;   // The second-order derivatives of scatter nodes
+        VECDOUBLE vecCurvatures;        // The curvatures of scatter nodes, which are |d1 x d2| / |d1|^3
+        VECDOUBLE vecArcLengths;        // The accumulated length of chords from the first scatter node
+    };
+    typedef ScatterArrays<DPOINT2> ScatterArrays2D;
+    typedef ScatterArrays<DPOINT3> ScatterArrays3D;
+
+    /**
+     * The status of scatter, which is finished unless it's interrupted by the scatter token.
+     */
+    struct scatter_status
+    {
+        enum { finished = 0, cancelled = 1, expired = 2 };
+    };
+
+    /**
+     * The token to interrupt the scatter of long spline, which is cancelled by another thread or expired at the deadline.
+     * The interrupted scatter outputs the result before it's interrupted, which covers the front part of spline.
+     */
+    struct ScatterToken
+    {
+        std::atomic<bool> bCancelled{ false };
+        std::chrono::steady_clock::time_point tmDeadline = (std::chrono::steady_clock::time_point::max)();
+
+        // Returns cancelled or expired if the scatter should be interrupted, otherwise returns finished.
+        int GetStatus() const
+        {
+            if (bCancelled.load(std::memory_order_relaxed)) {
+                return scatter_status::cancelled;
+            }
+
+            if (tmDeadline != (std::chrono::steady_clock::time_point::max)() && std::chrono::steady_clock::now() >= tmDeadline) {
+                return scatter_status::expired;
+            }
+
+            return scatter_status::finished;
+        }
+    };
+
     /**
      * The scatter for two-dimensional nurbs node.
      */
@@ -31,6 +104,17 @@ namespace neat
     // Scatter nurbs node by given deflection, and output the polyline.
     NEATSPLINE_API void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, Polyline2D& Polyline2D_);
 
+    // Scatter nurbs node by given deflection, and output the polyline. The token is checked before fitting every knot interval,
+    // and the interrupted polyline covers the front part of nurbs node. Returns the value of scatter_status.
+    NEATSPLINE_API int ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const ScatterToken& ScatterToken_,
+        Polyline2D& Polyline2D_);
+
+    // Scatter compiled nurbs curve by given deflection, and output the scatter points.
+    NEATSPLINE_API void ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, VECDPOINT2& vecScatterPoints_);
+
+    // Scatter compiled nurbs curve by given deflection, and output the scatter nodes.
+    NEATSPLINE_API void ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_);
+
     /**
      * The scatter for three-dimensional nurbs node.
      */
@@ -41,6 +125,12 @@ namespace neat
     // Scatter nurbs node by given deflection, and output the scatter nodes.
     NEATSPLINE_API void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
 
+    // Scatter compiled nurbs curve by given deflection, and output the scatter points.
+    NEATSPLINE_API void ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, VECDPOINT3& vecScatterPoints_);
+
+    // Scatter compiled nurbs curve by given deflection, and output the scatter nodes.
+    NEATSPLINE_API void ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
+
     /**
      * The scatter for two-dimensional bezier node.
      */
@@ -54,6 +144,10 @@ namespace neat
     // Scatter bezier node by given deflection, and output the polyline.
     NEATSPLINE_API void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, Polyline2D& Polyline2D_);
 
+    // Scatter bezier node by given deflection, and output the polyline, which is interrupted by the token like above.
+    NEATSPLINE_API int ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, const ScatterToken& ScatterToken_,
+        Polyline2D& Polyline2D_);
+
     /**
      * The scatter for three-dimensional bezier node.
      */
@@ -64,6 +158,377 @@ namespace neat
     // Scatter bezier node by given deflection, and output the scatter nodes.
     NEATSPLINE_API void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
 
+    /**
+     * The reusable scatter for two-dimensional nurbs node.
+     * The internal buffers are retained across calls, scattering many nodes by one object doesn't allocate memory for every node.
+     */
+    class NEATSPLINE_API CNurbsScatter2D final
+    {
+    public:
+        CNurbsScatter2D();
+        ~CNurbsScatter2D();
+
+        // Scatter nurbs node by given deflection, and output the scatter points.
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_);
+
+        // Scatter nurbs node by given deflection, and output the scatter nodes.
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_);
+
+        // Scatter compiled nurbs curve by given deflection, and output the scatter points.
+        void ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, VECDPOINT2& vecScatterPoints_);
+
+        // Scatter compiled nurbs curve by given deflection, and output the scatter nodes.
+        void ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_);
+
+        // Scatter bezier node by given deflection, and output the scatter points.
+        void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, VECDPOINT2& vecScatterPoints_);
+
+        // Scatter bezier node by given deflection, and output the scatter nodes.
+        void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_);
+
+        // Scatter nurbs node by given deflection, and send the scatter nodes to ScatterSink_ one by one as soon as they are finalized.
+        // The scatter nodes are the same as the output of std::vector<ScatterNode2D>, but no buffer grows with the length of curve.
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const ScatterSink2D& ScatterSink_);
+
+        // Scatter compiled nurbs curve by given deflection, and send the scatter nodes to ScatterSink_ one by one.
+        void ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, const ScatterSink2D& ScatterSink_);
+
+        // Scatter bezier node by given deflection, and send the scatter nodes to ScatterSink_ one by one.
+        void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, const ScatterSink2D& ScatterSink_);
+
+        // Scatter nurbs node by given deflection, and output the fields of scatter nodes selected by nFields_ of scatter_field.
+        // Only the selected fields are written, the second-order derivatives are not calculated unless they or the curvatures
+        // are selected. The points and knots of 2D curve take 3 doubles per node instead of 7 of ScatterNode2D.
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_);
+
+        // Scatter compiled nurbs curve by given deflection, and output the selected fields of scatter nodes.
+        void ScatterNurbs(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_);
+
+        // Scatter bezier node by given deflection, and output the selected fields of scatter nodes.
+        void ScatterBezier(const BezierNode2D* pBezierNode_, double nDeflection_, int nFields_, ScatterArrays2D& ScatterArrays_);
+
+        // Scatter nurbs nodes by given deflection, and output the scatter points of all nurbs nodes in order.
+        // The scatter points of pNurbsNodes_[i] are from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, double nDeflection_, VECDPOINT2& vecScatterPoints_,
+            std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs nodes by given deflection, and output the scatter nodes of all nurbs nodes in order.
+        // The scatter nodes of pNurbsNodes_[i] are from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, double nDeflection_, std::vector<ScatterNode2D>& vecScatterNodes_,
+            std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs nodes by the point budget, and output the scatter points of all nurbs nodes in order.
+        // The segment with the largest estimated chord error of all nurbs nodes is divided first, until the count of scatter points
+        // reaches nPointBudget_ or the chord errors are within deflection, so the best points of given count are got for preview.
+        // The knot intervals of nurbs nodes are not divided less, which may need more points than the budget. It's scattered by
+        // the calling thread, and the flatness scatter isn't supported, which raises an exception if it's enabled.
+        // The scatter points of pNurbsNodes_[i] are from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            VECDPOINT2& vecScatterPoints_, std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs nodes by the point budget like above, and output the scatter nodes of all nurbs nodes in order.
+        void ScatterNurbs(const NurbsNode2D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            std::vector<ScatterNode2D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs node by several deflections in descending order in one pass, and output the nested levels of scatter points.
+        // Level i is scattered by vecDeflections_[i], and vecLevels_[j] is the first level containing point j, so the points of
+        // level i are the points whose levels are no more than i in the same order, and the coarse levels are subsets of the fine
+        // levels. The chord is divided in half instead of quasi uniform, and the collinear points of every level are combined
+        // from the coarsest level, whose combined points first appear at the next level. It's scattered by the calling thread,
+        // and the flatness scatter isn't supported, which raises an exception if it's enabled.
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, const VECDOUBLE& vecDeflections_, VECDPOINT2& vecScatterPoints_,
+            std::vector<int>& vecLevels_);
+
+        // Scatter nurbs node by several deflections like above, and output the nested levels of scatter nodes.
+        void ScatterNurbs(const NurbsNode2D* pNurbsNode_, const VECDOUBLE& vecDeflections_, std::vector<ScatterNode2D>& vecScatterNodes_,
+            std::vector<int>& vecLevels_);
+
+        // Scatter nurbs node again after its poles or weights of given indexes are modified, and the knots and degree are not.
+        // vecScatterNodes_ is the scatter nodes of nurbs node before modification by the same deflection, only the knot intervals
+        // affected by the modified poles are scattered again, and the scatter nodes in them are replaced by the new ones.
+        // The intervals are scattered by quasi uniform deflection of the calling thread, and the previous nodes are kept if it's
+        // interrupted by the scatter token. The flatness scatter isn't supported, which raises an exception if it's enabled.
+        void RescatterNurbs(const NurbsNode2D* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+            std::vector<ScatterNode2D>& vecScatterNodes_);
+
+        // Set the number of threads which scatter the knot intervals of one nurbs node or the nurbs nodes of batch,
+        // the default is one thread. The scatter result is the same for any number of threads.
+        void SetThreadCount(int nThreadCount_);
+
+        // Set the ratio of deflection which is used to simplify the scatter nodes, and the rest ratio is used to scatter.
+        // The chord skips the nodes within the simplify tolerance from it, and the chord error is still within deflection.
+        // A larger ratio scatters more densely and then simplifies to fewer nodes, such as 0.9 for the fewest NC blocks.
+        // The ratio must be in [0, 1), the default 0 only combines the collinear nodes.
+        void SetSimplifyRatio(double nSimplifyRatio_);
+
+        // Enable to scatter the bezier spans of nurbs node by control polygon flatness, the default is disabled.
+        // Every bezier span is divided by de Casteljau until its control points are within deflection from the chord,
+        // so the chord error is certainly within deflection and no curve evaluation is needed. It's scattered by the calling thread.
+        // The point budget, level and rescatter don't support it, and they raise an exception if it's enabled.
+        void EnableFlatnessScatter(bool bEnable_);
+
+        // Set the max segment length and the max turning angle (radian) of scatter nodes, zero means no constraint and is the default.
+        // The chord is divided until it's within deflection, no longer than the max segment length, and the angle between the
+        // tangents at its ends is within the max turning angle, which is close to the angle between consecutive segments.
+        // The constraints are checked in the same pass of deflection, but they are ignored by the point budget scatter.
+        void SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_);
+
+        // Set the token to interrupt the scatter of one spline, nullptr means no token and is the default. The token must be valid
+        // until the next call. It's checked every 64 steps of deflection, and the interrupted scatter outputs the nodes before,
+        // which are within deflection and cover the front part of spline. The batch, budget and level scatters aren't interrupted.
+        void SetScatterToken(const ScatterToken* pScatterToken_);
+
+        // Returns the value of scatter_status of the last scatter.
+        int GetScatterStatus() const;
+
+    private:
+        CNurbsScatter2D(const CNurbsScatter2D&) = delete;
+        CNurbsScatter2D& operator=(const CNurbsScatter2D&) = delete;
+
+        CNurbsScatterPointer* m_pScatterPointer;
+    };
+
+    /**
+     * The scatter iterator for two-dimensional nurbs node, which scatters on demand for real-time consumer.
+     * Every call of Next only scatters until next scatter node is finalized, the consumer needn't wait for the whole node.
+     */
+    class NEATSPLINE_API CNurbsScatterIterator2D final
+    {
+    public:
+        CNurbsScatterIterator2D();
+        ~CNurbsScatterIterator2D();
+
+        // Start to scatter nurbs node by given deflection, the nurbs node must be valid until all scatter nodes are got.
+        void Start(const NurbsNode2D* pNurbsNode_, double nDeflection_);
+
+        // Start to scatter compiled nurbs curve by given deflection, the curve must be valid until all scatter nodes are got.
+        void Start(const CNurbsCurve2D* pNurbsCurve_, double nDeflection_);
+
+        // Start to scatter bezier node by given deflection, the bezier node is converted and retained by iterator.
+        void Start(const BezierNode2D* pBezierNode_, double nDeflection_);
+
+        // Get next scatter node, the scatter nodes are the same as the output of std::vector<ScatterNode2D>, except that
+        // a long straight run is output in pieces of no more than 64 skipped nodes.
+        // Returns false if all scatter nodes are got.
+        bool Next(ScatterNode2D& ScatterNode_);
+
+    private:
+        CNurbsScatterIterator2D(const CNurbsScatterIterator2D&) = delete;
+        CNurbsScatterIterator2D& operator=(const CNurbsScatterIterator2D&) = delete;
+
+        CNurbsScatterPointer* m_pScatterPointer;
+    };
+
+    /**
+     * The reusable scatter for three-dimensional nurbs node.
+     * The internal buffers are retained across calls, scattering many nodes by one object doesn't allocate memory for every node.
+     */
+    class NEATSPLINE_API CNurbsScatter3D final
+    {
+    public:
+        CNurbsScatter3D();
+        ~CNurbsScatter3D();
+
+        // Scatter nurbs node by given deflection, and output the scatter points.
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_);
+
+        // Scatter nurbs node by given deflection, and output the scatter nodes.
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
+
+        // Scatter compiled nurbs curve by given deflection, and output the scatter points.
+        void ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, VECDPOINT3& vecScatterPoints_);
+
+        // Scatter compiled nurbs curve by given deflection, and output the scatter nodes.
+        void ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
+
+        // Scatter bezier node by given deflection, and output the scatter points.
+        void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, VECDPOINT3& vecScatterPoints_);
+
+        // Scatter bezier node by given deflection, and output the scatter nodes.
+        void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_);
+
+        // Scatter nurbs node by given deflection, and send the scatter nodes to ScatterSink_ one by one as soon as they are finalized.
+        // The scatter nodes are the same as the output of std::vector<ScatterNode3D>, but no buffer grows with the length of curve.
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, const ScatterSink3D& ScatterSink_);
+
+        // Scatter compiled nurbs curve by given deflection, and send the scatter nodes to ScatterSink_ one by one.
+        void ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, const ScatterSink3D& ScatterSink_);
+
+        // Scatter bezier node by given deflection, and send the scatter nodes to ScatterSink_ one by one.
+        void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, const ScatterSink3D& ScatterSink_);
+
+        // Scatter nurbs node by given deflection, and output the fields of scatter nodes selected by nFields_ of scatter_field.
+        // Only the selected fields are written, the second-order derivatives are not calculated unless they or the curvatures
+        // are selected. The points and knots of 3D curve take 4 doubles per node instead of 10 of ScatterNode3D.
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_);
+
+        // Scatter compiled nurbs curve by given deflection, and output the selected fields of scatter nodes.
+        void ScatterNurbs(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_);
+
+        // Scatter bezier node by given deflection, and output the selected fields of scatter nodes.
+        void ScatterBezier(const BezierNode3D* pBezierNode_, double nDeflection_, int nFields_, ScatterArrays3D& ScatterArrays_);
+
+        // Scatter nurbs nodes by given deflection, and output the scatter points of all nurbs nodes in order.
+        // The scatter points of pNurbsNodes_[i] are from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, double nDeflection_, VECDPOINT3& vecScatterPoints_,
+            std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs nodes by given deflection, and output the scatter nodes of all nurbs nodes in order.
+        // The scatter nodes of pNurbsNodes_[i] are from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, double nDeflection_, std::vector<ScatterNode3D>& vecScatterNodes_,
+            std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs nodes by the point budget, and output the scatter points of all nurbs nodes in order.
+        // The segment with the largest estimated chord error of all nurbs nodes is divided first, until the count of scatter points
+        // reaches nPointBudget_ or the chord errors are within deflection, so the best points of given count are got for preview.
+        // The knot intervals of nurbs nodes are not divided less, which may need more points than the budget. It's scattered by
+        // the calling thread, and the flatness scatter isn't supported, which raises an exception if it's enabled.
+        // The scatter points of pNurbsNodes_[i] are from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            VECDPOINT3& vecScatterPoints_, std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs nodes by the point budget like above, and output the scatter nodes of all nurbs nodes in order.
+        void ScatterNurbs(const NurbsNode3D* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            std::vector<ScatterNode3D>& vecScatterNodes_, std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs node by several deflections in descending order in one pass, and output the nested levels of scatter points.
+        // Level i is scattered by vecDeflections_[i], and vecLevels_[j] is the first level containing point j, so the points of
+        // level i are the points whose levels are no more than i in the same order, and the coarse levels are subsets of the fine
+        // levels. The chord is divided in half instead of quasi uniform, and the collinear points of every level are combined
+        // from the coarsest level, whose combined points first appear at the next level. It's scattered by the calling thread,
+        // and the flatness scatter isn't supported, which raises an exception if it's enabled.
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, const VECDOUBLE& vecDeflections_, VECDPOINT3& vecScatterPoints_,
+            std::vector<int>& vecLevels_);
+
+        // Scatter nurbs node by several deflections like above, and output the nested levels of scatter nodes.
+        void ScatterNurbs(const NurbsNode3D* pNurbsNode_, const VECDOUBLE& vecDeflections_, std::vector<ScatterNode3D>& vecScatterNodes_,
+            std::vector<int>& vecLevels_);
+
+        // Scatter nurbs node again after its poles or weights of given indexes are modified, and the knots and degree are not.
+        // vecScatterNodes_ is the scatter nodes of nurbs node before modification by the same deflection, only the knot intervals
+        // affected by the modified poles are scattered again, and the scatter nodes in them are replaced by the new ones.
+        // The intervals are scattered by quasi uniform deflection of the calling thread, and the previous nodes are kept if it's
+        // interrupted by the scatter token. The flatness scatter isn't supported, which raises an exception if it's enabled.
+        void RescatterNurbs(const NurbsNode3D* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+            std::vector<ScatterNode3D>& vecScatterNodes_);
+
+        // Set the number of threads which scatter the knot intervals of one nurbs node or the nurbs nodes of batch,
+        // the default is one thread. The scatter result is the same for any number of threads.
+        void SetThreadCount(int nThreadCount_);
+
+        // Set the ratio of deflection which is used to simplify the scatter nodes, and the rest ratio is used to scatter.
+        // The chord skips the nodes within the simplify tolerance from it, and the chord error is still within deflection.
+        // A larger ratio scatters more densely and then simplifies to fewer nodes, such as 0.9 for the fewest NC blocks.
+        // The ratio must be in [0, 1), the default 0 only combines the collinear nodes.
+        void SetSimplifyRatio(double nSimplifyRatio_);
+
+        // Enable to scatter the bezier spans of nurbs node by control polygon flatness, the default is disabled.
+        // Every bezier span is divided by de Casteljau until its control points are within deflection from the chord,
+        // so the chord error is certainly within deflection and no curve evaluation is needed. It's scattered by the calling thread.
+        // The point budget, level and rescatter don't support it, and they raise an exception if it's enabled.
+        void EnableFlatnessScatter(bool bEnable_);
+
+        // Set the max segment length and the max turning angle (radian) of scatter nodes, zero means no constraint and is the default.
+        // The chord is divided until it's within deflection, no longer than the max segment length, and the angle between the
+        // tangents at its ends is within the max turning angle, which is close to the angle between consecutive segments.
+        // The constraints are checked in the same pass of deflection, but they are ignored by the point budget scatter.
+        void SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_);
+
+        // Set the token to interrupt the scatter of one spline, nullptr means no token and is the default. The token must be valid
+        // until the next call. It's checked every 64 steps of deflection, and the interrupted scatter outputs the nodes before,
+        // which are within deflection and cover the front part of spline. The batch, budget and level scatters aren't interrupted.
+        void SetScatterToken(const ScatterToken* pScatterToken_);
+
+        // Returns the value of scatter_status of the last scatter.
+        int GetScatterStatus() const;
+
+    private:
+        CNurbsScatter3D(const CNurbsScatter3D&) = delete;
+        CNurbsScatter3D& operator=(const CNurbsScatter3D&) = delete;
+
+        CNurbsScatterPointer* m_pScatterPointer;
+    };
+
+    /**
+     * The scatter iterator for three-dimensional nurbs node, which scatters on demand for real-time consumer.
+     * Every call of Next only scatters until next scatter node is finalized, the consumer needn't wait for the whole node.
+     */
+    class NEATSPLINE_API CNurbsScatterIterator3D final
+    {
+    public:
+        CNurbsScatterIterator3D();
+        ~CNurbsScatterIterator3D();
+
+        // Start to scatter nurbs node by given deflection, the nurbs node must be valid until all scatter nodes are got.
+        void Start(const NurbsNode3D* pNurbsNode_, double nDeflection_);
+
+        // Start to scatter compiled nurbs curve by given deflection, the curve must be valid until all scatter nodes are got.
+        void Start(const CNurbsCurve3D* pNurbsCurve_, double nDeflection_);
+
+        // Start to scatter bezier node by given deflection, the bezier node is converted and retained by iterator.
+        void Start(const BezierNode3D* pBezierNode_, double nDeflection_);
+
+        // Get next scatter node, the scatter nodes are the same as the output of std::vector<ScatterNode3D>, except that
+        // a long straight run is output in pieces of no more than 64 skipped nodes.
+        // Returns false if all scatter nodes are got.
+        bool Next(ScatterNode3D& ScatterNode_);
+
+    private:
+        CNurbsScatterIterator3D(const CNurbsScatterIterator3D&) = delete;
+        CNurbsScatterIterator3D& operator=(const CNurbsScatterIterator3D&) = delete;
+
+        CNurbsScatterPointer* m_pScatterPointer;
+    };
+
+    /**
+     * The reusable scatter for multi-axis nurbs node whose dimension N is 4, 5 or 6, such as the position and tool orientation
+     * of N-axis machining. The position axes are scattered by the deflection without combining collinear nodes, and then the
+     * knot intervals are divided in half until the other axes are within the orientation deflection from the chord, which is
+     * bounded by the second-order derivative of non-rational node and only checked at the middle and quarter knots of rational node.
+     */
+    template<int N>
+    class CNurbsScatterND final
+    {
+    public:
+        CNurbsScatterND();
+        ~CNurbsScatterND();
+
+        // Set the two or three different axes of position on which the deflection is measured, the default is x, y and z.
+        void SetDeflectionAxes(const std::vector<int>& vecAxes_);
+
+        // Set the deflection of the other axes than position, which is in the unit of these axes such as the angle.
+        // Zero means the same as the deflection of position, which is the default.
+        void SetOrientationDeflection(double nOrientationDeflection_);
+
+        // Scatter nurbs node by given deflection on all axes, and output the scatter points of all axes.
+        // The poles of one-degree nurbs node are output directly.
+        void ScatterNurbs(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_,
+            std::vector<CAxisPoint<double, N>>& vecScatterPoints_);
+
+        // Scatter nurbs node by given deflection on all axes, and output the scatter nodes of all axes.
+        void ScatterNurbs(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_,
+            std::vector<ScatterNode<CAxisPoint<double, N>>>& vecScatterNodes_);
+
+        // Set the number of threads which scatter the knot intervals of nurbs node, the default is one thread.
+        void SetThreadCount(int nThreadCount_);
+
+    private:
+        CNurbsScatterND(const CNurbsScatterND&) = delete;
+        CNurbsScatterND& operator=(const CNurbsScatterND&) = delete;
+
+        CNurbsAxisScatter<N>* m_pAxisScatter;
+    };
+
+    // The instances are exported by the explicit instantiations of library, and imported by the clients.
+#ifndef NEATSPLINE_EXPORTS
+    extern template class NEATSPLINE_API CNurbsScatterND<4>;
+    extern template class NEATSPLINE_API CNurbsScatterND<5>;
+    extern template class NEATSPLINE_API CNurbsScatterND<6>;
+#endif
+    typedef CNurbsScatterND<4> CNurbsScatter4D;
+    typedef CNurbsScatterND<5> CNurbsScatter5D;
+    typedef CNurbsScatterND<6> CNurbsScatter6D;
+
 } // End namespace neat
 
 #endif // __NEAT_SCATTER_H_20200130__
\ No newline at end of file
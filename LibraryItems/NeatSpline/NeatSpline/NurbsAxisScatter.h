@@ -0,0 +1,392 @@
+/***************************************************************************************************
+ Created on: 2020-03-20
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __NURBS_AXIS_SCATTER_H_20200320__
+#define __NURBS_AXIS_SCATTER_H_20200320__
+
+/**
+ * This file defines the scatter for multi-axis nurbs node.
+ */
+namespace neat
+{
+    /**
+     * The scatter for multi-axis nurbs node, whose dimension N is 4, 5 or 6. The nurbs node projected on the deflection
+     * axes is scattered without combining collinear nodes, and then the knot intervals are divided in half until the other
+     * axes are within the orientation deflection from the chord. It's bounded by the second-order derivative of non-rational
+     * node, but only sampled at the middle and quarter knots of rational node, which may miss a bump between the samples.
+     */
+    template<int N>
+    class CNurbsAxisScatter final
+    {
+    public:
+        CNurbsAxisScatter();
+
+        void SetDeflectionAxes(const std::vector<int>& vecAxes_);
+        void SetOrientationDeflection(double nOrientationDeflection_);
+        void ScatterNurbs(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_,
+            std::vector<CAxisPoint<double, N>>& vecScatterPoints_);
+        void ScatterNurbs(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_,
+            std::vector<ScatterNode<CAxisPoint<double, N>>>& vecScatterNodes_);
+        void SetThreadCount(int nThreadCount_);
+
+    private:
+        CNurbsAxisScatter(const CNurbsAxisScatter&) = delete;
+        CNurbsAxisScatter& operator=(const CNurbsAxisScatter&) = delete;
+
+        // Scatter the nurbs node projected on deflection axes,
+        // and then divide the knots of scatter nodes by the other axes.
+        // The projected node has the same weights and knots, so it's exactly the projection of the multi-axis curve.
+        // The collinear projected nodes are not combined, because the other axes may not be linear between them,
+        // and only the repeated knots of adjacent knot intervals are skipped.
+        void ScatterKnots(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_);
+
+        // Bound the second-order derivative on the other axes of every knot span of non-rational nurbs node to m_vecSpanBounds,
+        // which is cleared for rational nurbs node.
+        void BoundSpanDeriv2s(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_);
+
+        // Divide the knot intervals in half until the other axes are within deflection from the chord,
+        // and collect the knots to m_vecKnots and the points of all axes to m_vecPoints.
+        // The chord error of non-rational node is within (h^2 / 8) * max|C''| of the knot interval h, so it's certainly
+        // within deflection. The rational node is only checked at the middle and quarter knots.
+        void DivideKnots(double nDeflection_);
+
+        // Returns the square distance from the point to the chord on the other axes than deflection axes.
+        double GetSquareOrientationDistance(const CAxisPoint<double, N>& ptPoint_, const CAxisPoint<double, N>& ptStart_,
+            const CAxisPoint<double, N>& ptEnd_) const;
+
+        // The knot and point of the end node of the knot interval which is not divided yet.
+        struct AxisNode
+        {
+            double nKnot;
+            CAxisPoint<double, N> ptPoint;
+        };
+
+        std::vector<int> m_vecDeflectionAxes;
+        std::vector<int> m_vecOrientationAxes;
+        double m_nOrientationDeflection;
+        CNurbsScatter<DPOINT2, DPOINT3> m_Scatter2D;
+        CNurbsScatter<DPOINT3, DPOINT4> m_Scatter3D;
+        CNurbsParser<CAxisPoint<double, N>> m_Parser;
+        const NurbsNode<CAxisPoint<double, N>>* m_pNurbsNode;
+
+        // The projected nurbs node and its scatter nodes, whose capacities are reused by next nurbs node.
+        NurbsNode2D m_NurbsNode2D;
+        NurbsNode3D m_NurbsNode3D;
+        std::vector<ScatterNode2D> m_vecScatterNodes2D;
+        std::vector<ScatterNode3D> m_vecScatterNodes3D;
+        VECDOUBLE m_vecKnots;
+        std::vector<CAxisPoint<double, N>> m_vecPoints;
+        std::vector<CAxisPoint<double, N>> m_vecDeriv1s;
+        std::vector<CAxisPoint<double, N>> m_vecDeriv2s;
+        VECDOUBLE m_vecDividedKnots;
+        std::vector<CAxisPoint<double, N>> m_vecDividedPoints;
+        std::vector<AxisNode> m_vecEndNodes;
+        VECDOUBLE m_vecSpanBounds;
+    };
+
+    /**
+     * The implementation of template class.
+     */
+    template<int N>
+    CNurbsAxisScatter<N>::CNurbsAxisScatter()
+        : m_nOrientationDeflection(0.0)
+        , m_pNurbsNode(nullptr)
+    {
+        m_Scatter2D.EnableCollinearCombine(false);
+        m_Scatter3D.EnableCollinearCombine(false);
+        SetDeflectionAxes({ axis::x, axis::y, axis::z });
+    }
+
+    template<int N>
+    void CNurbsAxisScatter<N>::SetDeflectionAxes(const std::vector<int>& vecAxes_)
+    {
+        NEAT_RAISE(vecAxes_.size() != 2 && vecAxes_.size() != 3, g_strWrongDeflectionAxes);
+        for (size_t i = 0; i < vecAxes_.size(); ++i) {
+            NEAT_RAISE(vecAxes_[i] < 0 || vecAxes_[i] >= N, g_strWrongDeflectionAxes);
+            for (size_t j = 0; j < i; ++j) {
+                NEAT_RAISE(vecAxes_[j] == vecAxes_[i], g_strWrongDeflectionAxes);
+            }
+        }
+
+        m_vecDeflectionAxes = vecAxes_;
+        m_vecOrientationAxes.clear();
+        for (int i = 0; i < N; ++i) {
+            bool _bDeflectionAxis = false;
+            for (int _nAxis : vecAxes_) {
+                _bDeflectionAxis = _bDeflectionAxis || _nAxis == i;
+            }
+
+            if (!_bDeflectionAxis) {
+                m_vecOrientationAxes.push_back(i);
+            }
+        }
+    }
+
+    template<int N>
+    void CNurbsAxisScatter<N>::SetOrientationDeflection(double nOrientationDeflection_)
+    {
+        NEAT_RAISE(nOrientationDeflection_ < 0.0, g_strWrongDeflection);
+        m_nOrientationDeflection = nOrientationDeflection_;
+    }
+
+    template<int N>
+    void CNurbsAxisScatter<N>::ScatterNurbs(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_,
+        std::vector<CAxisPoint<double, N>>& vecScatterPoints_)
+    {
+        ScatterKnots(pNurbsNode_, nDeflection_);
+        if (pNurbsNode_->nDegree == 1) {
+            // the pole at the repeated knot is skipped except the last one, which is the point at the knot
+            const VECDOUBLE& _vecKnots = pNurbsNode_->vecKnots;
+            vecScatterPoints_.clear();
+            for (size_t i = 0, _nSize = pNurbsNode_->vecPoles.size(); i < _nSize; ++i) {
+                if (i + 1 == _nSize || _vecKnots[i + 2] > _vecKnots[i + 1]) {
+                    vecScatterPoints_.push_back(pNurbsNode_->vecPoles[i]);
+                }
+            }
+            return;
+        }
+
+        vecScatterPoints_ = m_vecPoints;
+    }
+
+    template<int N>
+    void CNurbsAxisScatter<N>::ScatterNurbs(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_,
+        std::vector<ScatterNode<CAxisPoint<double, N>>>& vecScatterNodes_)
+    {
+        ScatterKnots(pNurbsNode_, nDeflection_);
+
+        const size_t _nCount = m_vecKnots.size();
+        m_vecPoints.resize(_nCount);
+        m_vecDeriv1s.resize(_nCount);
+        m_vecDeriv2s.resize(_nCount);
+        if (pNurbsNode_->nDegree == 1) {
+            // the second-order derivatives of rational one-degree nurbs node aren't zero
+            CAxisPoint<double, N> _ptxDerivs[3];
+            for (size_t i = 0; i < _nCount; ++i) {
+                m_Parser.GetNurbsDeriv(m_vecKnots[i], 2, _ptxDerivs);
+                m_vecPoints[i] = _ptxDerivs[0];
+                m_vecDeriv1s[i] = _ptxDerivs[1];
+                m_vecDeriv2s[i] = _ptxDerivs[2];
+            }
+        }
+        else {
+            m_Parser.GetNurbsDerivs(m_vecKnots.data(), _nCount, m_vecPoints.data(),
+                m_vecDeriv1s.data(), m_vecDeriv2s.data());
+        }
+
+        vecScatterNodes_.resize(_nCount);
+        for (size_t i = 0; i < _nCount; ++i) {
+            ScatterNode<CAxisPoint<double, N>>& _ScatterNode = vecScatterNodes_[i];
+            _ScatterNode.ptPoint = m_vecPoints[i];
+            _ScatterNode.ptDeriv1 = m_vecDeriv1s[i];
+            _ScatterNode.ptDeriv2 = m_vecDeriv2s[i];
+            _ScatterNode.nKnot = m_vecKnots[i];
+        }
+    }
+
+    template<int N>
+    void CNurbsAxisScatter<N>::SetThreadCount(int nThreadCount_)
+    {
+        m_Scatter2D.SetThreadCount(nThreadCount_);
+        m_Scatter3D.SetThreadCount(nThreadCount_);
+    }
+
+    template<int N>
+    void CNurbsAxisScatter<N>::ScatterKnots(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_, double nDeflection_)
+    {
+        NEAT_RAISE(pNurbsNode_ == nullptr, g_strEmptyPointer);
+        m_Parser.SetNurbsNode(pNurbsNode_);
+        m_pNurbsNode = pNurbsNode_;
+
+        // the poles of one-degree nurbs node are at the knots of valid range, and the repeated knots are skipped
+        m_vecKnots.clear();
+        if (pNurbsNode_->nDegree == 1) {
+            for (size_t i = 1, _nSize = pNurbsNode_->vecKnots.size() - 1; i < _nSize; ++i) {
+                if (m_vecKnots.empty() || pNurbsNode_->vecKnots[i] > m_vecKnots.back()) {
+                    m_vecKnots.push_back(pNurbsNode_->vecKnots[i]);
+                }
+            }
+            return;
+        }
+
+        const size_t _nPoleCount = pNurbsNode_->vecPoles.size();
+        if (m_vecDeflectionAxes.size() == 2) {
+            m_NurbsNode2D.vecPoles.resize(_nPoleCount);
+            for (size_t i = 0; i < _nPoleCount; ++i) {
+                m_NurbsNode2D.vecPoles[i][axis::x] = pNurbsNode_->vecPoles[i][m_vecDeflectionAxes[0]];
+                m_NurbsNode2D.vecPoles[i][axis::y] = pNurbsNode_->vecPoles[i][m_vecDeflectionAxes[1]];
+            }
+
+            m_NurbsNode2D.vecWeights = pNurbsNode_->vecWeights;
+            m_NurbsNode2D.vecKnots = pNurbsNode_->vecKnots;
+            m_NurbsNode2D.nDegree = pNurbsNode_->nDegree;
+            m_Scatter2D.ScatterNurbs(&m_NurbsNode2D, nDeflection_, m_vecScatterNodes2D);
+            for (const ScatterNode2D& _ScatterNode : m_vecScatterNodes2D) {
+                if (m_vecKnots.empty() || _ScatterNode.nKnot > m_vecKnots.back()) {
+                    m_vecKnots.push_back(_ScatterNode.nKnot);
+                }
+            }
+        }
+        else {
+            m_NurbsNode3D.vecPoles.resize(_nPoleCount);
+            for (size_t i = 0; i < _nPoleCount; ++i) {
+                m_NurbsNode3D.vecPoles[i][axis::x] = pNurbsNode_->vecPoles[i][m_vecDeflectionAxes[0]];
+                m_NurbsNode3D.vecPoles[i][axis::y] = pNurbsNode_->vecPoles[i][m_vecDeflectionAxes[1]];
+                m_NurbsNode3D.vecPoles[i][axis::z] = pNurbsNode_->vecPoles[i][m_vecDeflectionAxes[2]];
+            }
+
+            m_NurbsNode3D.vecWeights = pNurbsNode_->vecWeights;
+            m_NurbsNode3D.vecKnots = pNurbsNode_->vecKnots;
+            m_NurbsNode3D.nDegree = pNurbsNode_->nDegree;
+            m_Scatter3D.ScatterNurbs(&m_NurbsNode3D, nDeflection_, m_vecScatterNodes3D);
+            for (const ScatterNode3D& _ScatterNode : m_vecScatterNodes3D) {
+                if (m_vecKnots.empty() || _ScatterNode.nKnot > m_vecKnots.back()) {
+                    m_vecKnots.push_back(_ScatterNode.nKnot);
+                }
+            }
+        }
+
+        BoundSpanDeriv2s(pNurbsNode_);
+        DivideKnots(m_nOrientationDeflection > 0.0 ? m_nOrientationDeflection : nDeflection_);
+    }
+
+    template<int N>
+    void CNurbsAxisScatter<N>::BoundSpanDeriv2s(const NurbsNode<CAxisPoint<double, N>>* pNurbsNode_)
+    {
+        m_vecSpanBounds.clear();
+        if (CheckNurbsNodeRational(pNurbsNode_)) {
+            return;
+        }
+
+        // The second-order derivative is a nurbs of degree p - 2, whose poles are the second differences
+        //   R(i) = (p - 1) * (Q(i + 1) - Q(i)) / (U(i + p + 1) - U(i + 2)), Q(i) = p * (P(i + 1) - P(i)) / (U(i + p + 1) - U(i + 1))
+        // and it's within the longest poles R(k - p) ... R(k - 2) on the knot span [U(k), U(k + 1)), see "The NURBS Book" 3.3.
+        const VECDOUBLE& _vecKnots = pNurbsNode_->vecKnots;
+        const std::vector<CAxisPoint<double, N>>& _vecPoles = pNurbsNode_->vecPoles;
+        const int _nDegree = pNurbsNode_->nDegree;
+        m_vecSpanBounds.assign(_vecKnots.size(), 0.0);
+        for (int i = 0, _nCount = static_cast<int>(_vecPoles.size()) - 2; i < _nCount; ++i) {
+            double _nSpan = _vecKnots[i + _nDegree + 1] - _vecKnots[i + 2];
+            if (_nSpan <= 0.0) {
+                continue;
+            }
+
+            double _nScale0 = _nDegree / (_vecKnots[i + _nDegree + 1] - _vecKnots[i + 1]);
+            double _nScale1 = _nDegree / (_vecKnots[i + _nDegree + 2] - _vecKnots[i + 2]);
+            double _nSquareLength = 0.0;
+            for (int _nAxis : m_vecOrientationAxes) {
+                double _nDeriv2 = (_nDegree - 1) / _nSpan * ((_vecPoles[i + 2][_nAxis] - _vecPoles[i + 1][_nAxis]) * _nScale1
+                    - (_vecPoles[i + 1][_nAxis] - _vecPoles[i][_nAxis]) * _nScale0);
+                _nSquareLength += _nDeriv2 * _nDeriv2;
+            }
+
+            double _nLength = sqrt(_nSquareLength);
+            for (int k = i + 2; k <= i + _nDegree; ++k) {
+                m_vecSpanBounds[k] = max(m_vecSpanBounds[k], _nLength);
+            }
+        }
+    }
+
+    template<int N>
+    void CNurbsAxisScatter<N>::DivideKnots(double nDeflection_)
+    {
+        m_vecPoints.resize(m_vecKnots.size());
+        m_Parser.GetNurbsPoints(m_vecKnots.data(), m_vecKnots.size(), m_vecPoints.data());
+
+        m_vecDividedKnots.clear();
+        m_vecDividedPoints.clear();
+        m_vecDividedKnots.push_back(m_vecKnots.front());
+        m_vecDividedPoints.push_back(m_vecPoints.front());
+        const double _nSquareDeflection = nDeflection_ * nDeflection_;
+        CAxisPoint<double, N> _ptQuarter;
+        AxisNode _MiddleNode;
+        for (size_t i = 1, _nSize = m_vecKnots.size(); i < _nSize; ++i) {
+            m_vecEndNodes.clear();
+            m_vecEndNodes.push_back(AxisNode{ m_vecKnots[i], m_vecPoints[i] });
+            while (!m_vecEndNodes.empty()) {
+                const double _nStartKnot = m_vecDividedKnots.back();
+                const CAxisPoint<double, N>& _ptStart = m_vecDividedPoints.back();
+                const AxisNode& _EndNode = m_vecEndNodes.back();
+
+                // the interval is divided at the middle knot if the bound of non-rational node exceeds,
+                // or any one of the middle and quarter points of rational node exceeds
+                _MiddleNode.nKnot = 0.5 * (_nStartKnot + _EndNode.nKnot);
+                bool _bExceeded = false;
+                if (_MiddleNode.nKnot > _nStartKnot && _MiddleNode.nKnot < _EndNode.nKnot) {
+                    if (!m_vecSpanBounds.empty()) {
+                        // the spans of the interval are from the last knot no more than the start knot
+                        const VECDOUBLE& _vecKnots = m_pNurbsNode->vecKnots;
+                        size_t k = std::upper_bound(_vecKnots.begin(), _vecKnots.end(), _nStartKnot) - _vecKnots.begin() - 1;
+                        double _nBound = 0.0;
+                        for (; k < m_vecSpanBounds.size() && _vecKnots[k] < _EndNode.nKnot; ++k) {
+                            _nBound = max(_nBound, m_vecSpanBounds[k]);
+                        }
+
+                        double _nLength = _EndNode.nKnot - _nStartKnot;
+                        _bExceeded = 0.125 * _nLength * _nLength * _nBound > nDeflection_;
+                        if (_bExceeded) {
+                            m_Parser.GetNurbsPoint(_MiddleNode.nKnot, _MiddleNode.ptPoint);
+                        }
+                    }
+                    else {
+                        m_Parser.GetNurbsPoint(_MiddleNode.nKnot, _MiddleNode.ptPoint);
+                        _bExceeded = GetSquareOrientationDistance(_MiddleNode.ptPoint, _ptStart, _EndNode.ptPoint)
+                            > _nSquareDeflection;
+                        for (int j = 0; j < 2 && !_bExceeded; ++j) {
+                            double _nQuarterKnot = 0.5 * (_MiddleNode.nKnot + (j == 0 ? _nStartKnot : _EndNode.nKnot));
+                            m_Parser.GetNurbsPoint(_nQuarterKnot, _ptQuarter);
+                            _bExceeded = GetSquareOrientationDistance(_ptQuarter, _ptStart, _EndNode.ptPoint)
+                                > _nSquareDeflection;
+                        }
+                    }
+                }
+
+                if (_bExceeded) {
+                    m_vecEndNodes.push_back(_MiddleNode);
+                    continue;
+                }
+
+                m_vecDividedKnots.push_back(_EndNode.nKnot);
+                m_vecDividedPoints.push_back(_EndNode.ptPoint);
+                m_vecEndNodes.pop_back();
+            }
+        }
+
+        m_vecKnots.swap(m_vecDividedKnots);
+        m_vecPoints.swap(m_vecDividedPoints);
+    }
+
+    template<int N>
+    double CNurbsAxisScatter<N>::GetSquareOrientationDistance(const CAxisPoint<double, N>& ptPoint_,
+        const CAxisPoint<double, N>& ptStart_, const CAxisPoint<double, N>& ptEnd_) const
+    {
+        double _nSquareLength = 0.0;
+        double _nProjection = 0.0;
+        for (int _nAxis : m_vecOrientationAxes) {
+            double _nChord = ptEnd_[_nAxis] - ptStart_[_nAxis];
+            _nSquareLength += _nChord * _nChord;
+            _nProjection += (ptPoint_[_nAxis] - ptStart_[_nAxis]) * _nChord;
+        }
+
+        double _nRatio = _nSquareLength > 0.0 ? min(max(_nProjection / _nSquareLength, 0.0), 1.0) : 0.0;
+        double _nSquareDistance = 0.0;
+        for (int _nAxis : m_vecOrientationAxes) {
+            double _nDistance = ptPoint_[_nAxis] - ptStart_[_nAxis] - (ptEnd_[_nAxis] - ptStart_[_nAxis]) * _nRatio;
+            _nSquareDistance += _nDistance * _nDistance;
+        }
+
+        return _nSquareDistance;
+    }
+
+} // End namespace neat
+
+#endif // __NURBS_AXIS_SCATTER_H_20200320__
\ No newline at end of file
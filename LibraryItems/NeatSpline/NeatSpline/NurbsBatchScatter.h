@@ -0,0 +1,359 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __NURBS_BATCH_SCATTER_H_20200302__
+#define __NURBS_BATCH_SCATTER_H_20200302__
+
+#include <atomic>
+#include <mutex>
+
+/**
+ * This file defines the batch scatter for nurbs nodes.
+ */
+namespace neat
+{
+    /**
+     * The batch scatter scatters nurbs nodes by several work stealing threads.
+     * Every thread owns a range of nurbs nodes, scatters them from the front of range, and steals the back half
+     * of the range of other thread when its range is empty. So the threads are busy even if the nurbs nodes are
+     * wildly different sizes.
+     */
+    template<typename TYPE, typename TYPEEX>
+    class CNurbsBatchScatter
+    {
+    public:
+        CNurbsBatchScatter();
+        ~CNurbsBatchScatter();
+
+        // Set the number of threads which scatter the nurbs nodes.
+        void SetThreadCount(int nThreadCount_);
+
+        // Set the thread pool which is shared with other scatters, or nullptr to use the own thread pool.
+        void SetThreadPool(CScatterThreadPool* pThreadPool_);
+
+        // Set the ratio of deflection which is used to simplify the scatter nodes of every nurbs node.
+        void SetSimplifyRatio(double nSimplifyRatio_);
+
+        // Enable to scatter the bezier spans of every nurbs node by control polygon flatness.
+        void EnableFlatnessScatter(bool bEnable_);
+
+        // Set the max segment length and the max turning angle of scatter nodes of every nurbs node.
+        void SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_);
+
+        // Scatter nurbs nodes by given deflection, and output the scatter points of all nurbs nodes in order.
+        // The scatter points of nurbs node i are from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, double nDeflection_,
+            std::vector<TYPE>& vecScatterPoints_, std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs nodes by given deflection, and output the scatter nodes of all nurbs nodes in order.
+        // The scatter nodes of nurbs node i are from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, double nDeflection_,
+            std::vector<ScatterNode<TYPE>>& vecScatterNodes_, std::vector<size_t>& vecOffsets_);
+
+    private:
+        CNurbsBatchScatter(const CNurbsBatchScatter&) = delete;
+        CNurbsBatchScatter& operator=(const CNurbsBatchScatter&) = delete;
+
+        /**
+         * The scatter thread, whose buffers are retained for next batch.
+         */
+        struct ScatterWorker
+        {
+            CNurbsScatter<TYPE, TYPEEX> NurbsScatter;
+
+            // The output of current nurbs node and all nurbs nodes scattered by this thread.
+            std::vector<TYPE> vecScatterPoints;
+            std::vector<TYPE> vecWorkerPoints;
+            std::vector<ScatterNode<TYPE>> vecScatterNodes;
+            std::vector<ScatterNode<TYPE>> vecWorkerNodes;
+
+            // The nurbs nodes from nStartIndex to nEndIndex (not included) are not scattered.
+            std::mutex RangeMutex;
+            size_t nStartIndex = 0;
+            size_t nEndIndex = 0;
+
+            std::exception_ptr pException;
+        };
+
+        template<typename OUTPUT>
+        void ScatterBatch(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, double nDeflection_,
+            std::vector<OUTPUT>& vecOutputs_, std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs nodes in the thread until all nurbs nodes are scattered.
+        template<typename OUTPUT>
+        void ScatterWorkerNodes(int nWorkerIndex_);
+
+        // Copy the output of nurbs nodes from nStartIndex_ to nEndIndex_ (not included) to the batch output.
+        template<typename OUTPUT>
+        void CopyWorkerOutputs(size_t nStartIndex_, size_t nEndIndex_, std::vector<OUTPUT>& vecOutputs_,
+            const std::vector<size_t>& vecOffsets_);
+
+        // Get the next nurbs node from the range of the thread, or steal from other threads.
+        bool PopNurbsNode(int nWorkerIndex_, size_t& nNodeIndex_);
+
+        // Returns the output buffers of worker for the type of output.
+        void GetWorkerOutputs(ScatterWorker* pWorker_, std::vector<TYPE>*& pvecScatterOutputs_, std::vector<TYPE>*& pvecWorkerOutputs_);
+        void GetWorkerOutputs(ScatterWorker* pWorker_, std::vector<ScatterNode<TYPE>>*& pvecScatterOutputs_,
+            std::vector<ScatterNode<TYPE>>*& pvecWorkerOutputs_);
+
+    private:
+        int m_nThreadCount;
+        int m_nWorkerCount;
+        CScatterThreadPool m_ThreadPool;
+        CScatterThreadPool* m_pThreadPool;
+        double m_nSimplifyRatio;
+        bool m_bFlatnessScatter;
+        double m_nMaxSegmentLength;
+        double m_nMaxTurningAngle;
+        std::vector<ScatterWorker*> m_vecWorkers;
+
+        // The batch being scattered.
+        const NurbsNode<TYPE>* m_pNurbsNodes;
+        double m_nDeflection;
+        std::atomic<bool> m_bCancel;
+
+        // The worker, the start index in the output of worker and the output size of every nurbs node.
+        std::vector<int> m_vecNodeWorkers;
+        std::vector<size_t> m_vecNodeStarts;
+        std::vector<size_t> m_vecNodeCounts;
+    };
+
+    /**
+     * The implementation of template class.
+     */
+    template<typename TYPE, typename TYPEEX>
+    CNurbsBatchScatter<TYPE, TYPEEX>::CNurbsBatchScatter()
+        : m_nThreadCount(1)
+        , m_nWorkerCount(0)
+        , m_pThreadPool(&m_ThreadPool)
+        , m_nSimplifyRatio(0.0)
+        , m_bFlatnessScatter(false)
+        , m_nMaxSegmentLength(0.0)
+        , m_nMaxTurningAngle(0.0)
+        , m_pNurbsNodes(nullptr)
+        , m_nDeflection(0.0)
+        , m_bCancel(false)
+    {
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    CNurbsBatchScatter<TYPE, TYPEEX>::~CNurbsBatchScatter()
+    {
+        for (auto _pWorker : m_vecWorkers) {
+            delete _pWorker;
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::SetThreadCount(int nThreadCount_)
+    {
+        NEAT_RAISE(nThreadCount_ < 1, g_strWrongThreadCount);
+        m_nThreadCount = nThreadCount_;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::SetThreadPool(CScatterThreadPool* pThreadPool_)
+    {
+        m_pThreadPool = (pThreadPool_ != nullptr) ? pThreadPool_ : &m_ThreadPool;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::SetSimplifyRatio(double nSimplifyRatio_)
+    {
+        NEAT_RAISE(nSimplifyRatio_ < 0.0 || nSimplifyRatio_ >= 1.0, g_strWrongSimplifyRatio);
+        m_nSimplifyRatio = nSimplifyRatio_;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::EnableFlatnessScatter(bool bEnable_)
+    {
+        m_bFlatnessScatter = bEnable_;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_)
+    {
+        NEAT_RAISE(nMaxSegmentLength_ < 0.0 || nMaxTurningAngle_ < 0.0, g_strWrongSegmentConstraints);
+        m_nMaxSegmentLength = nMaxSegmentLength_;
+        m_nMaxTurningAngle = nMaxTurningAngle_;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, double nDeflection_,
+        std::vector<TYPE>& vecScatterPoints_, std::vector<size_t>& vecOffsets_)
+    {
+        ScatterBatch(pNurbsNodes_, nCount_, nDeflection_, vecScatterPoints_, vecOffsets_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, double nDeflection_,
+        std::vector<ScatterNode<TYPE>>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+    {
+        ScatterBatch(pNurbsNodes_, nCount_, nDeflection_, vecScatterNodes_, vecOffsets_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    template<typename OUTPUT>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::ScatterBatch(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, double nDeflection_,
+        std::vector<OUTPUT>& vecOutputs_, std::vector<size_t>& vecOffsets_)
+    {
+        NEAT_RAISE(pNurbsNodes_ == nullptr && nCount_ > 0, g_strEmptyPointer);
+
+        vecOutputs_.clear();
+        vecOffsets_.assign(nCount_ + 1, 0);
+        if (nCount_ == 0) {
+            return;
+        }
+
+        m_pNurbsNodes = pNurbsNodes_;
+        m_nDeflection = nDeflection_;
+        m_bCancel = false;
+        m_vecNodeWorkers.resize(nCount_);
+        m_vecNodeStarts.resize(nCount_);
+        m_vecNodeCounts.resize(nCount_);
+
+        // Every thread owns a continuous range of nurbs nodes at first.
+        m_nWorkerCount = static_cast<int>(min(static_cast<size_t>(m_nThreadCount), nCount_));
+        while (static_cast<int>(m_vecWorkers.size()) < m_nWorkerCount) {
+            m_vecWorkers.push_back(new ScatterWorker());
+        }
+
+        for (int i = 0; i < m_nWorkerCount; ++i) {
+            ScatterWorker* _pWorker = m_vecWorkers[i];
+            _pWorker->nStartIndex = nCount_ * i / m_nWorkerCount;
+            _pWorker->nEndIndex = nCount_ * (i + 1) / m_nWorkerCount;
+            _pWorker->vecWorkerPoints.clear();
+            _pWorker->vecWorkerNodes.clear();
+            _pWorker->pException = nullptr;
+            _pWorker->NurbsScatter.SetSimplifyRatio(m_nSimplifyRatio);
+            _pWorker->NurbsScatter.EnableFlatnessScatter(m_bFlatnessScatter);
+            _pWorker->NurbsScatter.SetSegmentConstraints(m_nMaxSegmentLength, m_nMaxTurningAngle);
+        }
+
+        // scatter nurbs nodes, the calling thread is the first thread
+        m_pThreadPool->RunTasks(m_nWorkerCount, [this](int nWorkerIndex_) { ScatterWorkerNodes<OUTPUT>(nWorkerIndex_); });
+
+        for (int i = 0; i < m_nWorkerCount; ++i) {
+            if (m_vecWorkers[i]->pException != nullptr) {
+                std::rethrow_exception(m_vecWorkers[i]->pException);
+            }
+        }
+
+        // the offset of every nurbs node in the batch output
+        for (size_t i = 0; i < nCount_; ++i) {
+            vecOffsets_[i + 1] = vecOffsets_[i] + m_vecNodeCounts[i];
+        }
+
+        // copy the output of threads to the batch output in order by the same threads
+        vecOutputs_.resize(vecOffsets_.back());
+        m_pThreadPool->RunTasks(m_nWorkerCount, [this, nCount_, &vecOutputs_, &vecOffsets_](int nWorkerIndex_) {
+            CopyWorkerOutputs(nCount_ * nWorkerIndex_ / m_nWorkerCount, nCount_ * (nWorkerIndex_ + 1) / m_nWorkerCount, vecOutputs_, vecOffsets_);
+        });
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    template<typename OUTPUT>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::ScatterWorkerNodes(int nWorkerIndex_)
+    {
+        ScatterWorker* _pWorker = m_vecWorkers[nWorkerIndex_];
+        std::vector<OUTPUT>* _pvecScatterOutputs = nullptr;
+        std::vector<OUTPUT>* _pvecWorkerOutputs = nullptr;
+        GetWorkerOutputs(_pWorker, _pvecScatterOutputs, _pvecWorkerOutputs);
+
+        try {
+            size_t _nNodeIndex = 0;
+            while (!m_bCancel && PopNurbsNode(nWorkerIndex_, _nNodeIndex)) {
+                _pWorker->NurbsScatter.ScatterNurbs(m_pNurbsNodes + _nNodeIndex, m_nDeflection, *_pvecScatterOutputs);
+                m_vecNodeWorkers[_nNodeIndex] = nWorkerIndex_;
+                m_vecNodeStarts[_nNodeIndex] = _pvecWorkerOutputs->size();
+                m_vecNodeCounts[_nNodeIndex] = _pvecScatterOutputs->size();
+                _pvecWorkerOutputs->insert(_pvecWorkerOutputs->end(), _pvecScatterOutputs->begin(), _pvecScatterOutputs->end());
+            }
+        }
+        catch (...) {
+            // stop other threads as soon as possible
+            _pWorker->pException = std::current_exception();
+            m_bCancel = true;
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    template<typename OUTPUT>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::CopyWorkerOutputs(size_t nStartIndex_, size_t nEndIndex_, std::vector<OUTPUT>& vecOutputs_,
+        const std::vector<size_t>& vecOffsets_)
+    {
+        for (size_t i = nStartIndex_; i < nEndIndex_; ++i) {
+            std::vector<OUTPUT>* _pvecScatterOutputs = nullptr;
+            std::vector<OUTPUT>* _pvecWorkerOutputs = nullptr;
+            GetWorkerOutputs(m_vecWorkers[m_vecNodeWorkers[i]], _pvecScatterOutputs, _pvecWorkerOutputs);
+
+            auto _itStart = _pvecWorkerOutputs->begin() + m_vecNodeStarts[i];
+            std::copy(_itStart, _itStart + m_vecNodeCounts[i], vecOutputs_.begin() + vecOffsets_[i]);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    bool CNurbsBatchScatter<TYPE, TYPEEX>::PopNurbsNode(int nWorkerIndex_, size_t& nNodeIndex_)
+    {
+        ScatterWorker* _pWorker = m_vecWorkers[nWorkerIndex_];
+        {
+            std::lock_guard<std::mutex> _Lock(_pWorker->RangeMutex);
+            if (_pWorker->nStartIndex < _pWorker->nEndIndex) {
+                nNodeIndex_ = _pWorker->nStartIndex++;
+                return true;
+            }
+        }
+
+        // steal the back half of the range of other thread
+        for (int i = 1; i < m_nWorkerCount; ++i) {
+            ScatterWorker* _pVictim = m_vecWorkers[(nWorkerIndex_ + i) % m_nWorkerCount];
+            size_t _nStartIndex = 0, _nEndIndex = 0;
+            {
+                std::lock_guard<std::mutex> _Lock(_pVictim->RangeMutex);
+                if (_pVictim->nStartIndex >= _pVictim->nEndIndex) {
+                    continue;
+                }
+
+                _nEndIndex = _pVictim->nEndIndex;
+                _nStartIndex = _pVictim->nStartIndex + (_pVictim->nEndIndex - _pVictim->nStartIndex) / 2;
+                _pVictim->nEndIndex = _nStartIndex;
+            }
+
+            std::lock_guard<std::mutex> _Lock(_pWorker->RangeMutex);
+            nNodeIndex_ = _nStartIndex;
+            _pWorker->nStartIndex = _nStartIndex + 1;
+            _pWorker->nEndIndex = _nEndIndex;
+            return true;
+        }
+
+        return false;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::GetWorkerOutputs(ScatterWorker* pWorker_, std::vector<TYPE>*& pvecScatterOutputs_,
+        std::vector<TYPE>*& pvecWorkerOutputs_)
+    {
+        pvecScatterOutputs_ = &pWorker_->vecScatterPoints;
+        pvecWorkerOutputs_ = &pWorker_->vecWorkerPoints;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsBatchScatter<TYPE, TYPEEX>::GetWorkerOutputs(ScatterWorker* pWorker_, std::vector<ScatterNode<TYPE>>*& pvecScatterOutputs_,
+        std::vector<ScatterNode<TYPE>>*& pvecWorkerOutputs_)
+    {
+        pvecScatterOutputs_ = &pWorker_->vecScatterNodes;
+        pvecWorkerOutputs_ = &pWorker_->vecWorkerNodes;
+    }
+
+} // End namespace neat
+
+#endif // __NURBS_BATCH_SCATTER_H_20200302__
\ No newline at end of file
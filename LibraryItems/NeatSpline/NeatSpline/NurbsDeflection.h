@@ -13,13 +13,24 @@
 #ifndef __NURBS_DEFLECTION_H_20200130__
 #define __NURBS_DEFLECTION_H_20200130__
 
-#include <list>
+#include <algorithm>
 
 /**
  * This file defines the deflection for Non-uniform rational B-spline curve.
  */
 namespace neat
 {
+    /**
+     * The knot interval of nurbs node which is scattered independently
+     */
+    template<typename TYPE>
+    struct ScatterInterval
+    {
+        const NurbsNode<TYPE>* pNurbsNode = nullptr;
+        double nStartKnot = 0.0;
+        double nEndKnot = 0.0;
+    };
+
     /**
      * The quasi uniform deflection for nurbs node
      */
@@ -33,24 +44,145 @@ namespace neat
         // If you only get the point coordinates, you don't need to calculate the second-order guide of the NURBS curve.
         void SetOnlyGetPoints(bool bOnlyGetPoints_) { m_bOnlyGetPoints = bOnlyGetPoints_; }
 
+        // Set the max length of chord and the max angle between the tangents at both ends of chord, zero means no constraint.
+        // The chord is accepted only if it satisfies the deflection and the constraints, but the budget scatter ignores them.
+        void SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_);
+
+        // Set the token to interrupt scattering the intervals, which is checked every 64 steps. The scatter nodes of interrupted
+        // scatter are within deflection and cover the front part of intervals, and the status is got by GetScatterStatus.
+        void SetScatterToken(const ScatterToken* pScatterToken_) { m_pScatterToken = pScatterToken_; }
+        int GetScatterStatus() const { return m_nScatterStatus; }
+
         // Scatter nurbs node by given deflection, and output the scatter nodes.
         void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_,
             CFastVector<ScatterNode<TYPE>>& vecScatterNodes_);
 
+        // Append the knot intervals of nurbs node to vecScatterIntervals_, the intervals are independent of each other.
+        void CollectIntervals(const NurbsNode<TYPE>* pNurbsNode_, CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_);
+
+        // Scatter the intervals from nStartIndex_ to nEndIndex_ (not included) by given deflection, and output the scatter nodes.
+        // The end node of every interval is replaced by the start node of next interval.
+        void ScatterIntervals(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_, int nStartIndex_, int nEndIndex_,
+            double nDeflection_, CFastVector<ScatterNode<TYPE>>& vecScatterNodes_);
+
+        // Scatter the intervals like above, but the finalized scatter nodes are sent to pScatterSink_ after every interval,
+        // only the last scatter node is retained in vecScatterNodes_.
+        void ScatterIntervals(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_, int nStartIndex_, int nEndIndex_,
+            double nDeflection_, CFastVector<ScatterNode<TYPE>>& vecScatterNodes_, const ScatterSink<TYPE>* pScatterSink_);
+
+        // Start to scatter the intervals step by step, every step appends no more than one scatter node to vecScatterNodes_,
+        // and the last scatter node may be replaced by next step. The intervals must be valid until all steps are done.
+        void StartIntervals(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_, int nStartIndex_, int nEndIndex_,
+            double nDeflection_, CFastVector<ScatterNode<TYPE>>& vecScatterNodes_);
+
+        // Scatter one step, which evaluates nurbs node no more than twice. Returns false if all intervals are scattered.
+        bool ScatterStep();
+
+        // Scatter the intervals by the point budget, the segment with the largest estimated chord error is divided in half first,
+        // until the count of scatter nodes reaches nPointBudget_ or the chord errors of all segments are within deflection.
+        // The count of scatter nodes is the count of intervals plus one at least, the shared end node of intervals is counted once.
+        // The scatter nodes of interval i are from vecIntervalOffsets_[i] to vecIntervalOffsets_[i + 1] (not included),
+        // which contain the start node and end node of interval.
+        void ScatterBudget(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_, size_t nPointBudget_, double nDeflection_,
+            CFastVector<ScatterNode<TYPE>>& vecScatterNodes_, CFastVector<int>& vecIntervalOffsets_);
+
+        // Scatter the intervals by several deflections in descending order in one pass, the chord is divided in half at the first
+        // level whose deflection or constraints it exceeds, so the scatter nodes of coarse level are a subset of fine level.
+        // vecNodeLevels_ is the first level of every scatter node, the end node of every interval is replaced by next interval.
+        void ScatterLevels(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_, const double* pDeflections_, int nLevelCount_,
+            CFastVector<ScatterNode<TYPE>>& vecScatterNodes_, CFastVector<int>& vecNodeLevels_);
+
     private:
         // Get scatter node with given knot.
         void GetScatterNode(double nKnot_, ScatterNode<TYPE>& ScatterNode_);
 
-        // Quasi uniform scatter nurbs node between the given scope.
-        void QuasiFlecheNurbs(double nDeflection_, double nStartKnot_, double nEndKnot_);
+        // Quasi uniform scatter nurbs node between the given scope, the first step evaluates the start and end nodes,
+        // and every next step judges the deflection of one chord.
+        void StartFlecheNurbs(double nStartKnot_, double nEndKnot_);
+        void StepFlecheNurbs();
+
+        // Estimate the square chord error between two scatter nodes by their tangents, or by the middle point if the tangents
+        // are parallel. The nurbs node of parser must be the one of scatter nodes.
+        double GetSquareFleche(const ScatterNode<TYPE>& StartNode_, const ScatterNode<TYPE>& EndNode_);
+
+        // Get the ratio of the chord length to the max segment length, or the ratio of the angle between tangents to the max
+        // turning angle, whichever is larger. The chord satisfies the constraints if the ratio is no more than 1.
+        double GetConstraintRatio(const ScatterNode<TYPE>& StartNode_, const ScatterNode<TYPE>& EndNode_);
+
+        // Send the scatter nodes except the last one to the sink, the last one is replaced by next interval.
+        void FlushScatterNodes();
+
+        // Push the segment from the budget node to its next node into the heap of budget segments.
+        void PushBudgetSegment(int nNodeIndex_);
 
     private:
+        // Unprocessed nodes
+        struct UndoNodes
+        {
+            ScatterNode<TYPE> node;
+            int nPointMin = 0;
+        };
+
+        // The scatter node of budget scatter, the nodes of one interval are linked in order of knots.
+        struct BudgetNode
+        {
+            ScatterNode<TYPE> node;
+            int nIntervalIndex = 0;
+            int nNextIndex = -1;
+        };
+
+        // The segment from the budget node to its next node, the heap of segments is ordered by the square chord error.
+        struct BudgetSegment
+        {
+            double nSquareFleche = 0.0;
+            int nNodeIndex = 0;
+
+            bool operator<(const BudgetSegment& BudgetSegment_) const { return nSquareFleche < BudgetSegment_.nSquareFleche; }
+        };
+
+        // Unprocessed node of level scatter, the chord to it is only judged from the check level, because it's not divided by
+        // the coarser levels.
+        struct LevelNodes
+        {
+            ScatterNode<TYPE> node;
+            int nNodeLevel = 0;
+            int nCheckLevel = 0;
+        };
+
         CNurbsParser<TYPE> m_NurbsParser;
         CFastVector<ScatterNode<TYPE>>* m_pvecScatterNodes;
+        const ScatterSink<TYPE>* m_pScatterSink;
+        CFastVector<ScatterInterval<TYPE>> m_vecScatterIntervals;
+        CFastVector<double> m_vecValidKnots;
+
+        // The state of scattering intervals step by step, the top of undo stack is the back.
+        const CFastVector<ScatterInterval<TYPE>>* m_pvecScatterIntervals;
+        const NurbsNode<TYPE>* m_pNurbsNode;
+        int m_nIntervalIndex;
+        int m_nEndIndex;
+        double m_nDeflection;
+        CFastVector<UndoNodes> m_vecUndoNodes;
+
+        // The state of budget scatter.
+        CFastVector<BudgetNode> m_vecBudgetNodes;
+        std::vector<BudgetSegment> m_vecBudgetSegments;
+
+        // The state of level scatter, the top of stack is the back.
+        CFastVector<LevelNodes> m_vecLevelNodes;
+        CFastVector<double> m_vecSquareDeflections;
 
         // temporary variable reutilization
         TYPE m_nxTempPoints[4];
         bool m_bOnlyGetPoints;
+
+        // The constraints of chord, the square of the difference between unit tangents is compared instead of the angle.
+        double m_nMaxSegmentLength;
+        double m_nMaxTurningAngle;
+        double m_nSquareTangentDiff;
+
+        // The token to interrupt scattering, and the status of the last scatter.
+        const ScatterToken* m_pScatterToken;
+        int m_nScatterStatus;
     };
 
     /**
@@ -58,6 +190,19 @@ namespace neat
      */
     template<typename TYPE>
     CNurbsQuasiUniformDeflection<TYPE>::CNurbsQuasiUniformDeflection()
+        : m_pvecScatterNodes(nullptr)
+        , m_pScatterSink(nullptr)
+        , m_pvecScatterIntervals(nullptr)
+        , m_pNurbsNode(nullptr)
+        , m_nIntervalIndex(0)
+        , m_nEndIndex(0)
+        , m_nDeflection(0.0)
+        , m_bOnlyGetPoints(false)
+        , m_nMaxSegmentLength(0.0)
+        , m_nMaxTurningAngle(0.0)
+        , m_nSquareTangentDiff(0.0)
+        , m_pScatterToken(nullptr)
+        , m_nScatterStatus(scatter_status::finished)
     {
     }
 
@@ -66,28 +211,42 @@ namespace neat
     {
     }
 
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_)
+    {
+        NEAT_RAISE_IF(nMaxSegmentLength_ < 0.0 || nMaxTurningAngle_ < 0.0, g_strWrongSegmentConstraints);
+
+        // the unit tangents with angle a are apart from each other by 2 * sin(a / 2)
+        m_nMaxSegmentLength = nMaxSegmentLength_;
+        m_nMaxTurningAngle = min(nMaxTurningAngle_, Precision::PIE());
+        double _nSine = sin(0.5 * m_nMaxTurningAngle);
+        m_nSquareTangentDiff = 4.0 * _nSine * _nSine;
+    }
+
     template<typename TYPE>
     void CNurbsQuasiUniformDeflection<TYPE>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_,
         CFastVector<ScatterNode<TYPE>>& vecScatterNodes_)
     {
-        NEAT_RAISE_IF(nDeflection_ <= 0.0, g_strWrongDeflection);
-        m_NurbsParser.SetNurbsNode(pNurbsNode_);
+        m_vecScatterIntervals.clear();
+        CollectIntervals(pNurbsNode_, m_vecScatterIntervals);
+        ScatterIntervals(m_vecScatterIntervals, 0, static_cast<int>(m_vecScatterIntervals.size()), nDeflection_, vecScatterNodes_);
+    }
 
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::CollectIntervals(const NurbsNode<TYPE>* pNurbsNode_,
+        CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_)
+    {
         // check repeat knot at front and back
         NEAT_RAISE_IF(!DOUBLE_EQU(pNurbsNode_->vecKnots[pNurbsNode_->nDegree], pNurbsNode_->vecKnots.front())
             || !DOUBLE_EQU(pNurbsNode_->vecKnots[pNurbsNode_->vecKnots.size() - pNurbsNode_->nDegree - 1], pNurbsNode_->vecKnots.back()),
             g_strNurbsParamsError);
 
-        m_pvecScatterNodes = &vecScatterNodes_;
-        m_pvecScatterNodes->clear();
-        m_pvecScatterNodes->push_back(ScatterNode<TYPE>());
-
         // collect the no repeat knots
-        CFastVector<double> _vecValidKnots;
-        _vecValidKnots.push_back(pNurbsNode_->vecKnots[pNurbsNode_->nDegree]);
+        m_vecValidKnots.clear();
+        m_vecValidKnots.push_back(pNurbsNode_->vecKnots[pNurbsNode_->nDegree]);
         for (int i = pNurbsNode_->nDegree, _nSize = static_cast<int>(pNurbsNode_->vecKnots.size()) - pNurbsNode_->nDegree - 1; i <= _nSize; ++i) {
-            if (!DOUBLE_EQU(pNurbsNode_->vecKnots[i], _vecValidKnots.back())) {
-                _vecValidKnots.push_back(pNurbsNode_->vecKnots[i]);
+            if (!DOUBLE_EQU(pNurbsNode_->vecKnots[i], m_vecValidKnots.back())) {
+                m_vecValidKnots.push_back(pNurbsNode_->vecKnots[i]);
             }
         }
 
@@ -100,18 +259,257 @@ namespace neat
             _nInnerCount += 1;
         }
 
-        for (int i = 1, _nSize = static_cast<int>(_vecValidKnots.size()); i < _nSize; ++i) {
-            double _nStartKnot = _vecValidKnots[i - 1];
+        ScatterInterval<TYPE> _ScatterInterval;
+        _ScatterInterval.pNurbsNode = pNurbsNode_;
+        for (int i = 1, _nSize = static_cast<int>(m_vecValidKnots.size()); i < _nSize; ++i) {
+            _ScatterInterval.nStartKnot = m_vecValidKnots[i - 1];
             for (int j = 1; j < _nInnerCount; ++j)
             {
                 double _nRatio = 1.0 * j / _nInnerCount;
-                double _nEndKnot = (1.0 - _nRatio) * _vecValidKnots[i - 1] + _nRatio * _vecValidKnots[i];
-                QuasiFlecheNurbs(nDeflection_, _nStartKnot, _nEndKnot);
-                _nStartKnot = _nEndKnot;
+                _ScatterInterval.nEndKnot = (1.0 - _nRatio) * m_vecValidKnots[i - 1] + _nRatio * m_vecValidKnots[i];
+                vecScatterIntervals_.push_back(_ScatterInterval);
+                _ScatterInterval.nStartKnot = _ScatterInterval.nEndKnot;
+            }
+
+            _ScatterInterval.nEndKnot = m_vecValidKnots[i];
+            vecScatterIntervals_.push_back(_ScatterInterval);
+        }
+    }
+
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::ScatterIntervals(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_,
+        int nStartIndex_, int nEndIndex_, double nDeflection_, CFastVector<ScatterNode<TYPE>>& vecScatterNodes_)
+    {
+        ScatterIntervals(vecScatterIntervals_, nStartIndex_, nEndIndex_, nDeflection_, vecScatterNodes_, nullptr);
+    }
+
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::ScatterIntervals(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_,
+        int nStartIndex_, int nEndIndex_, double nDeflection_, CFastVector<ScatterNode<TYPE>>& vecScatterNodes_,
+        const ScatterSink<TYPE>* pScatterSink_)
+    {
+        m_pScatterSink = pScatterSink_;
+        StartIntervals(vecScatterIntervals_, nStartIndex_, nEndIndex_, nDeflection_, vecScatterNodes_);
+        int _nStepCount = 0;
+        while (ScatterStep()) {
+            // no unprocessed node means that one interval is scattered
+            if (m_pScatterSink != nullptr && m_vecUndoNodes.empty()) {
+                FlushScatterNodes();
+            }
+
+            // the last scatter node is the end of accepted chords, so the unprocessed nodes are dropped when it's interrupted
+            if (m_pScatterToken != nullptr && (++_nStepCount & 0x3F) == 0) {
+                m_nScatterStatus = m_pScatterToken->GetStatus();
+                if (m_nScatterStatus != scatter_status::finished) {
+                    m_vecUndoNodes.clear();
+                    break;
+                }
+            }
+        }
+    }
+
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::StartIntervals(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_,
+        int nStartIndex_, int nEndIndex_, double nDeflection_, CFastVector<ScatterNode<TYPE>>& vecScatterNodes_)
+    {
+        NEAT_RAISE_IF(nDeflection_ <= 0.0, g_strWrongDeflection);
+        NEAT_RAISE_IF(nStartIndex_ < 0 || nEndIndex_ > static_cast<int>(vecScatterIntervals_.size()), g_strNurbsParamsError);
+
+        m_pvecScatterIntervals = &vecScatterIntervals_;
+        m_pNurbsNode = nullptr;
+        m_nIntervalIndex = nStartIndex_;
+        m_nEndIndex = nEndIndex_;
+        m_nDeflection = nDeflection_;
+        m_nScatterStatus = scatter_status::finished;
+        m_vecUndoNodes.clear();
+
+        m_pvecScatterNodes = &vecScatterNodes_;
+        m_pvecScatterNodes->clear();
+        m_pvecScatterNodes->push_back(ScatterNode<TYPE>());
+    }
+
+    template<typename TYPE>
+    bool CNurbsQuasiUniformDeflection<TYPE>::ScatterStep()
+    {
+        if (!m_vecUndoNodes.empty()) {
+            StepFlecheNurbs();
+            return true;
+        }
+
+        if (m_nIntervalIndex >= m_nEndIndex) {
+            return false;
+        }
+
+        // the parser is set again when the interval belongs to another nurbs node
+        const ScatterInterval<TYPE>& _ScatterInterval = (*m_pvecScatterIntervals)[m_nIntervalIndex++];
+        if (_ScatterInterval.pNurbsNode != m_pNurbsNode) {
+            m_pNurbsNode = _ScatterInterval.pNurbsNode;
+            m_NurbsParser.SetNurbsNode(m_pNurbsNode);
+        }
+
+        StartFlecheNurbs(_ScatterInterval.nStartKnot, _ScatterInterval.nEndKnot);
+        return true;
+    }
+
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::ScatterBudget(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_,
+        size_t nPointBudget_, double nDeflection_, CFastVector<ScatterNode<TYPE>>& vecScatterNodes_, CFastVector<int>& vecIntervalOffsets_)
+    {
+        NEAT_RAISE_IF(nDeflection_ <= 0.0, g_strWrongDeflection);
+
+        m_pNurbsNode = nullptr;
+        m_vecBudgetNodes.clear();
+        m_vecBudgetSegments.clear();
+
+        // the start node and end node of interval i are the budget node 2i and 2i + 1
+        const int _nIntervalCount = static_cast<int>(vecScatterIntervals_.size());
+        BudgetNode _BudgetNode;
+        for (int i = 0; i < _nIntervalCount; ++i) {
+            const ScatterInterval<TYPE>& _ScatterInterval = vecScatterIntervals_[i];
+            if (_ScatterInterval.pNurbsNode != m_pNurbsNode) {
+                m_pNurbsNode = _ScatterInterval.pNurbsNode;
+                m_NurbsParser.SetNurbsNode(m_pNurbsNode);
             }
 
-            QuasiFlecheNurbs(nDeflection_, _nStartKnot, _vecValidKnots[i]);
+            _BudgetNode.nIntervalIndex = i;
+            _BudgetNode.nNextIndex = static_cast<int>(m_vecBudgetNodes.size()) + 1;
+            GetScatterNode(_ScatterInterval.nStartKnot, _BudgetNode.node);
+            m_vecBudgetNodes.push_back(_BudgetNode);
+
+            _BudgetNode.nNextIndex = -1;
+            GetScatterNode(_ScatterInterval.nEndKnot, _BudgetNode.node);
+            m_vecBudgetNodes.push_back(_BudgetNode);
+            PushBudgetSegment(i * 2);
+        }
+
+        // Divide the segment with the largest chord error, the segment whose middle knot is not between its end knots is dropped.
+        const double _nSquareDeflection = nDeflection_ * nDeflection_;
+        size_t _nPointCount = _nIntervalCount + 1;
+        while (_nPointCount < nPointBudget_ && !m_vecBudgetSegments.empty()) {
+            std::pop_heap(m_vecBudgetSegments.begin(), m_vecBudgetSegments.end());
+            BudgetSegment _BudgetSegment = m_vecBudgetSegments.back();
+            m_vecBudgetSegments.pop_back();
+            if (_BudgetSegment.nSquareFleche < _nSquareDeflection) {
+                break;
+            }
+
+            const BudgetNode& _StartNode = m_vecBudgetNodes[_BudgetSegment.nNodeIndex];
+            const BudgetNode& _EndNode = m_vecBudgetNodes[_StartNode.nNextIndex];
+            double _nMiddleKnot = 0.5 * (_StartNode.node.nKnot + _EndNode.node.nKnot);
+            if (_nMiddleKnot <= _StartNode.node.nKnot || _nMiddleKnot >= _EndNode.node.nKnot) {
+                continue;
+            }
+
+            const ScatterInterval<TYPE>& _ScatterInterval = vecScatterIntervals_[_StartNode.nIntervalIndex];
+            if (_ScatterInterval.pNurbsNode != m_pNurbsNode) {
+                m_pNurbsNode = _ScatterInterval.pNurbsNode;
+                m_NurbsParser.SetNurbsNode(m_pNurbsNode);
+            }
+
+            _BudgetNode.nIntervalIndex = _StartNode.nIntervalIndex;
+            _BudgetNode.nNextIndex = _StartNode.nNextIndex;
+            GetScatterNode(_nMiddleKnot, _BudgetNode.node);
+
+            // the references of budget nodes are invalid after pushing
+            const int _nMiddleIndex = static_cast<int>(m_vecBudgetNodes.size());
+            m_vecBudgetNodes[_BudgetSegment.nNodeIndex].nNextIndex = _nMiddleIndex;
+            m_vecBudgetNodes.push_back(_BudgetNode);
+            PushBudgetSegment(_BudgetSegment.nNodeIndex);
+            PushBudgetSegment(_nMiddleIndex);
+            ++_nPointCount;
         }
+
+        // output the linked nodes of every interval
+        vecScatterNodes_.clear();
+        vecIntervalOffsets_.clear();
+        for (int i = 0; i < _nIntervalCount; ++i) {
+            vecIntervalOffsets_.push_back(static_cast<int>(vecScatterNodes_.size()));
+            for (int j = i * 2; j >= 0; j = m_vecBudgetNodes[j].nNextIndex) {
+                vecScatterNodes_.push_back(m_vecBudgetNodes[j].node);
+            }
+        }
+
+        vecIntervalOffsets_.push_back(static_cast<int>(vecScatterNodes_.size()));
+    }
+
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::ScatterLevels(const CFastVector<ScatterInterval<TYPE>>& vecScatterIntervals_,
+        const double* pDeflections_, int nLevelCount_, CFastVector<ScatterNode<TYPE>>& vecScatterNodes_, CFastVector<int>& vecNodeLevels_)
+    {
+        NEAT_RAISE_IF(pDeflections_ == nullptr || nLevelCount_ < 1, g_strWrongDeflection);
+
+        m_vecSquareDeflections.clear();
+        for (int i = 0; i < nLevelCount_; ++i) {
+            NEAT_RAISE_IF(pDeflections_[i] <= 0.0 || (i > 0 && pDeflections_[i] >= pDeflections_[i - 1]), g_strWrongDeflection);
+            m_vecSquareDeflections.push_back(pDeflections_[i] * pDeflections_[i]);
+        }
+
+        m_pNurbsNode = nullptr;
+        vecScatterNodes_.clear();
+        vecNodeLevels_.clear();
+        LevelNodes _LevelNodes;
+        for (int i = 0, _nSize = static_cast<int>(vecScatterIntervals_.size()); i < _nSize; ++i) {
+            const ScatterInterval<TYPE>& _ScatterInterval = vecScatterIntervals_[i];
+            if (_ScatterInterval.pNurbsNode != m_pNurbsNode) {
+                m_pNurbsNode = _ScatterInterval.pNurbsNode;
+                m_NurbsParser.SetNurbsNode(m_pNurbsNode);
+            }
+
+            // the start node of interval replaces the end node of previous interval, which are both in all levels
+            if (vecScatterNodes_.empty()) {
+                vecScatterNodes_.push_back(ScatterNode<TYPE>());
+                vecNodeLevels_.push_back(0);
+            }
+
+            GetScatterNode(_ScatterInterval.nStartKnot, vecScatterNodes_.back());
+            _LevelNodes.nNodeLevel = 0;
+            _LevelNodes.nCheckLevel = 0;
+            GetScatterNode(_ScatterInterval.nEndKnot, _LevelNodes.node);
+            m_vecLevelNodes.clear();
+            m_vecLevelNodes.push_back(_LevelNodes);
+
+            while (!m_vecLevelNodes.empty()) {
+                const ScatterNode<TYPE>& _StartNode = vecScatterNodes_.back();
+                LevelNodes& _EndNodes = m_vecLevelNodes.back();
+
+                // find the first level from check level which the chord exceeds, the finer levels are exceeded too
+                int _nLevel = _EndNodes.nCheckLevel;
+                if (GetConstraintRatio(_StartNode, _EndNodes.node) <= 1.0) {
+                    double _nSquareFleche = GetSquareFleche(_StartNode, _EndNodes.node);
+                    while (_nLevel < nLevelCount_ && _nSquareFleche < m_vecSquareDeflections[_nLevel]) {
+                        ++_nLevel;
+                    }
+                }
+
+                double _nMiddleKnot = 0.5 * (_StartNode.nKnot + _EndNodes.node.nKnot);
+                if (_nLevel >= nLevelCount_ || _nMiddleKnot <= _StartNode.nKnot || _nMiddleKnot >= _EndNodes.node.nKnot) {
+                    vecScatterNodes_.push_back(_EndNodes.node);
+                    vecNodeLevels_.push_back(_EndNodes.nNodeLevel);
+                    m_vecLevelNodes.pop_back();
+                    continue;
+                }
+
+                // the middle node first appears at the level, and both halves are judged from it
+                _EndNodes.nCheckLevel = _nLevel;
+                _LevelNodes.nNodeLevel = _nLevel;
+                _LevelNodes.nCheckLevel = _nLevel;
+                GetScatterNode(_nMiddleKnot, _LevelNodes.node);
+
+                // the reference of level node is invalid after pushing
+                m_vecLevelNodes.push_back(_LevelNodes);
+            }
+        }
+    }
+
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::PushBudgetSegment(int nNodeIndex_)
+    {
+        const BudgetNode& _BudgetNode = m_vecBudgetNodes[nNodeIndex_];
+        BudgetSegment _BudgetSegment;
+        _BudgetSegment.nSquareFleche = GetSquareFleche(_BudgetNode.node, m_vecBudgetNodes[_BudgetNode.nNextIndex].node);
+        _BudgetSegment.nNodeIndex = nNodeIndex_;
+        m_vecBudgetSegments.push_back(_BudgetSegment);
+        std::push_heap(m_vecBudgetSegments.begin(), m_vecBudgetSegments.end());
     }
 
     template<typename TYPE>
@@ -127,7 +525,7 @@ namespace neat
     }
 
     template<typename TYPE>
-    void CNurbsQuasiUniformDeflection<TYPE>::QuasiFlecheNurbs(double nDeflection_, double nStartKnot_, double nEndKnot_)
+    void CNurbsQuasiUniformDeflection<TYPE>::StartFlecheNurbs(double nStartKnot_, double nEndKnot_)
     {
         ScatterNode<TYPE> _StartScatterNode, _EndScatterNode;
         GetScatterNode(nStartKnot_, _StartScatterNode);
@@ -136,72 +534,120 @@ namespace neat
         m_pvecScatterNodes->pop_back();
         m_pvecScatterNodes->push_back(_StartScatterNode);
 
-        const double _nSquareTolerance = Precision::SquareRealTolerance();
-        const double _nSquareDeflection = nDeflection_ * nDeflection_;
         const int _nPointMin = 2;
+        m_vecUndoNodes.push_back(UndoNodes{ _EndScatterNode, _nPointMin });
+    }
 
-        // Unprocessed nodes
-        struct UndoNodes
-        {
-            ScatterNode<TYPE> node;
-            int nPointMin = 0;
-        };
-
-        std::list<UndoNodes> _listUndoNodes;
-        _listUndoNodes.emplace_front(UndoNodes{ _EndScatterNode, _nPointMin });
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::StepFlecheNurbs()
+    {
+        const double _nSquareDeflection = m_nDeflection * m_nDeflection;
 
-        // recursion could stack overflow, loop instead
+        // recursion could stack overflow, one step of loop instead
         ScatterNode<TYPE> _NextKnot;
-        while (!_listUndoNodes.empty()) {
-            ScatterNode<TYPE>& _StartKnot = m_pvecScatterNodes->back();
-            UndoNodes& _UndoEndKnot = _listUndoNodes.front();
-
-            int _nPointSize = static_cast<int>(m_pvecScatterNodes->size());
-            double _nDeltaKnot = _UndoEndKnot.node.nKnot - _StartKnot.nKnot;
-            _NextKnot = _UndoEndKnot.node;
-            if (_UndoEndKnot.nPointMin > 2) {
-                _nDeltaKnot /= (_UndoEndKnot.nPointMin - 1);
-                GetScatterNode(_StartKnot.nKnot + _nDeltaKnot, _NextKnot);
-            }
+        ScatterNode<TYPE>& _StartKnot = m_pvecScatterNodes->back();
+        UndoNodes& _UndoEndKnot = m_vecUndoNodes.back();
+
+        int _nPointSize = static_cast<int>(m_pvecScatterNodes->size());
+        double _nDeltaKnot = _UndoEndKnot.node.nKnot - _StartKnot.nKnot;
+        _NextKnot = _UndoEndKnot.node;
+        if (_UndoEndKnot.nPointMin > 2) {
+            _nDeltaKnot /= (_UndoEndKnot.nPointMin - 1);
+            GetScatterNode(_StartKnot.nKnot + _nDeltaKnot, _NextKnot);
+        }
 
-            double _nNorme = (_NextKnot.ptPoint - _StartKnot.ptPoint).GetSquareLength();
-            double _nTheFleche = 0.0;
-            bool _bFlecheOK = false;
-            if (_nNorme > _nSquareTolerance) {
-                double _nNorme1 = _StartKnot.ptDeriv1.GetSquareLength();
-                double _nNorme2 = _NextKnot.ptDeriv1.GetSquareLength();
-                if (_nNorme1 > _nSquareTolerance && _nNorme2 > _nSquareTolerance) {
-                    m_nxTempPoints[0] = _StartKnot.ptDeriv1 / _StartKnot.ptDeriv1.GetLength();
-                    m_nxTempPoints[1] = _NextKnot.ptDeriv1 / _NextKnot.ptDeriv1.GetLength();
-                    double _nNormeDiff = (m_nxTempPoints[0] - m_nxTempPoints[1]).GetSquareLength();
-                    if (_nNormeDiff > _nSquareTolerance) {
-                        _nTheFleche = _nNormeDiff * _nNorme / 64.0;
-                        _bFlecheOK = true;
-                    }
+        // The chord beyond constraints is divided to quasi uniform chords by the ratio, instead of halves.
+        double _nConstraintRatio = GetConstraintRatio(_StartKnot, _NextKnot);
+        if (_nConstraintRatio > 1.0) {
+            const int _nPointMin = static_cast<int>(ceil(min(_nConstraintRatio, 1024.0))) + 1;
+            m_vecUndoNodes.push_back(UndoNodes{ _NextKnot, _nPointMin });
+            return;
+        }
+
+        if (GetSquareFleche(_StartKnot, _NextKnot) < _nSquareDeflection) {
+            m_pvecScatterNodes->push_back(_NextKnot);
+        }
+        else {
+            // the reference of undo node is invalid after pushing
+            m_vecUndoNodes.push_back(UndoNodes{ _NextKnot, 3 });
+            return;
+        }
+
+        if (_UndoEndKnot.nPointMin > 2) {
+            _UndoEndKnot.nPointMin += _nPointSize - static_cast<int>(m_pvecScatterNodes->size());
+        }
+        else {
+            m_vecUndoNodes.pop_back();
+        }
+    }
+
+    template<typename TYPE>
+    double CNurbsQuasiUniformDeflection<TYPE>::GetSquareFleche(const ScatterNode<TYPE>& StartNode_, const ScatterNode<TYPE>& EndNode_)
+    {
+        const double _nSquareTolerance = Precision::SquareRealTolerance();
+        double _nNorme = (EndNode_.ptPoint - StartNode_.ptPoint).GetSquareLength();
+        if (_nNorme > _nSquareTolerance) {
+            double _nNorme1 = StartNode_.ptDeriv1.GetSquareLength();
+            double _nNorme2 = EndNode_.ptDeriv1.GetSquareLength();
+            if (_nNorme1 > _nSquareTolerance && _nNorme2 > _nSquareTolerance) {
+                m_nxTempPoints[0] = StartNode_.ptDeriv1 / StartNode_.ptDeriv1.GetLength();
+                m_nxTempPoints[1] = EndNode_.ptDeriv1 / EndNode_.ptDeriv1.GetLength();
+                double _nNormeDiff = (m_nxTempPoints[0] - m_nxTempPoints[1]).GetSquareLength();
+                if (_nNormeDiff > _nSquareTolerance) {
+                    return _nNormeDiff * _nNorme / 64.0;
                 }
             }
+        }
 
-            if (!_bFlecheOK) {
-                m_nxTempPoints[2] = (_StartKnot.ptPoint + _NextKnot.ptPoint) * 0.5;
-                m_NurbsParser.GetNurbsPoint(_StartKnot.nKnot + 0.5 * _nDeltaKnot, m_nxTempPoints[3]);
-                _nTheFleche = (m_nxTempPoints[2] - m_nxTempPoints[3]).GetSquareLength();
-            }
+        m_nxTempPoints[2] = (StartNode_.ptPoint + EndNode_.ptPoint) * 0.5;
+        m_NurbsParser.GetNurbsPoint(StartNode_.nKnot + 0.5 * (EndNode_.nKnot - StartNode_.nKnot), m_nxTempPoints[3]);
+        return (m_nxTempPoints[2] - m_nxTempPoints[3]).GetSquareLength();
+    }
 
-            if (_nTheFleche < _nSquareDeflection) {
-                m_pvecScatterNodes->push_back(_NextKnot);
-            }
-            else {
-                _listUndoNodes.emplace_front(UndoNodes{ _NextKnot, 3 });
-                continue;
-            }
+    template<typename TYPE>
+    double CNurbsQuasiUniformDeflection<TYPE>::GetConstraintRatio(const ScatterNode<TYPE>& StartNode_, const ScatterNode<TYPE>& EndNode_)
+    {
+        // the coincident nodes satisfy the constraints, so the cusp of curve is not divided endlessly
+        const double _nSquareTolerance = Precision::SquareRealTolerance();
+        double _nNorme = (EndNode_.ptPoint - StartNode_.ptPoint).GetSquareLength();
+        if (_nNorme <= _nSquareTolerance) {
+            return 0.0;
+        }
 
-            if (_UndoEndKnot.nPointMin > 2) {
-                _UndoEndKnot.nPointMin += _nPointSize - static_cast<int>(m_pvecScatterNodes->size());
-            }
-            else {
-                _listUndoNodes.pop_front();
+        double _nRatio = 0.0;
+        if (m_nMaxSegmentLength > 0.0 && _nNorme > m_nMaxSegmentLength * m_nMaxSegmentLength) {
+            _nRatio = sqrt(_nNorme) / m_nMaxSegmentLength;
+        }
+
+        if (m_nMaxTurningAngle > 0.0) {
+            double _nNorme1 = StartNode_.ptDeriv1.GetSquareLength();
+            double _nNorme2 = EndNode_.ptDeriv1.GetSquareLength();
+            if (_nNorme1 > _nSquareTolerance && _nNorme2 > _nSquareTolerance) {
+                m_nxTempPoints[0] = StartNode_.ptDeriv1 / sqrt(_nNorme1);
+                m_nxTempPoints[1] = EndNode_.ptDeriv1 / sqrt(_nNorme2);
+                double _nNormeDiff = (m_nxTempPoints[0] - m_nxTempPoints[1]).GetSquareLength();
+                if (_nNormeDiff > m_nSquareTangentDiff) {
+                    double _nAngle = 2.0 * asin(min(1.0, 0.5 * sqrt(_nNormeDiff)));
+                    _nRatio = max(_nRatio, _nAngle / m_nMaxTurningAngle);
+                }
             }
         }
+
+        return _nRatio;
+    }
+
+    template<typename TYPE>
+    void CNurbsQuasiUniformDeflection<TYPE>::FlushScatterNodes()
+    {
+        const int _nSize = static_cast<int>(m_pvecScatterNodes->size());
+        for (int i = 0; i < _nSize - 1; ++i) {
+            (*m_pScatterSink)((*m_pvecScatterNodes)[i]);
+        }
+
+        // the buffer is cleared, so its size is bounded by the scatter nodes of one interval
+        ScatterNode<TYPE> _LastScatterNode = m_pvecScatterNodes->back();
+        m_pvecScatterNodes->clear();
+        m_pvecScatterNodes->push_back(_LastScatterNode);
     }
 
 } // End namespace neat
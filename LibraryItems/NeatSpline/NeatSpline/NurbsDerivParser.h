@@ -0,0 +1,275 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __NURBS_DERIV_PARSER_H_20200302__
+#define __NURBS_DERIV_PARSER_H_20200302__
+
+/**
+ * This file defines the parser for arbitrary-order derivatives of nurbs curve.
+ */
+namespace neat
+{
+    /**
+     * This class calculates the point and derivatives up to any order in one pass over the basis functions.
+     * The derivatives of rational B-spline curve are obtained from the homogeneous derivatives by quotient rule.
+     */
+    template<typename TYPE>
+    class CNurbsDerivParser
+    {
+    public:
+        CNurbsDerivParser();
+        ~CNurbsDerivParser();
+
+        // Set the information for nurbs node.
+        void SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_, bool bRational_);
+
+        // Set the information for compiled nurbs curve, which is not checked any more.
+        void SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_);
+
+        // Returns in pDerivs_[0] the point and pDerivs_[k] the k-order derivative (k <= nOrder_) of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, int nOrder_, TYPE* pDerivs_);
+
+    private:
+        // Initialize the knot index and allocate the tables of basis functions.
+        void InitBasisTables();
+
+        // Calculate the basis functions and their derivatives up to nOrder_ in the span nKnotIndex_.
+        void CalculateBasisDerivs(double nKnot_, int nKnotIndex_, int nOrder_);
+
+    private:
+        NurbsNode<TYPE>* m_pNurbsNode;
+        const CNurbsCurve<TYPE>* m_pNurbsCurve;
+        int m_nStartIndex;
+        int m_nEndIndex;
+        int m_nKnotIndex;
+        UniformKnots m_UniformKnots;
+        bool m_bRational;
+
+        // The tables used to calculate basis functions, whose sizes depend on degree
+        VECDOUBLE m_vecLeft;
+        VECDOUBLE m_vecRight;
+        VECDOUBLE m_vecBasisTable;
+        VECDOUBLE m_vecCoefficients;
+
+        // The derivatives of basis functions, the row k records the k-order derivatives
+        VECDOUBLE m_vecBasisDerivs;
+
+        // The derivatives of numerator and denominator of rational B-spline curve
+        std::vector<TYPE> m_vecNumeratorDerivs;
+        VECDOUBLE m_vecDenominatorDerivs;
+    };
+
+    /**
+     * The implementation of template class.
+     */
+    template<typename TYPE>
+    CNurbsDerivParser<TYPE>::CNurbsDerivParser()
+        : m_pNurbsNode(nullptr)
+        , m_pNurbsCurve(nullptr)
+        , m_nStartIndex(0)
+        , m_nEndIndex(0)
+        , m_nKnotIndex(0)
+        , m_bRational(false)
+    {
+    }
+
+    template<typename TYPE>
+    CNurbsDerivParser<TYPE>::~CNurbsDerivParser()
+    {
+    }
+
+    template<typename TYPE>
+    void CNurbsDerivParser<TYPE>::SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_, bool bRational_)
+    {
+        NEAT_RAISE_IF(pNurbsNode_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE_IF(CheckNurbsNodeRational(pNurbsNode_) != bRational_, g_strNurbsParamsError);
+
+        m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsNode_;
+        m_pNurbsCurve = nullptr;
+        m_bRational = bRational_;
+
+        // Initialize the knot index limit value
+        m_nStartIndex = m_pNurbsNode->nDegree;
+        m_nEndIndex = static_cast<int>(m_pNurbsNode->vecKnots.size()) - m_pNurbsNode->nDegree - 1;
+        NEAT_RAISE(DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nStartIndex], m_pNurbsNode->vecKnots[m_nEndIndex]), g_strNurbsParamsError);
+        CheckUniformKnots(m_pNurbsNode->vecKnots, m_nStartIndex, m_nEndIndex, m_UniformKnots);
+
+        InitBasisTables();
+    }
+
+    template<typename TYPE>
+    void CNurbsDerivParser<TYPE>::SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_)
+    {
+        NEAT_RAISE_IF(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+
+        m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsCurve_->GetNurbsNode();
+        m_pNurbsCurve = pNurbsCurve_;
+        m_bRational = pNurbsCurve_->IsRational();
+
+        // The compiled nurbs curve has been checked
+        m_nStartIndex = pNurbsCurve_->GetStartIndex();
+        m_nEndIndex = pNurbsCurve_->GetEndIndex();
+        m_UniformKnots = pNurbsCurve_->GetUniformKnots();
+        InitBasisTables();
+    }
+
+    template<typename TYPE>
+    void CNurbsDerivParser<TYPE>::InitBasisTables()
+    {
+        m_nKnotIndex = m_nStartIndex;
+        while (DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nKnotIndex + 1], m_pNurbsNode->vecKnots[m_nStartIndex])) {
+            ++m_nKnotIndex;
+        }
+
+        const int _nSize = m_pNurbsNode->nDegree + 1;
+        m_vecLeft.assign(_nSize, 0.0);
+        m_vecRight.assign(_nSize, 0.0);
+        m_vecBasisTable.assign(_nSize * _nSize, 0.0);
+        m_vecCoefficients.assign(2 * _nSize, 0.0);
+    }
+
+    template<typename TYPE>
+    void CNurbsDerivParser<TYPE>::GetNurbsDeriv(double nKnot_, int nOrder_, TYPE* pDerivs_)
+    {
+        NEAT_RAISE(m_pNurbsNode == nullptr || pDerivs_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(nOrder_ < 0, g_strNurbsParamsError);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && CheckNurbsNodeRational(m_pNurbsNode) != m_bRational, g_strNurbsParamsError);
+
+        const int _nDegree = m_pNurbsNode->nDegree;
+        const int _nBasisOrder = nOrder_ < _nDegree ? nOrder_ : _nDegree;
+        const int _nKnotIndex = FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_UniformKnots, m_nKnotIndex);
+        CalculateBasisDerivs(nKnot_, _nKnotIndex, _nBasisOrder);
+
+        const TYPE* _pPoles = m_pNurbsNode->vecPoles.data() + _nKnotIndex - _nDegree;
+        const int _nSize = _nDegree + 1;
+        if (!m_bRational) {
+            // The derivatives of Non-rational B-spline curve are the combination of poles
+            for (int k = 0; k <= nOrder_; ++k) {
+                pDerivs_[k] = TYPE();
+            }
+
+            for (int k = 0; k <= _nBasisOrder; ++k) {
+                const double* _pBasisDerivs = m_vecBasisDerivs.data() + k * _nSize;
+                for (int j = 0; j <= _nDegree; ++j) {
+                    pDerivs_[k] += _pPoles[j] * _pBasisDerivs[j];
+                }
+            }
+
+            return;
+        }
+
+        // The derivatives of numerator and denominator of rational B-spline curve
+        const double* _pWeights = m_pNurbsNode->vecWeights.data() + _nKnotIndex - _nDegree;
+        m_vecNumeratorDerivs.assign(nOrder_ + 1, TYPE());
+        m_vecDenominatorDerivs.assign(nOrder_ + 1, 0.0);
+        for (int k = 0; k <= _nBasisOrder; ++k) {
+            const double* _pBasisDerivs = m_vecBasisDerivs.data() + k * _nSize;
+            for (int j = 0; j <= _nDegree; ++j) {
+                double _nWeightBasis = _pBasisDerivs[j] * _pWeights[j];
+                m_vecNumeratorDerivs[k] += _pPoles[j] * _nWeightBasis;
+                m_vecDenominatorDerivs[k] += _nWeightBasis;
+            }
+        }
+
+        // Quotient rule: C(k) = (A(k) - sum(Bin(k, i) * w(i) * C(k - i), i = 1...k)) / w
+        double _nAlpha = 1.0 / m_vecDenominatorDerivs[0];
+        for (int k = 0; k <= nOrder_; ++k) {
+            TYPE _ptDeriv = m_vecNumeratorDerivs[k];
+            double _nBinomial = 1.0;
+            for (int i = 1; i <= k; ++i) {
+                _nBinomial = _nBinomial * (k - i + 1) / i;
+                _ptDeriv -= pDerivs_[k - i] * (_nBinomial * m_vecDenominatorDerivs[i]);
+            }
+
+            pDerivs_[k] = _ptDeriv * _nAlpha;
+        }
+    }
+
+    template<typename TYPE>
+    void CNurbsDerivParser<TYPE>::CalculateBasisDerivs(double nKnot_, int nKnotIndex_, int nOrder_)
+    {
+        const int _nDegree = m_pNurbsNode->nDegree;
+        const int _nSize = _nDegree + 1;
+        const double* _pKnots = m_pNurbsNode->vecKnots.data();
+        double* _pLeft = m_vecLeft.data();
+        double* _pRight = m_vecRight.data();
+
+        // The basis functions and knot differences: the upper triangle records the basis functions of all degrees
+        // and the lower triangle records the reciprocals of knot differences, which is indexed by row * _nSize + column.
+        double* _pTable = m_vecBasisTable.data();
+        _pTable[0] = 1.0;
+        for (int j = 1; j <= _nDegree; ++j) {
+            _pLeft[j] = nKnot_ - _pKnots[nKnotIndex_ + 1 - j];
+            _pRight[j] = _pKnots[nKnotIndex_ + j] - nKnot_;
+            double _nSaved = 0.0;
+            for (int r = 0; r < j; ++r) {
+                _pTable[j * _nSize + r] = 1.0 / (_pRight[r + 1] + _pLeft[j - r]);
+                double _nTemp = _pTable[r * _nSize + j - 1] * _pTable[j * _nSize + r];
+                _pTable[r * _nSize + j] = _nSaved + _pRight[r + 1] * _nTemp;
+                _nSaved = _pLeft[j - r] * _nTemp;
+            }
+
+            _pTable[j * _nSize + j] = _nSaved;
+        }
+
+        m_vecBasisDerivs.resize((nOrder_ + 1) * _nSize);
+        double* _pDerivs = m_vecBasisDerivs.data();
+        for (int j = 0; j <= _nDegree; ++j) {
+            _pDerivs[j] = _pTable[j * _nSize + _nDegree];
+        }
+
+        // The derivatives of basis functions by two alternate rows of coefficients
+        double* _pCoefficients = m_vecCoefficients.data();
+        for (int r = 0; r <= _nDegree; ++r) {
+            double* _pRow1 = _pCoefficients;
+            double* _pRow2 = _pCoefficients + _nSize;
+            _pRow1[0] = 1.0;
+            for (int k = 1; k <= nOrder_; ++k) {
+                double _nDeriv = 0.0;
+                int _nRK = r - k;
+                int _nPK = _nDegree - k;
+                if (r >= k) {
+                    _pRow2[0] = _pRow1[0] * _pTable[(_nPK + 1) * _nSize + _nRK];
+                    _nDeriv = _pRow2[0] * _pTable[_nRK * _nSize + _nPK];
+                }
+
+                int _nStart = _nRK >= -1 ? 1 : -_nRK;
+                int _nEnd = r - 1 <= _nPK ? k - 1 : _nDegree - r;
+                for (int j = _nStart; j <= _nEnd; ++j) {
+                    _pRow2[j] = (_pRow1[j] - _pRow1[j - 1]) * _pTable[(_nPK + 1) * _nSize + _nRK + j];
+                    _nDeriv += _pRow2[j] * _pTable[(_nRK + j) * _nSize + _nPK];
+                }
+
+                if (r <= _nPK) {
+                    _pRow2[k] = -_pRow1[k - 1] * _pTable[(_nPK + 1) * _nSize + r];
+                    _nDeriv += _pRow2[k] * _pTable[r * _nSize + _nPK];
+                }
+
+                _pDerivs[k * _nSize + r] = _nDeriv;
+                std::swap(_pRow1, _pRow2);
+            }
+        }
+
+        // Multiply through by the factors p!/(p-k)!
+        double _nFactor = _nDegree;
+        for (int k = 1; k <= nOrder_; ++k) {
+            for (int j = 0; j <= _nDegree; ++j) {
+                _pDerivs[k * _nSize + j] *= _nFactor;
+            }
+
+            _nFactor *= _nDegree - k;
+        }
+    }
+
+} // End namespace neat
+
+#endif // __NURBS_DERIV_PARSER_H_20200302__
\ No newline at end of file
@@ -0,0 +1,415 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __NURBS_POWER_PARSER_H_20200302__
+#define __NURBS_POWER_PARSER_H_20200302__
+
+/**
+ * This file defines the power basis parser for nurbs node.
+ */
+namespace neat
+{
+    /**
+     * The nurbs node is divided into bezier nodes by the converter once, and every span is converted to the coefficients
+     * of power basis in its normalized parameter, then the point and derivatives are evaluated by Horner scheme.
+     * The rational span keeps the coefficients of numerator and denominator, and is projected by the quotient rule.
+     * It costs more memory than the nurbs node, which is reported by GetSpanMemory.
+     */
+    template<typename TYPE, typename TYPEEX>
+    class CNurbsPowerParser
+    {
+    public:
+        CNurbsPowerParser();
+        ~CNurbsPowerParser();
+
+        // Set the information for nurbs node, and convert all spans to power basis.
+        void SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_);
+
+        // Set the information for compiled nurbs curve, and convert all spans to power basis.
+        void SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_);
+
+        // Returns in ptPoint_ the point of parameter nKnot_.
+        void GetNurbsPoint(double nKnot_, TYPE& ptPoint_);
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative, ptDeriv2_ the second-order derivative
+        // and ptDeriv3_ the third-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_, TYPE& ptDeriv3_);
+
+        // Returns in pDerivs_[0] the point and pDerivs_[k] the k-order derivative (k <= nOrder_) of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, int nOrder_, TYPE* pDerivs_);
+
+        // Returns in pPoints_ the points of the parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, TYPE* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_, TYPE* pDeriv2s_);
+
+        // Returns in vecPoints_ the points of every span sampled by nSteps_ uniform parameter steps, and the end point of curve.
+        void GetSamplePoints(int nSteps_, std::vector<TYPE>& vecPoints_);
+
+        // Returns the number of spans.
+        int GetSpanCount() const;
+
+        // Returns the bytes of coefficients and knots for one span.
+        size_t GetSpanMemory() const;
+
+    private:
+        // Convert all bezier nodes of nurbs node to the coefficients of power basis.
+        void ConstructCoefficients(const NurbsNode<TYPE>* pNurbsNode_, bool bRational_);
+
+        // Returns the span of nKnot_ and nParam_ the normalized parameter in the span.
+        int LocateSpan(double nKnot_, double& nParam_);
+
+        // Calculate the point and derivatives up to the fixed order.
+        template<int ORDER>
+        void CalculateDeriv(double nKnot_, TYPE* pDerivs_);
+
+        // Calculate the point and derivatives up to nOrder_ at nParam_ of span, pNumerators_ and pDenominators_ are the buffers
+        // of nOrder_ + 1 derivatives of numerator and denominator.
+        void CalculateSpanDeriv(int nSpanIndex_, double nParam_, int nOrder_, TYPE* pNumerators_, double* pDenominators_,
+            TYPE* pDerivs_);
+
+    private:
+        CNurbsConverter<TYPE, TYPEEX> m_NurbsConverter;
+        std::vector<BezierNode<TYPE>> m_vecBezierNodes;
+        int m_nDegree;
+        int m_nSpanIndex;
+        bool m_bRational;
+
+        // The knots of span boundary and the reciprocals of span length
+        VECDOUBLE m_vecSpanKnots;
+        VECDOUBLE m_vecSpanAlphas;
+        UniformKnots m_UniformKnots;
+
+        // The coefficients of numerator and denominator, m_nDegree + 1 for every span
+        std::vector<TYPE> m_vecCoefficients;
+        VECDOUBLE m_vecWeightCoefficients;
+
+        // The derivatives of numerator and denominator for the arbitrary order, or the forward differences for sampling
+        std::vector<TYPE> m_vecNumeratorDerivs;
+        VECDOUBLE m_vecDenominatorDerivs;
+    };
+
+    /**
+     * The implementation of template class.
+     */
+    template<typename TYPE, typename TYPEEX>
+    CNurbsPowerParser<TYPE, TYPEEX>::CNurbsPowerParser()
+        : m_nDegree(0)
+        , m_nSpanIndex(0)
+        , m_bRational(false)
+    {
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    CNurbsPowerParser<TYPE, TYPEEX>::~CNurbsPowerParser()
+    {
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_)
+    {
+        ConstructCoefficients(pNurbsNode_, CheckNurbsNodeRational(pNurbsNode_));
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_)
+    {
+        NEAT_RAISE(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+        ConstructCoefficients(pNurbsCurve_->GetNurbsNode(), pNurbsCurve_->IsRational());
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetNurbsPoint(double nKnot_, TYPE& ptPoint_)
+    {
+        CalculateDeriv<0>(nKnot_, &ptPoint_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_)
+    {
+        TYPE _ptxDerivs[2];
+        CalculateDeriv<1>(nKnot_, _ptxDerivs);
+        ptPoint_ = _ptxDerivs[0];
+        ptDeriv1_ = _ptxDerivs[1];
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
+    {
+        TYPE _ptxDerivs[3];
+        CalculateDeriv<2>(nKnot_, _ptxDerivs);
+        ptPoint_ = _ptxDerivs[0];
+        ptDeriv1_ = _ptxDerivs[1];
+        ptDeriv2_ = _ptxDerivs[2];
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_, TYPE& ptDeriv3_)
+    {
+        TYPE _ptxDerivs[4];
+        CalculateDeriv<3>(nKnot_, _ptxDerivs);
+        ptPoint_ = _ptxDerivs[0];
+        ptDeriv1_ = _ptxDerivs[1];
+        ptDeriv2_ = _ptxDerivs[2];
+        ptDeriv3_ = _ptxDerivs[3];
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetNurbsDeriv(double nKnot_, int nOrder_, TYPE* pDerivs_)
+    {
+        NEAT_RAISE(pDerivs_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(nOrder_ < 0, g_strNurbsParamsError);
+
+        double _nParam = 0.0;
+        int _nSpanIndex = LocateSpan(nKnot_, _nParam);
+        m_vecNumeratorDerivs.resize(nOrder_ + 1);
+        m_vecDenominatorDerivs.resize(nOrder_ + 1);
+        CalculateSpanDeriv(_nSpanIndex, _nParam, nOrder_, m_vecNumeratorDerivs.data(), m_vecDenominatorDerivs.data(), pDerivs_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetNurbsPoints(const double* pKnots_, size_t nCount_, TYPE* pPoints_)
+    {
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr), g_strEmptyPointer);
+
+        for (size_t i = 0; i < nCount_; ++i) {
+            CalculateDeriv<0>(pKnots_[i], pPoints_ + i);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_)
+    {
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr || pDeriv1s_ == nullptr), g_strEmptyPointer);
+
+        for (size_t i = 0; i < nCount_; ++i) {
+            GetNurbsDeriv(pKnots_[i], pPoints_[i], pDeriv1s_[i]);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_,
+        TYPE* pDeriv2s_)
+    {
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr || pDeriv1s_ == nullptr || pDeriv2s_ == nullptr),
+            g_strEmptyPointer);
+
+        for (size_t i = 0; i < nCount_; ++i) {
+            GetNurbsDeriv(pKnots_[i], pPoints_[i], pDeriv1s_[i], pDeriv2s_[i]);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::GetSamplePoints(int nSteps_, std::vector<TYPE>& vecPoints_)
+    {
+        NEAT_RAISE(m_vecSpanAlphas.empty(), g_strEmptyPointer);
+        NEAT_RAISE(nSteps_ < 1, g_strNurbsParamsError);
+
+        // The forward differences are seeded again by Horner scheme to bound the accumulated rounding error
+        const int _nReseedSteps = 64;
+        const int _nCount = m_nDegree + 1;
+        const int _nSpanCount = GetSpanCount();
+        const double _nStep = 1.0 / nSteps_;
+        m_vecNumeratorDerivs.resize(_nCount);
+        m_vecDenominatorDerivs.resize(_nCount);
+        TYPE* _pNumerators = m_vecNumeratorDerivs.data();
+        double* _pDenominators = m_vecDenominatorDerivs.data();
+
+        vecPoints_.resize(static_cast<size_t>(_nSpanCount) * nSteps_ + 1);
+        TYPE* _pPoints = vecPoints_.data();
+        for (int i = 0; i < _nSpanCount; ++i) {
+            const TYPE* _pCoefficients = m_vecCoefficients.data() + i * _nCount;
+            const double* _pWeightCoefficients = m_bRational ? m_vecWeightCoefficients.data() + i * _nCount : nullptr;
+            for (int j = 0; j < nSteps_; ++j) {
+                if (j % _nReseedSteps == 0) {
+                    InitForwardDiffs(_pCoefficients, m_nDegree, j * _nStep, _nStep, _pNumerators);
+                    if (m_bRational) {
+                        InitForwardDiffs(_pWeightCoefficients, m_nDegree, j * _nStep, _nStep, _pDenominators);
+                    }
+                }
+
+                if (m_bRational) {
+                    *_pPoints++ = _pNumerators[0] * (1.0 / _pDenominators[0]);
+                    for (int k = 0; k < m_nDegree; ++k) {
+                        _pNumerators[k] += _pNumerators[k + 1];
+                        _pDenominators[k] += _pDenominators[k + 1];
+                    }
+                }
+                else {
+                    *_pPoints++ = _pNumerators[0];
+                    for (int k = 0; k < m_nDegree; ++k) {
+                        _pNumerators[k] += _pNumerators[k + 1];
+                    }
+                }
+            }
+        }
+
+        CalculateDeriv<0>(m_vecSpanKnots.back(), _pPoints);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    int CNurbsPowerParser<TYPE, TYPEEX>::GetSpanCount() const
+    {
+        return static_cast<int>(m_vecSpanAlphas.size());
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    size_t CNurbsPowerParser<TYPE, TYPEEX>::GetSpanMemory() const
+    {
+        // The coefficients, the denominator coefficients of rational span, the knot and reciprocal of span length
+        size_t _nCount = static_cast<size_t>(m_nDegree) + 1;
+        return _nCount * sizeof(TYPE) + (m_bRational ? _nCount * sizeof(double) : 0) + 2 * sizeof(double);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::ConstructCoefficients(const NurbsNode<TYPE>* pNurbsNode_, bool bRational_)
+    {
+        NEAT_RAISE(pNurbsNode_ == nullptr, g_strEmptyPointer);
+
+        m_nDegree = pNurbsNode_->nDegree;
+        m_nSpanIndex = 0;
+        m_bRational = bRational_;
+        m_vecSpanKnots.clear();
+        m_vecSpanAlphas.clear();
+        m_vecCoefficients.clear();
+        m_vecWeightCoefficients.clear();
+
+        // Divide nurbs node in every knot
+        m_NurbsConverter.ConvertNurbsToBezier(pNurbsNode_, m_vecBezierNodes);
+
+        const int _nCount = m_nDegree + 1;
+        std::vector<TYPE> _vecPoles(_nCount);
+        for (size_t i = 0, _nSize = m_vecBezierNodes.size(); i < _nSize; ++i) {
+            const BezierNode<TYPE>& _BezierNode = m_vecBezierNodes[i];
+            NEAT_RAISE(static_cast<int>(_BezierNode.vecPoles.size()) != _nCount, g_strNurbsParamsError);
+            if (DOUBLE_EQU(_BezierNode.nStartKnot, _BezierNode.nEndKnot)) {
+                continue;
+            }
+
+            if (m_vecSpanKnots.empty()) {
+                m_vecSpanKnots.push_back(_BezierNode.nStartKnot);
+            }
+            m_vecSpanKnots.push_back(_BezierNode.nEndKnot);
+            m_vecSpanAlphas.push_back(1.0 / (_BezierNode.nEndKnot - _BezierNode.nStartKnot));
+
+            // The rational span is converted in homogeneous space
+            size_t _nOffset = m_vecCoefficients.size();
+            m_vecCoefficients.resize(_nOffset + _nCount);
+            for (int j = 0; j < _nCount; ++j) {
+                _vecPoles[j] = m_bRational ? _BezierNode.vecPoles[j] * _BezierNode.vecWeights[j] : _BezierNode.vecPoles[j];
+            }
+            ConvertBezierToPower(_vecPoles.data(), m_nDegree, m_vecCoefficients.data() + _nOffset);
+
+            if (m_bRational) {
+                NEAT_RAISE(static_cast<int>(_BezierNode.vecWeights.size()) != _nCount, g_strNurbsParamsError);
+                m_vecWeightCoefficients.resize(_nOffset + _nCount);
+                ConvertBezierToPower(_BezierNode.vecWeights.data(), m_nDegree, m_vecWeightCoefficients.data() + _nOffset);
+            }
+        }
+
+        m_vecBezierNodes.clear();
+        NEAT_RAISE(m_vecSpanAlphas.empty(), g_strNurbsParamsError);
+        CheckUniformKnots(m_vecSpanKnots, 0, GetSpanCount(), m_UniformKnots);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    int CNurbsPowerParser<TYPE, TYPEEX>::LocateSpan(double nKnot_, double& nParam_)
+    {
+        NEAT_RAISE(m_vecSpanAlphas.empty(), g_strEmptyPointer);
+        NEAT_RAISE(nKnot_ < m_vecSpanKnots.front() || nKnot_ > m_vecSpanKnots.back(), g_strNurbsParamsError);
+
+        int _nSpanIndex = FindSpanForKnot(m_vecSpanKnots, nKnot_, 0, GetSpanCount(), m_UniformKnots, m_nSpanIndex);
+        nParam_ = (nKnot_ - m_vecSpanKnots[_nSpanIndex]) * m_vecSpanAlphas[_nSpanIndex];
+        return _nSpanIndex;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    template<int ORDER>
+    void CNurbsPowerParser<TYPE, TYPEEX>::CalculateDeriv(double nKnot_, TYPE* pDerivs_)
+    {
+        double _nParam = 0.0;
+        int _nSpanIndex = LocateSpan(nKnot_, _nParam);
+
+        TYPE _ptxDerivs[ORDER + 1];
+        double _nxWeights[ORDER + 1];
+        CalculateSpanDeriv(_nSpanIndex, _nParam, ORDER, _ptxDerivs, _nxWeights, pDerivs_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsPowerParser<TYPE, TYPEEX>::CalculateSpanDeriv(int nSpanIndex_, double nParam_, int nOrder_, TYPE* pNumerators_,
+        double* pDenominators_, TYPE* pDerivs_)
+    {
+        const int _nCount = m_nDegree + 1;
+
+        for (int k = 0; k <= nOrder_; ++k) {
+            pNumerators_[k] = TYPE();
+            pDenominators_[k] = 0.0;
+        }
+
+        // Horner scheme with the synthetic division for derivatives
+        const TYPE* _pCoefficients = m_vecCoefficients.data() + nSpanIndex_ * _nCount;
+        for (int j = m_nDegree; j >= 0; --j) {
+            for (int k = nOrder_; k > 0; --k) {
+                pNumerators_[k] = pNumerators_[k] * nParam_ + pNumerators_[k - 1];
+            }
+            pNumerators_[0] = pNumerators_[0] * nParam_ + _pCoefficients[j];
+        }
+
+        if (m_bRational) {
+            const double* _pWeightCoefficients = m_vecWeightCoefficients.data() + nSpanIndex_ * _nCount;
+            for (int j = m_nDegree; j >= 0; --j) {
+                for (int k = nOrder_; k > 0; --k) {
+                    pDenominators_[k] = pDenominators_[k] * nParam_ + pDenominators_[k - 1];
+                }
+                pDenominators_[0] = pDenominators_[0] * nParam_ + _pWeightCoefficients[j];
+            }
+        }
+
+        double _nScale = 1.0;
+        for (int k = 1; k <= nOrder_; ++k) {
+            _nScale *= k * m_vecSpanAlphas[nSpanIndex_];
+            pNumerators_[k] *= _nScale;
+            pDenominators_[k] *= _nScale;
+        }
+
+        if (!m_bRational) {
+            for (int k = 0; k <= nOrder_; ++k) {
+                pDerivs_[k] = pNumerators_[k];
+            }
+            return;
+        }
+
+        // C(k) = (A(k) - sum(C(k, i) * w(i) * C(k - i))) / w
+        double _nReciprocal = 1.0 / pDenominators_[0];
+        for (int k = 0; k <= nOrder_; ++k) {
+            double _nBinomial = 1.0;
+            for (int i = 1; i <= k; ++i) {
+                _nBinomial = _nBinomial * (k - i + 1) / i;
+                pNumerators_[k] -= pDerivs_[k - i] * (_nBinomial * pDenominators_[i]);
+            }
+            pDerivs_[k] = pNumerators_[k] * _nReciprocal;
+        }
+    }
+
+} // End namespace neat
+
+#endif // __NURBS_POWER_PARSER_H_20200302__
\ No newline at end of file
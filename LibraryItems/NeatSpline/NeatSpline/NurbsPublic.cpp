@@ -16,6 +16,43 @@ using namespace neat;
 
 //////////////////////////////////////////////////////////////////////////
 // global function
+void neat::CheckUniformKnots(const VECDOUBLE& vecKnots_, int nStartIndex_, int nEndIndex_, UniformKnots& UniformKnots_)
+{
+    UniformKnots_.bUniform = false;
+    UniformKnots_.nReciprocal = 0.0;
+    if (nEndIndex_ <= nStartIndex_) {
+        return;
+    }
+
+    double _nLength = (vecKnots_[nEndIndex_] - vecKnots_[nStartIndex_]) / (nEndIndex_ - nStartIndex_);
+    if (DOUBLE_EQU_ZERO(_nLength)) {
+        return;
+    }
+
+    for (int i = nStartIndex_ + 1; i < nEndIndex_; ++i) {
+        if (!DOUBLE_EQU(vecKnots_[i], vecKnots_[nStartIndex_] + (i - nStartIndex_) * _nLength)) {
+            return;
+        }
+    }
+
+    UniformKnots_.bUniform = true;
+    UniformKnots_.nReciprocal = 1.0 / _nLength;
+}
+
+void neat::CheckBatchKnots(const VECDOUBLE& vecKnots_, const double* pKnots_, size_t nCount_, int nStartIndex_, int nEndIndex_)
+{
+    if (nCount_ == 0) {
+        return;
+    }
+
+    // The ascending parameters are within the valid knots if the first and last ones are
+    for (size_t i = 1; i < nCount_; ++i) {
+        NEAT_RAISE(pKnots_[i] < pKnots_[i - 1], g_strNurbsParamsError);
+    }
+
+    NEAT_RAISE(pKnots_[0] < vecKnots_[nStartIndex_] || pKnots_[nCount_ - 1] > vecKnots_[nEndIndex_], g_strNurbsParamsError);
+}
+
 int neat::FindSpanForKnot(const VECDOUBLE& vecKnots_, double nKnot_, int nStartIndex_, int nEndIndex_, int& nCacheIndex_)
 {
     NEAT_RAISE_IF(nKnot_ < vecKnots_[nStartIndex_] || nKnot_ > vecKnots_[nEndIndex_], g_strNurbsParamsError);
@@ -27,6 +64,10 @@ int neat::FindSpanForKnot(const VECDOUBLE& vecKnots_, double nKnot_, int nStartI
 
     // the last knot
     if (DOUBLE_EQU(nKnot_, vecKnots_[nEndIndex_])) {
+        if (DOUBLE_EQU(vecKnots_[nCacheIndex_ + 1], vecKnots_[nEndIndex_]) && !DOUBLE_EQU(vecKnots_[nCacheIndex_], vecKnots_[nEndIndex_])) {
+            return nCacheIndex_;
+        }
+
         int _nKnotIndex = nEndIndex_ - 1;
         while (DOUBLE_EQU(vecKnots_[_nKnotIndex], vecKnots_[nEndIndex_])) {
             --_nKnotIndex;
@@ -36,9 +77,30 @@ int neat::FindSpanForKnot(const VECDOUBLE& vecKnots_, double nKnot_, int nStartI
         return nCacheIndex_;
     }
 
+    // search from cache by doubling steps until U_low <= nKnot_ < U_high
+    int _nLow = nCacheIndex_;
+    int _nHigh = nCacheIndex_ + 1;
+    int _nStep = 1;
+    if (nKnot_ < vecKnots_[nCacheIndex_]) {
+        _nHigh = nCacheIndex_;
+        _nLow = _nHigh - 1 > nStartIndex_ ? _nHigh - 1 : nStartIndex_;
+        while (_nLow > nStartIndex_ && nKnot_ < vecKnots_[_nLow]) {
+            _nHigh = _nLow;
+            _nStep *= 2;
+            _nLow = _nHigh - _nStep > nStartIndex_ ? _nHigh - _nStep : nStartIndex_;
+        }
+    }
+    else {
+        _nLow = nCacheIndex_ + 1;
+        _nHigh = _nLow + 1 < nEndIndex_ ? _nLow + 1 : nEndIndex_;
+        while (_nHigh < nEndIndex_ && nKnot_ >= vecKnots_[_nHigh]) {
+            _nLow = _nHigh;
+            _nStep *= 2;
+            _nHigh = _nLow + _nStep < nEndIndex_ ? _nLow + _nStep : nEndIndex_;
+        }
+    }
+
     // search by dichotomy
-    int _nLow = nStartIndex_;
-    int _nHigh = nEndIndex_;
     int _nMid = (_nLow & _nHigh) + ((_nLow ^ _nHigh) >> 1);
     while (true) {
         if (nKnot_ < vecKnots_[_nMid]) {
@@ -56,4 +118,27 @@ int neat::FindSpanForKnot(const VECDOUBLE& vecKnots_, double nKnot_, int nStartI
 
     nCacheIndex_ = _nMid;
     return nCacheIndex_;
+}
+
+int neat::FindSpanForKnot(const VECDOUBLE& vecKnots_, double nKnot_, int nStartIndex_, int nEndIndex_, const UniformKnots& UniformKnots_,
+    int& nCacheIndex_)
+{
+    if (UniformKnots_.bUniform && nKnot_ >= vecKnots_[nStartIndex_] && nKnot_ < vecKnots_[nEndIndex_]) {
+        // The rounding error moves the calculated span by one at most
+        int _nKnotIndex = nStartIndex_ + static_cast<int>((nKnot_ - vecKnots_[nStartIndex_]) * UniformKnots_.nReciprocal);
+        _nKnotIndex = _nKnotIndex < nEndIndex_ ? _nKnotIndex : nEndIndex_ - 1;
+        if (nKnot_ < vecKnots_[_nKnotIndex] && _nKnotIndex > nStartIndex_) {
+            --_nKnotIndex;
+        }
+        else if (nKnot_ >= vecKnots_[_nKnotIndex + 1] && _nKnotIndex + 1 < nEndIndex_) {
+            ++_nKnotIndex;
+        }
+
+        if (nKnot_ >= vecKnots_[_nKnotIndex] && nKnot_ < vecKnots_[_nKnotIndex + 1]) {
+            nCacheIndex_ = _nKnotIndex;
+            return nCacheIndex_;
+        }
+    }
+
+    return FindSpanForKnot(vecKnots_, nKnot_, nStartIndex_, nEndIndex_, nCacheIndex_);
 }
\ No newline at end of file
@@ -32,11 +32,6 @@ namespace neat
 #define DOUBLE_EQU(x, y)    Precision::IsAlmostEqual(x, y, Precision::RealTolerance())
 #define DOUBLE_EQU_ZERO(x)  DOUBLE_EQU(x, 0.0)
 
-    /**
-     * Type definition
-     */
-    typedef CAxisPoint<double, 4> DPOINT4;
-
     /**
      * Check if nurbs node is rational
      */
@@ -87,9 +82,110 @@ namespace neat
         pNurbsNode_->vecWeights = pBezierNode_->vecWeights;
     }
 
-    // Return the span i of nKnot_ (U_i <= nKnot_ < U_i+1)
+    /**
+     * Get the square distance from the point to the segment between the start point and end point
+     */
+    template<typename TYPE>
+    double GetSquareSegmentDistance(const TYPE& ptPoint_, const TYPE& ptStartPoint_, const TYPE& ptEndPoint_)
+    {
+        TYPE _ptSegment = ptEndPoint_ - ptStartPoint_;
+        TYPE _ptVector = ptPoint_ - ptStartPoint_;
+        double _nSquareLength = _ptSegment.GetSquareLength();
+        double _nProjection = DotProduct(_ptVector, _ptSegment);
+        if (_nProjection <= 0.0 || _nSquareLength <= 0.0) {
+            return _ptVector.GetSquareLength();
+        }
+
+        if (_nProjection >= _nSquareLength) {
+            return (ptPoint_ - ptEndPoint_).GetSquareLength();
+        }
+
+        double _nSquareDistance = _ptVector.GetSquareLength() - _nProjection * _nProjection / _nSquareLength;
+        return _nSquareDistance > 0.0 ? _nSquareDistance : 0.0;
+    }
+
+    /**
+     * Convert the bezier poles of nDegree_ to the coefficients of power basis.
+     */
+    template<typename VALUE>
+    void ConvertBezierToPower(const VALUE* pPoles_, int nDegree_, VALUE* pCoefficients_)
+    {
+        // a[j] = C(n, j) * sum((-1) ^ (j - i) * C(j, i) * P[i]), i = 0, ..., j
+        double _nBinomial = 1.0;
+        for (int j = 0; j <= nDegree_; ++j) {
+            VALUE _Sum = VALUE();
+            double _nInnerBinomial = 1.0;
+            for (int i = 0; i <= j; ++i) {
+                _Sum += pPoles_[i] * ((j - i) % 2 == 0 ? _nInnerBinomial : -_nInnerBinomial);
+                _nInnerBinomial = _nInnerBinomial * (j - i) / (i + 1);
+            }
+
+            pCoefficients_[j] = _Sum * _nBinomial;
+            _nBinomial = _nBinomial * (nDegree_ - j) / (j + 1);
+        }
+    }
+
+    /**
+     * Initialize in pDiffs_ the forward differences of the polynomial from the normalized parameter nParam_ by nStep_.
+     */
+    template<typename VALUE>
+    void InitForwardDiffs(const VALUE* pCoefficients_, int nDegree_, double nParam_, double nStep_, VALUE* pDiffs_)
+    {
+        // Shift the polynomial to nParam_ and scale it by nStep_, then p(s) = sum(d[j] * s ^ j) for the step s
+        for (int j = 0; j <= nDegree_; ++j) {
+            pDiffs_[j] = pCoefficients_[j];
+        }
+        for (int k = 0; k < nDegree_; ++k) {
+            for (int j = nDegree_ - 1; j >= k; --j) {
+                pDiffs_[j] += pDiffs_[j + 1] * nParam_;
+            }
+        }
+
+        double _nScale = 1.0;
+        for (int j = 1; j <= nDegree_; ++j) {
+            _nScale *= nStep_;
+            pDiffs_[j] *= _nScale;
+        }
+
+        // Convert to newton form on the steps 0, 1, ..., and the k-order forward difference is k! times the k-th coefficient.
+        // It avoids the cancellation of differencing the sampled values.
+        for (int k = 1; k < nDegree_; ++k) {
+            for (int j = nDegree_ - 1; j >= k; --j) {
+                pDiffs_[j] += pDiffs_[j + 1] * static_cast<double>(k);
+            }
+        }
+
+        double _nFactorial = 1.0;
+        for (int k = 2; k <= nDegree_; ++k) {
+            _nFactorial *= k;
+            pDiffs_[k] *= _nFactorial;
+        }
+    }
+
+    /**
+     * The uniformity of the valid knots, the span of uniform knots is calculated directly.
+     * The repeated end knots of clamped nurbs node are not valid knots, so the quasi-uniform knots are uniform too.
+     */
+    struct UniformKnots
+    {
+        bool bUniform = false;      // All valid spans have the same length
+        double nReciprocal = 0.0;   // The reciprocal of span length
+    };
+
+    // Check if the valid knots from nStartIndex_ to nEndIndex_ are uniform.
+    void CheckUniformKnots(const VECDOUBLE& vecKnots_, int nStartIndex_, int nEndIndex_, UniformKnots& UniformKnots_);
+
+    // Check the nCount_ batch parameters pKnots_ are in ascending order and within the valid knots from nStartIndex_ to nEndIndex_.
+    void CheckBatchKnots(const VECDOUBLE& vecKnots_, const double* pKnots_, size_t nCount_, int nStartIndex_, int nEndIndex_);
+
+    // Return the span i of nKnot_ (U_i <= nKnot_ < U_i+1), nCacheIndex_ is the cursor of the last span.
+    // The span is searched from the cursor by doubling steps, so the neighbouring span of monotone parameters costs O(1).
     int FindSpanForKnot(const VECDOUBLE& vecKnots_, double nKnot_, int nStartIndex_, int nEndIndex_, int& nCacheIndex_);
 
+    // Return the span i of nKnot_, which is calculated directly for uniform knots.
+    int FindSpanForKnot(const VECDOUBLE& vecKnots_, double nKnot_, int nStartIndex_, int nEndIndex_, const UniformKnots& UniformKnots_,
+        int& nCacheIndex_);
+
 } // End namespace neat
 
 #endif // __NURBS_PUBLIC_H_20200130__
\ No newline at end of file
@@ -31,6 +31,9 @@ namespace neat
         // Set the information for nurbs node.
         void SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_, bool bRational_);
 
+        // Set the information for compiled nurbs curve, which is not checked any more.
+        void SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_);
+
         // Divide nurbs node in the given knots and repeated knots, and return nurbs node subsection.
         CFastVector<NurbsNode<TYPE>>* DivideNurbs(const CFastVector<double>& vecDivideKnots_);
 
@@ -107,6 +110,20 @@ namespace neat
         m_nKnotIndex = m_nStartIndex;
     }
 
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsRefiner<TYPE, TYPEEX>::SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_)
+    {
+        NEAT_RAISE_IF(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+
+        m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsCurve_->GetNurbsNode();
+        m_bRational = pNurbsCurve_->IsRational();
+
+        // Initialize the knot index limit value
+        m_nStartIndex = pNurbsCurve_->GetStartIndex();
+        m_nEndIndex = pNurbsCurve_->GetEndIndex();
+        m_nKnotIndex = m_nStartIndex;
+    }
+
     template<typename TYPE, typename TYPEEX>
     CFastVector<NurbsNode<TYPE>>* CNurbsRefiner<TYPE, TYPEEX>::DivideNurbs(const CFastVector<double>& vecDivideKnots_)
     {
@@ -0,0 +1,347 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __NURBS_CURVE_H_20200302__
+#define __NURBS_CURVE_H_20200302__
+
+/**
+ * This file defines the compiled nurbs curve.
+ */
+namespace neat
+{
+    /**
+     * The compiled nurbs curve: the nurbs node is copied, validated and classified only once,
+     * so the parsers, scatter and refiner can use it without checking the nurbs node again.
+     * The evaluation functions are const, and the span and scratch poles are kept in the context owned by the caller.
+     */
+    template<typename TYPE>
+    class CNurbsCurve
+    {
+    public:
+        CNurbsCurve(const NurbsNode<TYPE>* pNurbsNode_);
+        ~CNurbsCurve();
+
+        // Returns the compiled nurbs node.
+        const NurbsNode<TYPE>* GetNurbsNode() const { return &m_NurbsNode; }
+
+        // Returns true if the nurbs node is rational.
+        bool IsRational() const { return m_bRational; }
+
+        // Returns the index limit value of the valid knots.
+        int GetStartIndex() const { return m_nStartIndex; }
+        int GetEndIndex() const { return m_nEndIndex; }
+
+        // Returns the uniformity of the valid knots.
+        const UniformKnots& GetUniformKnots() const { return m_UniformKnots; }
+
+        // Returns the unique knots and their multiplicities.
+        const VECDOUBLE& GetUniqueKnots() const { return m_vecUniqueKnots; }
+        const std::vector<int>& GetMultiplicities() const { return m_vecMultiplicities; }
+
+        // Returns the poles with weights, which is empty for non rational nurbs node.
+        const CFastVector<TYPE>& GetWeightedPoles() const { return m_vecWeightedPoles; }
+
+        // Returns the homogeneous poles of vectorized kernel, which is null if the nurbs node has no vectorized kernel.
+        const DPOINT4* GetHomogeneousPoles() const { return m_vecHomogeneousPoles.empty() ? nullptr : m_vecHomogeneousPoles.data(); }
+
+        // Returns in ptPoint_ the point of parameter nKnot_.
+        void GetNurbsPoint(double nKnot_, NurbsContext<TYPE>& NurbsContext_, TYPE& ptPoint_) const;
+
+        // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, NurbsContext<TYPE>& NurbsContext_, TYPE& ptPoint_, TYPE& ptDeriv1_) const;
+
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative.
+        void GetNurbsDeriv(double nKnot_, NurbsContext<TYPE>& NurbsContext_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_) const;
+
+    private:
+        CNurbsCurve(const CNurbsCurve&) = delete;
+        CNurbsCurve& operator=(const CNurbsCurve&) = delete;
+
+        // Find the span of nKnot_ starting from the span recorded in the context.
+        int LocateSpan(double nKnot_, NurbsContext<TYPE>& NurbsContext_) const;
+
+        // Calculate the derivatives of numerator and denominator up to nOrder_ (no more than 2) with the scratch poles,
+        // the denominator of non rational nurbs node is always 1.
+        void CalculateHomogeneousDeriv(double nKnot_, int nKnotIndex_, int nOrder_, NurbsContext<TYPE>& NurbsContext_,
+            TYPE* pNumeratorDeriv_, double* pDenominatorDeriv_) const;
+
+        // De-Boor recursive algorithm from level nStartLevel_ + 1 to level nEndLevel_, pKnots_ points to the knot of span.
+        void DeBoorAlgorithm(const double* pKnots_, double nKnot_, int nStartLevel_, int nEndLevel_, TYPE* pPoles_,
+            double* pWeights_) const;
+
+    private:
+        NurbsNode<TYPE> m_NurbsNode;
+        int m_nStartIndex;
+        int m_nEndIndex;
+        bool m_bRational;
+        UniformKnots m_UniformKnots;
+
+        // The unique knots and their multiplicities
+        VECDOUBLE m_vecUniqueKnots;
+        std::vector<int> m_vecMultiplicities;
+
+        // The weighted poles
+        CFastVector<TYPE> m_vecWeightedPoles;
+
+        // The homogeneous poles (wx, wy, wz, w) of three-dimensional rational nurbs node
+        std::vector<DPOINT4> m_vecHomogeneousPoles;
+    };
+
+    /**
+     * The implementation pointer of compiled nurbs curve.
+     */
+    class CNurbsCurvePointer final
+    {
+    public:
+        CNurbsCurvePointer(const NurbsNode2D* pNurbsNode_);
+        CNurbsCurvePointer(const NurbsNode3D* pNurbsNode_);
+        ~CNurbsCurvePointer();
+
+        const CNurbsCurve<DPOINT2>* GetNurbsCurve2D() const { return m_pNurbsCurve2D; }
+        const CNurbsCurve<DPOINT3>* GetNurbsCurve3D() const { return m_pNurbsCurve3D; }
+
+        // Returns the compiled nurbs curve of the interface.
+        static const CNurbsCurve<DPOINT2>* GetNurbsCurve(const CNurbsCurve2D* pNurbsCurve_);
+        static const CNurbsCurve<DPOINT3>* GetNurbsCurve(const CNurbsCurve3D* pNurbsCurve_);
+
+    private:
+        CNurbsCurvePointer(const CNurbsCurvePointer&) = delete;
+        CNurbsCurvePointer& operator=(const CNurbsCurvePointer&) = delete;
+
+        CNurbsCurve<DPOINT2>* m_pNurbsCurve2D;
+        CNurbsCurve<DPOINT3>* m_pNurbsCurve3D;
+    };
+
+    /**
+     * The implementation of template class.
+     */
+    template<typename TYPE>
+    CNurbsCurve<TYPE>::CNurbsCurve(const NurbsNode<TYPE>* pNurbsNode_)
+        : m_nStartIndex(0)
+        , m_nEndIndex(0)
+        , m_bRational(false)
+    {
+        // Check if nurbs node is legal and rational
+        m_bRational = CheckNurbsNodeRational(pNurbsNode_);
+        m_NurbsNode = *pNurbsNode_;
+
+        const VECDOUBLE& _vecKnots = m_NurbsNode.vecKnots;
+        for (size_t i = 1, _nSize = _vecKnots.size(); i < _nSize; ++i) {
+            NEAT_RAISE(_vecKnots[i] < _vecKnots[i - 1], g_strNurbsParamsError);
+        }
+
+        // Initialize the knot index limit value
+        m_nStartIndex = m_NurbsNode.nDegree;
+        m_nEndIndex = static_cast<int>(_vecKnots.size()) - m_NurbsNode.nDegree - 1;
+        NEAT_RAISE(DOUBLE_EQU(_vecKnots[m_nStartIndex], _vecKnots[m_nEndIndex]), g_strNurbsParamsError);
+        CheckUniformKnots(_vecKnots, m_nStartIndex, m_nEndIndex, m_UniformKnots);
+
+        // Classify the unique knots
+        for (size_t i = 0, _nSize = _vecKnots.size(); i < _nSize; ++i) {
+            if (m_vecUniqueKnots.empty() || !DOUBLE_EQU(_vecKnots[i], m_vecUniqueKnots.back())) {
+                m_vecUniqueKnots.push_back(_vecKnots[i]);
+                m_vecMultiplicities.push_back(1);
+            }
+            else {
+                ++m_vecMultiplicities.back();
+            }
+        }
+
+        // Construct the poles with weights.
+        if (m_bRational) {
+            for (size_t i = 0, _nSize = m_NurbsNode.vecPoles.size(); i < _nSize; ++i) {
+                m_vecWeightedPoles.push_back(m_NurbsNode.vecPoles[i] * m_NurbsNode.vecWeights[i]);
+            }
+            UpgradeHomogeneousPoles(m_NurbsNode, m_vecHomogeneousPoles);
+        }
+    }
+
+    template<typename TYPE>
+    CNurbsCurve<TYPE>::~CNurbsCurve()
+    {
+    }
+
+    template<typename TYPE>
+    void CNurbsCurve<TYPE>::GetNurbsPoint(double nKnot_, NurbsContext<TYPE>& NurbsContext_, TYPE& ptPoint_) const
+    {
+        int _nKnotIndex = LocateSpan(nKnot_, NurbsContext_);
+        const int& _nDegree = m_NurbsNode.nDegree;
+        const double* _pKnots = m_NurbsNode.vecKnots.data();
+
+        // Low degree is calculated by the specialized kernel, and rational curve by the vectorized kernel first
+        if (!m_bRational) {
+            if (DeBoorKernelPoint(_nDegree, _pKnots, m_NurbsNode.vecPoles.data(), _nKnotIndex, nKnot_, ptPoint_)) {
+                return;
+            }
+        }
+        else if (HomogeneousKernelPoint(_nDegree, _pKnots, GetHomogeneousPoles(), _nKnotIndex, nKnot_, ptPoint_)
+            || DeBoorKernelRationalPoint(_nDegree, _pKnots, m_NurbsNode.vecPoles.data(), m_NurbsNode.vecWeights.data(),
+            _nKnotIndex, nKnot_, ptPoint_)) {
+            return;
+        }
+
+        TYPE _ptxNumeratorDeriv[1];
+        double _nxDenominatorDeriv[1];
+        CalculateHomogeneousDeriv(nKnot_, _nKnotIndex, 0, NurbsContext_, _ptxNumeratorDeriv, _nxDenominatorDeriv);
+        ptPoint_ = _ptxNumeratorDeriv[0] / _nxDenominatorDeriv[0];
+    }
+
+    template<typename TYPE>
+    void CNurbsCurve<TYPE>::GetNurbsDeriv(double nKnot_, NurbsContext<TYPE>& NurbsContext_, TYPE& ptPoint_, TYPE& ptDeriv1_) const
+    {
+        int _nKnotIndex = LocateSpan(nKnot_, NurbsContext_);
+        const int& _nDegree = m_NurbsNode.nDegree;
+        const double* _pKnots = m_NurbsNode.vecKnots.data();
+
+        if (!m_bRational) {
+            if (DeBoorKernelDeriv(_nDegree, _pKnots, m_NurbsNode.vecPoles.data(), _nKnotIndex, nKnot_, ptPoint_, ptDeriv1_)) {
+                return;
+            }
+        }
+        else if (HomogeneousKernelDeriv(_nDegree, _pKnots, GetHomogeneousPoles(), _nKnotIndex, nKnot_, ptPoint_, ptDeriv1_)
+            || DeBoorKernelRationalDeriv(_nDegree, _pKnots, m_NurbsNode.vecPoles.data(), m_NurbsNode.vecWeights.data(),
+            _nKnotIndex, nKnot_, ptPoint_, ptDeriv1_)) {
+            return;
+        }
+
+        TYPE _ptxNumeratorDeriv[2];
+        double _nxDenominatorDeriv[2];
+        CalculateHomogeneousDeriv(nKnot_, _nKnotIndex, 1, NurbsContext_, _ptxNumeratorDeriv, _nxDenominatorDeriv);
+
+        double _nAlpha = 1.0 / _nxDenominatorDeriv[0];
+        ptPoint_ = _ptxNumeratorDeriv[0] * _nAlpha;
+        ptDeriv1_ = (_ptxNumeratorDeriv[1] - ptPoint_ * _nxDenominatorDeriv[1]) * _nAlpha;
+    }
+
+    template<typename TYPE>
+    void CNurbsCurve<TYPE>::GetNurbsDeriv(double nKnot_, NurbsContext<TYPE>& NurbsContext_, TYPE& ptPoint_, TYPE& ptDeriv1_,
+        TYPE& ptDeriv2_) const
+    {
+        NEAT_RAISE(m_NurbsNode.nDegree < 2, g_strWrongNurbsDegree);
+
+        int _nKnotIndex = LocateSpan(nKnot_, NurbsContext_);
+        const int& _nDegree = m_NurbsNode.nDegree;
+        const double* _pKnots = m_NurbsNode.vecKnots.data();
+
+        TYPE _ptxNumeratorDeriv[3];
+        double _nxDenominatorDeriv[3];
+        if (!m_bRational) {
+            if (DeBoorKernelDeriv(_nDegree, _pKnots, m_NurbsNode.vecPoles.data(), _nKnotIndex, nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_)) {
+                return;
+            }
+
+            CalculateHomogeneousDeriv(nKnot_, _nKnotIndex, 2, NurbsContext_, _ptxNumeratorDeriv, _nxDenominatorDeriv);
+        }
+        else if (HomogeneousKernelDeriv(_nDegree, _pKnots, GetHomogeneousPoles(), _nKnotIndex, nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_)) {
+            return;
+        }
+        else if (!DeBoorKernelHomogeneousDeriv(_nDegree, _pKnots, &m_vecWeightedPoles[0], m_NurbsNode.vecWeights.data(),
+            _nKnotIndex, nKnot_, _ptxNumeratorDeriv, _nxDenominatorDeriv)) {
+            CalculateHomogeneousDeriv(nKnot_, _nKnotIndex, 2, NurbsContext_, _ptxNumeratorDeriv, _nxDenominatorDeriv);
+        }
+
+        double _nAlpha = 1.0 / _nxDenominatorDeriv[0];
+        ptPoint_ = _ptxNumeratorDeriv[0] * _nAlpha;
+        ptDeriv1_ = (_ptxNumeratorDeriv[1] - ptPoint_ * _nxDenominatorDeriv[1]) * _nAlpha;
+        ptDeriv2_ = (_ptxNumeratorDeriv[2] - 2.0 * ptDeriv1_ * _nxDenominatorDeriv[1] - ptPoint_ * _nxDenominatorDeriv[2]) * _nAlpha;
+    }
+
+    template<typename TYPE>
+    int CNurbsCurve<TYPE>::LocateSpan(double nKnot_, NurbsContext<TYPE>& NurbsContext_) const
+    {
+        NEAT_RAISE(nKnot_ < m_NurbsNode.vecKnots[m_nStartIndex] || nKnot_ > m_NurbsNode.vecKnots[m_nEndIndex], g_strNurbsParamsError);
+
+        // The context may be new or used by another curve
+        if (NurbsContext_.nKnotIndex < m_nStartIndex || NurbsContext_.nKnotIndex >= m_nEndIndex) {
+            NurbsContext_.nKnotIndex = m_nStartIndex;
+        }
+
+        return FindSpanForKnot(m_NurbsNode.vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_UniformKnots, NurbsContext_.nKnotIndex);
+    }
+
+    template<typename TYPE>
+    void CNurbsCurve<TYPE>::CalculateHomogeneousDeriv(double nKnot_, int nKnotIndex_, int nOrder_, NurbsContext<TYPE>& NurbsContext_,
+        TYPE* pNumeratorDeriv_, double* pDenominatorDeriv_) const
+    {
+        const int& _nDegree = m_NurbsNode.nDegree;
+        const double* _pKnots = m_NurbsNode.vecKnots.data() + nKnotIndex_;
+
+        // The scratch poles are only allocated when the context meets a higher degree
+        if (static_cast<int>(NurbsContext_.vecPoles.size()) <= _nDegree) {
+            NurbsContext_.vecPoles.resize(_nDegree + 1);
+            NurbsContext_.vecWeights.resize(_nDegree + 1);
+        }
+
+        TYPE* _pPoles = NurbsContext_.vecPoles.data();
+        double* _pWeights = m_bRational ? NurbsContext_.vecWeights.data() : nullptr;
+        for (int i = 0; i <= _nDegree; ++i) {
+            int _nPoleIndex = nKnotIndex_ - _nDegree + i;
+            _pPoles[i] = m_bRational ? m_vecWeightedPoles[_nPoleIndex] : m_NurbsNode.vecPoles[_nPoleIndex];
+            if (m_bRational) {
+                _pWeights[i] = m_NurbsNode.vecWeights[_nPoleIndex];
+            }
+        }
+
+        int _nLevel = 0;
+        double _nAlpha1 = _nDegree / (_pKnots[1] - _pKnots[0]);
+        if (nOrder_ >= 2) {
+            pNumeratorDeriv_[2] = TYPE();
+            pDenominatorDeriv_[2] = 0.0;
+            if (_nDegree >= 2) {
+                DeBoorAlgorithm(_pKnots, nKnot_, _nLevel, _nDegree - 2, _pPoles, _pWeights);
+                _nLevel = _nDegree - 2;
+
+                double _nAlpha2 = 1.0 / (_pKnots[2] - _pKnots[0]);
+                double _nAlpha3 = 1.0 / (_pKnots[1] - _pKnots[-1]);
+                pNumeratorDeriv_[2] = _nAlpha1 * (_nDegree - 1) * ((_pPoles[_nDegree] - _pPoles[_nDegree - 1]) * _nAlpha2
+                    - (_pPoles[_nDegree - 1] - _pPoles[_nDegree - 2]) * _nAlpha3);
+                if (m_bRational) {
+                    pDenominatorDeriv_[2] = _nAlpha1 * (_nDegree - 1) * ((_pWeights[_nDegree] - _pWeights[_nDegree - 1]) * _nAlpha2
+                        - (_pWeights[_nDegree - 1] - _pWeights[_nDegree - 2]) * _nAlpha3);
+                }
+            }
+        }
+
+        if (nOrder_ >= 1) {
+            DeBoorAlgorithm(_pKnots, nKnot_, _nLevel, _nDegree - 1, _pPoles, _pWeights);
+            _nLevel = _nDegree - 1;
+
+            pNumeratorDeriv_[1] = _nAlpha1 * (_pPoles[_nDegree] - _pPoles[_nDegree - 1]);
+            pDenominatorDeriv_[1] = m_bRational ? _nAlpha1 * (_pWeights[_nDegree] - _pWeights[_nDegree - 1]) : 0.0;
+        }
+
+        DeBoorAlgorithm(_pKnots, nKnot_, _nLevel, _nDegree, _pPoles, _pWeights);
+        pNumeratorDeriv_[0] = _pPoles[_nDegree];
+        pDenominatorDeriv_[0] = m_bRational ? _pWeights[_nDegree] : 1.0;
+    }
+
+    template<typename TYPE>
+    void CNurbsCurve<TYPE>::DeBoorAlgorithm(const double* pKnots_, double nKnot_, int nStartLevel_, int nEndLevel_, TYPE* pPoles_,
+        double* pWeights_) const
+    {
+        const int& _nDegree = m_NurbsNode.nDegree;
+
+        // The poles are updated from back to front, so only one array is needed
+        for (int i = nStartLevel_ + 1; i <= nEndLevel_; ++i) {
+            for (int j = _nDegree; j >= i; --j) {
+                double _nAlpha = (nKnot_ - pKnots_[j - _nDegree]) / (pKnots_[j + 1 - i] - pKnots_[j - _nDegree]);
+                pPoles_[j] = pPoles_[j - 1] * (1.0 - _nAlpha) + pPoles_[j] * _nAlpha;
+                if (pWeights_ != nullptr) {
+                    pWeights_[j] = pWeights_[j - 1] * (1.0 - _nAlpha) + pWeights_[j] * _nAlpha;
+                }
+            }
+        }
+    }
+
+} // End namespace neat
+
+#endif // __NURBS_CURVE_H_20200302__
\ No newline at end of file
@@ -28,6 +28,9 @@ namespace neat
         // Set the information for two-dimensional nurbs node.
         void SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_);
 
+        // Set the information for compiled nurbs curve.
+        void SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_);
+
         // Returns in ptPoint_ the point of parameter nKnot_.
         void GetNurbsPoint(double nKnot_, TYPE& ptPoint_);
 
@@ -37,12 +40,36 @@ namespace neat
         // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
         void GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
 
+        // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative, ptDeriv2_ the second-order derivative
+        // and ptDeriv3_ the third-order derivative of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_, TYPE& ptDeriv3_);
+
+        // Returns in pDerivs_[0] the point and pDerivs_[k] the k-order derivative (k <= nOrder_) of parameter nKnot_.
+        void GetNurbsDeriv(double nKnot_, int nOrder_, TYPE* pDerivs_);
+
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, TYPE* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_);
+
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_, TYPE* pDeriv2s_);
+
     private:
+        // Returns the sub parser which has been set with current nurbs node.
+        CNRBSplineParser<TYPE>* PrepareNRBSplineParser();
+        CRBSplineParser<TYPE>* PrepareRBSplineParser();
+        CRBSplineParser2<TYPE>* PrepareRBSplineParser2();
+        CNurbsDerivParser<TYPE>* PrepareNurbsDerivParser();
+
         NurbsNode<TYPE>* m_pNurbsNode;
+        const CNurbsCurve<TYPE>* m_pNurbsCurve;
         CNRBSplineParser<TYPE>* m_pNRBSplineParser;
         CRBSplineParser<TYPE>* m_pRBSplineParser;
         CRBSplineParser2<TYPE>* m_pRBSplineParser2;
-        bool m_bSetNurbsNode[3];
+        CNurbsDerivParser<TYPE>* m_pNurbsDerivParser;
+        bool m_bSetNurbsNode[4];
         bool m_bRational;
     };
 
@@ -52,12 +79,14 @@ namespace neat
     template<typename TYPE>
     CNurbsParser<TYPE>::CNurbsParser()
         : m_pNurbsNode(nullptr)
+        , m_pNurbsCurve(nullptr)
         , m_pNRBSplineParser(nullptr)
         , m_pRBSplineParser(nullptr)
         , m_pRBSplineParser2(nullptr)
+        , m_pNurbsDerivParser(nullptr)
         , m_bRational(false)
     {
-        for (int i = 0; i < 3; ++i) {
+        for (int i = 0; i < 4; ++i) {
             m_bSetNurbsNode[i] = false;
         }
     }
@@ -76,14 +105,32 @@ namespace neat
         if (m_pRBSplineParser2 != nullptr) {
             delete m_pRBSplineParser2;
         }
+
+        if (m_pNurbsDerivParser != nullptr) {
+            delete m_pNurbsDerivParser;
+        }
     }
 
     template<typename TYPE>
     void CNurbsParser<TYPE>::SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_)
     {
         m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsNode_;
+        m_pNurbsCurve = nullptr;
         m_bRational = CheckNurbsNodeRational(pNurbsNode_);
-        for (int i = 0; i < 3; ++i) {
+        for (int i = 0; i < 4; ++i) {
+            m_bSetNurbsNode[i] = false;
+        }
+    }
+
+    template<typename TYPE>
+    void CNurbsParser<TYPE>::SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_)
+    {
+        NEAT_RAISE(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+
+        m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsCurve_->GetNurbsNode();
+        m_pNurbsCurve = pNurbsCurve_;
+        m_bRational = pNurbsCurve_->IsRational();
+        for (int i = 0; i < 4; ++i) {
             m_bSetNurbsNode[i] = false;
         }
     }
@@ -93,29 +140,11 @@ namespace neat
     {
         if (!m_bRational) {
             // Non Rational BSpline curve
-            if (m_pNRBSplineParser == nullptr) {
-                m_pNRBSplineParser = new CNRBSplineParser<TYPE>();
-            }
-
-            if (!m_bSetNurbsNode[0]) {
-                m_pNRBSplineParser->SetNurbsNode(m_pNurbsNode, m_bRational);
-                m_bSetNurbsNode[0] = true;
-            }
-
-            m_pNRBSplineParser->GetNurbsPoint(nKnot_, ptPoint_);
+            PrepareNRBSplineParser()->GetNurbsPoint(nKnot_, ptPoint_);
         }
         else {
             // Rational BSpline curve: less less than first-order derivative.
-            if (m_pRBSplineParser == nullptr) {
-                m_pRBSplineParser = new CRBSplineParser<TYPE>();
-            }
-
-            if (!m_bSetNurbsNode[1]) {
-                m_pRBSplineParser->SetNurbsNode(m_pNurbsNode, m_bRational);
-                m_bSetNurbsNode[1] = true;
-            }
-
-            m_pRBSplineParser->GetNurbsPoint(nKnot_, ptPoint_);
+            PrepareRBSplineParser()->GetNurbsPoint(nKnot_, ptPoint_);
         }
     }
 
@@ -124,63 +153,174 @@ namespace neat
     {
         if (!m_bRational) {
             // Non Rational BSpline curve
-            if (m_pNRBSplineParser == nullptr) {
-                m_pNRBSplineParser = new CNRBSplineParser<TYPE>();
-            }
+            PrepareNRBSplineParser()->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+        }
+        else {
+            // Rational BSpline curve: less less than first-order derivative.
+            PrepareRBSplineParser()->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+        }
+    }
 
-            if (!m_bSetNurbsNode[0]) {
-                m_pNRBSplineParser->SetNurbsNode(m_pNurbsNode, m_bRational);
-                m_bSetNurbsNode[0] = true;
-            }
+    template<typename TYPE>
+    void CNurbsParser<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
+    {
+        if (!m_bRational) {
+            // Non Rational BSpline curve
+            CNRBSplineParser<TYPE>* _pNRBSplineParser = PrepareNRBSplineParser();
+            NEAT_RAISE(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
+            _pNRBSplineParser->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+        }
+        else {
+            // Rational BSpline curve: more than second-order derivative.
+            CRBSplineParser2<TYPE>* _pRBSplineParser2 = PrepareRBSplineParser2();
+            NEAT_RAISE(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
+            _pRBSplineParser2->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+        }
+    }
+
+    template<typename TYPE>
+    void CNurbsParser<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_, TYPE& ptDeriv3_)
+    {
+        TYPE _ptxDerivs[4];
+        PrepareNurbsDerivParser()->GetNurbsDeriv(nKnot_, 3, _ptxDerivs);
+        ptPoint_ = _ptxDerivs[0];
+        ptDeriv1_ = _ptxDerivs[1];
+        ptDeriv2_ = _ptxDerivs[2];
+        ptDeriv3_ = _ptxDerivs[3];
+    }
 
-            m_pNRBSplineParser->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+    template<typename TYPE>
+    void CNurbsParser<TYPE>::GetNurbsDeriv(double nKnot_, int nOrder_, TYPE* pDerivs_)
+    {
+        // Both Non Rational and Rational BSpline curve
+        PrepareNurbsDerivParser()->GetNurbsDeriv(nKnot_, nOrder_, pDerivs_);
+    }
+
+    template<typename TYPE>
+    void CNurbsParser<TYPE>::GetNurbsPoints(const double* pKnots_, size_t nCount_, TYPE* pPoints_)
+    {
+        if (!m_bRational) {
+            // Non Rational BSpline curve
+            PrepareNRBSplineParser()->GetNurbsPoints(pKnots_, nCount_, pPoints_);
         }
         else {
             // Rational BSpline curve: less less than first-order derivative.
-            if (m_pRBSplineParser == nullptr) {
-                m_pRBSplineParser = new CRBSplineParser<TYPE>();
-            }
-
-            if (!m_bSetNurbsNode[1]) {
-                m_pRBSplineParser->SetNurbsNode(m_pNurbsNode, m_bRational);
-                m_bSetNurbsNode[1] = true;
-            }
+            PrepareRBSplineParser()->GetNurbsPoints(pKnots_, nCount_, pPoints_);
+        }
+    }
 
-            m_pRBSplineParser->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_);
+    template<typename TYPE>
+    void CNurbsParser<TYPE>::GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_)
+    {
+        if (!m_bRational) {
+            // Non Rational BSpline curve
+            PrepareNRBSplineParser()->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
+        }
+        else {
+            // Rational BSpline curve: less less than first-order derivative.
+            PrepareRBSplineParser()->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_);
         }
     }
 
     template<typename TYPE>
-    void CNurbsParser<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
+    void CNurbsParser<TYPE>::GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_, TYPE* pDeriv2s_)
     {
         if (!m_bRational) {
             // Non Rational BSpline curve
-            if (m_pNRBSplineParser == nullptr) {
-                m_pNRBSplineParser = new CNRBSplineParser<TYPE>();
-            }
+            CNRBSplineParser<TYPE>* _pNRBSplineParser = PrepareNRBSplineParser();
+            NEAT_RAISE(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
+            _pNRBSplineParser->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+        }
+        else {
+            // Rational BSpline curve: more than second-order derivative.
+            CRBSplineParser2<TYPE>* _pRBSplineParser2 = PrepareRBSplineParser2();
+            NEAT_RAISE(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
+            _pRBSplineParser2->GetNurbsDerivs(pKnots_, nCount_, pPoints_, pDeriv1s_, pDeriv2s_);
+        }
+    }
 
-            if (!m_bSetNurbsNode[0]) {
+    template<typename TYPE>
+    CNRBSplineParser<TYPE>* CNurbsParser<TYPE>::PrepareNRBSplineParser()
+    {
+        if (m_pNRBSplineParser == nullptr) {
+            m_pNRBSplineParser = new CNRBSplineParser<TYPE>();
+        }
+
+        if (!m_bSetNurbsNode[0]) {
+            if (m_pNurbsCurve != nullptr) {
+                m_pNRBSplineParser->SetNurbsCurve(m_pNurbsCurve);
+            }
+            else {
                 m_pNRBSplineParser->SetNurbsNode(m_pNurbsNode, m_bRational);
-                m_bSetNurbsNode[0] = true;
             }
 
-            NEAT_RAISE(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
-            m_pNRBSplineParser->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+            m_bSetNurbsNode[0] = true;
         }
-        else {
-            // Rational BSpline curve: more than second-order derivative.
-            if (m_pRBSplineParser2 == nullptr) {
-                m_pRBSplineParser2 = new CRBSplineParser2<TYPE>();
+
+        return m_pNRBSplineParser;
+    }
+
+    template<typename TYPE>
+    CRBSplineParser<TYPE>* CNurbsParser<TYPE>::PrepareRBSplineParser()
+    {
+        if (m_pRBSplineParser == nullptr) {
+            m_pRBSplineParser = new CRBSplineParser<TYPE>();
+        }
+
+        if (!m_bSetNurbsNode[1]) {
+            if (m_pNurbsCurve != nullptr) {
+                m_pRBSplineParser->SetNurbsCurve(m_pNurbsCurve);
+            }
+            else {
+                m_pRBSplineParser->SetNurbsNode(m_pNurbsNode, m_bRational);
             }
 
-            if (!m_bSetNurbsNode[2]) {
+            m_bSetNurbsNode[1] = true;
+        }
+
+        return m_pRBSplineParser;
+    }
+
+    template<typename TYPE>
+    CRBSplineParser2<TYPE>* CNurbsParser<TYPE>::PrepareRBSplineParser2()
+    {
+        if (m_pRBSplineParser2 == nullptr) {
+            m_pRBSplineParser2 = new CRBSplineParser2<TYPE>();
+        }
+
+        if (!m_bSetNurbsNode[2]) {
+            if (m_pNurbsCurve != nullptr) {
+                m_pRBSplineParser2->SetNurbsCurve(m_pNurbsCurve);
+            }
+            else {
                 m_pRBSplineParser2->SetNurbsNode(m_pNurbsNode, m_bRational);
-                m_bSetNurbsNode[2] = true;
             }
 
-            NEAT_RAISE(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
-            m_pRBSplineParser2->GetNurbsDeriv(nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_);
+            m_bSetNurbsNode[2] = true;
+        }
+
+        return m_pRBSplineParser2;
+    }
+
+    template<typename TYPE>
+    CNurbsDerivParser<TYPE>* CNurbsParser<TYPE>::PrepareNurbsDerivParser()
+    {
+        if (m_pNurbsDerivParser == nullptr) {
+            m_pNurbsDerivParser = new CNurbsDerivParser<TYPE>();
         }
+
+        if (!m_bSetNurbsNode[3]) {
+            if (m_pNurbsCurve != nullptr) {
+                m_pNurbsDerivParser->SetNurbsCurve(m_pNurbsCurve);
+            }
+            else {
+                m_pNurbsDerivParser->SetNurbsNode(m_pNurbsNode, m_bRational);
+            }
+
+            m_bSetNurbsNode[3] = true;
+        }
+
+        return m_pNurbsDerivParser;
     }
 
 } // End namespace neat
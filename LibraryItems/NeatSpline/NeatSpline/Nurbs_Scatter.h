@@ -13,11 +13,75 @@
 #ifndef __NURBS_SCATTER_H_20200130__
 #define __NURBS_SCATTER_H_20200130__
 
+#include <atomic>
+#include <exception>
+
 /**
  * This file defines the scatter for nurbs node.
  */
 namespace neat
 {
+    /**
+     * Combine the collinear scatter nodes which are added one by one. If the tolerance is positive, the chord from last output
+     * node is extended while no more than MAX_SKIPPED_COUNT skipped nodes are within tolerance from the chord. The exactly
+     * collinear nodes are combined without limit, unless the limit is enabled to output a long straight run in pieces.
+     * Only the last two combined nodes and the skipped points are retained, the others are finalized and output at once. The
+     * chord is not extended beyond the max segment length if it's set.
+     */
+    template<typename TYPE>
+    class CCollinearCombiner
+    {
+    public:
+        CCollinearCombiner();
+        ~CCollinearCombiner();
+
+        // Start to combine, the finalized nodes are appended to pvecScatterNodes_ or sent to pScatterSink_.
+        void Reset(CFastVector<ScatterNode<TYPE>>* pvecScatterNodes_, const ScatterSink<TYPE>* pScatterSink_, double nTolerance_);
+
+        // Set the max length of combined chord, zero means no constraint. It's retained by the next reset.
+        void SetMaxSegmentLength(double nMaxSegmentLength_) { m_nMaxSegmentLength = nMaxSegmentLength_; }
+
+        // Enable to combine, otherwise every added node is output at once. It's retained by the next reset.
+        void EnableCombine(bool bEnable_) { m_bCombineEnabled = bEnable_; }
+
+        // Limit the exactly collinear nodes skipped by one chord to MAX_SKIPPED_COUNT until the next reset.
+        void EnableSkippedLimit() { m_bSkippedLimited = true; }
+
+        void AddScatterNode(const ScatterNode<TYPE>& ScatterNode_);
+
+        // Output the last node which is retained.
+        void Finish();
+
+    private:
+        void OutputScatterNode(const ScatterNode<TYPE>& ScatterNode_);
+        bool JudgeCollinearPoints(const TYPE& ptPoint1_, const TYPE& ptPoint2_, const TYPE& ptPoint3_);
+
+        // Judge whether the skipped points and current node are within tolerance from the chord between previous node and the point.
+        bool JudgeChordPoint(const TYPE& ptPoint_);
+
+        // Judge whether the chord between previous node and the point is within the max segment length.
+        bool JudgeSegmentLength(const TYPE& ptPoint_) const;
+
+    private:
+        enum { MAX_SKIPPED_COUNT = 64 };
+
+        CFastVector<ScatterNode<TYPE>>* m_pvecScatterNodes;
+        const ScatterSink<TYPE>* m_pScatterSink;
+        double m_nTolerance;
+        double m_nMaxSegmentLength;
+        bool m_bCombineEnabled;
+        bool m_bSkippedLimited;
+
+        // the points between previous node and current node, which are skipped by the chord
+        CFastVector<TYPE> m_vecSkippedPoints;
+        int m_nSkippedCount;
+
+        // the count of combined nodes, the previous node has been output and the current node may be replaced
+        int m_nCombinedCount;
+        ScatterNode<TYPE> m_PreScatterNode;
+        ScatterNode<TYPE> m_CurScatterNode;
+    };
+
     template<typename TYPE, typename TYPEEX>
     class CNurbsScatter
     {
@@ -28,40 +92,677 @@ namespace neat
         void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_, std::vector<TYPE>& vecScatterPoints_);
         void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_, std::vector<ScatterNode<TYPE>>& vecScatterNodes_);
 
+        void ScatterNurbs(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_, std::vector<TYPE>& vecScatterPoints_);
+        void ScatterNurbs(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_, std::vector<ScatterNode<TYPE>>& vecScatterNodes_);
+
+        // The scatter nodes are sent to the sink as soon as they are finalized, which is scattered by the calling thread.
+        void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_, const ScatterSink<TYPE>& ScatterSink_);
+        void ScatterNurbs(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_, const ScatterSink<TYPE>& ScatterSink_);
+
+        // Output the fields of scatter nodes selected by nFields_ of scatter_field to structure of arrays. The scatter nodes are sent
+        // to the arrays through the sink as soon as they are finalized, which is scattered by the calling thread.
+        void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_, int nFields_, ScatterArrays<TYPE>& ScatterArrays_);
+        void ScatterNurbs(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_, int nFields_, ScatterArrays<TYPE>& ScatterArrays_);
+
+        // Start to scatter step by step, and then get the scatter nodes one by one, which are the same as the scatter nodes in vector
+        // except that a long straight run is output in pieces.
+        // The other scatter functions can't be called until all scatter nodes are got.
+        void StartScatter(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_);
+        void StartScatter(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_);
+
+        // Get next scatter node, which only scatters until next scatter node is finalized. Returns false if all nodes are got.
+        bool NextScatterNode(ScatterNode<TYPE>& ScatterNode_);
+
+        // Set the number of threads which scatter the knot intervals of one nurbs node, the result is same as one thread.
+        void SetThreadCount(int nThreadCount_);
+
+        // Set the thread pool which is shared with other scatters, or nullptr to use the own thread pool.
+        void SetThreadPool(CScatterThreadPool* pThreadPool_);
+
+        // Set the ratio of deflection which is used to simplify the scatter nodes, the rest is used to scatter.
+        void SetSimplifyRatio(double nSimplifyRatio_);
+
+        // Enable to combine the collinear scatter nodes, the default is enabled. The disabled scatter nodes are not simplified either.
+        void EnableCollinearCombine(bool bEnable_);
+
+        // Enable to scatter the bezier spans by control polygon flatness, which is scattered by the calling thread.
+        void EnableFlatnessScatter(bool bEnable_);
+
+        // Set the max segment length and the max turning angle of scatter nodes besides deflection, zero means no constraint.
+        void SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_);
+
+        // Set the token to interrupt the scatter of one nurbs node, and get the status of the last scatter. The interrupted scatter
+        // outputs the scatter nodes before, the budget scatter, level scatter and scattering step by step are not interrupted.
+        void SetScatterToken(const ScatterToken* pScatterToken_);
+        int GetScatterStatus() const { return m_nScatterStatus; }
+
+        // Scatter nurbs nodes by the point budget, the segment with the largest estimated chord error of all nurbs nodes is
+        // divided first, until the point budget or the deflection is reached. It's scattered by the calling thread.
+        // The output of nurbs node i is from vecOffsets_[i] to vecOffsets_[i + 1] (not included).
+        void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            std::vector<TYPE>& vecScatterPoints_, std::vector<size_t>& vecOffsets_);
+        void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            std::vector<ScatterNode<TYPE>>& vecScatterNodes_, std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs node by several deflections in descending order in one pass, and output the nested levels of scatter nodes.
+        // vecLevels_ is the first level of every output, which is scattered by the calling thread, and the collinear nodes
+        // of every level are combined.
+        void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, const VECDOUBLE& vecDeflections_, std::vector<TYPE>& vecScatterPoints_,
+            std::vector<int>& vecLevels_);
+        void ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, const VECDOUBLE& vecDeflections_,
+            std::vector<ScatterNode<TYPE>>& vecScatterNodes_, std::vector<int>& vecLevels_);
+
+        // Scatter nurbs node again after its poles of given indexes are modified, vecScatterNodes_ is the previous scatter nodes.
+        // The pole i only affects the knot interval [u(i), u(i + degree + 1)], so only the knot intervals overlapping it are
+        // scattered again, and they are combined with the previous nodes on both sides before replacing the previous nodes.
+        void RescatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_, const std::vector<int>& vecPoleIndexes_,
+            std::vector<ScatterNode<TYPE>>& vecScatterNodes_);
+
     private:
-        CFastVector<ScatterNode<TYPE>>* DeflectNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_);
+        CNurbsScatter(const CNurbsScatter&) = delete;
+        CNurbsScatter& operator=(const CNurbsScatter&) = delete;
+
+        void OutputScatterPoints(double nDeflection_, std::vector<TYPE>& vecScatterPoints_);
+        void OutputScatterNodes(double nDeflection_, std::vector<ScatterNode<TYPE>>& vecScatterNodes_);
+        void OutputScatterSink(double nDeflection_, const ScatterSink<TYPE>& ScatterSink_);
+        void SinkScatterNodes(double nDeflection_, const ScatterSink<TYPE>& ScatterSink_);
+        void OutputScatterArrays(double nDeflection_, int nFields_, ScatterArrays<TYPE>& ScatterArrays_);
+        void StartScatterSteps(double nDeflection_);
+
+        // Append the fields of scatter node selected by m_nScatterFields to m_pScatterArrays, which is the sink of arrays output.
+        void AppendScatterArrays(const ScatterNode<TYPE>& ScatterNode_);
+        CFastVector<ScatterNode<TYPE>>* DeflectNurbs(double nDeflection_);
+        void CollectIntervals();
+
+        // Divide nurbs node in repeat knots, the nurbs node subsections are retained by the refiner.
+        CFastVector<NurbsNode<TYPE>>* DivideNurbs();
+        void SetOnlyGetPoints(bool bOnlyGetPoints_);
+        bool ScatterStep();
+
+        // Scatter the knot intervals in blocks by several threads, and join the scatter nodes of blocks in order.
+        void ParallelDeflectNurbs(double nDeflection_);
+        void DeflectBlocks(int nThreadIndex_, double nDeflection_);
         void CombineCollinearPoints(const CFastVector<ScatterNode<TYPE>>& vecScatterNodesIn_,
-            CFastVector<ScatterNode<TYPE>>& vecScatterNodesOut_);
-        bool JudgeCollinearPoints(const TYPE& ptPoint1_, const TYPE& ptPoint2_, const TYPE& ptPoint3_);
+            CFastVector<ScatterNode<TYPE>>& vecScatterNodesOut_, double nTolerance_);
+
+        // Scatter nurbs nodes by the point budget, and join the scatter nodes of every nurbs node to m_vecScatterNodes.
+        void BudgetDeflectNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, size_t nPointBudget_, double nDeflection_,
+            std::vector<size_t>& vecOffsets_);
+
+        // Scatter nurbs node by several deflections to m_vecScatterNodes, and output the first level of every scatter node.
+        void LevelDeflectNurbs(const VECDOUBLE& vecDeflections_, std::vector<int>& vecLevels_);
 
     private:
         CNurbsQuasiUniformDeflection<TYPE> m_NurbsQuasiUniformDeflection;
+        CBezierFlatnessDeflection<TYPE> m_BezierFlatnessDeflection;
         CNurbsRefiner<TYPE, TYPEEX> m_NurbsRefiner;
+        CCollinearCombiner<TYPE> m_CollinearCombiner;
+        ScatterSink<TYPE> m_CombinerSink;
+        ScatterSink<TYPE> m_ArraysSink;
+        ScatterArrays<TYPE>* m_pScatterArrays;
+        int m_nScatterFields;
+        TYPE m_ptLastArrayPoint;
         CFastVector<ScatterNode<TYPE>> m_vecScatterNodes;
         CFastVector<ScatterNode<TYPE>> m_vecTempScatterNodes;
         CFastVector<double> m_vecEmptyVector;
+        CFastVector<ScatterInterval<TYPE>> m_vecScatterIntervals;
+        bool m_bFlatnessScatter;
+
+        // The deflection of every thread except the calling thread, and the scatter nodes of every block.
+        int m_nThreadCount;
+        CScatterThreadPool m_ThreadPool;
+        CScatterThreadPool* m_pThreadPool;
+        bool m_bOnlyGetPoints;
+        double m_nSimplifyRatio;
+        double m_nMaxSegmentLength;
+        double m_nMaxTurningAngle;
+        std::vector<CNurbsQuasiUniformDeflection<TYPE>*> m_vecThreadDeflections;
+        std::vector<std::exception_ptr> m_vecThreadExceptions;
+        std::vector<CFastVector<ScatterNode<TYPE>>> m_vecBlockScatterNodes;
+        std::vector<int> m_vecBlockStatus;
+        std::atomic<int> m_nNextBlock;
+
+        // The finalized scatter nodes of scattering step by step, which are got from m_nReadyIndex.
+        CFastVector<ScatterNode<TYPE>> m_vecReadyScatterNodes;
+        int m_nReadyIndex;
+        bool m_bStepsFinished;
+
+        // The nurbs node subsections of budget scatter, and the first subsection and first interval of every nurbs node.
+        CFastVector<NurbsNode<TYPE>> m_vecBudgetNurbsNodes;
+        CFastVector<int> m_vecBudgetNodeStarts;
+        CFastVector<int> m_vecBudgetIntervalStarts;
+        CFastVector<int> m_vecIntervalOffsets;
+
+        // The first level of every scatter node of level scatter.
+        CFastVector<int> m_vecNodeLevels;
+
+        // The token to interrupt scattering, and the status of the last scatter.
+        const ScatterToken* m_pScatterToken;
+        int m_nScatterStatus;
     };
 
     /**
      * The implementation of template class.
      */
+    template<typename TYPE>
+    CCollinearCombiner<TYPE>::CCollinearCombiner()
+        : m_pvecScatterNodes(nullptr)
+        , m_pScatterSink(nullptr)
+        , m_nTolerance(0.0)
+        , m_nMaxSegmentLength(0.0)
+        , m_bCombineEnabled(true)
+        , m_bSkippedLimited(false)
+        , m_nSkippedCount(0)
+        , m_nCombinedCount(0)
+    {
+    }
+
+    template<typename TYPE>
+    CCollinearCombiner<TYPE>::~CCollinearCombiner()
+    {
+    }
+
+    template<typename TYPE>
+    void CCollinearCombiner<TYPE>::Reset(CFastVector<ScatterNode<TYPE>>* pvecScatterNodes_, const ScatterSink<TYPE>* pScatterSink_,
+        double nTolerance_)
+    {
+        m_pvecScatterNodes = pvecScatterNodes_;
+        m_pScatterSink = pScatterSink_;
+        m_nTolerance = nTolerance_;
+        m_nCombinedCount = 0;
+        m_vecSkippedPoints.clear();
+        m_nSkippedCount = 0;
+        m_bSkippedLimited = false;
+    }
+
+    template<typename TYPE>
+    void CCollinearCombiner<TYPE>::AddScatterNode(const ScatterNode<TYPE>& ScatterNode_)
+    {
+        if (!m_bCombineEnabled) {
+            OutputScatterNode(ScatterNode_);
+            return;
+        }
+
+        // start point
+        if (0 == m_nCombinedCount) {
+            m_CurScatterNode = ScatterNode_;
+            m_nCombinedCount = 1;
+            return;
+        }
+
+        // the second point is the first one which doesn't coincide with start point
+        if (1 == m_nCombinedCount) {
+            double _nLength = (ScatterNode_.ptPoint - m_CurScatterNode.ptPoint).GetLength();
+            if (DOUBLE_EQU_ZERO(_nLength)) {
+                return;
+            }
+        }
+        else if (m_nTolerance > 0.0) {
+            if (JudgeSegmentLength(ScatterNode_.ptPoint) && JudgeChordPoint(ScatterNode_.ptPoint)) {
+                m_vecSkippedPoints.push_back(m_CurScatterNode.ptPoint);
+                m_CurScatterNode = ScatterNode_;
+                return;
+            }
+        }
+        else if ((!m_bSkippedLimited || m_nSkippedCount < MAX_SKIPPED_COUNT) && JudgeSegmentLength(ScatterNode_.ptPoint)
+            && JudgeCollinearPoints(m_PreScatterNode.ptPoint, m_CurScatterNode.ptPoint, ScatterNode_.ptPoint)) {
+            m_CurScatterNode = ScatterNode_;
+            ++m_nSkippedCount;
+            return;
+        }
+
+        OutputScatterNode(m_CurScatterNode);
+        m_PreScatterNode = m_CurScatterNode;
+        m_CurScatterNode = ScatterNode_;
+        ++m_nCombinedCount;
+        m_vecSkippedPoints.clear();
+        m_nSkippedCount = 0;
+    }
+
+    template<typename TYPE>
+    void CCollinearCombiner<TYPE>::Finish()
+    {
+        if (m_nCombinedCount > 0) {
+            OutputScatterNode(m_CurScatterNode);
+        }
+
+        m_nCombinedCount = 0;
+    }
+
+    template<typename TYPE>
+    void CCollinearCombiner<TYPE>::OutputScatterNode(const ScatterNode<TYPE>& ScatterNode_)
+    {
+        if (m_pScatterSink != nullptr) {
+            (*m_pScatterSink)(ScatterNode_);
+        }
+        else {
+            m_pvecScatterNodes->push_back(ScatterNode_);
+        }
+    }
+
+    template<typename TYPE>
+    bool CCollinearCombiner<TYPE>::JudgeCollinearPoints(const TYPE& ptPoint1_, const TYPE& ptPoint2_, const TYPE& ptPoint3_)
+    {
+        double _nLength12 = (ptPoint2_ - ptPoint1_).GetLength();
+        double _nLength23 = (ptPoint3_ - ptPoint2_).GetLength();
+        double _nLength13 = (ptPoint3_ - ptPoint1_).GetLength();
+        return DOUBLE_EQU_ZERO(_nLength12 + _nLength23 - _nLength13);
+    }
+
+    template<typename TYPE>
+    bool CCollinearCombiner<TYPE>::JudgeChordPoint(const TYPE& ptPoint_)
+    {
+        if (static_cast<int>(m_vecSkippedPoints.size()) >= MAX_SKIPPED_COUNT) {
+            return false;
+        }
+
+        // The distance to chord is convex, so the chords between the skipped points are within tolerance too.
+        double _nSquareTolerance = m_nTolerance * m_nTolerance;
+        for (int i = 0, _nSize = static_cast<int>(m_vecSkippedPoints.size()); i <= _nSize; ++i) {
+            const TYPE& _ptSkippedPoint = (i < _nSize ? m_vecSkippedPoints[i] : m_CurScatterNode.ptPoint);
+            if (GetSquareSegmentDistance(_ptSkippedPoint, m_PreScatterNode.ptPoint, ptPoint_) > _nSquareTolerance) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename TYPE>
+    bool CCollinearCombiner<TYPE>::JudgeSegmentLength(const TYPE& ptPoint_) const
+    {
+        return m_nMaxSegmentLength <= 0.0
+            || (ptPoint_ - m_PreScatterNode.ptPoint).GetSquareLength() <= m_nMaxSegmentLength * m_nMaxSegmentLength;
+    }
+
     template<typename TYPE, typename TYPEEX>
     CNurbsScatter<TYPE, TYPEEX>::CNurbsScatter()
+        : m_pScatterArrays(nullptr)
+        , m_nScatterFields(0)
+        , m_bFlatnessScatter(false)
+        , m_nThreadCount(1)
+        , m_pThreadPool(&m_ThreadPool)
+        , m_bOnlyGetPoints(false)
+        , m_nSimplifyRatio(0.0)
+        , m_nMaxSegmentLength(0.0)
+        , m_nMaxTurningAngle(0.0)
+        , m_nNextBlock(0)
+        , m_nReadyIndex(0)
+        , m_bStepsFinished(true)
+        , m_pScatterToken(nullptr)
+        , m_nScatterStatus(scatter_status::finished)
     {
+        m_CombinerSink = [this](const ScatterNode<TYPE>& ScatterNode_) { m_CollinearCombiner.AddScatterNode(ScatterNode_); };
+        m_ArraysSink = [this](const ScatterNode<TYPE>& ScatterNode_) { AppendScatterArrays(ScatterNode_); };
     }
 
     template<typename TYPE, typename TYPEEX>
     CNurbsScatter<TYPE, TYPEEX>::~CNurbsScatter()
     {
+        for (auto _pDeflection : m_vecThreadDeflections) {
+            delete _pDeflection;
+        }
     }
 
     template<typename TYPE, typename TYPEEX>
     void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_, std::vector<TYPE>& vecScatterPoints_)
     {
-        m_NurbsQuasiUniformDeflection.SetOnlyGetPoints(true);
+        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, CheckNurbsNodeRational(pNurbsNode_));
+        OutputScatterPoints(nDeflection_, vecScatterPoints_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_,
+        std::vector<ScatterNode<TYPE>>& vecScatterNodes_)
+    {
+        NEAT_RAISE(pNurbsNode_->nDegree < 2, g_strWrongNurbsDegree);
+
+        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, CheckNurbsNodeRational(pNurbsNode_));
+        OutputScatterNodes(nDeflection_, vecScatterNodes_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_,
+        std::vector<TYPE>& vecScatterPoints_)
+    {
+        m_NurbsRefiner.SetNurbsCurve(pNurbsCurve_);
+        OutputScatterPoints(nDeflection_, vecScatterPoints_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_,
+        std::vector<ScatterNode<TYPE>>& vecScatterNodes_)
+    {
+        NEAT_RAISE(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(pNurbsCurve_->GetNurbsNode()->nDegree < 2, g_strWrongNurbsDegree);
+
+        m_NurbsRefiner.SetNurbsCurve(pNurbsCurve_);
+        OutputScatterNodes(nDeflection_, vecScatterNodes_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_,
+        const ScatterSink<TYPE>& ScatterSink_)
+    {
+        NEAT_RAISE(pNurbsNode_->nDegree < 2, g_strWrongNurbsDegree);
+
+        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, CheckNurbsNodeRational(pNurbsNode_));
+        OutputScatterSink(nDeflection_, ScatterSink_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_,
+        const ScatterSink<TYPE>& ScatterSink_)
+    {
+        NEAT_RAISE(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(pNurbsCurve_->GetNurbsNode()->nDegree < 2, g_strWrongNurbsDegree);
+
+        m_NurbsRefiner.SetNurbsCurve(pNurbsCurve_);
+        OutputScatterSink(nDeflection_, ScatterSink_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_, int nFields_,
+        ScatterArrays<TYPE>& ScatterArrays_)
+    {
+        NEAT_RAISE((nFields_ & (scatter_field::deriv2 | scatter_field::curvature)) != 0 && pNurbsNode_->nDegree < 2,
+            g_strWrongNurbsDegree);
+
+        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, CheckNurbsNodeRational(pNurbsNode_));
+        OutputScatterArrays(nDeflection_, nFields_, ScatterArrays_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_, int nFields_,
+        ScatterArrays<TYPE>& ScatterArrays_)
+    {
+        NEAT_RAISE(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE((nFields_ & (scatter_field::deriv2 | scatter_field::curvature)) != 0 && pNurbsCurve_->GetNurbsNode()->nDegree < 2,
+            g_strWrongNurbsDegree);
+
+        m_NurbsRefiner.SetNurbsCurve(pNurbsCurve_);
+        OutputScatterArrays(nDeflection_, nFields_, ScatterArrays_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::StartScatter(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_)
+    {
+        NEAT_RAISE(pNurbsNode_->nDegree < 2, g_strWrongNurbsDegree);
+
+        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, CheckNurbsNodeRational(pNurbsNode_));
+        StartScatterSteps(nDeflection_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::StartScatter(const CNurbsCurve<TYPE>* pNurbsCurve_, double nDeflection_)
+    {
+        NEAT_RAISE(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(pNurbsCurve_->GetNurbsNode()->nDegree < 2, g_strWrongNurbsDegree);
+
+        m_NurbsRefiner.SetNurbsCurve(pNurbsCurve_);
+        StartScatterSteps(nDeflection_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    bool CNurbsScatter<TYPE, TYPEEX>::NextScatterNode(ScatterNode<TYPE>& ScatterNode_)
+    {
+        while (m_nReadyIndex >= static_cast<int>(m_vecReadyScatterNodes.size())) {
+            if (m_bStepsFinished) {
+                return false;
+            }
+
+            m_vecReadyScatterNodes.clear();
+            m_nReadyIndex = 0;
+            if (ScatterStep()) {
+                // the scatter nodes except the last one are finalized by deflection
+                if (m_vecTempScatterNodes.size() > 1) {
+                    m_CollinearCombiner.AddScatterNode(m_vecTempScatterNodes.front());
+                    ScatterNode<TYPE> _LastScatterNode = m_vecTempScatterNodes.back();
+                    m_vecTempScatterNodes.clear();
+                    m_vecTempScatterNodes.push_back(_LastScatterNode);
+                }
+            }
+            else {
+                for (int i = 0, _nSize = static_cast<int>(m_vecTempScatterNodes.size()); i < _nSize; ++i) {
+                    m_CollinearCombiner.AddScatterNode(m_vecTempScatterNodes[i]);
+                }
+
+                m_CollinearCombiner.Finish();
+                m_bStepsFinished = true;
+            }
+        }
+
+        ScatterNode_ = m_vecReadyScatterNodes[m_nReadyIndex++];
+        return true;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::SetThreadCount(int nThreadCount_)
+    {
+        NEAT_RAISE(nThreadCount_ < 1, g_strWrongThreadCount);
+        m_nThreadCount = nThreadCount_;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::SetThreadPool(CScatterThreadPool* pThreadPool_)
+    {
+        m_pThreadPool = (pThreadPool_ != nullptr) ? pThreadPool_ : &m_ThreadPool;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::SetSimplifyRatio(double nSimplifyRatio_)
+    {
+        NEAT_RAISE(nSimplifyRatio_ < 0.0 || nSimplifyRatio_ >= 1.0, g_strWrongSimplifyRatio);
+        m_nSimplifyRatio = nSimplifyRatio_;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::EnableCollinearCombine(bool bEnable_)
+    {
+        m_CollinearCombiner.EnableCombine(bEnable_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::EnableFlatnessScatter(bool bEnable_)
+    {
+        m_bFlatnessScatter = bEnable_;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::SetSegmentConstraints(double nMaxSegmentLength_, double nMaxTurningAngle_)
+    {
+        NEAT_RAISE(nMaxSegmentLength_ < 0.0 || nMaxTurningAngle_ < 0.0, g_strWrongSegmentConstraints);
+        m_nMaxSegmentLength = nMaxSegmentLength_;
+        m_nMaxTurningAngle = nMaxTurningAngle_;
+        m_NurbsQuasiUniformDeflection.SetSegmentConstraints(nMaxSegmentLength_, nMaxTurningAngle_);
+        m_BezierFlatnessDeflection.SetSegmentConstraints(nMaxSegmentLength_, nMaxTurningAngle_);
+        m_CollinearCombiner.SetMaxSegmentLength(nMaxSegmentLength_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::SetScatterToken(const ScatterToken* pScatterToken_)
+    {
+        m_pScatterToken = pScatterToken_;
+        m_NurbsQuasiUniformDeflection.SetScatterToken(pScatterToken_);
+        m_BezierFlatnessDeflection.SetScatterToken(pScatterToken_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, size_t nPointBudget_,
+        double nDeflection_, std::vector<TYPE>& vecScatterPoints_, std::vector<size_t>& vecOffsets_)
+    {
+        SetOnlyGetPoints(true);
+        BudgetDeflectNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecOffsets_);
+
+        vecScatterPoints_.clear();
+        vecScatterPoints_.reserve(m_vecScatterNodes.size());
+        for (int i = 0, _nSize = static_cast<int>(m_vecScatterNodes.size()); i < _nSize; ++i) {
+            vecScatterPoints_.push_back(m_vecScatterNodes[i].ptPoint);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, size_t nPointBudget_,
+        double nDeflection_, std::vector<ScatterNode<TYPE>>& vecScatterNodes_, std::vector<size_t>& vecOffsets_)
+    {
+        for (size_t i = 0; i < nCount_; ++i) {
+            NEAT_RAISE(pNurbsNodes_[i].nDegree < 2, g_strWrongNurbsDegree);
+        }
+
+        SetOnlyGetPoints(false);
+        BudgetDeflectNurbs(pNurbsNodes_, nCount_, nPointBudget_, nDeflection_, vecOffsets_);
+
+        vecScatterNodes_.clear();
+        vecScatterNodes_.reserve(m_vecScatterNodes.size());
+        for (int i = 0, _nSize = static_cast<int>(m_vecScatterNodes.size()); i < _nSize; ++i) {
+            vecScatterNodes_.push_back(m_vecScatterNodes[i]);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, const VECDOUBLE& vecDeflections_,
+        std::vector<TYPE>& vecScatterPoints_, std::vector<int>& vecLevels_)
+    {
+        SetOnlyGetPoints(true);
+        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, CheckNurbsNodeRational(pNurbsNode_));
+        LevelDeflectNurbs(vecDeflections_, vecLevels_);
+
+        vecScatterPoints_.clear();
+        vecScatterPoints_.reserve(m_vecScatterNodes.size());
+        for (int i = 0, _nSize = static_cast<int>(m_vecScatterNodes.size()); i < _nSize; ++i) {
+            vecScatterPoints_.push_back(m_vecScatterNodes[i].ptPoint);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, const VECDOUBLE& vecDeflections_,
+        std::vector<ScatterNode<TYPE>>& vecScatterNodes_, std::vector<int>& vecLevels_)
+    {
+        NEAT_RAISE(pNurbsNode_->nDegree < 2, g_strWrongNurbsDegree);
+
+        SetOnlyGetPoints(false);
+        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, CheckNurbsNodeRational(pNurbsNode_));
+        LevelDeflectNurbs(vecDeflections_, vecLevels_);
+
+        vecScatterNodes_.clear();
+        vecScatterNodes_.reserve(m_vecScatterNodes.size());
+        for (int i = 0, _nSize = static_cast<int>(m_vecScatterNodes.size()); i < _nSize; ++i) {
+            vecScatterNodes_.push_back(m_vecScatterNodes[i]);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::RescatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_,
+        const std::vector<int>& vecPoleIndexes_, std::vector<ScatterNode<TYPE>>& vecScatterNodes_)
+    {
+        NEAT_RAISE(pNurbsNode_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(pNurbsNode_->nDegree < 2, g_strWrongNurbsDegree);
+        NEAT_RAISE(vecPoleIndexes_.empty() || vecScatterNodes_.size() < 2, g_strWrongRescatterParams);
+        NEAT_RAISE(m_bFlatnessScatter, g_strFunctionNotImplemented);
+        const bool _bRational = CheckNurbsNodeRational(pNurbsNode_);
+
+        // the scatter nodes cover the valid knot range, which is narrower than the knot vector of unclamped nurbs node
+        const int _nDegree = pNurbsNode_->nDegree;
+        const double _nValidStartKnot = pNurbsNode_->vecKnots[_nDegree];
+        const double _nValidEndKnot = pNurbsNode_->vecKnots[pNurbsNode_->vecKnots.size() - _nDegree - 1];
+        NEAT_RAISE(!DOUBLE_EQU(vecScatterNodes_.front().nKnot, _nValidStartKnot)
+            || !DOUBLE_EQU(vecScatterNodes_.back().nKnot, _nValidEndKnot), g_strWrongRescatterParams);
+
+        // the knot interval affected by the modified poles, which is clamped to the valid knot range
+        const int _nPoleCount = static_cast<int>(pNurbsNode_->vecPoles.size());
+        double _nStartKnot = _nValidEndKnot;
+        double _nEndKnot = _nValidStartKnot;
+        for (int _nPoleIndex : vecPoleIndexes_) {
+            NEAT_RAISE(_nPoleIndex < 0 || _nPoleIndex >= _nPoleCount, g_strWrongRescatterParams);
+            _nStartKnot = min(_nStartKnot, max(_nValidStartKnot, pNurbsNode_->vecKnots[_nPoleIndex]));
+            _nEndKnot = max(_nEndKnot, min(_nValidEndKnot, pNurbsNode_->vecKnots[_nPoleIndex + _nDegree + 1]));
+        }
+
+        m_nScatterStatus = scatter_status::finished;
+        SetOnlyGetPoints(false);
+        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, _bRational);
+        CollectIntervals();
+
+        int _nStartIndex = 0;
+        int _nEndIndex = static_cast<int>(m_vecScatterIntervals.size());
+        while (_nStartIndex < _nEndIndex && m_vecScatterIntervals[_nStartIndex].nEndKnot <= _nStartKnot) {
+            ++_nStartIndex;
+        }
+
+        while (_nEndIndex > _nStartIndex && m_vecScatterIntervals[_nEndIndex - 1].nStartKnot >= _nEndKnot) {
+            --_nEndIndex;
+        }
+
+        if (_nStartIndex >= _nEndIndex) {
+            return;
+        }
+
+        m_NurbsQuasiUniformDeflection.ScatterIntervals(m_vecScatterIntervals, _nStartIndex, _nEndIndex,
+            nDeflection_ * (1.0 - m_nSimplifyRatio), m_vecTempScatterNodes);
+        m_nScatterStatus = m_NurbsQuasiUniformDeflection.GetScatterStatus();
+        if (m_nScatterStatus != scatter_status::finished) {
+            return;
+        }
+
+        // The previous nodes before the first interval and after the last interval are kept, the nearest ones are combined with
+        // the new nodes, and the previous nodes between them are replaced.
+        double _nFrontKnot = m_vecScatterIntervals[_nStartIndex].nStartKnot;
+        double _nBackKnot = m_vecScatterIntervals[_nEndIndex - 1].nEndKnot;
+        const int _nPrevCount = static_cast<int>(vecScatterNodes_.size());
+        int _nFrontIndex = 0;
+        while (_nFrontIndex < _nPrevCount && vecScatterNodes_[_nFrontIndex].nKnot < _nFrontKnot
+            && !DOUBLE_EQU(vecScatterNodes_[_nFrontIndex].nKnot, _nFrontKnot)) {
+            ++_nFrontIndex;
+        }
+
+        int _nBackIndex = _nPrevCount;
+        while (_nBackIndex > _nFrontIndex && vecScatterNodes_[_nBackIndex - 1].nKnot > _nBackKnot
+            && !DOUBLE_EQU(vecScatterNodes_[_nBackIndex - 1].nKnot, _nBackKnot)) {
+            --_nBackIndex;
+        }
+
+        int _nReplaceStart = _nFrontIndex;
+        int _nReplaceEnd = _nBackIndex;
+        m_vecScatterNodes.clear();
+        m_CollinearCombiner.Reset(&m_vecScatterNodes, nullptr, nDeflection_ * m_nSimplifyRatio);
+        if (_nFrontIndex > 0) {
+            _nReplaceStart = _nFrontIndex - 1;
+            m_CollinearCombiner.AddScatterNode(vecScatterNodes_[_nReplaceStart]);
+        }
+
+        for (int i = 0, _nSize = static_cast<int>(m_vecTempScatterNodes.size()); i < _nSize; ++i) {
+            m_CollinearCombiner.AddScatterNode(m_vecTempScatterNodes[i]);
+        }
+
+        if (_nBackIndex < _nPrevCount) {
+            _nReplaceEnd = _nBackIndex + 1;
+            m_CollinearCombiner.AddScatterNode(vecScatterNodes_[_nBackIndex]);
+        }
+
+        m_CollinearCombiner.Finish();
+
+        // move the previous nodes after the replaced ones only once
+        const int _nNewCount = static_cast<int>(m_vecScatterNodes.size());
+        const int _nOldCount = _nReplaceEnd - _nReplaceStart;
+        if (_nNewCount > _nOldCount) {
+            vecScatterNodes_.insert(vecScatterNodes_.begin() + _nReplaceEnd, _nNewCount - _nOldCount, ScatterNode<TYPE>());
+        }
+        else {
+            vecScatterNodes_.erase(vecScatterNodes_.begin() + _nReplaceStart + _nNewCount, vecScatterNodes_.begin() + _nReplaceEnd);
+        }
+
+        for (int i = 0; i < _nNewCount; ++i) {
+            vecScatterNodes_[_nReplaceStart + i] = m_vecScatterNodes[i];
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::OutputScatterPoints(double nDeflection_, std::vector<TYPE>& vecScatterPoints_)
+    {
+        SetOnlyGetPoints(true);
 
         // discrete NURBS curve
-        CFastVector<ScatterNode<TYPE>>* _pvecScatterNodes = DeflectNurbs(pNurbsNode_, nDeflection_);
+        CFastVector<ScatterNode<TYPE>>* _pvecScatterNodes = DeflectNurbs(nDeflection_);
 
         // output discrete points
         vecScatterPoints_.clear();
@@ -72,15 +773,12 @@ namespace neat
     }
 
     template<typename TYPE, typename TYPEEX>
-    void CNurbsScatter<TYPE, TYPEEX>::ScatterNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_,
-        std::vector<ScatterNode<TYPE>>& vecScatterNodes_)
+    void CNurbsScatter<TYPE, TYPEEX>::OutputScatterNodes(double nDeflection_, std::vector<ScatterNode<TYPE>>& vecScatterNodes_)
     {
-        NEAT_RAISE(pNurbsNode_->nDegree < 2, g_strWrongNurbsDegree);
-
-        m_NurbsQuasiUniformDeflection.SetOnlyGetPoints(false);
+        SetOnlyGetPoints(false);
 
         // discrete NURBS curve
-        CFastVector<ScatterNode<TYPE>>* _pvecScatterNodes = DeflectNurbs(pNurbsNode_, nDeflection_);
+        CFastVector<ScatterNode<TYPE>>* _pvecScatterNodes = DeflectNurbs(nDeflection_);
 
         // output discrete nodes
         vecScatterNodes_.clear();
@@ -91,80 +789,397 @@ namespace neat
     }
 
     template<typename TYPE, typename TYPEEX>
-    CFastVector<ScatterNode<TYPE>>* CNurbsScatter<TYPE, TYPEEX>::DeflectNurbs(const NurbsNode<TYPE>* pNurbsNode_, double nDeflection_)
+    void CNurbsScatter<TYPE, TYPEEX>::OutputScatterSink(double nDeflection_, const ScatterSink<TYPE>& ScatterSink_)
     {
-        // divide nurbs node in repeat knots
-        bool _bRational = CheckNurbsNodeRational(pNurbsNode_);
-        m_NurbsRefiner.SetNurbsNode(pNurbsNode_, _bRational);
+        NEAT_RAISE(!ScatterSink_, g_strEmptyPointer);
+
+        SetOnlyGetPoints(false);
+        SinkScatterNodes(nDeflection_, ScatterSink_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::SinkScatterNodes(double nDeflection_, const ScatterSink<TYPE>& ScatterSink_)
+    {
+        // The deflection sends the scatter nodes of every interval to the combiner, which sends the finalized nodes to sink.
+        m_CollinearCombiner.Reset(nullptr, &ScatterSink_, nDeflection_ * m_nSimplifyRatio);
+        if (m_bFlatnessScatter) {
+            m_BezierFlatnessDeflection.ScatterNurbs(*DivideNurbs(), nDeflection_ * (1.0 - m_nSimplifyRatio),
+                m_vecTempScatterNodes, &m_CombinerSink);
+            m_nScatterStatus = m_BezierFlatnessDeflection.GetScatterStatus();
+        }
+        else {
+            CollectIntervals();
+            m_NurbsQuasiUniformDeflection.ScatterIntervals(m_vecScatterIntervals, 0, static_cast<int>(m_vecScatterIntervals.size()),
+                nDeflection_ * (1.0 - m_nSimplifyRatio), m_vecTempScatterNodes, &m_CombinerSink);
+            m_nScatterStatus = m_NurbsQuasiUniformDeflection.GetScatterStatus();
+        }
+
+        for (int i = 0, _nSize = static_cast<int>(m_vecTempScatterNodes.size()); i < _nSize; ++i) {
+            m_CollinearCombiner.AddScatterNode(m_vecTempScatterNodes[i]);
+        }
+
+        m_CollinearCombiner.Finish();
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::OutputScatterArrays(double nDeflection_, int nFields_, ScatterArrays<TYPE>& ScatterArrays_)
+    {
+        NEAT_RAISE(nFields_ <= 0 || (nFields_ & ~scatter_field::all) != 0, g_strWrongScatterFields);
+
+        // The quasi uniform deflection always calculates the first-order derivatives, but the flatness deflection doesn't.
+        bool _bOnlyGetPoints = (nFields_ & (scatter_field::deriv2 | scatter_field::curvature)) == 0
+            && (!m_bFlatnessScatter || (nFields_ & scatter_field::deriv1) == 0);
+        SetOnlyGetPoints(_bOnlyGetPoints);
+
+        // The scatter nodes are sent to the arrays as soon as they are finalized, the arrays of unselected fields are cleared.
+        m_pScatterArrays = &ScatterArrays_;
+        m_nScatterFields = nFields_;
+        ScatterArrays_.vecPoints.clear();
+        ScatterArrays_.vecKnots.clear();
+        ScatterArrays_.vecDeriv1s.clear();
+        ScatterArrays_.vecDeriv2s.clear();
+        ScatterArrays_.vecCurvatures.clear();
+        ScatterArrays_.vecArcLengths.clear();
+        SinkScatterNodes(nDeflection_, m_ArraysSink);
+        m_pScatterArrays = nullptr;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::AppendScatterArrays(const ScatterNode<TYPE>& ScatterNode_)
+    {
+        ScatterArrays<TYPE>& _ScatterArrays = *m_pScatterArrays;
+        if ((m_nScatterFields & scatter_field::point) != 0) {
+            _ScatterArrays.vecPoints.push_back(ScatterNode_.ptPoint);
+        }
+
+        if ((m_nScatterFields & scatter_field::knot) != 0) {
+            _ScatterArrays.vecKnots.push_back(ScatterNode_.nKnot);
+        }
+
+        if ((m_nScatterFields & scatter_field::deriv1) != 0) {
+            _ScatterArrays.vecDeriv1s.push_back(ScatterNode_.ptDeriv1);
+        }
+
+        if ((m_nScatterFields & scatter_field::deriv2) != 0) {
+            _ScatterArrays.vecDeriv2s.push_back(ScatterNode_.ptDeriv2);
+        }
+
+        // |d1 x d2|^2 = |d1|^2 * |d2|^2 - (d1 . d2)^2 in any dimension, the curvature is zero where the derivative vanishes
+        if ((m_nScatterFields & scatter_field::curvature) != 0) {
+            double _nNorme1 = ScatterNode_.ptDeriv1.GetSquareLength();
+            double _nCurvature = 0.0;
+            if (_nNorme1 > Precision::SquareRealTolerance()) {
+                double _nDot = DotProduct(ScatterNode_.ptDeriv1, ScatterNode_.ptDeriv2);
+                double _nSquareCross = _nNorme1 * ScatterNode_.ptDeriv2.GetSquareLength() - _nDot * _nDot;
+                _nCurvature = sqrt(max(_nSquareCross, 0.0)) / (_nNorme1 * sqrt(_nNorme1));
+            }
+
+            _ScatterArrays.vecCurvatures.push_back(_nCurvature);
+        }
+
+        // the arc length is accumulated from the point of previous scatter node
+        if ((m_nScatterFields & scatter_field::arc_length) != 0) {
+            double _nArcLength = 0.0;
+            if (!_ScatterArrays.vecArcLengths.empty()) {
+                _nArcLength = _ScatterArrays.vecArcLengths.back() + (ScatterNode_.ptPoint - m_ptLastArrayPoint).GetLength();
+            }
+
+            _ScatterArrays.vecArcLengths.push_back(_nArcLength);
+            m_ptLastArrayPoint = ScatterNode_.ptPoint;
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::StartScatterSteps(double nDeflection_)
+    {
+        m_bStepsFinished = true;
+        m_nScatterStatus = scatter_status::finished;
+        SetOnlyGetPoints(false);
+
+        // Every step of deflection appends no more than one scatter node, which is combined when it's finalized.
+        m_vecReadyScatterNodes.clear();
+        m_nReadyIndex = 0;
+        m_CollinearCombiner.Reset(&m_vecReadyScatterNodes, nullptr, nDeflection_ * m_nSimplifyRatio);
+        m_CollinearCombiner.EnableSkippedLimit();
+        if (m_bFlatnessScatter) {
+            m_BezierFlatnessDeflection.StartNurbs(*DivideNurbs(), nDeflection_ * (1.0 - m_nSimplifyRatio), m_vecTempScatterNodes);
+        }
+        else {
+            CollectIntervals();
+            m_NurbsQuasiUniformDeflection.StartIntervals(m_vecScatterIntervals, 0, static_cast<int>(m_vecScatterIntervals.size()),
+                nDeflection_ * (1.0 - m_nSimplifyRatio), m_vecTempScatterNodes);
+        }
+        m_bStepsFinished = false;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    CFastVector<ScatterNode<TYPE>>* CNurbsScatter<TYPE, TYPEEX>::DeflectNurbs(double nDeflection_)
+    {
+        // scatter knot intervals by given deflection, the simplify ratio of deflection is kept for combining
+        double _nScatterDeflection = nDeflection_ * (1.0 - m_nSimplifyRatio);
+        if (m_bFlatnessScatter) {
+            m_BezierFlatnessDeflection.ScatterNurbs(*DivideNurbs(), _nScatterDeflection, m_vecTempScatterNodes, nullptr);
+            m_nScatterStatus = m_BezierFlatnessDeflection.GetScatterStatus();
+        }
+        else {
+            CollectIntervals();
+            if (m_nThreadCount > 1 && static_cast<int>(m_vecScatterIntervals.size()) > 1) {
+                ParallelDeflectNurbs(_nScatterDeflection);
+            }
+            else {
+                m_NurbsQuasiUniformDeflection.ScatterIntervals(m_vecScatterIntervals, 0, static_cast<int>(m_vecScatterIntervals.size()),
+                    _nScatterDeflection, m_vecTempScatterNodes);
+                m_nScatterStatus = m_NurbsQuasiUniformDeflection.GetScatterStatus();
+            }
+        }
 
+        // combine collinear points
+        CombineCollinearPoints(m_vecTempScatterNodes, m_vecScatterNodes, nDeflection_ * m_nSimplifyRatio);
+
+        return &m_vecScatterNodes;
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    CFastVector<NurbsNode<TYPE>>* CNurbsScatter<TYPE, TYPEEX>::DivideNurbs()
+    {
         m_vecEmptyVector.clear();
-        CFastVector<NurbsNode<TYPE>>* _pvecNurbsNodes = m_NurbsRefiner.DivideNurbs(m_vecEmptyVector);
+        return m_NurbsRefiner.DivideNurbs(m_vecEmptyVector);
+    }
 
-        // scatter nurbs node by given deflection
-        m_vecScatterNodes.clear();
-        m_vecTempScatterNodes.clear();
-        m_vecTempScatterNodes.push_back(ScatterNode<TYPE>());
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::CollectIntervals()
+    {
+        // divide nurbs node in repeat knots
+        CFastVector<NurbsNode<TYPE>>* _pvecNurbsNodes = DivideNurbs();
 
+        // collect the knot intervals of all nurbs node subsections
+        m_vecScatterIntervals.clear();
         for (int i = 0, _nSize = static_cast<int>(_pvecNurbsNodes->size()); i < _nSize; ++i) {
-            m_NurbsQuasiUniformDeflection.ScatterNurbs(&((*_pvecNurbsNodes)[i]), nDeflection_, m_vecScatterNodes);
+            m_NurbsQuasiUniformDeflection.CollectIntervals(&((*_pvecNurbsNodes)[i]), m_vecScatterIntervals);
+        }
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::SetOnlyGetPoints(bool bOnlyGetPoints_)
+    {
+        m_bOnlyGetPoints = bOnlyGetPoints_;
+        m_NurbsQuasiUniformDeflection.SetOnlyGetPoints(bOnlyGetPoints_);
+        m_BezierFlatnessDeflection.SetOnlyGetPoints(bOnlyGetPoints_);
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    bool CNurbsScatter<TYPE, TYPEEX>::ScatterStep()
+    {
+        return m_bFlatnessScatter ? m_BezierFlatnessDeflection.ScatterStep() : m_NurbsQuasiUniformDeflection.ScatterStep();
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::ParallelDeflectNurbs(double nDeflection_)
+    {
+        // Several blocks for every thread balance the different cost of knot intervals.
+        const int _nIntervalCount = static_cast<int>(m_vecScatterIntervals.size());
+        const int _nThreadCount = min(m_nThreadCount, _nIntervalCount);
+        const int _nBlockCount = min(_nThreadCount * 8, _nIntervalCount);
+
+        while (static_cast<int>(m_vecThreadDeflections.size()) < _nThreadCount - 1) {
+            m_vecThreadDeflections.push_back(new CNurbsQuasiUniformDeflection<TYPE>());
+        }
+
+        for (int i = 0; i < _nThreadCount - 1; ++i) {
+            m_vecThreadDeflections[i]->SetOnlyGetPoints(m_bOnlyGetPoints);
+            m_vecThreadDeflections[i]->SetSegmentConstraints(m_nMaxSegmentLength, m_nMaxTurningAngle);
+            m_vecThreadDeflections[i]->SetScatterToken(m_pScatterToken);
+        }
+
+        if (static_cast<int>(m_vecBlockScatterNodes.size()) < _nBlockCount) {
+            m_vecBlockScatterNodes.resize(_nBlockCount);
+        }
+
+        m_vecThreadExceptions.assign(_nThreadCount, nullptr);
+        m_vecBlockStatus.assign(_nBlockCount, scatter_status::finished);
+        m_nNextBlock = 0;
+
+        // the calling thread is the first thread
+        m_pThreadPool->RunTasks(_nThreadCount, [this, nDeflection_](int nThreadIndex_) { DeflectBlocks(nThreadIndex_, nDeflection_); });
+
+        for (const auto& _pException : m_vecThreadExceptions) {
+            if (_pException != nullptr) {
+                std::rethrow_exception(_pException);
+            }
+        }
+
+        // The end node of block is replaced by the start node of next block like the knot intervals in one block.
+        // The blocks are taken in order and the thread stops after its interrupted block, so the blocks which are not taken
+        // are after the first interrupted block, and the blocks are joined until it.
+        m_nScatterStatus = scatter_status::finished;
+        m_vecTempScatterNodes.clear();
+        m_vecTempScatterNodes.push_back(ScatterNode<TYPE>());
+        for (int i = 0; i < _nBlockCount && m_nScatterStatus == scatter_status::finished; ++i) {
             m_vecTempScatterNodes.pop_back();
-            m_vecTempScatterNodes.copy(m_vecScatterNodes);
+            m_vecTempScatterNodes.copy(m_vecBlockScatterNodes[i]);
+            m_nScatterStatus = m_vecBlockStatus[i];
         }
+    }
 
-        // combine collinear points
-        CombineCollinearPoints(m_vecTempScatterNodes, m_vecScatterNodes);
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::DeflectBlocks(int nThreadIndex_, double nDeflection_)
+    {
+        const int _nIntervalCount = static_cast<int>(m_vecScatterIntervals.size());
+        const int _nBlockCount = min(min(m_nThreadCount, _nIntervalCount) * 8, _nIntervalCount);
+        CNurbsQuasiUniformDeflection<TYPE>* _pDeflection = (nThreadIndex_ == 0)
+            ? &m_NurbsQuasiUniformDeflection : m_vecThreadDeflections[nThreadIndex_ - 1];
 
-        return &m_vecScatterNodes;
+        try {
+            int _nBlock = m_nNextBlock++;
+            while (_nBlock < _nBlockCount) {
+                int _nStartIndex = static_cast<int>(static_cast<long long>(_nIntervalCount) * _nBlock / _nBlockCount);
+                int _nEndIndex = static_cast<int>(static_cast<long long>(_nIntervalCount) * (_nBlock + 1) / _nBlockCount);
+                _pDeflection->ScatterIntervals(m_vecScatterIntervals, _nStartIndex, _nEndIndex, nDeflection_, m_vecBlockScatterNodes[_nBlock]);
+                m_vecBlockStatus[_nBlock] = _pDeflection->GetScatterStatus();
+                if (m_vecBlockStatus[_nBlock] != scatter_status::finished) {
+                    break;
+                }
+
+                _nBlock = m_nNextBlock++;
+            }
+        }
+        catch (...) {
+            m_vecThreadExceptions[nThreadIndex_] = std::current_exception();
+        }
     }
 
     template<typename TYPE, typename TYPEEX>
     void CNurbsScatter<TYPE, TYPEEX>::CombineCollinearPoints(const CFastVector<ScatterNode<TYPE>>& vecScatterNodesIn_,
-        CFastVector<ScatterNode<TYPE>>& vecScatterNodesOut_)
+        CFastVector<ScatterNode<TYPE>>& vecScatterNodesOut_, double nTolerance_)
     {
         vecScatterNodesOut_.clear();
+        m_CollinearCombiner.Reset(&vecScatterNodesOut_, nullptr, nTolerance_);
+        for (int i = 0, _nSize = static_cast<int>(vecScatterNodesIn_.size()); i < _nSize; ++i) {
+            m_CollinearCombiner.AddScatterNode(vecScatterNodesIn_[i]);
+        }
 
-        const int _nSize = static_cast<int>(vecScatterNodesIn_.size());
-        if (0 == _nSize) {
-            return;
+        m_CollinearCombiner.Finish();
+    }
+
+    template<typename TYPE, typename TYPEEX>
+    void CNurbsScatter<TYPE, TYPEEX>::BudgetDeflectNurbs(const NurbsNode<TYPE>* pNurbsNodes_, size_t nCount_, size_t nPointBudget_,
+        double nDeflection_, std::vector<size_t>& vecOffsets_)
+    {
+        NEAT_RAISE(pNurbsNodes_ == nullptr && nCount_ > 0, g_strEmptyPointer);
+        NEAT_RAISE(nDeflection_ <= 0.0, g_strWrongDeflection);
+        NEAT_RAISE(m_bFlatnessScatter, g_strFunctionNotImplemented);
+        m_nScatterStatus = scatter_status::finished;
+
+        // The subsections of all nurbs nodes are copied before collecting intervals, so the intervals point to the fixed subsections.
+        m_vecBudgetNurbsNodes.clear();
+        m_vecBudgetNodeStarts.clear();
+        for (size_t i = 0; i < nCount_; ++i) {
+            m_NurbsRefiner.SetNurbsNode(&pNurbsNodes_[i], CheckNurbsNodeRational(&pNurbsNodes_[i]));
+            m_vecBudgetNodeStarts.push_back(static_cast<int>(m_vecBudgetNurbsNodes.size()));
+            m_vecBudgetNurbsNodes.copy(*DivideNurbs());
         }
 
-        // start point
-        vecScatterNodesOut_.push_back(vecScatterNodesIn_.front());
-        int _nIndex = 0;
-        while (++_nIndex < _nSize) {
-            double _nLength = (vecScatterNodesIn_[_nIndex].ptPoint - vecScatterNodesOut_.back().ptPoint).GetLength();
-            if (!DOUBLE_EQU_ZERO(_nLength)) {
-                vecScatterNodesOut_.push_back(vecScatterNodesIn_[_nIndex]);
-                break;
+        m_vecBudgetNodeStarts.push_back(static_cast<int>(m_vecBudgetNurbsNodes.size()));
+        m_vecScatterIntervals.clear();
+        m_vecBudgetIntervalStarts.clear();
+        for (size_t i = 0; i < nCount_; ++i) {
+            m_vecBudgetIntervalStarts.push_back(static_cast<int>(m_vecScatterIntervals.size()));
+            for (int j = m_vecBudgetNodeStarts[i]; j < m_vecBudgetNodeStarts[i + 1]; ++j) {
+                m_NurbsQuasiUniformDeflection.CollectIntervals(&m_vecBudgetNurbsNodes[j], m_vecScatterIntervals);
             }
         }
 
-        if (_nIndex + 1 >= _nSize) {
-            return;
-        }
+        m_vecBudgetIntervalStarts.push_back(static_cast<int>(m_vecScatterIntervals.size()));
 
-        // other points
-        for (int i = _nIndex + 1; i < _nSize; ++i) {
-            int _nOutSize = static_cast<int>(vecScatterNodesOut_.size());
-            const TYPE& _ptPrePoint = vecScatterNodesOut_[_nOutSize - 2].ptPoint;
-            const TYPE& _ptCurPoint = vecScatterNodesOut_[_nOutSize - 1].ptPoint;
-            const TYPE& _ptNextPoint = vecScatterNodesIn_[i].ptPoint;
-            if (JudgeCollinearPoints(_ptPrePoint, _ptCurPoint, _ptNextPoint)) {
-                vecScatterNodesOut_.back() = vecScatterNodesIn_[i];
-            }
-            else {
-                vecScatterNodesOut_.push_back(vecScatterNodesIn_[i]);
+        // The deflection counts the shared end node of intervals once, but the end node of nurbs node isn't shared with next one.
+        size_t _nPointBudget = (nCount_ > 1) ? nPointBudget_ - min(nPointBudget_, nCount_ - 1) : nPointBudget_;
+        m_NurbsQuasiUniformDeflection.ScatterBudget(m_vecScatterIntervals, _nPointBudget, nDeflection_, m_vecTempScatterNodes,
+            m_vecIntervalOffsets);
+
+        // join the intervals of every nurbs node, whose start node is the same as the end node of previous interval
+        m_vecScatterNodes.clear();
+        vecOffsets_.clear();
+        for (size_t i = 0; i < nCount_; ++i) {
+            vecOffsets_.push_back(m_vecScatterNodes.size());
+            m_CollinearCombiner.Reset(&m_vecScatterNodes, nullptr, 0.0);
+            for (int j = m_vecBudgetIntervalStarts[i]; j < m_vecBudgetIntervalStarts[i + 1]; ++j) {
+                int _nStartIndex = m_vecIntervalOffsets[j] + (j > m_vecBudgetIntervalStarts[i] ? 1 : 0);
+                for (int k = _nStartIndex; k < m_vecIntervalOffsets[j + 1]; ++k) {
+                    m_CollinearCombiner.AddScatterNode(m_vecTempScatterNodes[k]);
+                }
             }
+
+            m_CollinearCombiner.Finish();
         }
+
+        vecOffsets_.push_back(m_vecScatterNodes.size());
     }
 
     template<typename TYPE, typename TYPEEX>
-    bool CNurbsScatter<TYPE, TYPEEX>::JudgeCollinearPoints(const TYPE& ptPoint1_, const TYPE& ptPoint2_, const TYPE& ptPoint3_)
+    void CNurbsScatter<TYPE, TYPEEX>::LevelDeflectNurbs(const VECDOUBLE& vecDeflections_, std::vector<int>& vecLevels_)
     {
-        double _nLength12 = (ptPoint2_ - ptPoint1_).GetLength();
-        double _nLength23 = (ptPoint3_ - ptPoint2_).GetLength();
-        double _nLength13 = (ptPoint3_ - ptPoint1_).GetLength();
-        return DOUBLE_EQU_ZERO(_nLength12 + _nLength23 - _nLength13);
+        NEAT_RAISE(m_bFlatnessScatter, g_strFunctionNotImplemented);
+
+        // the deflections must be positive and strictly descending, which is checked before dividing nurbs node
+        NEAT_RAISE(vecDeflections_.empty(), g_strWrongDeflection);
+        for (size_t i = 0; i < vecDeflections_.size(); ++i) {
+            NEAT_RAISE(vecDeflections_[i] <= 0.0 || (i > 0 && vecDeflections_[i] >= vecDeflections_[i - 1]), g_strWrongDeflection);
+        }
+
+        m_nScatterStatus = scatter_status::finished;
+
+        CollectIntervals();
+        int _nLevelCount = static_cast<int>(vecDeflections_.size());
+        m_NurbsQuasiUniformDeflection.ScatterLevels(m_vecScatterIntervals, vecDeflections_.data(), _nLevelCount,
+            m_vecScatterNodes, m_vecNodeLevels);
+
+        // Combine the collinear nodes of every level from the coarsest one. The combined node of a level is moved to the next level,
+        // so the levels are still nested, and the combined node of the finest level is removed.
+        for (int _nLevel = 0; _nLevel < _nLevelCount; ++_nLevel) {
+            m_vecTempScatterNodes.clear();
+            m_CollinearCombiner.Reset(&m_vecTempScatterNodes, nullptr, 0.0);
+            for (int i = 0, _nSize = static_cast<int>(m_vecScatterNodes.size()); i < _nSize; ++i) {
+                if (m_vecNodeLevels[i] <= _nLevel) {
+                    m_CollinearCombiner.AddScatterNode(m_vecScatterNodes[i]);
+                }
+            }
+
+            m_CollinearCombiner.Finish();
+
+            // the output nodes are in the same order, and only the nodes first appearing at this level can be moved
+            int _nOutputIndex = 0;
+            for (int i = 0, _nSize = static_cast<int>(m_vecScatterNodes.size()); i < _nSize; ++i) {
+                if (m_vecNodeLevels[i] > _nLevel) {
+                    continue;
+                }
+
+                if (_nOutputIndex < static_cast<int>(m_vecTempScatterNodes.size())
+                    && m_vecTempScatterNodes[_nOutputIndex].nKnot == m_vecScatterNodes[i].nKnot) {
+                    ++_nOutputIndex;
+                }
+                else if (m_vecNodeLevels[i] == _nLevel) {
+                    m_vecNodeLevels[i] = _nLevel + 1;
+                }
+            }
+        }
+
+        int _nNodeCount = 0;
+        for (int i = 0, _nSize = static_cast<int>(m_vecScatterNodes.size()); i < _nSize; ++i) {
+            if (m_vecNodeLevels[i] < _nLevelCount) {
+                m_vecScatterNodes[_nNodeCount] = m_vecScatterNodes[i];
+                m_vecNodeLevels[_nNodeCount] = m_vecNodeLevels[i];
+                ++_nNodeCount;
+            }
+        }
+
+        m_vecScatterNodes.resize(_nNodeCount);
+        m_vecNodeLevels.resize(_nNodeCount);
+
+        vecLevels_.clear();
+        vecLevels_.reserve(m_vecNodeLevels.size());
+        for (int i = 0, _nSize = static_cast<int>(m_vecNodeLevels.size()); i < _nSize; ++i) {
+            vecLevels_.push_back(m_vecNodeLevels[i]);
+        }
     }
 
 } // End namespace neat
@@ -31,33 +31,52 @@ namespace neat
         // Set the information for nurbs node.
         void SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_, bool bRational_);
 
+        // Set the information for compiled nurbs curve, which is not checked any more.
+        void SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_);
+
         // Returns in ptPoint_ the point of parameter nKnot_.
         void GetNurbsPoint(double nKnot_, TYPE& ptPoint_);
 
         // Returns in ptPoint_ the point and ptDeriv1_ the first-order derivative of parameter nKnot_.
         void GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_);
 
+        // Returns in pPoints_ the points of the ascending parameters pKnots_.
+        void GetNurbsPoints(const double* pKnots_, size_t nCount_, TYPE* pPoints_);
+
+        // Returns in pPoints_ the points and pDeriv1s_ the first-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_);
+
     private:
-        // Record valid poles and their weights.
-        void RecordValidPoles(int nKnotIndex_);
+        // Initialize the knot index to the first nonempty span.
+        void InitKnotIndex();
+
+        // Find the span of nKnot_ from the last knot index.
+        int LocateKnotIndex(double nKnot_);
+
+        // Copy the valid poles and weights of the span nKnotIndex_ to the iteration poles and weights of the generic De-Boor algorithm.
+        void CopyValidPoles(int nKnotIndex_);
+
+        // Calculate the point and first-order derivative in the span nKnotIndex_.
+        void CalculatePoint(double nKnot_, int nKnotIndex_, TYPE& ptPoint_);
+        void CalculateDeriv(double nKnot_, int nKnotIndex_, TYPE& ptPoint_, TYPE& ptDeriv1_);
 
         // De-Boor recursive algorithm to calculate iteration poles and weights.
         void DeBoorAlgorithm(double nKnot_, int nKnotIndex_, int nStartIndex_, int nEndIndex_);
 
     private:
         NurbsNode<TYPE>* m_pNurbsNode;
+        const CNurbsCurve<TYPE>* m_pNurbsCurve;
         int m_nStartIndex;
         int m_nEndIndex;
         int m_nKnotIndex;
+        UniformKnots m_UniformKnots;
         bool m_bRational;
 
-        // Record the effective control points corresponding to m_nKnotIndex
-        CFastVector<TYPE> m_vecValidPoles;
+        // The iteration poles of the generic De-Boor algorithm
         CFastVector<TYPE> m_vecTempPoles1;
         CFastVector<TYPE> m_vecTempPoles2;
 
-        // Record the effective control point weight corresponding to m_nKnotIndex
-        CFastVector<double> m_vecValidWeights;
+        // The iteration weights of the generic De-Boor algorithm
         CFastVector<double> m_vecTempWeights1;
         CFastVector<double> m_vecTempWeights2;
     };
@@ -68,6 +87,7 @@ namespace neat
     template<typename TYPE>
     CRBSplineParser<TYPE>::CRBSplineParser()
         : m_pNurbsNode(nullptr)
+        , m_pNurbsCurve(nullptr)
         , m_nStartIndex(0)
         , m_nEndIndex(0)
         , m_nKnotIndex(0)
@@ -86,100 +106,157 @@ namespace neat
         NEAT_RAISE_IF(!bRational_ || !CheckNurbsNodeRational(pNurbsNode_), g_strNurbsParamsError);
 
         m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsNode_;
+        m_pNurbsCurve = nullptr;
         m_bRational = bRational_;
 
         // Initialize the knot index limit value
         m_nStartIndex = m_pNurbsNode->nDegree;
         m_nEndIndex = static_cast<int>(m_pNurbsNode->vecKnots.size()) - m_pNurbsNode->nDegree - 1;
         NEAT_RAISE(DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nStartIndex], m_pNurbsNode->vecKnots[m_nEndIndex]), g_strNurbsParamsError);
+        CheckUniformKnots(m_pNurbsNode->vecKnots, m_nStartIndex, m_nEndIndex, m_UniformKnots);
+
+        InitKnotIndex();
+    }
 
+    template<typename TYPE>
+    void CRBSplineParser<TYPE>::SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_)
+    {
+        NEAT_RAISE_IF(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE_IF(!pNurbsCurve_->IsRational(), g_strNurbsParamsError);
+
+        m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsCurve_->GetNurbsNode();
+        m_pNurbsCurve = pNurbsCurve_;
+        m_bRational = pNurbsCurve_->IsRational();
+
+        // The compiled nurbs curve has been checked
+        m_nStartIndex = pNurbsCurve_->GetStartIndex();
+        m_nEndIndex = pNurbsCurve_->GetEndIndex();
+        m_UniformKnots = pNurbsCurve_->GetUniformKnots();
+        InitKnotIndex();
+    }
+
+    template<typename TYPE>
+    void CRBSplineParser<TYPE>::InitKnotIndex()
+    {
         m_nKnotIndex = m_nStartIndex;
         while (DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nKnotIndex + 1], m_pNurbsNode->vecKnots[m_nStartIndex])) {
             ++m_nKnotIndex;
         }
-
-        RecordValidPoles(m_nKnotIndex);
     }
 
     template<typename TYPE>
     void CRBSplineParser<TYPE>::GetNurbsPoint(double nKnot_, TYPE& ptPoint_)
     {
         NEAT_RAISE_IF(m_pNurbsNode == nullptr, g_strEmptyPointer);
-        NEAT_RAISE_IF(!CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
-
-        int _nLastKnotIndex = m_nKnotIndex;
-        int _nCurKnotIndex = FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_nKnotIndex);
-        if (_nCurKnotIndex != _nLastKnotIndex) {
-            RecordValidPoles(_nCurKnotIndex);
-        }
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && !CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
 
-        m_vecTempPoles1.clear();
-        m_vecTempPoles2.clear();
-        m_vecTempWeights1.clear();
-        m_vecTempWeights2.clear();
-        m_vecTempPoles1.copy(m_vecValidPoles);
-        m_vecTempPoles2.copy(m_vecValidPoles);
-        m_vecTempWeights1.copy(m_vecValidWeights);
-        m_vecTempWeights2.copy(m_vecValidWeights);
-
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, 0, m_pNurbsNode->nDegree);
-        ptPoint_ = m_vecTempPoles1[m_pNurbsNode->nDegree];
+        CalculatePoint(nKnot_, LocateKnotIndex(nKnot_), ptPoint_);
     }
 
     template<typename TYPE>
     void CRBSplineParser<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_)
     {
         NEAT_RAISE_IF(m_pNurbsNode == nullptr, g_strEmptyPointer);
-        NEAT_RAISE_IF(!CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && !CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+
+        CalculateDeriv(nKnot_, LocateKnotIndex(nKnot_), ptPoint_, ptDeriv1_);
+    }
 
-        int _nLastKnotIndex = m_nKnotIndex;
-        int _nCurKnotIndex = FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_nKnotIndex);
-        if (_nCurKnotIndex != _nLastKnotIndex) {
-            RecordValidPoles(_nCurKnotIndex);
+    template<typename TYPE>
+    void CRBSplineParser<TYPE>::GetNurbsPoints(const double* pKnots_, size_t nCount_, TYPE* pPoints_)
+    {
+        NEAT_RAISE(m_pNurbsNode == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr), g_strEmptyPointer);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && !CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        CheckBatchKnots(m_pNurbsNode->vecKnots, pKnots_, nCount_, m_nStartIndex, m_nEndIndex);
+
+        // The span is searched from the last one since the parameters are ascending
+        for (size_t i = 0; i < nCount_; ++i) {
+            CalculatePoint(pKnots_[i], LocateKnotIndex(pKnots_[i]), pPoints_[i]);
+        }
+    }
+
+    template<typename TYPE>
+    void CRBSplineParser<TYPE>::GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_)
+    {
+        NEAT_RAISE(m_pNurbsNode == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr || pDeriv1s_ == nullptr), g_strEmptyPointer);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && !CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        CheckBatchKnots(m_pNurbsNode->vecKnots, pKnots_, nCount_, m_nStartIndex, m_nEndIndex);
+
+        for (size_t i = 0; i < nCount_; ++i) {
+            CalculateDeriv(pKnots_[i], LocateKnotIndex(pKnots_[i]), pPoints_[i], pDeriv1s_[i]);
         }
+    }
+
+    template<typename TYPE>
+    int CRBSplineParser<TYPE>::LocateKnotIndex(double nKnot_)
+    {
+        return FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_UniformKnots, m_nKnotIndex);
+    }
+
+    template<typename TYPE>
+    void CRBSplineParser<TYPE>::CopyValidPoles(int nKnotIndex_)
+    {
+        NEAT_RAISE_IF(nKnotIndex_ < m_nStartIndex || nKnotIndex_ > m_nEndIndex, g_strNurbsParamsError);
 
         m_vecTempPoles1.clear();
         m_vecTempPoles2.clear();
         m_vecTempWeights1.clear();
         m_vecTempWeights2.clear();
-        m_vecTempPoles1.copy(m_vecValidPoles);
-        m_vecTempPoles2.copy(m_vecValidPoles);
-        m_vecTempWeights1.copy(m_vecValidWeights);
-        m_vecTempWeights2.copy(m_vecValidWeights);
-
-        const int& _nDegree = m_pNurbsNode->nDegree;
-        const VECDOUBLE& _vecKnots = m_pNurbsNode->vecKnots;
+        for (int i = nKnotIndex_ - m_pNurbsNode->nDegree; i <= nKnotIndex_; ++i) {
+            m_vecTempPoles1.push_back(m_pNurbsNode->vecPoles[i]);
+            m_vecTempPoles2.push_back(m_pNurbsNode->vecPoles[i]);
+            m_vecTempWeights1.push_back(m_pNurbsNode->vecWeights[i]);
+            m_vecTempWeights2.push_back(m_pNurbsNode->vecWeights[i]);
+        }
+    }
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, 0, _nDegree - 1);
+    template<typename TYPE>
+    void CRBSplineParser<TYPE>::CalculatePoint(double nKnot_, int nKnotIndex_, TYPE& ptPoint_)
+    {
+        // The compiled curve is calculated by the vectorized kernel first, and low degree by the specialized kernel
+        if (m_pNurbsCurve != nullptr && HomogeneousKernelPoint(m_pNurbsNode->nDegree, m_pNurbsNode->vecKnots.data(),
+            m_pNurbsCurve->GetHomogeneousPoles(), nKnotIndex_, nKnot_, ptPoint_)) {
+            return;
+        }
 
-        double _nAlpha = 1.0 / (_vecKnots[_nCurKnotIndex + 1] - _vecKnots[_nCurKnotIndex]);
-        double _nBeta = (nKnot_ - _vecKnots[_nCurKnotIndex]) * _nAlpha;
-        double _nWeight = (1.0 - _nBeta) * m_vecTempWeights1[_nDegree - 1] + _nBeta * m_vecTempWeights1[_nDegree];
-        ptDeriv1_ = (m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1]) * static_cast<double>(_nDegree) * _nAlpha
-            * m_vecTempWeights1[_nDegree] * m_vecTempWeights1[_nDegree - 1] / (_nWeight * _nWeight);
+        if (DeBoorKernelRationalPoint(m_pNurbsNode->nDegree, m_pNurbsNode->vecKnots.data(), m_pNurbsNode->vecPoles.data(),
+            m_pNurbsNode->vecWeights.data(), nKnotIndex_, nKnot_, ptPoint_)) {
+            return;
+        }
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, _nDegree - 1, _nDegree);
-        ptPoint_ = m_vecTempPoles1[_nDegree];
+        CopyValidPoles(nKnotIndex_);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, 0, m_pNurbsNode->nDegree);
+        ptPoint_ = m_vecTempPoles1[m_pNurbsNode->nDegree];
     }
 
     template<typename TYPE>
-    void CRBSplineParser<TYPE>::RecordValidPoles(int nKnotIndex_)
+    void CRBSplineParser<TYPE>::CalculateDeriv(double nKnot_, int nKnotIndex_, TYPE& ptPoint_, TYPE& ptDeriv1_)
     {
-        NEAT_RAISE_IF(nKnotIndex_ < m_nStartIndex || nKnotIndex_ > m_nEndIndex, g_strNurbsParamsError);
-
-        m_vecValidPoles.clear();
-        auto _iterPolesBegin = m_pNurbsNode->vecPoles.begin() + nKnotIndex_ - m_pNurbsNode->nDegree;
-        auto _iterPolesEnd = m_pNurbsNode->vecPoles.begin() + nKnotIndex_ + 1;
-        for (; _iterPolesBegin != _iterPolesEnd; ++_iterPolesBegin) {
-            m_vecValidPoles.push_back(*_iterPolesBegin);
+        const int& _nDegree = m_pNurbsNode->nDegree;
+        const VECDOUBLE& _vecKnots = m_pNurbsNode->vecKnots;
+        if (m_pNurbsCurve != nullptr && HomogeneousKernelDeriv(_nDegree, _vecKnots.data(), m_pNurbsCurve->GetHomogeneousPoles(),
+            nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_)) {
+            return;
         }
 
-        m_vecValidWeights.clear();
-        auto _iterWeightBegin = m_pNurbsNode->vecWeights.begin() + nKnotIndex_ - m_pNurbsNode->nDegree;
-        auto _iterWeightEnd = m_pNurbsNode->vecWeights.begin() + nKnotIndex_ + 1;
-        for (; _iterWeightBegin != _iterWeightEnd; ++_iterWeightBegin) {
-            m_vecValidWeights.push_back(*_iterWeightBegin);
+        if (DeBoorKernelRationalDeriv(_nDegree, _vecKnots.data(), m_pNurbsNode->vecPoles.data(), m_pNurbsNode->vecWeights.data(),
+            nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_)) {
+            return;
         }
+
+        CopyValidPoles(nKnotIndex_);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, 0, _nDegree - 1);
+
+        double _nAlpha = 1.0 / (_vecKnots[nKnotIndex_ + 1] - _vecKnots[nKnotIndex_]);
+        double _nBeta = (nKnot_ - _vecKnots[nKnotIndex_]) * _nAlpha;
+        double _nWeight = (1.0 - _nBeta) * m_vecTempWeights1[_nDegree - 1] + _nBeta * m_vecTempWeights1[_nDegree];
+        ptDeriv1_ = (m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1]) * static_cast<double>(_nDegree) * _nAlpha
+            * m_vecTempWeights1[_nDegree] * m_vecTempWeights1[_nDegree - 1] / (_nWeight * _nWeight);
+
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, _nDegree - 1, _nDegree);
+        ptPoint_ = m_vecTempPoles1[_nDegree];
     }
 
     template<typename TYPE>
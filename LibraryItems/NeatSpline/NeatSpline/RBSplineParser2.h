@@ -31,35 +31,54 @@ namespace neat
         // Set the information for nurbs node.
         void SetNurbsNode(const NurbsNode<TYPE>* pNurbsNode_, bool bRational_);
 
+        // Set the information for compiled nurbs curve, which is not checked any more.
+        void SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_);
+
         // Returns in ptPoint_ the point, ptDeriv1_ the first-order derivative and ptDeriv2_ the second-order derivative of parameter nKnot_.
         void GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
 
+        // Returns in pPoints_ the points, pDeriv1s_ the first-order derivatives and pDeriv2s_ the second-order derivatives of the ascending parameters pKnots_.
+        void GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_, TYPE* pDeriv2s_);
+
     private:
-        // Record valid weighted poles and their weights.
-        void RecordValidPoles(int nKnotIndex_);
+        // Initialize the knot index to the first nonempty span.
+        void InitKnotIndex();
+
+        // Find the span of nKnot_ from the last knot index.
+        int LocateKnotIndex(double nKnot_);
+
+        // Copy the valid weighted poles and weights of the span nKnotIndex_ to the iteration poles and weights of the generic De-Boor algorithm.
+        void CopyValidPoles(int nKnotIndex_);
+
+        // Calculate the point, first-order derivative and second-order derivative in the span nKnotIndex_.
+        void CalculateDeriv(double nKnot_, int nKnotIndex_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_);
+
+        // Calculate the derivatives of numerator and denominator by the generic De-Boor algorithm.
+        void CalculateHomogeneousDeriv(double nKnot_, int nKnotIndex_);
 
         // De-Boor recursive algorithm to calculate iteration weighted poles and weights.
         void DeBoorAlgorithm(double nKnot_, int nKnotIndex_, int nStartIndex_, int nEndIndex_);
 
     private:
         NurbsNode<TYPE>* m_pNurbsNode;
+        const CNurbsCurve<TYPE>* m_pNurbsCurve;
         int m_nStartIndex;
         int m_nEndIndex;
         int m_nKnotIndex;
+        UniformKnots m_UniformKnots;
         bool m_bRational;
 
-        // Record the effective control points corresponding to m_nKnotIndex
-        CFastVector<TYPE> m_vecValidPoles;
+        // The iteration poles of the generic De-Boor algorithm
         CFastVector<TYPE> m_vecTempPoles1;
         CFastVector<TYPE> m_vecTempPoles2;
 
-        // Record the effective control point weight corresponding to m_nKnotIndex
-        CFastVector<double> m_vecValidWeights;
+        // The iteration weights of the generic De-Boor algorithm
         CFastVector<double> m_vecTempWeights1;
         CFastVector<double> m_vecTempWeights2;
 
         // The weighted poles
         CFastVector<TYPE> m_vecWeightedPoles;
+        const CFastVector<TYPE>* m_pWeightedPoles;
 
         // The derivation for numerator used to calculate the second-order derivative of Rational BSpline curve
         TYPE m_nxNumeratorDeriv[3];
@@ -74,10 +93,12 @@ namespace neat
     template<typename TYPE>
     CRBSplineParser2<TYPE>::CRBSplineParser2()
         : m_pNurbsNode(nullptr)
+        , m_pNurbsCurve(nullptr)
         , m_nStartIndex(0)
         , m_nEndIndex(0)
         , m_nKnotIndex(0)
         , m_bRational(false)
+        , m_pWeightedPoles(nullptr)
     {
     }
 
@@ -92,17 +113,14 @@ namespace neat
         NEAT_RAISE_IF(!bRational_ || !CheckNurbsNodeRational(pNurbsNode_), g_strNurbsParamsError);
 
         m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsNode_;
+        m_pNurbsCurve = nullptr;
         m_bRational = bRational_;
 
         // Initialize the knot index limit value
         m_nStartIndex = m_pNurbsNode->nDegree;
         m_nEndIndex = static_cast<int>(m_pNurbsNode->vecKnots.size()) - m_pNurbsNode->nDegree - 1;
         NEAT_RAISE(DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nStartIndex], m_pNurbsNode->vecKnots[m_nEndIndex]), g_strNurbsParamsError);
-
-        m_nKnotIndex = m_nStartIndex;
-        while (DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nKnotIndex + 1], m_pNurbsNode->vecKnots[m_nStartIndex])) {
-            ++m_nKnotIndex;
-        }
+        CheckUniformKnots(m_pNurbsNode->vecKnots, m_nStartIndex, m_nEndIndex, m_UniformKnots);
 
         // Construct the poles with weights.
         m_vecWeightedPoles.clear();
@@ -110,51 +128,102 @@ namespace neat
             m_vecWeightedPoles.push_back(m_pNurbsNode->vecPoles[i] * m_pNurbsNode->vecWeights[i]);
         }
 
-        RecordValidPoles(m_nKnotIndex);
+        m_pWeightedPoles = &m_vecWeightedPoles;
+        InitKnotIndex();
+    }
+
+    template<typename TYPE>
+    void CRBSplineParser2<TYPE>::SetNurbsCurve(const CNurbsCurve<TYPE>* pNurbsCurve_)
+    {
+        NEAT_RAISE_IF(pNurbsCurve_ == nullptr, g_strEmptyPointer);
+        NEAT_RAISE_IF(!pNurbsCurve_->IsRational(), g_strNurbsParamsError);
+
+        m_pNurbsNode = (NurbsNode<TYPE>*)pNurbsCurve_->GetNurbsNode();
+        m_pNurbsCurve = pNurbsCurve_;
+        m_bRational = pNurbsCurve_->IsRational();
+
+        // The compiled nurbs curve has been checked and its poles have been weighted
+        m_nStartIndex = pNurbsCurve_->GetStartIndex();
+        m_nEndIndex = pNurbsCurve_->GetEndIndex();
+        m_UniformKnots = pNurbsCurve_->GetUniformKnots();
+        m_pWeightedPoles = &pNurbsCurve_->GetWeightedPoles();
+        InitKnotIndex();
+    }
+
+    template<typename TYPE>
+    void CRBSplineParser2<TYPE>::InitKnotIndex()
+    {
+        m_nKnotIndex = m_nStartIndex;
+        while (DOUBLE_EQU(m_pNurbsNode->vecKnots[m_nKnotIndex + 1], m_pNurbsNode->vecKnots[m_nStartIndex])) {
+            ++m_nKnotIndex;
+        }
     }
 
     template<typename TYPE>
     void CRBSplineParser2<TYPE>::GetNurbsDeriv(double nKnot_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
     {
-        NEAT_RAISE_IF(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
         NEAT_RAISE_IF(m_pNurbsNode == nullptr, g_strEmptyPointer);
-        NEAT_RAISE_IF(!CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        NEAT_RAISE_IF(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && !CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+
+        CalculateDeriv(nKnot_, LocateKnotIndex(nKnot_), ptPoint_, ptDeriv1_, ptDeriv2_);
+    }
 
-        int _nLastKnotIndex = m_nKnotIndex;
-        int _nCurKnotIndex = FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_nKnotIndex);
-        if (_nCurKnotIndex != _nLastKnotIndex) {
-            RecordValidPoles(_nCurKnotIndex);
+    template<typename TYPE>
+    void CRBSplineParser2<TYPE>::GetNurbsDerivs(const double* pKnots_, size_t nCount_, TYPE* pPoints_, TYPE* pDeriv1s_, TYPE* pDeriv2s_)
+    {
+        NEAT_RAISE(m_pNurbsNode == nullptr, g_strEmptyPointer);
+        NEAT_RAISE(nCount_ > 0 && (pKnots_ == nullptr || pPoints_ == nullptr || pDeriv1s_ == nullptr || pDeriv2s_ == nullptr),
+            g_strEmptyPointer);
+        NEAT_RAISE(m_pNurbsNode->nDegree < 2, g_strWrongNurbsDegree);
+        NEAT_RAISE_IF(m_pNurbsCurve == nullptr && !CheckNurbsNodeRational(m_pNurbsNode), g_strNurbsParamsError);
+        CheckBatchKnots(m_pNurbsNode->vecKnots, pKnots_, nCount_, m_nStartIndex, m_nEndIndex);
+
+        // The span is searched from the last one since the parameters are ascending
+        for (size_t i = 0; i < nCount_; ++i) {
+            CalculateDeriv(pKnots_[i], LocateKnotIndex(pKnots_[i]), pPoints_[i], pDeriv1s_[i], pDeriv2s_[i]);
         }
+    }
+
+    template<typename TYPE>
+    int CRBSplineParser2<TYPE>::LocateKnotIndex(double nKnot_)
+    {
+        return FindSpanForKnot(m_pNurbsNode->vecKnots, nKnot_, m_nStartIndex, m_nEndIndex, m_UniformKnots, m_nKnotIndex);
+    }
+
+    template<typename TYPE>
+    void CRBSplineParser2<TYPE>::CopyValidPoles(int nKnotIndex_)
+    {
+        NEAT_RAISE_IF(nKnotIndex_ < m_nStartIndex || nKnotIndex_ > m_nEndIndex, g_strNurbsParamsError);
 
         m_vecTempPoles1.clear();
         m_vecTempPoles2.clear();
         m_vecTempWeights1.clear();
         m_vecTempWeights2.clear();
-        m_vecTempPoles1.copy(m_vecValidPoles);
-        m_vecTempPoles2.copy(m_vecValidPoles);
-        m_vecTempWeights1.copy(m_vecValidWeights);
-        m_vecTempWeights2.copy(m_vecValidWeights);
+        for (int i = nKnotIndex_ - m_pNurbsNode->nDegree; i <= nKnotIndex_; ++i) {
+            m_vecTempPoles1.push_back((*m_pWeightedPoles)[i]);
+            m_vecTempPoles2.push_back((*m_pWeightedPoles)[i]);
+            m_vecTempWeights1.push_back(m_pNurbsNode->vecWeights[i]);
+            m_vecTempWeights2.push_back(m_pNurbsNode->vecWeights[i]);
+        }
+    }
 
+    template<typename TYPE>
+    void CRBSplineParser2<TYPE>::CalculateDeriv(double nKnot_, int nKnotIndex_, TYPE& ptPoint_, TYPE& ptDeriv1_, TYPE& ptDeriv2_)
+    {
         const int& _nDegree = m_pNurbsNode->nDegree;
         const VECDOUBLE& _vecKnots = m_pNurbsNode->vecKnots;
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, 0, _nDegree - 2);
-
-        double _nAlpha1 = _nDegree / (_vecKnots[_nCurKnotIndex + 1] - _vecKnots[_nCurKnotIndex]);
-        double _nAlpha2 = 1.0 / (_vecKnots[_nCurKnotIndex + 2] - _vecKnots[_nCurKnotIndex]);
-        double _nAlpha3 = 1.0 / (_vecKnots[_nCurKnotIndex + 1] - _vecKnots[_nCurKnotIndex - 1]);
-        m_nxNumeratorDeriv[2] = _nAlpha1 * (_nDegree - 1) * ((m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1]) * _nAlpha2
-            - (m_vecTempPoles1[_nDegree - 1] - m_vecTempPoles1[_nDegree - 2]) * _nAlpha3);
-        m_nxDenominatorDeriv[2] = _nAlpha1 * (_nDegree - 1) * ((m_vecTempWeights1[_nDegree] - m_vecTempWeights1[_nDegree - 1]) * _nAlpha2
-            - (m_vecTempWeights1[_nDegree - 1] - m_vecTempWeights1[_nDegree - 2]) * _nAlpha3);
-
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, _nDegree - 2, _nDegree - 1);
-        m_nxNumeratorDeriv[1] = _nAlpha1 * (m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1]);
-        m_nxDenominatorDeriv[1] = _nAlpha1 * (m_vecTempWeights1[_nDegree] - m_vecTempWeights1[_nDegree - 1]);
+        // The compiled curve is calculated by the vectorized kernel first, and low degree by the specialized kernel
+        if (m_pNurbsCurve != nullptr && HomogeneousKernelDeriv(_nDegree, _vecKnots.data(), m_pNurbsCurve->GetHomogeneousPoles(),
+            nKnotIndex_, nKnot_, ptPoint_, ptDeriv1_, ptDeriv2_)) {
+            return;
+        }
 
-        DeBoorAlgorithm(nKnot_, _nCurKnotIndex, _nDegree - 1, _nDegree);
-        m_nxNumeratorDeriv[0] = m_vecTempPoles1[_nDegree];
-        m_nxDenominatorDeriv[0] = m_vecTempWeights1[_nDegree];
+        if (!DeBoorKernelHomogeneousDeriv(_nDegree, _vecKnots.data(), &(*m_pWeightedPoles)[0], m_pNurbsNode->vecWeights.data(),
+            nKnotIndex_, nKnot_, m_nxNumeratorDeriv, m_nxDenominatorDeriv)) {
+            CalculateHomogeneousDeriv(nKnot_, nKnotIndex_);
+        }
 
         double _nAlpha = 1.0 / m_nxDenominatorDeriv[0];
         ptPoint_ = m_nxNumeratorDeriv[0] * _nAlpha;
@@ -164,21 +233,29 @@ namespace neat
     }
 
     template<typename TYPE>
-    void CRBSplineParser2<TYPE>::RecordValidPoles(int nKnotIndex_)
+    void CRBSplineParser2<TYPE>::CalculateHomogeneousDeriv(double nKnot_, int nKnotIndex_)
     {
-        NEAT_RAISE_IF(nKnotIndex_ < m_nStartIndex || nKnotIndex_ > m_nEndIndex, g_strNurbsParamsError);
+        const int& _nDegree = m_pNurbsNode->nDegree;
+        const VECDOUBLE& _vecKnots = m_pNurbsNode->vecKnots;
 
-        m_vecValidPoles.clear();
-        for (int i = nKnotIndex_ - m_pNurbsNode->nDegree, _nSize = nKnotIndex_ + 1; i < _nSize; ++i) {
-            m_vecValidPoles.push_back(m_vecWeightedPoles[i]);
-        }
+        CopyValidPoles(nKnotIndex_);
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, 0, _nDegree - 2);
 
-        m_vecValidWeights.clear();
-        auto _iterWeightBegin = m_pNurbsNode->vecWeights.begin() + nKnotIndex_ - m_pNurbsNode->nDegree;
-        auto _iterWeightEnd = m_pNurbsNode->vecWeights.begin() + nKnotIndex_ + 1;
-        for (; _iterWeightBegin != _iterWeightEnd; ++_iterWeightBegin) {
-            m_vecValidWeights.push_back(*_iterWeightBegin);
-        }
+        double _nAlpha1 = _nDegree / (_vecKnots[nKnotIndex_ + 1] - _vecKnots[nKnotIndex_]);
+        double _nAlpha2 = 1.0 / (_vecKnots[nKnotIndex_ + 2] - _vecKnots[nKnotIndex_]);
+        double _nAlpha3 = 1.0 / (_vecKnots[nKnotIndex_ + 1] - _vecKnots[nKnotIndex_ - 1]);
+        m_nxNumeratorDeriv[2] = _nAlpha1 * (_nDegree - 1) * ((m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1]) * _nAlpha2
+            - (m_vecTempPoles1[_nDegree - 1] - m_vecTempPoles1[_nDegree - 2]) * _nAlpha3);
+        m_nxDenominatorDeriv[2] = _nAlpha1 * (_nDegree - 1) * ((m_vecTempWeights1[_nDegree] - m_vecTempWeights1[_nDegree - 1]) * _nAlpha2
+            - (m_vecTempWeights1[_nDegree - 1] - m_vecTempWeights1[_nDegree - 2]) * _nAlpha3);
+
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, _nDegree - 2, _nDegree - 1);
+        m_nxNumeratorDeriv[1] = _nAlpha1 * (m_vecTempPoles1[_nDegree] - m_vecTempPoles1[_nDegree - 1]);
+        m_nxDenominatorDeriv[1] = _nAlpha1 * (m_vecTempWeights1[_nDegree] - m_vecTempWeights1[_nDegree - 1]);
+
+        DeBoorAlgorithm(nKnot_, nKnotIndex_, _nDegree - 1, _nDegree);
+        m_nxNumeratorDeriv[0] = m_vecTempPoles1[_nDegree];
+        m_nxDenominatorDeriv[0] = m_vecTempWeights1[_nDegree];
     }
 
     template<typename TYPE>
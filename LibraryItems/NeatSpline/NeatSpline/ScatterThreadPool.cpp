@@ -0,0 +1,124 @@
+/***************************************************************************************************
+ Created on: 2020-03-22
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#include "pch.h"
+
+using namespace neat;
+
+CScatterThreadPool::CScatterThreadPool()
+    : m_pTask(nullptr)
+    , m_nTaskCount(0)
+    , m_nPendingCount(0)
+    , m_nRound(0)
+    , m_bStop(false)
+{
+}
+
+CScatterThreadPool::~CScatterThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> _Lock(m_TaskMutex);
+        m_bStop = true;
+    }
+
+    m_StartCondition.notify_all();
+    for (auto& _Thread : m_vecThreads) {
+        _Thread.join();
+    }
+}
+
+void CScatterThreadPool::RunTasks(int nTaskCount_, const std::function<void(int)>& funTask_)
+{
+    if (nTaskCount_ <= 1) {
+        if (nTaskCount_ == 1) {
+            funTask_(0);
+        }
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> _RunLock(m_RunMutex);
+    {
+        // the new thread waits for the round after current one
+        std::lock_guard<std::mutex> _Lock(m_TaskMutex);
+        while (static_cast<int>(m_vecThreads.size()) < nTaskCount_ - 1) {
+            m_vecThreads.emplace_back(&CScatterThreadPool::RunThread, this, static_cast<int>(m_vecThreads.size()) + 1, m_nRound);
+        }
+
+        m_pTask = &funTask_;
+        m_nTaskCount = nTaskCount_;
+        m_nPendingCount = nTaskCount_ - 1;
+        m_pException = nullptr;
+        ++m_nRound;
+    }
+
+    m_StartCondition.notify_all();
+
+    std::exception_ptr _pException;
+    try {
+        funTask_(0);
+    }
+    catch (...) {
+        _pException = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> _Lock(m_TaskMutex);
+    m_FinishCondition.wait(_Lock, [this] { return m_nPendingCount == 0; });
+    m_pTask = nullptr;
+    if (_pException == nullptr) {
+        _pException = m_pException;
+    }
+
+    m_pException = nullptr;
+    _Lock.unlock();
+
+    if (_pException != nullptr) {
+        std::rethrow_exception(_pException);
+    }
+}
+
+void CScatterThreadPool::RunThread(int nTaskIndex_, unsigned int nRound_)
+{
+    std::unique_lock<std::mutex> _Lock(m_TaskMutex);
+    while (true) {
+        m_StartCondition.wait(_Lock, [this, nRound_] { return m_bStop || m_nRound != nRound_; });
+        if (m_bStop) {
+            return;
+        }
+
+        // the thread is idle if current round has fewer tasks
+        nRound_ = m_nRound;
+        if (nTaskIndex_ >= m_nTaskCount) {
+            continue;
+        }
+
+        const std::function<void(int)>* _pTask = m_pTask;
+        _Lock.unlock();
+
+        std::exception_ptr _pException;
+        try {
+            (*_pTask)(nTaskIndex_);
+        }
+        catch (...) {
+            _pException = std::current_exception();
+        }
+
+        _Lock.lock();
+        if (_pException != nullptr && m_pException == nullptr) {
+            m_pException = _pException;
+        }
+
+        if (--m_nPendingCount == 0) {
+            m_FinishCondition.notify_one();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/***************************************************************************************************
+ Created on: 2020-03-22
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#ifndef __SCATTER_THREAD_POOL_H_20200322__
+#define __SCATTER_THREAD_POOL_H_20200322__
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * This file defines the thread pool of parallel scatter.
+ */
+namespace neat
+{
+    /**
+     * The threads of pool are created when they are first needed, and kept alive until the pool is destroyed.
+     * So the scatters which run tasks again and again don't create and join threads for every call.
+     */
+    class CScatterThreadPool
+    {
+    public:
+        CScatterThreadPool();
+        ~CScatterThreadPool();
+
+        // Run the tasks from 0 to nTaskCount_ (not included) and wait for all of them. The task 0 is run by the calling thread
+        // and the others by the threads of pool. The first exception of tasks is rethrown after all tasks are finished.
+        void RunTasks(int nTaskCount_, const std::function<void(int)>& funTask_);
+
+    private:
+        CScatterThreadPool(const CScatterThreadPool&) = delete;
+        CScatterThreadPool& operator=(const CScatterThreadPool&) = delete;
+
+        // Run the task nTaskIndex_ of every round after the round nRound_.
+        void RunThread(int nTaskIndex_, unsigned int nRound_);
+
+    private:
+        // Only one caller runs tasks at a time.
+        std::mutex m_RunMutex;
+
+        // The tasks of current round, which are protected by m_TaskMutex.
+        std::mutex m_TaskMutex;
+        std::condition_variable m_StartCondition;
+        std::condition_variable m_FinishCondition;
+        std::vector<std::thread> m_vecThreads;
+        const std::function<void(int)>* m_pTask;
+        int m_nTaskCount;
+        int m_nPendingCount;
+        unsigned int m_nRound;
+        bool m_bStop;
+        std::exception_ptr m_pException;
+    };
+
+} // End namespace neat
+
+#endif // __SCATTER_THREAD_POOL_H_20200322__
@@ -46,6 +46,36 @@ namespace neat
      */
     const std::string g_strWrongDimension = "ID_SPLINE_WRONG_DIMENSION";
 
+    /**
+     * Wrong number of threads
+     */
+    const std::string g_strWrongThreadCount = "ID_SPLINE_WRONG_THREAD_COUNT";
+
+    /**
+     * Wrong ratio of deflection for simplifying scatter nodes
+     */
+    const std::string g_strWrongSimplifyRatio = "ID_SPLINE_WRONG_SIMPLIFY_RATIO";
+
+    /**
+     * Wrong max segment length or max turning angle of scatter nodes
+     */
+    const std::string g_strWrongSegmentConstraints = "ID_SPLINE_WRONG_SEGMENT_CONSTRAINTS";
+
+    /**
+     * Wrong fields of scatter nodes to output
+     */
+    const std::string g_strWrongScatterFields = "ID_SPLINE_WRONG_SCATTER_FIELDS";
+
+    /**
+     * Wrong previous scatter nodes or pole indexes to rescatter
+     */
+    const std::string g_strWrongRescatterParams = "ID_SPLINE_WRONG_RESCATTER_PARAMETERS";
+
+    /**
+     * Wrong axes to measure deflection
+     */
+    const std::string g_strWrongDeflectionAxes = "ID_SPLINE_WRONG_DEFLECTION_AXES";
+
     /**
      * Bezier spline parameters error
      */
@@ -26,14 +26,24 @@
 #include "NeatSpline.h"
 
 #include "NurbsPublic.h"
+#include "DeBoorKernel.h"
+#include "HomogeneousKernel.h"
+#include "Nurbs_Curve.h"
 #include "NRBSplineParser.h"
 #include "RBSplineParser.h"
 #include "RBSplineParser2.h"
+#include "NurbsDerivParser.h"
 #include "Nurbs_Parser.h"
+#include "Bezier_Parser.h"
 #include "NurbsRefiner.h"
 #include "NurbsDeflection.h"
+#include "BezierDeflection.h"
+#include "ScatterThreadPool.h"
 #include "Nurbs_Scatter.h"
+#include "NurbsBatchScatter.h"
+#include "NurbsAxisScatter.h"
 #include "Nurbs_Converter.h"
+#include "NurbsPowerParser.h"
 #include "Nurbs_Interp.h"
 #include "Bezier_Converter.h"
 
@@ -0,0 +1,380 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library tester application.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#include "NeatSplineTester.h"
+#include <chrono>
+#include <iostream>
+
+using namespace neat;
+using namespace tester;
+
+/**
+ * Construct the non rational nurbs node with given degree and number of poles, all weights are one.
+ */
+static void ConstructNurbsNode(int nDegree_, int nPoleCount_, NurbsNode3D& NurbsNode_);
+
+/**
+ * Returns the average nanoseconds of evaluating a point for given parser.
+ */
+static double MeasureNurbsPoint(CNurbsParser3D& NurbsParser_, int nEvalCount_);
+static double MeasureNurbsPoint(CNurbsParser3D& NurbsParser_, const VECDOUBLE& vecKnots_);
+
+/**
+ * Returns the average nanoseconds of evaluating a point and its derivatives for given parser.
+ */
+static double MeasureNurbsDeriv(CNurbsParser3D& NurbsParser_, int nEvalCount_);
+
+/**
+ * Returns the average nanoseconds of evaluating a point and its derivatives up to nOrder_ in one pass for given parser.
+ */
+static double MeasureNurbsDeriv(CNurbsParser3D& NurbsParser_, int nOrder_, int nEvalCount_);
+
+/**
+ * Returns the average nanoseconds of setting a segment and evaluating nEvalCount_ points and derivatives on it.
+ */
+static double MeasureBezierSegment(const std::vector<BezierNode3D>& vecBezierNodes_, int nEvalCount_);
+static double MeasureNurbsSegment(const std::vector<NurbsNode3D>& vecNurbsNodes_, int nEvalCount_);
+
+/**
+ * Returns the average nanoseconds of a sample point by evaluating every parameter or forward differencing for given parser.
+ */
+static double MeasurePowerPoints(CNurbsPowerParser3D& PowerParser_, int nSteps_);
+static double MeasureSamplePoints(CNurbsPowerParser3D& PowerParser_, int nSteps_);
+
+/**
+ * This file benchmarks the interface for parsing splines.
+ */
+TEST(NeatParserBM, CompiledNurbsCurve)
+{
+    const int _nxPoleCounts[] = { 100, 1000, 10000, 100000 };
+    const int _nEvalCount = 5000;
+
+    for (int i = 0; i < _countof(_nxPoleCounts); ++i) {
+        NurbsNode3D _NurbsNode;
+        ConstructNurbsNode(3, _nxPoleCounts[i], _NurbsNode);
+        CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+        // The nurbs node is checked at every evaluation
+        CNurbsParser3D _NodeParser;
+        _NodeParser.SetNurbsNode(&_NurbsNode);
+        double _nNodeTime = MeasureNurbsPoint(_NodeParser, _nEvalCount);
+
+        // The compiled nurbs curve is checked only once
+        CNurbsParser3D _CurveParser;
+        _CurveParser.SetNurbsCurve(&_NurbsCurve);
+        double _nCurveTime = MeasureNurbsPoint(_CurveParser, _nEvalCount);
+
+        std::cout << "[ BENCHMARK] poles: " << _nxPoleCounts[i] << ", nurbs node: " << _nNodeTime
+            << " ns/eval, compiled curve: " << _nCurveTime << " ns/eval" << std::endl;
+    }
+}
+
+TEST(NeatParserBM, LargeNurbsSpanLookup)
+{
+    const int _nPoleCount = 50000;
+    const int _nEvalCount = 20000;
+
+    // The monotone parameters step into the neighbouring span, and the random parameters jump far away
+    VECDOUBLE _vecMonotoneKnots, _vecRandomKnots;
+    for (int i = 0; i < _nEvalCount; ++i) {
+        _vecMonotoneKnots.push_back(static_cast<double>(i) / _nEvalCount);
+        _vecRandomKnots.push_back(static_cast<double>((i * 7919) % _nEvalCount) / _nEvalCount);
+    }
+
+    for (int _nUniform = 1; _nUniform >= 0; --_nUniform) {
+        NurbsNode3D _NurbsNode;
+        ConstructNurbsNode(3, _nPoleCount, _NurbsNode);
+        for (size_t i = 4; _nUniform == 0 && i + 4 < _NurbsNode.vecKnots.size(); ++i) {
+            _NurbsNode.vecKnots[i] += 0.3 * sin(i * 0.37) / _nPoleCount;
+        }
+        CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+        CNurbsParser3D _NurbsParser;
+        _NurbsParser.SetNurbsCurve(&_NurbsCurve);
+        double _nMonotoneTime = MeasureNurbsPoint(_NurbsParser, _vecMonotoneKnots);
+        double _nRandomTime = MeasureNurbsPoint(_NurbsParser, _vecRandomKnots);
+
+        std::cout << "[ BENCHMARK] " << (_nUniform == 1 ? "uniform" : "non uniform") << " knots of " << _nPoleCount
+            << " poles, monotone: " << _nMonotoneTime << " ns/eval, random: " << _nRandomTime << " ns/eval" << std::endl;
+    }
+}
+
+TEST(NeatParserBM, DegreeKernelNurbsDeriv)
+{
+    const int _nEvalCount = 20000;
+
+    // Degree 2 to 5 are calculated by the specialized kernels
+    for (int _nDegree = 2; _nDegree <= 7; ++_nDegree) {
+        NurbsNode3D _NurbsNode;
+        ConstructNurbsNode(_nDegree, 100, _NurbsNode);
+        CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+        CNurbsParser3D _NurbsParser;
+        _NurbsParser.SetNurbsCurve(&_NurbsCurve);
+        double _nTime = MeasureNurbsDeriv(_NurbsParser, _nEvalCount);
+
+        std::cout << "[ BENCHMARK] degree: " << _nDegree << ", point and derivatives: " << _nTime << " ns/eval" << std::endl;
+    }
+}
+
+TEST(NeatParserBM, HigherDerivNurbsNode)
+{
+    const int _nEvalCount = 20000;
+
+    for (int _nRational = 0; _nRational < 2; ++_nRational) {
+        NurbsNode3D _NurbsNode;
+        ConstructNurbsNode(3, 100, _NurbsNode);
+        for (size_t i = 0; _nRational == 1 && i < _NurbsNode.vecWeights.size(); ++i) {
+            _NurbsNode.vecWeights[i] = 1.0 + 0.5 * (i % 3);
+        }
+        CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+        CNurbsParser3D _NurbsParser;
+        _NurbsParser.SetNurbsCurve(&_NurbsCurve);
+        double _nStagedTime = MeasureNurbsDeriv(_NurbsParser, _nEvalCount);
+        double _nDeriv2Time = MeasureNurbsDeriv(_NurbsParser, 2, _nEvalCount);
+        double _nDeriv3Time = MeasureNurbsDeriv(_NurbsParser, 3, _nEvalCount);
+
+        std::cout << "[ BENCHMARK] " << (_nRational == 1 ? "rational" : "non rational") << ", staged second-order: " << _nStagedTime
+            << " ns/eval, one pass second-order: " << _nDeriv2Time << " ns/eval, one pass third-order: " << _nDeriv3Time << " ns/eval"
+            << std::endl;
+    }
+}
+
+TEST(NeatParserBM, VectorKernelNurbsCurve)
+{
+    const int _nEvalCount = 20000;
+    const int _nxDegrees[] = { 3, 5, 7 };
+
+    for (int i = 0; i < _countof(_nxDegrees); ++i) {
+        NurbsNode3D _NurbsNode;
+        ConstructNurbsNode(_nxDegrees[i], 100, _NurbsNode);
+        for (size_t j = 0; j < _NurbsNode.vecWeights.size(); ++j) {
+            _NurbsNode.vecWeights[j] = 1.0 + 0.5 * (j % 3);
+        }
+        CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+        CNurbsParser3D _NurbsParser;
+        _NurbsParser.SetNurbsCurve(&_NurbsCurve);
+        EnableVectorKernel(false);
+        double _nScalarTime = MeasureNurbsDeriv(_NurbsParser, _nEvalCount);
+        EnableVectorKernel(true);
+        double _nVectorTime = MeasureNurbsDeriv(_NurbsParser, _nEvalCount);
+
+        std::cout << "[ BENCHMARK] rational degree " << _nxDegrees[i] << ", scalar kernel: " << _nScalarTime
+            << " ns/eval, vector kernel" << (CheckVectorKernel() ? "" : " (not supported)") << ": " << _nVectorTime << " ns/eval"
+            << std::endl;
+    }
+}
+
+TEST(NeatParserBM, BezierSegment)
+{
+    // The short segments of post processor output
+    const int _nSegmentCount = 2000;
+    const int _nEvalCount = 8;
+
+    for (int _nRational = 0; _nRational < 2; ++_nRational) {
+        std::vector<BezierNode3D> _vecBezierNodes(_nSegmentCount);
+        std::vector<NurbsNode3D> _vecNurbsNodes(_nSegmentCount);
+        for (int i = 0; i < _nSegmentCount; ++i) {
+            BezierNode3D& _BezierNode = _vecBezierNodes[i];
+            _BezierNode.nStartKnot = 0.0;
+            _BezierNode.nEndKnot = 1.0;
+            for (int j = 0; j <= 3; ++j) {
+                _BezierNode.vecPoles.push_back(DPOINT3(i + j, (i + j) % 7 * 3.0, (i * j) % 5 * 2.0));
+                _BezierNode.vecWeights.push_back(_nRational == 1 ? 1.0 + 0.5 * (j % 2) : 1.0);
+            }
+
+            NurbsNode3D& _NurbsNode = _vecNurbsNodes[i];
+            _NurbsNode.nDegree = 3;
+            _NurbsNode.vecKnots.assign(4, 0.0);
+            _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), 4, 1.0);
+            _NurbsNode.vecPoles = _BezierNode.vecPoles;
+            _NurbsNode.vecWeights = _BezierNode.vecWeights;
+        }
+
+        double _nBezierTime = MeasureBezierSegment(_vecBezierNodes, _nEvalCount);
+        double _nNurbsTime = MeasureNurbsSegment(_vecNurbsNodes, _nEvalCount);
+
+        std::cout << "[ BENCHMARK] " << (_nRational == 1 ? "rational" : "non rational") << " cubic segment of " << _nEvalCount
+            << " evaluations, bezier parser: " << _nBezierTime << " ns/segment, nurbs parser: " << _nNurbsTime << " ns/segment"
+            << std::endl;
+    }
+}
+
+TEST(NeatParserBM, ForwardDiffSamples)
+{
+    // The preview renderer samples every span at fixed steps
+    const int _nSteps = 32;
+
+    for (int _nRational = 0; _nRational < 2; ++_nRational) {
+        NurbsNode3D _NurbsNode;
+        ConstructNurbsNode(3, 1000, _NurbsNode);
+        for (size_t i = 0; _nRational == 1 && i < _NurbsNode.vecWeights.size(); ++i) {
+            _NurbsNode.vecWeights[i] = 1.0 + 0.5 * (i % 3);
+        }
+        CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+        CNurbsPowerParser3D _PowerParser;
+        _PowerParser.SetNurbsCurve(&_NurbsCurve);
+        double _nHornerTime = MeasurePowerPoints(_PowerParser, _nSteps);
+        double _nSampleTime = MeasureSamplePoints(_PowerParser, _nSteps);
+
+        std::cout << "[ BENCHMARK] " << (_nRational == 1 ? "rational" : "non rational") << " cubic of " << _nSteps
+            << " steps per span, horner: " << _nHornerTime << " ns/point, forward difference: " << _nSampleTime << " ns/point"
+            << std::endl;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void ConstructNurbsNode(int nDegree_, int nPoleCount_, NurbsNode3D& NurbsNode_)
+{
+    NurbsNode_.nDegree = nDegree_;
+    NurbsNode_.vecKnots.clear();
+    NurbsNode_.vecPoles.clear();
+    NurbsNode_.vecWeights.clear();
+
+    for (int i = 0; i <= NurbsNode_.nDegree; ++i) {
+        NurbsNode_.vecKnots.push_back(0.0);
+    }
+    int _nSpanCount = nPoleCount_ - NurbsNode_.nDegree;
+    for (int i = 1; i < _nSpanCount; ++i) {
+        NurbsNode_.vecKnots.push_back(static_cast<double>(i) / _nSpanCount);
+    }
+    for (int i = 0; i <= NurbsNode_.nDegree; ++i) {
+        NurbsNode_.vecKnots.push_back(1.0);
+    }
+
+    for (int i = 0; i < nPoleCount_; ++i) {
+        NurbsNode_.vecPoles.push_back(DPOINT3(i, (i % 7) * 3.0, (i % 5) * 2.0));
+        NurbsNode_.vecWeights.push_back(1.0);
+    }
+}
+
+static double MeasureNurbsPoint(CNurbsParser3D& NurbsParser_, int nEvalCount_)
+{
+    DPOINT3 _ptPoint, _ptSum;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nEvalCount_; ++i) {
+        NurbsParser_.GetNurbsPoint(static_cast<double>(i) / nEvalCount_, _ptPoint);
+        _ptSum += _ptPoint;
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_FALSE(_ptSum[0] != _ptSum[0]);
+
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / nEvalCount_;
+}
+
+static double MeasureNurbsPoint(CNurbsParser3D& NurbsParser_, const VECDOUBLE& vecKnots_)
+{
+    DPOINT3 _ptPoint, _ptSum;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vecKnots_.size(); ++i) {
+        NurbsParser_.GetNurbsPoint(vecKnots_[i], _ptPoint);
+        _ptSum += _ptPoint;
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_FALSE(_ptSum[0] != _ptSum[0]);
+
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / vecKnots_.size();
+}
+
+static double MeasureNurbsDeriv(CNurbsParser3D& NurbsParser_, int nEvalCount_)
+{
+    DPOINT3 _ptPoint, _ptDeriv1, _ptDeriv2, _ptSum;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nEvalCount_; ++i) {
+        NurbsParser_.GetNurbsDeriv(static_cast<double>(i) / nEvalCount_, _ptPoint, _ptDeriv1, _ptDeriv2);
+        _ptSum += _ptPoint + _ptDeriv1 + _ptDeriv2;
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_FALSE(_ptSum[0] != _ptSum[0]);
+
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / nEvalCount_;
+}
+
+static double MeasureNurbsDeriv(CNurbsParser3D& NurbsParser_, int nOrder_, int nEvalCount_)
+{
+    DPOINT3 _ptxDerivs[8], _ptSum;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nEvalCount_; ++i) {
+        NurbsParser_.GetNurbsDeriv(static_cast<double>(i) / nEvalCount_, nOrder_, _ptxDerivs);
+        _ptSum += _ptxDerivs[nOrder_];
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_FALSE(_ptSum[0] != _ptSum[0]);
+
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / nEvalCount_;
+}
+
+static double MeasureBezierSegment(const std::vector<BezierNode3D>& vecBezierNodes_, int nEvalCount_)
+{
+    CBezierParser3D _BezierParser;
+    DPOINT3 _ptPoint, _ptDeriv1, _ptDeriv2, _ptSum;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vecBezierNodes_.size(); ++i) {
+        _BezierParser.SetBezierNode(&vecBezierNodes_[i]);
+        for (int j = 0; j <= nEvalCount_; ++j) {
+            _BezierParser.GetBezierDeriv(static_cast<double>(j) / nEvalCount_, _ptPoint, _ptDeriv1, _ptDeriv2);
+            _ptSum += _ptPoint + _ptDeriv1 + _ptDeriv2;
+        }
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_FALSE(_ptSum[0] != _ptSum[0]);
+
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / vecBezierNodes_.size();
+}
+
+static double MeasureNurbsSegment(const std::vector<NurbsNode3D>& vecNurbsNodes_, int nEvalCount_)
+{
+    CNurbsParser3D _NurbsParser;
+    DPOINT3 _ptPoint, _ptDeriv1, _ptDeriv2, _ptSum;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vecNurbsNodes_.size(); ++i) {
+        _NurbsParser.SetNurbsNode(&vecNurbsNodes_[i]);
+        for (int j = 0; j <= nEvalCount_; ++j) {
+            _NurbsParser.GetNurbsDeriv(static_cast<double>(j) / nEvalCount_, _ptPoint, _ptDeriv1, _ptDeriv2);
+            _ptSum += _ptPoint + _ptDeriv1 + _ptDeriv2;
+        }
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_FALSE(_ptSum[0] != _ptSum[0]);
+
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / vecNurbsNodes_.size();
+}
+
+static double MeasurePowerPoints(CNurbsPowerParser3D& PowerParser_, int nSteps_)
+{
+    // The spans of ConstructNurbsNode are uniform in [0, 1]
+    int _nPointCount = PowerParser_.GetSpanCount() * nSteps_ + 1;
+    std::vector<DPOINT3> _vecPoints(_nPointCount);
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < _nPointCount; ++i) {
+        PowerParser_.GetNurbsPoint(static_cast<double>(i) / (_nPointCount - 1), _vecPoints[i]);
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_FALSE(_vecPoints.back()[0] != _vecPoints.back()[0]);
+
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / _nPointCount;
+}
+
+static double MeasureSamplePoints(CNurbsPowerParser3D& PowerParser_, int nSteps_)
+{
+    std::vector<DPOINT3> _vecPoints;
+    PowerParser_.GetSamplePoints(nSteps_, _vecPoints);
+    auto _tmStart = std::chrono::steady_clock::now();
+    PowerParser_.GetSamplePoints(nSteps_, _vecPoints);
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_FALSE(_vecPoints.back()[0] != _vecPoints.back()[0]);
+
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / _vecPoints.size();
+}
\ No newline at end of file
@@ -11,6 +11,8 @@
 
 ***************************************************************************************************/
 #include "NeatSplineTester.h"
+#include <algorithm>
+#include <thread>
 
 using namespace neat;
 using namespace tester;
@@ -359,4 +361,877 @@ TEST(NeatParserUT, 3DEllipseNurbsNode)
         double _nCurvature = _nxOuterProduct.GetLength() / pow(_ptDeriv1[1].GetLength(), 3);
         EXPECT_NEAR(_nCurvature, _nxCurvatures[i], Precision::RealTolerance());
     }
+}
+
+TEST(NeatParserUT, 2DBatchNurbsNode)
+{
+    // Two-dimensional ellipse
+    NurbsNode2D _NurbsNode;
+    _NurbsNode.nDegree = 2;
+    _NurbsNode.vecKnots.push_back(0.0);
+    _NurbsNode.vecKnots.push_back(0.0);
+    _NurbsNode.vecKnots.push_back(0.0);
+    _NurbsNode.vecKnots.push_back(1.0 / 3.0);
+    _NurbsNode.vecKnots.push_back(2.0 / 3.0);
+    _NurbsNode.vecKnots.push_back(2.0 / 3.0);
+    _NurbsNode.vecKnots.push_back(1.0);
+    _NurbsNode.vecKnots.push_back(1.0);
+    _NurbsNode.vecKnots.push_back(1.0);
+    _NurbsNode.vecPoles.push_back(DPOINT2(200.0, 0.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(200.0, -100.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(-200.0, -100.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(-200.0, 0.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(-200.0, 100.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(0.0, 100.0));
+    _NurbsNode.vecWeights.push_back(1.0);
+    _NurbsNode.vecWeights.push_back(0.5);
+    _NurbsNode.vecWeights.push_back(0.5);
+    _NurbsNode.vecWeights.push_back(1.0);
+    _NurbsNode.vecWeights.push_back(sqrt(2.0) / 2.0);
+    _NurbsNode.vecWeights.push_back(1.0);
+
+    // Parser nurbs node in batch and one by one
+    CNurbsParser2D _NurbsParser, _BatchParser;
+    EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_NurbsNode));
+    EXPECT_NO_THROW(_BatchParser.SetNurbsNode(&_NurbsNode));
+
+    const int _nCount = 61;
+    double _nxKnots[_nCount];
+    for (int i = 0; i < _nCount; ++i) {
+        _nxKnots[i] = static_cast<double>(i) / (_nCount - 1);
+    }
+
+    DPOINT2 _ptPoints[3][_nCount];
+    DPOINT2 _ptDeriv1s[2][_nCount];
+    DPOINT2 _ptDeriv2s[_nCount];
+    EXPECT_NO_THROW(_BatchParser.GetNurbsPoints(_nxKnots, _nCount, _ptPoints[0]));
+    EXPECT_NO_THROW(_BatchParser.GetNurbsDerivs(_nxKnots, _nCount, _ptPoints[1], _ptDeriv1s[0]));
+    EXPECT_NO_THROW(_BatchParser.GetNurbsDerivs(_nxKnots, _nCount, _ptPoints[2], _ptDeriv1s[1], _ptDeriv2s));
+
+    DPOINT2 _ptPoint, _ptDeriv1, _ptDeriv2;
+    for (int i = 0; i < _nCount; ++i) {
+        EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nxKnots[i], _ptPoint, _ptDeriv1, _ptDeriv2));
+        CheckDPoint2Equal(_ptPoints[0][i], _ptPoint, Precision::RealTolerance());
+        CheckDPoint2Equal(_ptPoints[1][i], _ptPoint, Precision::RealTolerance());
+        CheckDPoint2Equal(_ptPoints[2][i], _ptPoint, Precision::RealTolerance());
+        CheckDPoint2Equal(_ptDeriv1s[0][i], _ptDeriv1, Precision::RealTolerance());
+        CheckDPoint2Equal(_ptDeriv1s[1][i], _ptDeriv1, Precision::RealTolerance());
+        CheckDPoint2Equal(_ptDeriv2s[i], _ptDeriv2, Precision::RealTolerance());
+    }
+
+    // The parameters must be in ascending order
+    double _nxWrongKnots[] = { 0.5, 0.2 };
+    EXPECT_THROW(_BatchParser.GetNurbsPoints(_nxWrongKnots, _countof(_nxWrongKnots), _ptPoints[0]), std::exception);
+    EXPECT_THROW(_BatchParser.GetNurbsPoints(_nxKnots, _nCount, nullptr), std::exception);
+}
+
+TEST(NeatParserUT, 3DBatchNurbsNode)
+{
+    // Three-dimensional non rational curve with several spans
+    NurbsNode3D _NurbsNode;
+    _NurbsNode.nDegree = 3;
+    double _nxKnots[] = { 0.0, 0.0, 0.0, 0.0, 0.2, 0.45, 0.45, 0.7, 1.0, 1.0, 1.0, 1.0 };
+    for (int i = 0; i < _countof(_nxKnots); ++i) {
+        _NurbsNode.vecKnots.push_back(_nxKnots[i]);
+    }
+
+    _NurbsNode.vecPoles.push_back(DPOINT3(0.0, 0.0, 0.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(10.0, 25.0, 3.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(30.0, 20.0, -4.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(45.0, -5.0, 8.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(60.0, 10.0, 2.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(75.0, 35.0, -6.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(90.0, 15.0, 5.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(100.0, 0.0, 0.0));
+
+    // Parser nurbs node in batch and one by one
+    CNurbsParser3D _NurbsParser, _BatchParser;
+    EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_NurbsNode));
+    EXPECT_NO_THROW(_BatchParser.SetNurbsNode(&_NurbsNode));
+
+    const int _nCount = 101;
+    double _nxParams[_nCount];
+    for (int i = 0; i < _nCount; ++i) {
+        _nxParams[i] = static_cast<double>(i) / (_nCount - 1);
+    }
+
+    DPOINT3 _ptPoints[3][_nCount];
+    DPOINT3 _ptDeriv1s[2][_nCount];
+    DPOINT3 _ptDeriv2s[_nCount];
+    EXPECT_NO_THROW(_BatchParser.GetNurbsPoints(_nxParams, _nCount, _ptPoints[0]));
+    EXPECT_NO_THROW(_BatchParser.GetNurbsDerivs(_nxParams, _nCount, _ptPoints[1], _ptDeriv1s[0]));
+    EXPECT_NO_THROW(_BatchParser.GetNurbsDerivs(_nxParams, _nCount, _ptPoints[2], _ptDeriv1s[1], _ptDeriv2s));
+
+    DPOINT3 _ptPoint, _ptDeriv1, _ptDeriv2;
+    for (int i = 0; i < _nCount; ++i) {
+        EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nxParams[i], _ptPoint, _ptDeriv1, _ptDeriv2));
+        CheckDPoint3Equal(_ptPoints[0][i], _ptPoint, Precision::RealTolerance());
+        CheckDPoint3Equal(_ptPoints[1][i], _ptPoint, Precision::RealTolerance());
+        CheckDPoint3Equal(_ptPoints[2][i], _ptPoint, Precision::RealTolerance());
+        CheckDPoint3Equal(_ptDeriv1s[0][i], _ptDeriv1, Precision::RealTolerance());
+        CheckDPoint3Equal(_ptDeriv1s[1][i], _ptDeriv1, Precision::RealTolerance());
+        CheckDPoint3Equal(_ptDeriv2s[i], _ptDeriv2, Precision::RealTolerance());
+    }
+
+    // The parameters must be in ascending order and within the valid knots
+    double _nxWrongParams[] = { 0.8, 0.3 };
+    EXPECT_THROW(_BatchParser.GetNurbsPoints(_nxWrongParams, _countof(_nxWrongParams), _ptPoints[0]), std::exception);
+    double _nxOutParams[] = { 0.5, 1.5 };
+    EXPECT_THROW(_BatchParser.GetNurbsDerivs(_nxOutParams, _countof(_nxOutParams), _ptPoints[1], _ptDeriv1s[0]), std::exception);
+}
+
+TEST(NeatParserUT, 2DCompiledNurbsCurve)
+{
+    // Two-dimensional rational curve with a repeated inner knot
+    NurbsNode2D _NurbsNode;
+    _NurbsNode.nDegree = 2;
+    double _nxKnots[] = { 0.0, 0.0, 0.0, 0.25, 0.5, 0.5, 1.0, 1.0, 1.0 };
+    for (int i = 0; i < _countof(_nxKnots); ++i) {
+        _NurbsNode.vecKnots.push_back(_nxKnots[i]);
+    }
+
+    _NurbsNode.vecPoles.push_back(DPOINT2(0.0, 0.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(10.0, 20.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(30.0, 25.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(45.0, 5.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(60.0, -10.0));
+    _NurbsNode.vecPoles.push_back(DPOINT2(80.0, 0.0));
+    _NurbsNode.vecWeights.push_back(1.0);
+    _NurbsNode.vecWeights.push_back(0.8);
+    _NurbsNode.vecWeights.push_back(1.5);
+    _NurbsNode.vecWeights.push_back(1.0);
+    _NurbsNode.vecWeights.push_back(0.6);
+    _NurbsNode.vecWeights.push_back(1.0);
+
+    // Compile nurbs node
+    CNurbsCurve2D _NurbsCurve(&_NurbsNode);
+    EXPECT_TRUE(_NurbsCurve.IsRational());
+
+    VECDOUBLE _vecUniqueKnots;
+    std::vector<int> _vecMultiplicities;
+    _NurbsCurve.GetUniqueKnots(_vecUniqueKnots, _vecMultiplicities);
+    double _nxAimKnots[] = { 0.0, 0.25, 0.5, 1.0 };
+    int _nxAimMultiplicities[] = { 3, 1, 2, 3 };
+    EXPECT_EQ(_vecUniqueKnots.size(), _countof(_nxAimKnots));
+    EXPECT_EQ(_vecMultiplicities.size(), _countof(_nxAimMultiplicities));
+    for (size_t i = 0; i < _vecUniqueKnots.size() && i < _countof(_nxAimKnots); ++i) {
+        EXPECT_NEAR(_vecUniqueKnots[i], _nxAimKnots[i], Precision::RealTolerance());
+        EXPECT_EQ(_vecMultiplicities[i], _nxAimMultiplicities[i]);
+    }
+
+    // The compiled curve is a copy, changing the source node does not affect it
+    NurbsNode2D _SourceNode = _NurbsNode;
+    _NurbsNode.vecPoles[2] = DPOINT2(-100.0, -100.0);
+    EXPECT_EQ(_NurbsCurve.GetNurbsNode()->vecPoles[2][0], 30.0);
+
+    // Parser compiled curve and nurbs node
+    CNurbsParser2D _NurbsParser, _CurveParser;
+    EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_SourceNode));
+    EXPECT_NO_THROW(_CurveParser.SetNurbsCurve(&_NurbsCurve));
+
+    DPOINT2 _ptPoint[2], _ptDeriv1[2], _ptDeriv2[2];
+    for (int i = 0; i <= 40; ++i) {
+        double _nKnot = i / 40.0;
+        EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, _ptPoint[0], _ptDeriv1[0], _ptDeriv2[0]));
+        EXPECT_NO_THROW(_CurveParser.GetNurbsDeriv(_nKnot, _ptPoint[1], _ptDeriv1[1], _ptDeriv2[1]));
+        CheckDPoint2Equal(_ptPoint[0], _ptPoint[1], Precision::RealTolerance());
+        CheckDPoint2Equal(_ptDeriv1[0], _ptDeriv1[1], Precision::RealTolerance());
+        CheckDPoint2Equal(_ptDeriv2[0], _ptDeriv2[1], Precision::RealTolerance());
+        EXPECT_NO_THROW(_CurveParser.GetNurbsPoint(_nKnot, _ptPoint[1]));
+        CheckDPoint2Equal(_ptPoint[0], _ptPoint[1], Precision::RealTolerance());
+    }
+
+    // Illegal nurbs node can not be compiled
+    NurbsNode2D _WrongNode = _SourceNode;
+    _WrongNode.vecKnots[4] = 0.1;
+    EXPECT_THROW(CNurbsCurve2D _WrongCurve(&_WrongNode), std::exception);
+    _WrongNode = _SourceNode;
+    _WrongNode.vecWeights.pop_back();
+    EXPECT_THROW(CNurbsCurve2D _WrongCurve(&_WrongNode), std::exception);
+}
+
+TEST(NeatParserUT, 2DDegreeKernelNurbsNode)
+{
+    // The low degree uses the specialized kernels and the others use the generic De-Boor algorithm
+    for (int _nDegree = 1; _nDegree <= 7; ++_nDegree) {
+        NurbsNode2D _NurbsNode;
+        _NurbsNode.nDegree = _nDegree;
+        double _nxInnerKnots[] = { 0.15, 0.4, 0.55, 0.8 };
+        _NurbsNode.vecKnots.assign(_nDegree + 1, 0.0);
+        for (int i = 0; i < _countof(_nxInnerKnots); ++i) {
+            _NurbsNode.vecKnots.push_back(_nxInnerKnots[i]);
+        }
+        _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), _nDegree + 1, 1.0);
+
+        // The poles are the blossoms of x = u and y = u * u, so the curve reproduces them exactly
+        const VECDOUBLE& _vecKnots = _NurbsNode.vecKnots;
+        int _nPoleCount = static_cast<int>(_vecKnots.size()) - _nDegree - 1;
+        for (int i = 0; i < _nPoleCount; ++i) {
+            double _nSum = 0.0, _nProduct = 0.0;
+            for (int j = i + 1; j <= i + _nDegree; ++j) {
+                _nSum += _vecKnots[j];
+                for (int k = j + 1; k <= i + _nDegree; ++k) {
+                    _nProduct += _vecKnots[j] * _vecKnots[k];
+                }
+            }
+            double _nPoleX = _nSum / _nDegree;
+            double _nPoleY = _nDegree < 2 ? _nPoleX : _nProduct * 2.0 / (_nDegree * (_nDegree - 1));
+            _NurbsNode.vecPoles.push_back(DPOINT2(_nPoleX, _nPoleY));
+        }
+
+        // Rational node and its homogeneous non rational node
+        NurbsNode2D _RationalNode = _NurbsNode;
+        NurbsNode3D _HomogeneousNode;
+        _HomogeneousNode.nDegree = _nDegree;
+        _HomogeneousNode.vecKnots = _vecKnots;
+        for (int i = 0; i < _nPoleCount; ++i) {
+            double _nWeight = 1.0 + 0.5 * sin(i * 1.7);
+            const DPOINT2& _ptPole = _NurbsNode.vecPoles[i];
+            _RationalNode.vecWeights.push_back(_nWeight);
+            _HomogeneousNode.vecPoles.push_back(DPOINT3(_ptPole[0] * _nWeight, _ptPole[1] * _nWeight, _nWeight));
+        }
+
+        CNurbsParser2D _NurbsParser, _RationalParser;
+        CNurbsParser3D _HomogeneousParser;
+        EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_NurbsNode));
+        EXPECT_NO_THROW(_RationalParser.SetNurbsNode(&_RationalNode));
+        EXPECT_NO_THROW(_HomogeneousParser.SetNurbsNode(&_HomogeneousNode));
+
+        const double _nTolerance = 1.0e-7;
+        DPOINT2 _ptPoint, _ptDeriv1, _ptDeriv2;
+        DPOINT3 _ptxHomogeneous[3];
+        for (int i = 0; i <= 50; ++i) {
+            double _nKnot = i / 50.0;
+            double _nAimY = _nDegree < 2 ? _nKnot : _nKnot * _nKnot;
+            double _nAimDeriv1Y = _nDegree < 2 ? 1.0 : 2.0 * _nKnot;
+
+            // Non rational curve
+            EXPECT_NO_THROW(_NurbsParser.GetNurbsPoint(_nKnot, _ptPoint));
+            CheckDPoint2Equal(_ptPoint, DPOINT2(_nKnot, _nAimY), _nTolerance);
+            EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, _ptPoint, _ptDeriv1));
+            CheckDPoint2Equal(_ptPoint, DPOINT2(_nKnot, _nAimY), _nTolerance);
+            CheckDPoint2Equal(_ptDeriv1, DPOINT2(1.0, _nAimDeriv1Y), _nTolerance);
+            if (_nDegree >= 2) {
+                EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, _ptPoint, _ptDeriv1, _ptDeriv2));
+                CheckDPoint2Equal(_ptPoint, DPOINT2(_nKnot, _nAimY), _nTolerance);
+                CheckDPoint2Equal(_ptDeriv1, DPOINT2(1.0, _nAimDeriv1Y), _nTolerance);
+                CheckDPoint2Equal(_ptDeriv2, DPOINT2(0.0, 2.0), _nTolerance);
+            }
+
+            // Rational curve is the projection of homogeneous curve
+            if (_nDegree >= 2) {
+                EXPECT_NO_THROW(_HomogeneousParser.GetNurbsDeriv(_nKnot, _ptxHomogeneous[0], _ptxHomogeneous[1], _ptxHomogeneous[2]));
+            }
+            else {
+                EXPECT_NO_THROW(_HomogeneousParser.GetNurbsDeriv(_nKnot, _ptxHomogeneous[0], _ptxHomogeneous[1]));
+            }
+            double _nWeight = _ptxHomogeneous[0][2];
+            DPOINT2 _ptAimPoint(_ptxHomogeneous[0][0] / _nWeight, _ptxHomogeneous[0][1] / _nWeight);
+            DPOINT2 _ptAimDeriv1 = (DPOINT2(_ptxHomogeneous[1][0], _ptxHomogeneous[1][1]) - _ptAimPoint * _ptxHomogeneous[1][2]) / _nWeight;
+
+            EXPECT_NO_THROW(_RationalParser.GetNurbsPoint(_nKnot, _ptPoint));
+            CheckDPoint2Equal(_ptPoint, _ptAimPoint, _nTolerance);
+            EXPECT_NO_THROW(_RationalParser.GetNurbsDeriv(_nKnot, _ptPoint, _ptDeriv1));
+            CheckDPoint2Equal(_ptPoint, _ptAimPoint, _nTolerance);
+            CheckDPoint2Equal(_ptDeriv1, _ptAimDeriv1, _nTolerance);
+            if (_nDegree >= 2) {
+                DPOINT2 _ptAimDeriv2 = (DPOINT2(_ptxHomogeneous[2][0], _ptxHomogeneous[2][1]) - _ptAimDeriv1 * (2.0 * _ptxHomogeneous[1][2])
+                    - _ptAimPoint * _ptxHomogeneous[2][2]) / _nWeight;
+                EXPECT_NO_THROW(_RationalParser.GetNurbsDeriv(_nKnot, _ptPoint, _ptDeriv1, _ptDeriv2));
+                CheckDPoint2Equal(_ptPoint, _ptAimPoint, _nTolerance);
+                CheckDPoint2Equal(_ptDeriv1, _ptAimDeriv1, _nTolerance);
+                CheckDPoint2Equal(_ptDeriv2, _ptAimDeriv2, _nTolerance);
+            }
+        }
+    }
+}
+
+TEST(NeatParserUT, 3DBezierNode)
+{
+    // The bezier parser is same as the nurbs parser of the nurbs node with the single span
+    for (int _nDegree = 1; _nDegree <= 7; ++_nDegree) {
+        for (int _nRational = 0; _nRational < 2; ++_nRational) {
+            BezierNode3D _BezierNode;
+            _BezierNode.nStartKnot = 2.0;
+            _BezierNode.nEndKnot = 3.5;
+            NurbsNode3D _NurbsNode;
+            _NurbsNode.nDegree = _nDegree;
+            _NurbsNode.vecKnots.assign(_nDegree + 1, _BezierNode.nStartKnot);
+            _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), _nDegree + 1, _BezierNode.nEndKnot);
+            for (int i = 0; i <= _nDegree; ++i) {
+                _BezierNode.vecPoles.push_back(DPOINT3(i * 5.0, 8.0 * sin(i * 1.1), 3.0 * cos(i * 0.7)));
+                _BezierNode.vecWeights.push_back(_nRational == 1 ? 1.0 + 0.4 * sin(i * 1.9) : 1.0);
+            }
+            _NurbsNode.vecPoles = _BezierNode.vecPoles;
+            _NurbsNode.vecWeights = _BezierNode.vecWeights;
+
+            CBezierParser3D _BezierParser;
+            CNurbsParser3D _NurbsParser;
+            EXPECT_NO_THROW(_BezierParser.SetBezierNode(&_BezierNode));
+            EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_NurbsNode));
+
+            DPOINT3 _ptPoint[2], _ptDeriv1[2], _ptDeriv2[2];
+            for (int i = 0; i <= 30; ++i) {
+                double _nKnot = _BezierNode.nStartKnot + (_BezierNode.nEndKnot - _BezierNode.nStartKnot) * i / 30.0;
+                EXPECT_NO_THROW(_BezierParser.GetBezierPoint(_nKnot, _ptPoint[0]));
+                EXPECT_NO_THROW(_NurbsParser.GetNurbsPoint(_nKnot, _ptPoint[1]));
+                CheckDPoint3Equal(_ptPoint[0], _ptPoint[1], 1.0e-8);
+
+                EXPECT_NO_THROW(_BezierParser.GetBezierDeriv(_nKnot, _ptPoint[0], _ptDeriv1[0]));
+                EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, _ptPoint[1], _ptDeriv1[1]));
+                CheckDPoint3Equal(_ptPoint[0], _ptPoint[1], 1.0e-8);
+                CheckDPoint3Equal(_ptDeriv1[0], _ptDeriv1[1], 1.0e-7);
+
+                if (_nDegree >= 2) {
+                    EXPECT_NO_THROW(_BezierParser.GetBezierDeriv(_nKnot, _ptPoint[0], _ptDeriv1[0], _ptDeriv2[0]));
+                    EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, _ptPoint[1], _ptDeriv1[1], _ptDeriv2[1]));
+                    CheckDPoint3Equal(_ptPoint[0], _ptPoint[1], 1.0e-8);
+                    CheckDPoint3Equal(_ptDeriv1[0], _ptDeriv1[1], 1.0e-7);
+                    CheckDPoint3Equal(_ptDeriv2[0], _ptDeriv2[1], 1.0e-6);
+                }
+            }
+        }
+    }
+
+    // The second-order derivative of line is zero
+    BezierNode3D _LineNode;
+    _LineNode.nStartKnot = 0.0;
+    _LineNode.nEndKnot = 2.0;
+    _LineNode.vecPoles.push_back(DPOINT3(0.0, 0.0, 0.0));
+    _LineNode.vecPoles.push_back(DPOINT3(4.0, 2.0, 0.0));
+
+    CBezierParser3D _BezierParser;
+    DPOINT3 _ptPoint, _ptDeriv1, _ptDeriv2;
+    EXPECT_THROW(_BezierParser.GetBezierPoint(0.5, _ptPoint), std::exception);
+    EXPECT_NO_THROW(_BezierParser.SetBezierNode(&_LineNode));
+    EXPECT_NO_THROW(_BezierParser.GetBezierDeriv(0.5, _ptPoint, _ptDeriv1, _ptDeriv2));
+    CheckDPoint3Equal(_ptPoint, DPOINT3(1.0, 0.5, 0.0), Precision::RealTolerance());
+    CheckDPoint3Equal(_ptDeriv1, DPOINT3(2.0, 1.0, 0.0), Precision::RealTolerance());
+    CheckDPoint3Equal(_ptDeriv2, DPOINT3(0.0, 0.0, 0.0), Precision::RealTolerance());
+
+    // Knot out of range and illegal bezier node
+    EXPECT_THROW(_BezierParser.GetBezierPoint(2.5, _ptPoint), std::exception);
+    _LineNode.vecWeights.push_back(1.0);
+    EXPECT_THROW(_BezierParser.SetBezierNode(&_LineNode), std::exception);
+    _LineNode.vecWeights.clear();
+    _LineNode.nEndKnot = 0.0;
+    EXPECT_THROW(_BezierParser.SetBezierNode(&_LineNode), std::exception);
+}
+
+TEST(NeatParserUT, 2DHigherDerivNurbsNode)
+{
+    // Non rational curve: the poles are the blossoms of x = u and y = u * u * u
+    NurbsNode2D _NurbsNode;
+    _NurbsNode.nDegree = 4;
+    double _nxKnots[] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0 };
+    for (int i = 0; i < _countof(_nxKnots); ++i) {
+        _NurbsNode.vecKnots.push_back(_nxKnots[i]);
+    }
+
+    for (int i = 0; i + _NurbsNode.nDegree + 1 < _countof(_nxKnots); ++i) {
+        double _nSum = 0.0, _nProduct = 0.0;
+        for (int j = i + 1; j <= i + 4; ++j) {
+            _nSum += _nxKnots[j];
+            for (int k = j + 1; k <= i + 4; ++k) {
+                for (int l = k + 1; l <= i + 4; ++l) {
+                    _nProduct += _nxKnots[j] * _nxKnots[k] * _nxKnots[l];
+                }
+            }
+        }
+        _NurbsNode.vecPoles.push_back(DPOINT2(_nSum / 4.0, _nProduct / 4.0));
+    }
+
+    CNurbsParser2D _NurbsParser;
+    EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_NurbsNode));
+
+    DPOINT2 _ptxDerivs[6];
+    DPOINT2 _ptPoint, _ptDeriv1, _ptDeriv2, _ptDeriv3;
+    for (int i = 0; i <= 40; ++i) {
+        double _nKnot = i / 40.0;
+        EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, 5, _ptxDerivs));
+        CheckDPoint2Equal(_ptxDerivs[0], DPOINT2(_nKnot, _nKnot * _nKnot * _nKnot), Precision::RealTolerance());
+        CheckDPoint2Equal(_ptxDerivs[1], DPOINT2(1.0, 3.0 * _nKnot * _nKnot), Precision::RealTolerance());
+        CheckDPoint2Equal(_ptxDerivs[2], DPOINT2(0.0, 6.0 * _nKnot), Precision::RealTolerance());
+        CheckDPoint2Equal(_ptxDerivs[3], DPOINT2(0.0, 6.0), 1.0e-8);
+        CheckDPoint2Equal(_ptxDerivs[4], DPOINT2(0.0, 0.0), 1.0e-6);
+        CheckDPoint2Equal(_ptxDerivs[5], DPOINT2(0.0, 0.0), Precision::RealTolerance());
+
+        EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, _ptPoint, _ptDeriv1, _ptDeriv2, _ptDeriv3));
+        CheckDPoint2Equal(_ptPoint, _ptxDerivs[0], Precision::RealTolerance());
+        CheckDPoint2Equal(_ptDeriv1, _ptxDerivs[1], Precision::RealTolerance());
+        CheckDPoint2Equal(_ptDeriv2, _ptxDerivs[2], Precision::RealTolerance());
+        CheckDPoint2Equal(_ptDeriv3, _ptxDerivs[3], Precision::RealTolerance());
+    }
+
+    // Rational curve
+    NurbsNode2D _RationalNode = _NurbsNode;
+    double _nxWeights[] = { 1.0, 0.7, 1.6, 1.2, 0.5, 1.0, 2.0, 0.9, 1.0 };
+    ASSERT_EQ(_countof(_nxWeights), _RationalNode.vecPoles.size());
+    for (int i = 0; i < _countof(_nxWeights); ++i) {
+        _RationalNode.vecWeights.push_back(_nxWeights[i]);
+    }
+
+    CNurbsParser2D _RationalParser;
+    EXPECT_NO_THROW(_RationalParser.SetNurbsNode(&_RationalNode));
+
+    // The second-order derivative is same as the staged De-Boor algorithm and the third is its difference,
+    // the parameters avoid the knots where the difference is discontinuous
+    const double _nStep = 1.0e-5;
+    DPOINT2 _ptPrePoint, _ptPreDeriv1, _ptPreDeriv2, _ptNextPoint, _ptNextDeriv1, _ptNextDeriv2;
+    for (int i = 0; i < 40; ++i) {
+        double _nKnot = (i + 0.5) / 40.0;
+        EXPECT_NO_THROW(_RationalParser.GetNurbsDeriv(_nKnot, 3, _ptxDerivs));
+        EXPECT_NO_THROW(_RationalParser.GetNurbsDeriv(_nKnot, _ptPoint, _ptDeriv1, _ptDeriv2));
+        CheckDPoint2Equal(_ptxDerivs[0], _ptPoint, Precision::RealTolerance());
+        CheckDPoint2Equal(_ptxDerivs[1], _ptDeriv1, 1.0e-8);
+        CheckDPoint2Equal(_ptxDerivs[2], _ptDeriv2, 1.0e-7);
+
+        EXPECT_NO_THROW(_RationalParser.GetNurbsDeriv(_nKnot - _nStep, _ptPrePoint, _ptPreDeriv1, _ptPreDeriv2));
+        EXPECT_NO_THROW(_RationalParser.GetNurbsDeriv(_nKnot + _nStep, _ptNextPoint, _ptNextDeriv1, _ptNextDeriv2));
+        DPOINT2 _ptAimDeriv3 = (_ptNextDeriv2 - _ptPreDeriv2) / (2.0 * _nStep);
+        EXPECT_NEAR((_ptxDerivs[3] - _ptAimDeriv3).GetLength() / (1.0 + _ptAimDeriv3.GetLength()), 0.0, 1.0e-4);
+    }
+
+    // Order is illegal
+    EXPECT_THROW(_RationalParser.GetNurbsDeriv(0.5, -1, _ptxDerivs), std::exception);
+}
+
+TEST(NeatParserUT, 3DPowerBasisNurbsNode)
+{
+    // The power basis parser is same as the nurbs parser, including the repeated inner knots
+    for (int _nDegree = 1; _nDegree <= 5; ++_nDegree) {
+        for (int _nRational = 0; _nRational < 2; ++_nRational) {
+            NurbsNode3D _NurbsNode;
+            _NurbsNode.nDegree = _nDegree;
+            double _nxInnerKnots[] = { 0.2, 0.45, 0.45, 0.7 };
+            _NurbsNode.vecKnots.assign(_nDegree + 1, 1.0);
+            for (int i = 0; i < _countof(_nxInnerKnots); ++i) {
+                _NurbsNode.vecKnots.push_back(1.0 + 2.0 * _nxInnerKnots[i]);
+            }
+            _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), _nDegree + 1, 3.0);
+
+            int _nPoleCount = static_cast<int>(_NurbsNode.vecKnots.size()) - _nDegree - 1;
+            for (int i = 0; i < _nPoleCount; ++i) {
+                _NurbsNode.vecPoles.push_back(DPOINT3(i * 10.0, 15.0 * sin(i * 1.2), 4.0 * cos(i * 0.8)));
+                _NurbsNode.vecWeights.push_back(_nRational == 1 ? 1.0 + 0.5 * sin(i * 2.3) : 1.0);
+            }
+
+            CNurbsParser3D _NurbsParser;
+            CNurbsPowerParser3D _PowerParser;
+            EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_NurbsNode));
+            EXPECT_NO_THROW(_PowerParser.SetNurbsNode(&_NurbsNode));
+            EXPECT_EQ(_PowerParser.GetSpanCount(), 4);
+            EXPECT_EQ(_PowerParser.GetSpanMemory(), (_nDegree + 1) * (sizeof(DPOINT3) + _nRational * sizeof(double)) + 2 * sizeof(double));
+
+            DPOINT3 _ptPoint[2], _ptDeriv1[2], _ptDeriv2[2], _ptDeriv3[2];
+            DPOINT3 _ptxDerivs[2][5];
+            for (int i = 0; i <= 60; ++i) {
+                double _nKnot = 1.0 + i / 30.0;
+                EXPECT_NO_THROW(_NurbsParser.GetNurbsPoint(_nKnot, _ptPoint[0]));
+                EXPECT_NO_THROW(_PowerParser.GetNurbsPoint(_nKnot, _ptPoint[1]));
+                CheckDPoint3Equal(_ptPoint[0], _ptPoint[1], 1.0e-8);
+
+                EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, _ptPoint[0], _ptDeriv1[0]));
+                EXPECT_NO_THROW(_PowerParser.GetNurbsDeriv(_nKnot, _ptPoint[1], _ptDeriv1[1]));
+                CheckDPoint3Equal(_ptPoint[0], _ptPoint[1], 1.0e-8);
+                CheckDPoint3Equal(_ptDeriv1[0], _ptDeriv1[1], 1.0e-7);
+
+                EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, _ptPoint[0], _ptDeriv1[0], _ptDeriv2[0], _ptDeriv3[0]));
+                EXPECT_NO_THROW(_PowerParser.GetNurbsDeriv(_nKnot, _ptPoint[1], _ptDeriv1[1], _ptDeriv2[1], _ptDeriv3[1]));
+                CheckDPoint3Equal(_ptPoint[0], _ptPoint[1], 1.0e-8);
+                CheckDPoint3Equal(_ptDeriv1[0], _ptDeriv1[1], 1.0e-7);
+                CheckDPoint3Equal(_ptDeriv2[0], _ptDeriv2[1], 1.0e-6);
+                CheckDPoint3Equal(_ptDeriv3[0], _ptDeriv3[1], 1.0e-4);
+
+                EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nKnot, 4, _ptxDerivs[0]));
+                EXPECT_NO_THROW(_PowerParser.GetNurbsDeriv(_nKnot, 4, _ptxDerivs[1]));
+                for (int k = 0; k <= 4; ++k) {
+                    CheckDPoint3Equal(_ptxDerivs[0][k], _ptxDerivs[1][k], 1.0e-8 * pow(10.0, k));
+                }
+            }
+
+            // The batch evaluation is same as the single evaluation
+            double _nxKnots[] = { 2.9, 1.0, 1.45, 3.0, 1.9 };
+            DPOINT3 _ptxPoints[_countof(_nxKnots)], _ptxDeriv1s[_countof(_nxKnots)], _ptxDeriv2s[_countof(_nxKnots)];
+            EXPECT_NO_THROW(_PowerParser.GetNurbsDerivs(_nxKnots, _countof(_nxKnots), _ptxPoints, _ptxDeriv1s, _ptxDeriv2s));
+            for (int i = 0; i < _countof(_nxKnots); ++i) {
+                EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_nxKnots[i], _ptPoint[0], _ptDeriv1[0], _ptDeriv2[0], _ptDeriv3[0]));
+                CheckDPoint3Equal(_ptxPoints[i], _ptPoint[0], 1.0e-8);
+                CheckDPoint3Equal(_ptxDeriv1s[i], _ptDeriv1[0], 1.0e-7);
+                CheckDPoint3Equal(_ptxDeriv2s[i], _ptDeriv2[0], 1.0e-6);
+            }
+        }
+    }
+
+    // Parser without nurbs node and knot out of range
+    CNurbsPowerParser3D _PowerParser;
+    DPOINT3 _ptPoint;
+    EXPECT_THROW(_PowerParser.GetNurbsPoint(0.5, _ptPoint), std::exception);
+
+    NurbsNode3D _LineNode;
+    _LineNode.nDegree = 1;
+    _LineNode.vecKnots.assign(2, 0.0);
+    _LineNode.vecKnots.insert(_LineNode.vecKnots.end(), 2, 1.0);
+    _LineNode.vecPoles.push_back(DPOINT3(0.0, 0.0, 0.0));
+    _LineNode.vecPoles.push_back(DPOINT3(2.0, 4.0, 6.0));
+    CNurbsCurve3D _LineCurve(&_LineNode);
+    EXPECT_NO_THROW(_PowerParser.SetNurbsCurve(&_LineCurve));
+    EXPECT_NO_THROW(_PowerParser.GetNurbsPoint(0.5, _ptPoint));
+    CheckDPoint3Equal(_ptPoint, DPOINT3(1.0, 2.0, 3.0), Precision::RealTolerance());
+    EXPECT_THROW(_PowerParser.GetNurbsPoint(1.5, _ptPoint), std::exception);
+}
+
+TEST(NeatParserUT, 3DForwardDiffNurbsNode)
+{
+    // The sample points of forward differencing are same as the evaluation, including the re-seeded steps
+    const int _nxSteps[] = { 1, 7, 200 };
+    for (int _nDegree = 1; _nDegree <= 5; ++_nDegree) {
+        for (int _nRational = 0; _nRational < 2; ++_nRational) {
+            NurbsNode3D _NurbsNode;
+            _NurbsNode.nDegree = _nDegree;
+            _NurbsNode.vecKnots.assign(_nDegree + 1, 0.0);
+            for (int i = 1; i < 4; ++i) {
+                _NurbsNode.vecKnots.push_back(i);
+            }
+            _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), _nDegree + 1, 4.0);
+
+            int _nPoleCount = static_cast<int>(_NurbsNode.vecKnots.size()) - _nDegree - 1;
+            for (int i = 0; i < _nPoleCount; ++i) {
+                _NurbsNode.vecPoles.push_back(DPOINT3(i * 10.0, 15.0 * sin(i * 1.2), 4.0 * cos(i * 0.8)));
+                _NurbsNode.vecWeights.push_back(_nRational == 1 ? 1.0 + 0.5 * sin(i * 2.3) : 1.0);
+            }
+
+            CNurbsPowerParser3D _PowerParser;
+            EXPECT_NO_THROW(_PowerParser.SetNurbsNode(&_NurbsNode));
+            ASSERT_EQ(_PowerParser.GetSpanCount(), 4);
+
+            for (int i = 0; i < _countof(_nxSteps); ++i) {
+                std::vector<DPOINT3> _vecPoints;
+                EXPECT_NO_THROW(_PowerParser.GetSamplePoints(_nxSteps[i], _vecPoints));
+                ASSERT_EQ(_vecPoints.size(), 4 * _nxSteps[i] + 1);
+
+                DPOINT3 _ptPoint;
+                for (size_t j = 0; j < _vecPoints.size(); ++j) {
+                    EXPECT_NO_THROW(_PowerParser.GetNurbsPoint(static_cast<double>(j) / _nxSteps[i], _ptPoint));
+                    CheckDPoint3Equal(_vecPoints[j], _ptPoint, Precision::RealTolerance());
+                }
+            }
+        }
+    }
+
+    CNurbsPowerParser3D _PowerParser;
+    std::vector<DPOINT3> _vecPoints;
+    EXPECT_THROW(_PowerParser.GetSamplePoints(10, _vecPoints), std::exception);
+
+    NurbsNode3D _LineNode;
+    _LineNode.nDegree = 1;
+    _LineNode.vecKnots.assign(2, 0.0);
+    _LineNode.vecKnots.insert(_LineNode.vecKnots.end(), 2, 1.0);
+    _LineNode.vecPoles.push_back(DPOINT3(0.0, 0.0, 0.0));
+    _LineNode.vecPoles.push_back(DPOINT3(2.0, 4.0, 6.0));
+    EXPECT_NO_THROW(_PowerParser.SetNurbsNode(&_LineNode));
+    EXPECT_THROW(_PowerParser.GetSamplePoints(0, _vecPoints), std::exception);
+    EXPECT_NO_THROW(_PowerParser.GetSamplePoints(4, _vecPoints));
+    ASSERT_EQ(_vecPoints.size(), 5);
+    CheckDPoint3Equal(_vecPoints[1], DPOINT3(0.5, 1.0, 1.5), Precision::RealTolerance());
+    CheckDPoint3Equal(_vecPoints[4], DPOINT3(2.0, 4.0, 6.0), Precision::RealTolerance());
+}
+
+TEST(NeatParserUT, 3DVectorKernelNurbsCurve)
+{
+    // The vectorized kernel, the scalar kernels and the degree over the vectorized kernel
+    const int _nxDegrees[] = { 1, 2, 3, 4, 5, 6, 7, 17 };
+    const bool _bVectorKernel = CheckVectorKernel();
+    for (int d = 0; d < _countof(_nxDegrees); ++d) {
+        NurbsNode3D _NurbsNode;
+        _NurbsNode.nDegree = _nxDegrees[d];
+        double _nxInnerKnots[] = { 0.15, 0.4, 0.4, 0.75 };
+        _NurbsNode.vecKnots.assign(_NurbsNode.nDegree + 1, 0.0);
+        for (int i = 0; i < _countof(_nxInnerKnots); ++i) {
+            _NurbsNode.vecKnots.push_back(_nxInnerKnots[i]);
+        }
+        _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), _NurbsNode.nDegree + 1, 1.0);
+
+        int _nPoleCount = static_cast<int>(_NurbsNode.vecKnots.size()) - _NurbsNode.nDegree - 1;
+        for (int i = 0; i < _nPoleCount; ++i) {
+            _NurbsNode.vecPoles.push_back(DPOINT3(i * 8.0, 12.0 * sin(i * 1.1), 6.0 * cos(i * 0.7)));
+            _NurbsNode.vecWeights.push_back(1.0 + 0.6 * sin(i * 1.9) * sin(i * 1.9));
+        }
+
+        // The results of the nurbs node are the reference
+        CNurbsParser3D _NodeParser;
+        CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+        EXPECT_NO_THROW(_NodeParser.SetNurbsNode(&_NurbsNode));
+        EXPECT_TRUE(_NurbsCurve.IsRational());
+
+        for (int v = 0; v < 2; ++v) {
+            EnableVectorKernel(v == 0);
+            EXPECT_EQ(CheckVectorKernel(), v == 0 && _bVectorKernel);
+
+            CNurbsParser3D _CurveParser;
+            EXPECT_NO_THROW(_CurveParser.SetNurbsCurve(&_NurbsCurve));
+            NurbsContext3D _NurbsContext;
+            DPOINT3 _ptxDerivs[3], _ptPoint, _ptDeriv1, _ptDeriv2;
+            for (int i = 0; i <= 100; ++i) {
+                double _nKnot = i / 100.0;
+                EXPECT_NO_THROW(_NodeParser.GetNurbsDeriv(_nKnot, 2, _ptxDerivs));
+
+                EXPECT_NO_THROW(_NurbsCurve.GetNurbsPoint(_nKnot, _NurbsContext, _ptPoint));
+                CheckDPoint3Equal(_ptPoint, _ptxDerivs[0], 1.0e-8);
+                EXPECT_NO_THROW(_NurbsCurve.GetNurbsDeriv(_nKnot, _NurbsContext, _ptPoint, _ptDeriv1));
+                CheckDPoint3Equal(_ptPoint, _ptxDerivs[0], 1.0e-8);
+                CheckDPoint3Equal(_ptDeriv1, _ptxDerivs[1], 1.0e-6);
+                if (_NurbsNode.nDegree >= 2) {
+                    EXPECT_NO_THROW(_NurbsCurve.GetNurbsDeriv(_nKnot, _NurbsContext, _ptPoint, _ptDeriv1, _ptDeriv2));
+                    CheckDPoint3Equal(_ptPoint, _ptxDerivs[0], 1.0e-8);
+                    CheckDPoint3Equal(_ptDeriv1, _ptxDerivs[1], 1.0e-6);
+                    CheckDPoint3Equal(_ptDeriv2, _ptxDerivs[2], 1.0e-4);
+                }
+                else {
+                    EXPECT_THROW(_NurbsCurve.GetNurbsDeriv(_nKnot, _NurbsContext, _ptPoint, _ptDeriv1, _ptDeriv2), std::exception);
+                }
+
+                EXPECT_NO_THROW(_CurveParser.GetNurbsPoint(_nKnot, _ptPoint));
+                CheckDPoint3Equal(_ptPoint, _ptxDerivs[0], 1.0e-8);
+                EXPECT_NO_THROW(_CurveParser.GetNurbsDeriv(_nKnot, _ptPoint, _ptDeriv1));
+                CheckDPoint3Equal(_ptPoint, _ptxDerivs[0], 1.0e-8);
+                CheckDPoint3Equal(_ptDeriv1, _ptxDerivs[1], 1.0e-6);
+                if (_NurbsNode.nDegree >= 2) {
+                    EXPECT_NO_THROW(_CurveParser.GetNurbsDeriv(_nKnot, _ptPoint, _ptDeriv1, _ptDeriv2));
+                    CheckDPoint3Equal(_ptPoint, _ptxDerivs[0], 1.0e-8);
+                    CheckDPoint3Equal(_ptDeriv1, _ptxDerivs[1], 1.0e-6);
+                    CheckDPoint3Equal(_ptDeriv2, _ptxDerivs[2], 1.0e-4);
+                }
+            }
+        }
+    }
+
+    EnableVectorKernel(true);
+    EXPECT_EQ(CheckVectorKernel(), _bVectorKernel);
+}
+
+TEST(NeatParserUT, 3DLargeNurbsNode)
+{
+    // The quasi-uniform knots and the non uniform knots with repeated knots
+    const int _nSpanCount = 20000;
+    NurbsNode3D _xNurbsNodes[2];
+    for (int n = 0; n < _countof(_xNurbsNodes); ++n) {
+        NurbsNode3D& _NurbsNode = _xNurbsNodes[n];
+        _NurbsNode.nDegree = 3;
+        _NurbsNode.vecKnots.assign(_NurbsNode.nDegree + 1, 0.0);
+        for (int i = 1; i < _nSpanCount; ++i) {
+            if (n == 0) {
+                _NurbsNode.vecKnots.push_back(static_cast<double>(i) / _nSpanCount);
+            }
+            else {
+                _NurbsNode.vecKnots.push_back(i % 500 == 0 ? _NurbsNode.vecKnots.back() : (i + 0.4 * sin(i * 0.37)) / _nSpanCount);
+            }
+        }
+        _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), _NurbsNode.nDegree + 1, 1.0);
+
+        int _nPoleCount = static_cast<int>(_NurbsNode.vecKnots.size()) - _NurbsNode.nDegree - 1;
+        for (int i = 0; i < _nPoleCount; ++i) {
+            _NurbsNode.vecPoles.push_back(DPOINT3(i * 0.1, 20.0 * sin(i * 0.9), 5.0 * cos(i * 1.3)));
+        }
+    }
+
+    // The forward, backward and random parameters, the knots themselves are included
+    const int _nKnotCount = 3000;
+    VECDOUBLE _vecKnots;
+    for (int i = 0; i <= _nKnotCount; ++i) {
+        _vecKnots.push_back(static_cast<double>(i) / _nKnotCount);
+    }
+    for (int i = _nKnotCount; i >= 0; --i) {
+        _vecKnots.push_back(i * 0.7 / _nKnotCount);
+    }
+    for (int i = 0; i <= _nKnotCount; ++i) {
+        _vecKnots.push_back(static_cast<double>((i * 7919) % _nSpanCount) / _nSpanCount);
+    }
+
+    for (int n = 0; n < _countof(_xNurbsNodes); ++n) {
+        // The results of the bezier nodes are the reference
+        std::vector<BezierNode3D> _vecBezierNodes;
+        EXPECT_NO_THROW(ConvertNurbsToBezier(&_xNurbsNodes[n], _vecBezierNodes));
+        VECDOUBLE _vecEndKnots;
+        for (size_t i = 0; i < _vecBezierNodes.size(); ++i) {
+            _vecEndKnots.push_back(_vecBezierNodes[i].nEndKnot);
+        }
+
+        CNurbsCurve3D _NurbsCurve(&_xNurbsNodes[n]);
+        CNurbsParser3D _NodeParser, _CurveParser;
+        EXPECT_NO_THROW(_NodeParser.SetNurbsNode(&_xNurbsNodes[n]));
+        EXPECT_NO_THROW(_CurveParser.SetNurbsCurve(&_NurbsCurve));
+        NurbsContext3D _NurbsContext;
+        CBezierParser3D _BezierParser;
+        DPOINT3 _ptAimPoint, _ptxPoints[3];
+        for (size_t i = 0; i < _vecKnots.size(); ++i) {
+            size_t _nIndex = std::upper_bound(_vecEndKnots.begin(), _vecEndKnots.end(), _vecKnots[i]) - _vecEndKnots.begin();
+            _nIndex = _nIndex < _vecBezierNodes.size() ? _nIndex : _vecBezierNodes.size() - 1;
+            EXPECT_NO_THROW(_BezierParser.SetBezierNode(&_vecBezierNodes[_nIndex]));
+            EXPECT_NO_THROW(_BezierParser.GetBezierPoint(_vecKnots[i], _ptAimPoint));
+
+            EXPECT_NO_THROW(_NodeParser.GetNurbsPoint(_vecKnots[i], _ptxPoints[0]));
+            EXPECT_NO_THROW(_CurveParser.GetNurbsPoint(_vecKnots[i], _ptxPoints[1]));
+            EXPECT_NO_THROW(_NurbsCurve.GetNurbsPoint(_vecKnots[i], _NurbsContext, _ptxPoints[2]));
+            for (int k = 0; k < _countof(_ptxPoints); ++k) {
+                CheckDPoint3Equal(_ptxPoints[k], _ptAimPoint, 1.0e-8);
+            }
+        }
+    }
+}
+
+TEST(NeatParserUT, 3DConcurrentNurbsCurve)
+{
+    // Rational curve of the specialized kernel and non rational curve of the generic De-Boor algorithm
+    NurbsNode3D _xNurbsNodes[2];
+    _xNurbsNodes[0].nDegree = 3;
+    _xNurbsNodes[1].nDegree = 6;
+    double _nxInnerKnots[] = { 0.1, 0.35, 0.35, 0.6, 0.8 };
+    for (int n = 0; n < _countof(_xNurbsNodes); ++n) {
+        NurbsNode3D& _NurbsNode = _xNurbsNodes[n];
+        _NurbsNode.vecKnots.assign(_NurbsNode.nDegree + 1, 0.0);
+        for (int i = 0; i < _countof(_nxInnerKnots); ++i) {
+            _NurbsNode.vecKnots.push_back(_nxInnerKnots[i]);
+        }
+        _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), _NurbsNode.nDegree + 1, 1.0);
+
+        int _nPoleCount = static_cast<int>(_NurbsNode.vecKnots.size()) - _NurbsNode.nDegree - 1;
+        for (int i = 0; i < _nPoleCount; ++i) {
+            _NurbsNode.vecPoles.push_back(DPOINT3(i * 10.0, 20.0 * sin(i * 0.9), 5.0 * cos(i * 1.3)));
+            if (n == 0) {
+                _NurbsNode.vecWeights.push_back(1.0 + 0.4 * sin(i * 2.1));
+            }
+        }
+    }
+
+    CNurbsCurve3D _RationalCurve(&_xNurbsNodes[0]), _GenericCurve(&_xNurbsNodes[1]);
+    const CNurbsCurve3D* _pxNurbsCurves[] = { &_RationalCurve, &_GenericCurve };
+    EXPECT_TRUE(_RationalCurve.IsRational());
+    EXPECT_FALSE(_GenericCurve.IsRational());
+
+    const int _nKnotCount = 200;
+    for (int n = 0; n < _countof(_pxNurbsCurves); ++n) {
+        // The results of the parser are the reference
+        CNurbsParser3D _NurbsParser;
+        EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_xNurbsNodes[n]));
+        VECDPOINT3 _vecAimPoints(_nKnotCount + 1), _vecAimDeriv1s(_nKnotCount + 1), _vecAimDeriv2s(_nKnotCount + 1);
+        for (int i = 0; i <= _nKnotCount; ++i) {
+            EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(static_cast<double>(i) / _nKnotCount, _vecAimPoints[i], _vecAimDeriv1s[i],
+                _vecAimDeriv2s[i]));
+        }
+
+        // Every thread evaluates the same compiled curve with its own context in its own order
+        const CNurbsCurve3D& _NurbsCurve = *_pxNurbsCurves[n];
+        const int _nThreadCount = 4;
+        std::vector<VECDPOINT3> _vecPoints(_nThreadCount, VECDPOINT3(_nKnotCount + 1));
+        std::vector<VECDPOINT3> _vecDeriv1s(_nThreadCount, VECDPOINT3(_nKnotCount + 1));
+        std::vector<VECDPOINT3> _vecDeriv2s(_nThreadCount, VECDPOINT3(_nKnotCount + 1));
+        VECDOUBLE _vecDeviations(_nThreadCount, 0.0);
+        std::vector<std::thread> _vecThreads;
+        for (int t = 0; t < _nThreadCount; ++t) {
+            _vecThreads.push_back(std::thread([&, t]() {
+                NurbsContext3D _NurbsContext;
+                DPOINT3 _ptPoint, _ptDeriv1;
+                for (int j = 0; j <= _nKnotCount; ++j) {
+                    int i = (t % 2 == 0) ? (j * 37 + t) % (_nKnotCount + 1) : _nKnotCount - j;
+                    double _nKnot = static_cast<double>(i) / _nKnotCount;
+                    _NurbsCurve.GetNurbsDeriv(_nKnot, _NurbsContext, _vecPoints[t][i], _vecDeriv1s[t][i], _vecDeriv2s[t][i]);
+                    _NurbsCurve.GetNurbsDeriv(_nKnot, _NurbsContext, _ptPoint, _ptDeriv1);
+                    _vecDeviations[t] += (_ptPoint - _vecPoints[t][i]).GetLength() + (_ptDeriv1 - _vecDeriv1s[t][i]).GetLength();
+                    _NurbsCurve.GetNurbsPoint(_nKnot, _NurbsContext, _ptPoint);
+                    _vecDeviations[t] += (_ptPoint - _vecPoints[t][i]).GetLength();
+                }
+            }));
+        }
+
+        for (size_t t = 0; t < _vecThreads.size(); ++t) {
+            _vecThreads[t].join();
+        }
+
+        for (int t = 0; t < _nThreadCount; ++t) {
+            EXPECT_NEAR(_vecDeviations[t], 0.0, 1.0e-6);
+            for (int i = 0; i <= _nKnotCount; ++i) {
+                CheckDPoint3Equal(_vecPoints[t][i], _vecAimPoints[i], 1.0e-8);
+                CheckDPoint3Equal(_vecDeriv1s[t][i], _vecAimDeriv1s[i], 1.0e-7);
+                CheckDPoint3Equal(_vecDeriv2s[t][i], _vecAimDeriv2s[i], 1.0e-6);
+            }
+        }
+    }
+
+    // A context can be used by different curves, and the knot out of range is illegal
+    NurbsContext3D _NurbsContext;
+    DPOINT3 _ptPoint;
+    EXPECT_NO_THROW(_GenericCurve.GetNurbsPoint(0.9, _NurbsContext, _ptPoint));
+    EXPECT_NO_THROW(_RationalCurve.GetNurbsPoint(0.05, _NurbsContext, _ptPoint));
+    EXPECT_THROW(_RationalCurve.GetNurbsPoint(1.5, _NurbsContext, _ptPoint), std::exception);
+}
+
+TEST(NeatParserUT, 5DAxisNurbsNode)
+{
+    // Rational curve of position and tool orientation, every axis of which is a one-dimensional rational curve of the same weights
+    NurbsNode5D _NurbsNode;
+    _NurbsNode.nDegree = 3;
+    double _nxInnerKnots[] = { 0.1, 0.35, 0.35, 0.6, 0.8 };
+    _NurbsNode.vecKnots.assign(_NurbsNode.nDegree + 1, 0.0);
+    for (int i = 0; i < _countof(_nxInnerKnots); ++i) {
+        _NurbsNode.vecKnots.push_back(_nxInnerKnots[i]);
+    }
+    _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end(), _NurbsNode.nDegree + 1, 1.0);
+
+    int _nPoleCount = static_cast<int>(_NurbsNode.vecKnots.size()) - _NurbsNode.nDegree - 1;
+    for (int i = 0; i < _nPoleCount; ++i) {
+        DPOINT5 _ptPole;
+        _ptPole[0] = i * 10.0;
+        _ptPole[1] = 20.0 * sin(i * 0.9);
+        _ptPole[2] = 5.0 * cos(i * 1.3);
+        _ptPole[3] = 0.5 * sin(i * 0.4);
+        _ptPole[4] = 0.2 * i;
+        _NurbsNode.vecPoles.push_back(_ptPole);
+        _NurbsNode.vecWeights.push_back(1.0 + 0.4 * sin(i * 2.1));
+    }
+
+    NurbsNode1D _xAxisNodes[5];
+    CNurbsParser1D _xAxisParsers[5];
+    for (int j = 0; j < 5; ++j) {
+        _xAxisNodes[j].nDegree = _NurbsNode.nDegree;
+        _xAxisNodes[j].vecKnots = _NurbsNode.vecKnots;
+        _xAxisNodes[j].vecWeights = _NurbsNode.vecWeights;
+        for (int i = 0; i < _nPoleCount; ++i) {
+            _xAxisNodes[j].vecPoles.push_back(_NurbsNode.vecPoles[i][j]);
+        }
+        EXPECT_NO_THROW(_xAxisParsers[j].SetNurbsNode(&_xAxisNodes[j]));
+    }
+
+    CNurbsParser5D _NurbsParser;
+    EXPECT_NO_THROW(_NurbsParser.SetNurbsNode(&_NurbsNode));
+    const int _nKnotCount = 100;
+    VECDOUBLE _vecKnots;
+    for (int i = 0; i <= _nKnotCount; ++i) {
+        _vecKnots.push_back(static_cast<double>(i) / _nKnotCount);
+    }
+
+    std::vector<DPOINT5> _vecPoints(_vecKnots.size()), _vecDeriv1s(_vecKnots.size()), _vecDeriv2s(_vecKnots.size());
+    EXPECT_NO_THROW(_NurbsParser.GetNurbsDerivs(_vecKnots.data(), _vecKnots.size(), _vecPoints.data(), _vecDeriv1s.data(),
+        _vecDeriv2s.data()));
+    DPOINT5 _ptPoint, _ptDeriv1, _ptDeriv2;
+    for (size_t i = 0; i < _vecKnots.size(); ++i) {
+        EXPECT_NO_THROW(_NurbsParser.GetNurbsDeriv(_vecKnots[i], _ptPoint, _ptDeriv1, _ptDeriv2));
+        EXPECT_NEAR((_ptPoint - _vecPoints[i]).GetLength(), 0.0, 1.0e-8);
+        EXPECT_NEAR((_ptDeriv1 - _vecDeriv1s[i]).GetLength(), 0.0, 1.0e-7);
+        EXPECT_NEAR((_ptDeriv2 - _vecDeriv2s[i]).GetLength(), 0.0, 1.0e-6);
+
+        for (int j = 0; j < 5; ++j) {
+            double _nPoint, _nDeriv1, _nDeriv2;
+            _xAxisParsers[j].GetNurbsDeriv(_vecKnots[i], _nPoint, _nDeriv1, _nDeriv2);
+            EXPECT_NEAR(_ptPoint[j], _nPoint, 1.0e-8);
+            EXPECT_NEAR(_ptDeriv1[j], _nDeriv1, 1.0e-7);
+            EXPECT_NEAR(_ptDeriv2[j], _nDeriv2, 1.0e-6);
+        }
+    }
+
+    std::vector<DPOINT5> _vecOnlyPoints(_vecKnots.size());
+    EXPECT_NO_THROW(_NurbsParser.GetNurbsPoints(_vecKnots.data(), _vecKnots.size(), _vecOnlyPoints.data()));
+    for (size_t i = 0; i < _vecKnots.size(); ++i) {
+        EXPECT_NEAR((_vecOnlyPoints[i] - _vecPoints[i]).GetLength(), 0.0, 1.0e-8);
+    }
 }
\ No newline at end of file
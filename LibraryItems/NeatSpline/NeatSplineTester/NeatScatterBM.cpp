@@ -0,0 +1,688 @@
+/***************************************************************************************************
+ Created on: 2020-03-02
+ Created by: dquan2007@163.com
+ Copyright (c) 2020-2020
+
+ This file is part of C++ NeatSpline Library tester application.
+
+ This library is free software; you can redistribute it and/or modify it under the terms of the GNU
+ Lesser General Public License version 3 as published by the Free Software Foundation, with special
+ exception defined in the file LICENSE.
+
+***************************************************************************************************/
+#include "NeatSplineTester.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace neat;
+using namespace tester;
+
+/**
+ * Construct the short blocks of post processor output, every nurbs node has several spans.
+ */
+static void ConstructShortBlocks(int nBlockCount_, std::vector<BezierNode3D>& vecBezierNodes_, std::vector<NurbsNode3D>& vecNurbsNodes_);
+
+/**
+ * Returns the average nanoseconds and heap allocations of scattering a block by global functions or reusable scatter.
+ */
+static double MeasureGlobalScatter(const std::vector<BezierNode3D>& vecBezierNodes_, double nDeflection_, double& nAllocations_);
+static double MeasureGlobalScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_, double& nAllocations_);
+static double MeasureReusableScatter(const std::vector<BezierNode3D>& vecBezierNodes_, double nDeflection_, double& nAllocations_);
+static double MeasureReusableScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_, double& nAllocations_);
+
+/**
+ * Returns the milliseconds of scattering nurbs node by given number of threads.
+ */
+static double MeasureParallelScatter(const NurbsNode3D& NurbsNode_, double nDeflection_, int nThreadCount_);
+
+/**
+ * Returns the milliseconds of scattering the batch of nurbs nodes by given number of threads.
+ */
+static double MeasureBatchScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_, int nThreadCount_);
+
+/**
+ * Returns the milliseconds and heap allocations of scattering nurbs node to the vector of scatter nodes or to the sink.
+ */
+static double MeasureVectorScatter(const NurbsNode3D& NurbsNode_, double nDeflection_, size_t& nAllocations_);
+static double MeasureSinkScatter(const NurbsNode3D& NurbsNode_, double nDeflection_, size_t& nAllocations_);
+
+/**
+ * Append the nanoseconds of every call to get next scatter node of nurbs nodes, and returns the count of scatter nodes.
+ */
+static size_t MeasureIteratorLatency(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_,
+    std::vector<double>& vecLatencies_);
+
+/**
+ * Returns the milliseconds of scattering nurbs nodes by quasi uniform deflection or control polygon flatness.
+ */
+static double MeasureFlatnessScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_, bool bFlatness_,
+    size_t& nPointCount_);
+
+/**
+ * Returns the milliseconds of scattering all nurbs nodes by the point budget.
+ */
+static double MeasureBudgetScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, size_t nPointBudget_, size_t& nPointCount_);
+
+/**
+ * Returns the milliseconds and output bytes of scattering nurbs node by a reused scatter to the vector of scatter nodes
+ * or to the arrays of selected fields.
+ */
+static double MeasureNodesOutput(const NurbsNode3D& NurbsNode_, double nDeflection_, size_t& nOutputBytes_);
+static double MeasureArraysOutput(const NurbsNode3D& NurbsNode_, double nDeflection_, int nFields_, size_t& nOutputBytes_);
+
+/**
+ * Returns the milliseconds and point count of scattering nurbs nodes by every deflection separately, or by all deflections
+ * in one level scatter.
+ */
+static double MeasureSeparateLevels(const std::vector<NurbsNode3D>& vecNurbsNodes_, const VECDOUBLE& vecDeflections_,
+    size_t& nPointCount_);
+static double MeasureLevelScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, const VECDOUBLE& vecDeflections_,
+    size_t& nPointCount_);
+
+/**
+ * Returns the milliseconds and point count of scattering nurbs node by a reused scatter with the token, whose deadline is
+ * nTimeBudget_ milliseconds after the start of scatter, or no deadline if nTimeBudget_ is not positive.
+ */
+static double MeasureTokenScatter(const NurbsNode3D& NurbsNode_, double nDeflection_, double nTimeBudget_, size_t& nPointCount_);
+
+/**
+ * Returns the average milliseconds of updating the scattered nodes after dragging a pole of nurbs node nEditCount_ times,
+ * which scatters the whole nurbs node again or only rescatters the affected knot intervals.
+ */
+static double MeasureEditScatter(NurbsNode3D NurbsNode_, double nDeflection_, int nEditCount_, bool bRescatter_,
+    size_t& nPointCount_);
+
+/**
+ * This file benchmarks the interface for scatting splines.
+ */
+TEST(NeatScatterBM, ReusableNurbsScatter)
+{
+    const int _nBlockCount = 2000;
+    const double _nDeflection = 0.001;
+
+    std::vector<BezierNode3D> _vecBezierNodes;
+    std::vector<NurbsNode3D> _vecNurbsNodes;
+    ConstructShortBlocks(_nBlockCount, _vecBezierNodes, _vecNurbsNodes);
+
+    double _nGlobalAllocations = 0.0, _nReusableAllocations = 0.0;
+    double _nGlobalTime = MeasureGlobalScatter(_vecBezierNodes, _nDeflection, _nGlobalAllocations);
+    double _nReusableTime = MeasureReusableScatter(_vecBezierNodes, _nDeflection, _nReusableAllocations);
+
+    std::cout << "[ BENCHMARK] bezier blocks: " << _nBlockCount << ", global function: " << _nGlobalTime << " ns/block "
+        << FormatAllocations(_nGlobalAllocations, "allocs/block") << ", reusable scatter: " << _nReusableTime << " ns/block "
+        << FormatAllocations(_nReusableAllocations, "allocs/block") << std::endl;
+
+    _nGlobalTime = MeasureGlobalScatter(_vecNurbsNodes, _nDeflection, _nGlobalAllocations);
+    _nReusableTime = MeasureReusableScatter(_vecNurbsNodes, _nDeflection, _nReusableAllocations);
+
+    std::cout << "[ BENCHMARK] nurbs blocks: " << _nBlockCount << ", global function: " << _nGlobalTime << " ns/block "
+        << FormatAllocations(_nGlobalAllocations, "allocs/block") << ", reusable scatter: " << _nReusableTime << " ns/block "
+        << FormatAllocations(_nReusableAllocations, "allocs/block") << std::endl;
+}
+
+TEST(NeatScatterBM, ParallelNurbsScatter)
+{
+    // The imported freeform curve with many spans
+    const int _nPoleCount = 10000;
+    const double _nDeflection = 0.0001;
+
+    NurbsNode3D _NurbsNode;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 2.0, (i % 7) * 3.0, (i % 5) * 2.0); },
+        [](int i) { return 1.0 + 0.25 * (i % 3); }, _NurbsNode);
+
+    const int _nxThreadCounts[] = { 1, 2, 4, 8 };
+    for (int i = 0; i < _countof(_nxThreadCounts); ++i) {
+        double _nTime = MeasureParallelScatter(_NurbsNode, _nDeflection, _nxThreadCounts[i]);
+        std::cout << "[ BENCHMARK] rational cubic of " << _nPoleCount << " poles, threads: " << _nxThreadCounts[i]
+            << ", scatter: " << _nTime << " ms" << std::endl;
+    }
+}
+
+TEST(NeatScatterBM, BatchNurbsScatter)
+{
+    // The program of short blocks and some long blocks
+    const int _nBlockCount = 5000;
+    const double _nDeflection = 0.001;
+
+    std::vector<BezierNode3D> _vecBezierNodes;
+    std::vector<NurbsNode3D> _vecNurbsNodes;
+    ConstructShortBlocks(_nBlockCount, _vecBezierNodes, _vecNurbsNodes);
+    for (int i = 0; i < _nBlockCount; i += 97) {
+        NurbsNode3D& _NurbsNode = _vecNurbsNodes[i];
+        for (int j = 0; j < 200; ++j) {
+            _NurbsNode.vecKnots.insert(_NurbsNode.vecKnots.end() - 4, 1.0 + j);
+            _NurbsNode.vecPoles.push_back(DPOINT3(i + j + 7.0, (i + j) % 7 * 3.0, (i * j) % 5 * 2.0));
+            _NurbsNode.vecWeights.push_back(1.0);
+        }
+
+        for (int j = 0; j < 4; ++j) {
+            _NurbsNode.vecKnots[_NurbsNode.vecKnots.size() - 1 - j] = 201.0;
+        }
+    }
+
+    const int _nxThreadCounts[] = { 1, 2, 4, 8 };
+    for (int i = 0; i < _countof(_nxThreadCounts); ++i) {
+        double _nTime = MeasureBatchScatter(_vecNurbsNodes, _nDeflection, _nxThreadCounts[i]);
+        std::cout << "[ BENCHMARK] nurbs blocks: " << _nBlockCount << ", threads: " << _nxThreadCounts[i]
+            << ", batch scatter: " << _nTime << " ms" << std::endl;
+    }
+}
+
+TEST(NeatScatterBM, SinkNurbsScatter)
+{
+    // The imported freeform curve with many spans, scattered by a new scatter every time
+    const int _nPoleCount = 10000;
+    const double _nDeflection = 0.0001;
+
+    NurbsNode3D _NurbsNode;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 2.0, (i % 7) * 3.0, (i % 5) * 2.0); },
+        [](int i) { return 1.0 + 0.25 * (i % 3); }, _NurbsNode);
+
+    size_t _nVectorAllocations = 0, _nSinkAllocations = 0;
+    double _nVectorTime = MeasureVectorScatter(_NurbsNode, _nDeflection, _nVectorAllocations);
+    double _nSinkTime = MeasureSinkScatter(_NurbsNode, _nDeflection, _nSinkAllocations);
+
+    std::cout << "[ BENCHMARK] rational cubic of " << _nPoleCount << " poles, vector of scatter nodes: " << _nVectorTime << " ms "
+        << FormatAllocations(static_cast<double>(_nVectorAllocations), "allocs") << ", scatter sink: " << _nSinkTime << " ms "
+        << FormatAllocations(static_cast<double>(_nSinkAllocations), "allocs") << std::endl;
+}
+
+TEST(NeatScatterBM, NurbsScatterIterator)
+{
+    // The latency of every call is measured on all test files
+    const double _nDeflection = 0.001;
+    const CTestFileInfoList _listTestFileInfo;
+    std::vector<double> _vecLatencies;
+    for (const auto& _fileInfo : _listTestFileInfo) {
+        std::vector<NurbsNode3D> _vecNurbsNodes;
+        ReadNurbsFromFile(_fileInfo.strFileDir + _fileInfo.strFileName, _vecNurbsNodes);
+
+        std::vector<double> _vecFileLatencies;
+        size_t _nNodeCount = MeasureIteratorLatency(_vecNurbsNodes, _nDeflection, _vecFileLatencies);
+        if (_vecFileLatencies.empty()) {
+            continue;
+        }
+
+        _vecLatencies.insert(_vecLatencies.end(), _vecFileLatencies.begin(), _vecFileLatencies.end());
+        std::sort(_vecFileLatencies.begin(), _vecFileLatencies.end());
+        std::cout << "[ BENCHMARK] " << _fileInfo.strFileName << ", scatter nodes: " << _nNodeCount << ", next latency max: "
+            << _vecFileLatencies.back() << " ns, p99.9: " << _vecFileLatencies[_vecFileLatencies.size() * 999 / 1000] << " ns" << std::endl;
+    }
+
+    ASSERT_FALSE(_vecLatencies.empty());
+    std::sort(_vecLatencies.begin(), _vecLatencies.end());
+    std::cout << "[ BENCHMARK] all test files, calls: " << _vecLatencies.size() << ", next latency max: " << _vecLatencies.back()
+        << " ns, p99.9: " << _vecLatencies[_vecLatencies.size() * 999 / 1000] << " ns, median: "
+        << _vecLatencies[_vecLatencies.size() / 2] << " ns" << std::endl;
+}
+
+TEST(NeatScatterBM, FlatnessNurbsScatter)
+{
+    // The flatness scatter doesn't evaluate curve, but the control polygon overestimates the chord error
+    const double _nDeflection = 0.001;
+    const CTestFileInfoList _listTestFileInfo;
+    for (const auto& _fileInfo : _listTestFileInfo) {
+        std::vector<NurbsNode3D> _vecNurbsNodes;
+        ReadNurbsFromFile(_fileInfo.strFileDir + _fileInfo.strFileName, _vecNurbsNodes);
+
+        size_t _nQuasiPoints = 0, _nFlatnessPoints = 0;
+        double _nQuasiTime = MeasureFlatnessScatter(_vecNurbsNodes, _nDeflection, false, _nQuasiPoints);
+        double _nFlatnessTime = MeasureFlatnessScatter(_vecNurbsNodes, _nDeflection, true, _nFlatnessPoints);
+        std::cout << "[ BENCHMARK] " << _fileInfo.strFileName << ", quasi uniform: " << _nQuasiTime << " ms " << _nQuasiPoints
+            << " points, flatness: " << _nFlatnessTime << " ms " << _nFlatnessPoints << " points" << std::endl;
+    }
+
+    std::vector<BezierNode3D> _vecBezierNodes;
+    std::vector<NurbsNode3D> _vecNurbsNodes;
+    ConstructShortBlocks(2000, _vecBezierNodes, _vecNurbsNodes);
+
+    size_t _nQuasiPoints = 0, _nFlatnessPoints = 0;
+    double _nQuasiTime = MeasureFlatnessScatter(_vecNurbsNodes, _nDeflection, false, _nQuasiPoints);
+    double _nFlatnessTime = MeasureFlatnessScatter(_vecNurbsNodes, _nDeflection, true, _nFlatnessPoints);
+    std::cout << "[ BENCHMARK] nurbs blocks: " << _vecNurbsNodes.size() << ", quasi uniform: " << _nQuasiTime << " ms "
+        << _nQuasiPoints << " points, flatness: " << _nFlatnessTime << " ms " << _nFlatnessPoints << " points" << std::endl;
+}
+
+TEST(NeatScatterBM, BudgetNurbsScatter)
+{
+    // The budget is the point count of deflection, the budget scatter sorts the segments of all nurbs nodes by chord error
+    const double _nDeflection = 0.001;
+    const CTestFileInfoList _listTestFileInfo;
+    for (const auto& _fileInfo : _listTestFileInfo) {
+        std::vector<NurbsNode3D> _vecNurbsNodes;
+        ReadNurbsFromFile(_fileInfo.strFileDir + _fileInfo.strFileName, _vecNurbsNodes);
+
+        size_t _nDeflectionPoints = 0, _nBudgetPoints = 0;
+        double _nDeflectionTime = MeasureFlatnessScatter(_vecNurbsNodes, _nDeflection, false, _nDeflectionPoints);
+        double _nBudgetTime = MeasureBudgetScatter(_vecNurbsNodes, _nDeflectionPoints, _nBudgetPoints);
+        std::cout << "[ BENCHMARK] " << _fileInfo.strFileName << ", deflection: " << _nDeflectionTime << " ms " << _nDeflectionPoints
+            << " points, budget: " << _nBudgetTime << " ms " << _nBudgetPoints << " points" << std::endl;
+    }
+
+    std::vector<BezierNode3D> _vecBezierNodes;
+    std::vector<NurbsNode3D> _vecNurbsNodes;
+    ConstructShortBlocks(2000, _vecBezierNodes, _vecNurbsNodes);
+    for (size_t _nPointBudget : { 20000, 100000, 500000 }) {
+        size_t _nBudgetPoints = 0;
+        double _nBudgetTime = MeasureBudgetScatter(_vecNurbsNodes, _nPointBudget, _nBudgetPoints);
+        std::cout << "[ BENCHMARK] nurbs blocks: " << _vecNurbsNodes.size() << ", budget " << _nPointBudget << ": " << _nBudgetTime
+            << " ms " << _nBudgetPoints << " points" << std::endl;
+    }
+}
+
+TEST(NeatScatterBM, ScatterArraysNurbsScatter)
+{
+    // The imported freeform curve with many spans, whose points and knots are only needed by the machine
+    const int _nPoleCount = 10000;
+    const double _nDeflection = 0.0001;
+
+    NurbsNode3D _NurbsNode;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 2.0, (i % 7) * 3.0, (i % 5) * 2.0); },
+        [](int i) { return 1.0 + 0.25 * (i % 3); }, _NurbsNode);
+
+    size_t _nNodesBytes = 0, _nArraysBytes = 0;
+    double _nNodesTime = MeasureNodesOutput(_NurbsNode, _nDeflection, _nNodesBytes);
+    double _nArraysTime = MeasureArraysOutput(_NurbsNode, _nDeflection, scatter_field::point | scatter_field::knot, _nArraysBytes);
+
+    std::cout << "[ BENCHMARK] rational cubic of " << _nPoleCount << " poles, vector of scatter nodes: " << _nNodesTime << " ms "
+        << _nNodesBytes << " bytes, arrays of points and knots: " << _nArraysTime << " ms " << _nArraysBytes << " bytes" << std::endl;
+}
+
+TEST(NeatScatterBM, LevelNurbsScatter)
+{
+    // The viewer shows the same curves at three deflections
+    const VECDOUBLE _vecDeflections = { 0.1, 0.01, 0.001 };
+    const CTestFileInfoList _listTestFileInfo;
+    for (const auto& _fileInfo : _listTestFileInfo) {
+        std::vector<NurbsNode3D> _vecNurbsNodes;
+        ReadNurbsFromFile(_fileInfo.strFileDir + _fileInfo.strFileName, _vecNurbsNodes);
+
+        size_t _nSeparatePoints = 0, _nLevelPoints = 0;
+        double _nSeparateTime = MeasureSeparateLevels(_vecNurbsNodes, _vecDeflections, _nSeparatePoints);
+        double _nLevelTime = MeasureLevelScatter(_vecNurbsNodes, _vecDeflections, _nLevelPoints);
+        std::cout << "[ BENCHMARK] " << _fileInfo.strFileName << ", separate levels: " << _nSeparateTime << " ms " << _nSeparatePoints
+            << " points, level scatter: " << _nLevelTime << " ms " << _nLevelPoints << " points" << std::endl;
+    }
+}
+
+TEST(NeatScatterBM, InterruptedNurbsScatter)
+{
+    // The imported freeform curve which is replaced by the operator while scattering
+    const int _nPoleCount = 10000;
+    const double _nDeflection = 0.0001;
+
+    NurbsNode3D _NurbsNode;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 2.0, (i % 7) * 3.0, (i % 5) * 2.0); },
+        [](int i) { return 1.0 + 0.25 * (i % 3); }, _NurbsNode);
+
+    size_t _nFullPoints = 0;
+    double _nFullTime = MeasureTokenScatter(_NurbsNode, _nDeflection, 0.0, _nFullPoints);
+    std::cout << "[ BENCHMARK] rational cubic of " << _nPoleCount << " poles, no deadline: " << _nFullTime << " ms "
+        << _nFullPoints << " points" << std::endl;
+    for (double _nRatio : { 0.1, 0.5 }) {
+        size_t _nPointCount = 0;
+        double _nTime = MeasureTokenScatter(_NurbsNode, _nDeflection, _nFullTime * _nRatio, _nPointCount);
+        std::cout << "[ BENCHMARK] deadline " << _nFullTime * _nRatio << " ms: " << _nTime << " ms " << _nPointCount
+            << " points" << std::endl;
+    }
+}
+
+TEST(NeatScatterBM, RescatterNurbsScatter)
+{
+    // The long curve whose poles are dragged by the operator one by one
+    const int _nPoleCount = 10000;
+    const double _nDeflection = 0.0001;
+    const int _nEditCount = 20;
+
+    NurbsNode3D _NurbsNode;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 2.0, (i % 7) * 3.0, (i % 5) * 2.0); },
+        [](int i) { return 1.0 + 0.25 * (i % 3); }, _NurbsNode);
+
+    size_t _nFullPoints = 0, _nRescatterPoints = 0;
+    double _nFullTime = MeasureEditScatter(_NurbsNode, _nDeflection, _nEditCount, false, _nFullPoints);
+    double _nRescatterTime = MeasureEditScatter(_NurbsNode, _nDeflection, _nEditCount, true, _nRescatterPoints);
+    std::cout << "[ BENCHMARK] rational cubic of " << _nPoleCount << " poles, every edit: full scatter " << _nFullTime
+        << " ms " << _nFullPoints << " points, rescatter " << _nRescatterTime << " ms " << _nRescatterPoints << " points"
+        << std::endl;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void ConstructShortBlocks(int nBlockCount_, std::vector<BezierNode3D>& vecBezierNodes_, std::vector<NurbsNode3D>& vecNurbsNodes_)
+{
+    vecBezierNodes_.resize(nBlockCount_);
+    vecNurbsNodes_.resize(nBlockCount_);
+    for (int i = 0; i < nBlockCount_; ++i) {
+        BezierNode3D& _BezierNode = vecBezierNodes_[i];
+        _BezierNode.nStartKnot = 0.0;
+        _BezierNode.nEndKnot = 1.0;
+        for (int j = 0; j <= 3; ++j) {
+            _BezierNode.vecPoles.push_back(DPOINT3(i + j, (i + j) % 7 * 3.0, (i * j) % 5 * 2.0));
+            _BezierNode.vecWeights.push_back(1.0 + 0.5 * ((i + j) % 2));
+        }
+
+        NurbsNode3D& _NurbsNode = vecNurbsNodes_[i];
+        _NurbsNode.nDegree = 3;
+        double _nxKnots[] = { 0.0, 0.0, 0.0, 0.0, 0.25, 0.5, 0.75, 1.0, 1.0, 1.0, 1.0 };
+        _NurbsNode.vecKnots.assign(_nxKnots, _nxKnots + _countof(_nxKnots));
+        for (int j = 0; j < 7; ++j) {
+            _NurbsNode.vecPoles.push_back(DPOINT3(i + j, (i + j) % 7 * 3.0, (i * j) % 5 * 2.0));
+            _NurbsNode.vecWeights.push_back(1.0);
+        }
+    }
+}
+
+static double MeasureGlobalScatter(const std::vector<BezierNode3D>& vecBezierNodes_, double nDeflection_, double& nAllocations_)
+{
+    VECDPOINT3 _vecScatterPoints;
+    size_t _nPointCount = 0;
+    size_t _nAllocationCount = GetAllocationCount();
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vecBezierNodes_.size(); ++i) {
+        ScatterBezier(&vecBezierNodes_[i], nDeflection_, _vecScatterPoints);
+        _nPointCount += _vecScatterPoints.size();
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_GT(_nPointCount, vecBezierNodes_.size());
+
+    nAllocations_ = static_cast<double>(GetAllocationCount() - _nAllocationCount) / vecBezierNodes_.size();
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / vecBezierNodes_.size();
+}
+
+static double MeasureGlobalScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_, double& nAllocations_)
+{
+    VECDPOINT3 _vecScatterPoints;
+    size_t _nPointCount = 0;
+    size_t _nAllocationCount = GetAllocationCount();
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vecNurbsNodes_.size(); ++i) {
+        ScatterNurbs(&vecNurbsNodes_[i], nDeflection_, _vecScatterPoints);
+        _nPointCount += _vecScatterPoints.size();
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_GT(_nPointCount, vecNurbsNodes_.size());
+
+    nAllocations_ = static_cast<double>(GetAllocationCount() - _nAllocationCount) / vecNurbsNodes_.size();
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / vecNurbsNodes_.size();
+}
+
+static double MeasureReusableScatter(const std::vector<BezierNode3D>& vecBezierNodes_, double nDeflection_, double& nAllocations_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints;
+    size_t _nPointCount = 0;
+    size_t _nAllocationCount = GetAllocationCount();
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vecBezierNodes_.size(); ++i) {
+        _NurbsScatter.ScatterBezier(&vecBezierNodes_[i], nDeflection_, _vecScatterPoints);
+        _nPointCount += _vecScatterPoints.size();
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_GT(_nPointCount, vecBezierNodes_.size());
+
+    nAllocations_ = static_cast<double>(GetAllocationCount() - _nAllocationCount) / vecBezierNodes_.size();
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / vecBezierNodes_.size();
+}
+
+static double MeasureReusableScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_, double& nAllocations_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints;
+    size_t _nPointCount = 0;
+    size_t _nAllocationCount = GetAllocationCount();
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vecNurbsNodes_.size(); ++i) {
+        _NurbsScatter.ScatterNurbs(&vecNurbsNodes_[i], nDeflection_, _vecScatterPoints);
+        _nPointCount += _vecScatterPoints.size();
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_GT(_nPointCount, vecNurbsNodes_.size());
+
+    nAllocations_ = static_cast<double>(GetAllocationCount() - _nAllocationCount) / vecNurbsNodes_.size();
+    return std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count() / vecNurbsNodes_.size();
+}
+
+static double MeasureParallelScatter(const NurbsNode3D& NurbsNode_, double nDeflection_, int nThreadCount_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    _NurbsScatter.SetThreadCount(nThreadCount_);
+
+    VECDPOINT3 _vecScatterPoints;
+    auto _tmStart = std::chrono::steady_clock::now();
+    _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, _vecScatterPoints);
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_GT(_vecScatterPoints.size(), NurbsNode_.vecPoles.size());
+
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static double MeasureBatchScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_, int nThreadCount_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    _NurbsScatter.SetThreadCount(nThreadCount_);
+
+    VECDPOINT3 _vecScatterPoints;
+    std::vector<size_t> _vecOffsets;
+    auto _tmStart = std::chrono::steady_clock::now();
+    _NurbsScatter.ScatterNurbs(vecNurbsNodes_.data(), vecNurbsNodes_.size(), nDeflection_, _vecScatterPoints, _vecOffsets);
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_EQ(_vecOffsets.size(), vecNurbsNodes_.size() + 1);
+
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static double MeasureVectorScatter(const NurbsNode3D& NurbsNode_, double nDeflection_, size_t& nAllocations_)
+{
+    size_t _nAllocationCount = GetAllocationCount();
+    auto _tmStart = std::chrono::steady_clock::now();
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecScatterNodes;
+    _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, _vecScatterNodes);
+
+    DPOINT3 _ptSum;
+    for (const auto& _ScatterNode : _vecScatterNodes) {
+        _ptSum += _ScatterNode.ptPoint;
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_GT(_vecScatterNodes.size(), NurbsNode_.vecPoles.size());
+    EXPECT_GT(_ptSum[axis::x], 0.0);
+
+    nAllocations_ = GetAllocationCount() - _nAllocationCount;
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static double MeasureSinkScatter(const NurbsNode3D& NurbsNode_, double nDeflection_, size_t& nAllocations_)
+{
+    size_t _nAllocationCount = GetAllocationCount();
+    auto _tmStart = std::chrono::steady_clock::now();
+    CNurbsScatter3D _NurbsScatter;
+    size_t _nNodeCount = 0;
+    DPOINT3 _ptSum;
+    _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, [&_nNodeCount, &_ptSum](const ScatterNode3D& ScatterNode_) {
+        _ptSum += ScatterNode_.ptPoint;
+        ++_nNodeCount;
+    });
+    auto _tmEnd = std::chrono::steady_clock::now();
+    EXPECT_GT(_nNodeCount, NurbsNode_.vecPoles.size());
+    EXPECT_GT(_ptSum[axis::x], 0.0);
+
+    nAllocations_ = GetAllocationCount() - _nAllocationCount;
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static size_t MeasureIteratorLatency(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_,
+    std::vector<double>& vecLatencies_)
+{
+    CNurbsScatterIterator3D _ScatterIterator;
+    ScatterNode3D _ScatterNode;
+    size_t _nNodeCount = 0;
+    for (const auto& _NurbsNode : vecNurbsNodes_) {
+        // the scatter nodes need second-order derivative
+        if (_NurbsNode.nDegree < 2) {
+            continue;
+        }
+
+        _ScatterIterator.Start(&_NurbsNode, nDeflection_);
+        while (true) {
+            auto _tmStart = std::chrono::steady_clock::now();
+            bool _bNext = _ScatterIterator.Next(_ScatterNode);
+            auto _tmEnd = std::chrono::steady_clock::now();
+            if (!_bNext) {
+                break;
+            }
+
+            vecLatencies_.push_back(std::chrono::duration<double, std::nano>(_tmEnd - _tmStart).count());
+            ++_nNodeCount;
+        }
+    }
+
+    return _nNodeCount;
+}
+
+static double MeasureFlatnessScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, double nDeflection_, bool bFlatness_,
+    size_t& nPointCount_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    _NurbsScatter.EnableFlatnessScatter(bFlatness_);
+
+    VECDPOINT3 _vecScatterPoints;
+    nPointCount_ = 0;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vecNurbsNodes_.size(); ++i) {
+        _NurbsScatter.ScatterNurbs(&vecNurbsNodes_[i], nDeflection_, _vecScatterPoints);
+        nPointCount_ += _vecScatterPoints.size();
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static double MeasureBudgetScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, size_t nPointBudget_, size_t& nPointCount_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints;
+    std::vector<size_t> _vecOffsets;
+    auto _tmStart = std::chrono::steady_clock::now();
+    _NurbsScatter.ScatterNurbs(vecNurbsNodes_.data(), vecNurbsNodes_.size(), nPointBudget_, 1e-9, _vecScatterPoints, _vecOffsets);
+    auto _tmEnd = std::chrono::steady_clock::now();
+
+    nPointCount_ = _vecScatterPoints.size();
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static double MeasureNodesOutput(const NurbsNode3D& NurbsNode_, double nDeflection_, size_t& nOutputBytes_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecScatterNodes;
+    _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, _vecScatterNodes);
+
+    const int _nRepeatCount = 5;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < _nRepeatCount; ++i) {
+        _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, _vecScatterNodes);
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+
+    nOutputBytes_ = _vecScatterNodes.size() * sizeof(ScatterNode3D);
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count() / _nRepeatCount;
+}
+
+static double MeasureArraysOutput(const NurbsNode3D& NurbsNode_, double nDeflection_, int nFields_, size_t& nOutputBytes_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    ScatterArrays3D _ScatterArrays;
+    _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, nFields_, _ScatterArrays);
+
+    const int _nRepeatCount = 5;
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < _nRepeatCount; ++i) {
+        _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, nFields_, _ScatterArrays);
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+
+    nOutputBytes_ = (_ScatterArrays.vecPoints.size() + _ScatterArrays.vecDeriv1s.size() + _ScatterArrays.vecDeriv2s.size())
+        * sizeof(DPOINT3) + (_ScatterArrays.vecKnots.size() + _ScatterArrays.vecCurvatures.size()
+        + _ScatterArrays.vecArcLengths.size()) * sizeof(double);
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count() / _nRepeatCount;
+}
+
+static double MeasureSeparateLevels(const std::vector<NurbsNode3D>& vecNurbsNodes_, const VECDOUBLE& vecDeflections_,
+    size_t& nPointCount_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints;
+    nPointCount_ = 0;
+
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (const auto& _NurbsNode : vecNurbsNodes_) {
+        for (double _nDeflection : vecDeflections_) {
+            _NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterPoints);
+            nPointCount_ += _vecScatterPoints.size();
+        }
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static double MeasureLevelScatter(const std::vector<NurbsNode3D>& vecNurbsNodes_, const VECDOUBLE& vecDeflections_,
+    size_t& nPointCount_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints;
+    std::vector<int> _vecLevels;
+    nPointCount_ = 0;
+
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (const auto& _NurbsNode : vecNurbsNodes_) {
+        _NurbsScatter.ScatterNurbs(&_NurbsNode, vecDeflections_, _vecScatterPoints, _vecLevels);
+        nPointCount_ += _vecScatterPoints.size();
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static double MeasureTokenScatter(const NurbsNode3D& NurbsNode_, double nDeflection_, double nTimeBudget_, size_t& nPointCount_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    ScatterToken _ScatterToken;
+    VECDPOINT3 _vecScatterPoints;
+    _NurbsScatter.SetScatterToken(&_ScatterToken);
+    _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, _vecScatterPoints);
+
+    auto _tmStart = std::chrono::steady_clock::now();
+    if (nTimeBudget_ > 0.0) {
+        _ScatterToken.tmDeadline = _tmStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(nTimeBudget_));
+    }
+    _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, _vecScatterPoints);
+    auto _tmEnd = std::chrono::steady_clock::now();
+
+    nPointCount_ = _vecScatterPoints.size();
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count();
+}
+
+static double MeasureEditScatter(NurbsNode3D NurbsNode_, double nDeflection_, int nEditCount_, bool bRescatter_,
+    size_t& nPointCount_)
+{
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecScatterNodes;
+    _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, _vecScatterNodes);
+
+    auto _tmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nEditCount_; ++i) {
+        int _nPoleIndex = static_cast<int>(NurbsNode_.vecPoles.size() * (i + 1) / (nEditCount_ + 1));
+        NurbsNode_.vecPoles[_nPoleIndex] += DPOINT3(0.0, 0.5, 0.5);
+        if (bRescatter_) {
+            _NurbsScatter.RescatterNurbs(&NurbsNode_, nDeflection_, { _nPoleIndex }, _vecScatterNodes);
+        }
+        else {
+            _NurbsScatter.ScatterNurbs(&NurbsNode_, nDeflection_, _vecScatterNodes);
+        }
+    }
+    auto _tmEnd = std::chrono::steady_clock::now();
+
+    nPointCount_ = _vecScatterNodes.size();
+    return std::chrono::duration<double, std::milli>(_tmEnd - _tmStart).count() / nEditCount_;
+}
\ No newline at end of file
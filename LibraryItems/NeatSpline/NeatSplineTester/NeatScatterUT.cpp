@@ -11,10 +11,30 @@
 
 ***************************************************************************************************/
 #include "NeatSplineTester.h"
+#include <algorithm>
 
 using namespace neat;
 using namespace tester;
 
+/**
+ * Returns the max distance between the points of nurbs node and the chords of scatter nodes.
+ * Every chord is compared with the points whose knots are between the knots of chord.
+ */
+static double MeasureChordError(const NurbsNode3D* pNurbsNode_, const std::vector<ScatterNode3D>& vecScatterNodes_);
+
+/**
+ * Returns the max length of chords and the max angle between consecutive chords of scatter nodes.
+ */
+static void MeasureSegments(const std::vector<ScatterNode3D>& vecScatterNodes_, double& nMaxLength_, double& nMaxAngle_);
+
+/**
+ * Project the five-dimensional nurbs node or scatter nodes on no more than three axes, the other coordinates are zero.
+ * The projected nurbs node has the same weights and knots, so it's exactly the projection of curve.
+ */
+static void ProjectNurbsNode(const NurbsNode5D& NurbsNode_, const std::vector<int>& vecAxes_, NurbsNode3D& ProjectedNode_);
+static void ProjectScatterNodes(const std::vector<ScatterNode5D>& vecScatterNodes_, const std::vector<int>& vecAxes_,
+    std::vector<ScatterNode3D>& vecProjectedNodes_);
+
 /**
  * This file unit tests the interface for scatting splines.
  */
@@ -340,4 +360,1318 @@ TEST(NeatScatterUT, 3DEllipseNurbsNode)
         EXPECT_GE(_nCurvature, _nMinCurvature);
         EXPECT_LE(_nCurvature, _nMaxCurvature);
     }
+}
+
+TEST(NeatScatterUT, 3DCompiledNurbsCurve)
+{
+    // Three-dimensional non rational curve with several spans
+    NurbsNode3D _NurbsNode;
+    _NurbsNode.nDegree = 3;
+    double _nxKnots[] = { 0.0, 0.0, 0.0, 0.0, 0.2, 0.45, 0.45, 0.7, 1.0, 1.0, 1.0, 1.0 };
+    for (int i = 0; i < _countof(_nxKnots); ++i) {
+        _NurbsNode.vecKnots.push_back(_nxKnots[i]);
+    }
+
+    _NurbsNode.vecPoles.push_back(DPOINT3(0.0, 0.0, 0.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(10.0, 25.0, 3.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(30.0, 20.0, -4.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(45.0, -5.0, 8.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(60.0, 10.0, 2.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(75.0, 35.0, -6.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(90.0, 15.0, 5.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(100.0, 0.0, 0.0));
+    for (size_t i = 0; i < _NurbsNode.vecPoles.size(); ++i) {
+        _NurbsNode.vecWeights.push_back(1.0);
+    }
+
+    CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+    EXPECT_FALSE(_NurbsCurve.IsRational());
+
+    // Scatter compiled curve and nurbs node
+    const double _nDeflection = 0.001;
+    VECDPOINT3 _vecNodePoints, _vecCurvePoints;
+    EXPECT_NO_THROW(ScatterNurbs(&_NurbsNode, _nDeflection, _vecNodePoints));
+    EXPECT_NO_THROW(ScatterNurbs(&_NurbsCurve, _nDeflection, _vecCurvePoints));
+    EXPECT_EQ(_vecNodePoints.size(), _vecCurvePoints.size());
+    for (size_t i = 0; i < _vecNodePoints.size() && i < _vecCurvePoints.size(); ++i) {
+        CheckDPoint3Equal(_vecNodePoints[i], _vecCurvePoints[i], Precision::RealTolerance());
+    }
+
+    std::vector<ScatterNode3D> _vecNodeNodes, _vecCurveNodes;
+    EXPECT_NO_THROW(ScatterNurbs(&_NurbsNode, _nDeflection, _vecNodeNodes));
+    EXPECT_NO_THROW(ScatterNurbs(&_NurbsCurve, _nDeflection, _vecCurveNodes));
+    EXPECT_EQ(_vecNodeNodes.size(), _vecCurveNodes.size());
+    for (size_t i = 0; i < _vecNodeNodes.size() && i < _vecCurveNodes.size(); ++i) {
+        CheckDPoint3Equal(_vecNodeNodes[i].ptPoint, _vecCurveNodes[i].ptPoint, Precision::RealTolerance());
+        CheckDPoint3Equal(_vecNodeNodes[i].ptDeriv1, _vecCurveNodes[i].ptDeriv1, Precision::RealTolerance());
+        EXPECT_NEAR(_vecNodeNodes[i].nKnot, _vecCurveNodes[i].nKnot, Precision::RealTolerance());
+    }
+}
+
+TEST(NeatScatterUT, 3DReusableNurbsScatter)
+{
+    // Non rational curve with several spans
+    NurbsNode3D _NurbsNode;
+    _NurbsNode.nDegree = 3;
+    double _nxKnots[] = { 0.0, 0.0, 0.0, 0.0, 0.2, 0.45, 0.45, 0.7, 1.0, 1.0, 1.0, 1.0 };
+    for (int i = 0; i < _countof(_nxKnots); ++i) {
+        _NurbsNode.vecKnots.push_back(_nxKnots[i]);
+    }
+
+    _NurbsNode.vecPoles.push_back(DPOINT3(0.0, 0.0, 0.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(10.0, 25.0, 3.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(30.0, 20.0, -4.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(45.0, -5.0, 8.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(60.0, 10.0, 2.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(75.0, 35.0, -6.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(90.0, 15.0, 5.0));
+    _NurbsNode.vecPoles.push_back(DPOINT3(100.0, 0.0, 0.0));
+    for (size_t i = 0; i < _NurbsNode.vecPoles.size(); ++i) {
+        _NurbsNode.vecWeights.push_back(1.0);
+    }
+
+    CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+    // Rational quarter circle and non rational quartic bezier node
+    BezierNode3D _ArcBezierNode;
+    _ArcBezierNode.nStartKnot = 0.0;
+    _ArcBezierNode.nEndKnot = 1.0;
+    _ArcBezierNode.vecPoles.push_back(DPOINT3(20.0, 0.0, 5.0));
+    _ArcBezierNode.vecPoles.push_back(DPOINT3(20.0, 20.0, 5.0));
+    _ArcBezierNode.vecPoles.push_back(DPOINT3(0.0, 20.0, 5.0));
+    _ArcBezierNode.vecWeights.push_back(1.0);
+    _ArcBezierNode.vecWeights.push_back(sqrt(2.0) / 2.0);
+    _ArcBezierNode.vecWeights.push_back(1.0);
+
+    BezierNode3D _QuarticBezierNode;
+    _QuarticBezierNode.nStartKnot = 2.0;
+    _QuarticBezierNode.nEndKnot = 3.5;
+    _QuarticBezierNode.vecPoles.push_back(DPOINT3(0.0, 0.0, 0.0));
+    _QuarticBezierNode.vecPoles.push_back(DPOINT3(5.0, 12.0, 1.0));
+    _QuarticBezierNode.vecPoles.push_back(DPOINT3(15.0, -8.0, 2.0));
+    _QuarticBezierNode.vecPoles.push_back(DPOINT3(25.0, 9.0, -1.0));
+    _QuarticBezierNode.vecPoles.push_back(DPOINT3(30.0, 0.0, 0.0));
+
+    // The reused scatter must output the same result as the global functions in every round
+    const double _nDeflection = 0.001;
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints, _vecExpectPoints;
+    std::vector<ScatterNode3D> _vecScatterNodes, _vecExpectNodes;
+    for (int _nRound = 0; _nRound < 3; ++_nRound) {
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterPoints));
+        ScatterNurbs(&_NurbsNode, _nDeflection, _vecExpectPoints);
+        EXPECT_EQ(_vecScatterPoints.size(), _vecExpectPoints.size());
+        for (size_t i = 0; i < _vecScatterPoints.size() && i < _vecExpectPoints.size(); ++i) {
+            CheckDPoint3Equal(_vecScatterPoints[i], _vecExpectPoints[i], Precision::RealTolerance());
+        }
+
+        EXPECT_NO_THROW(_NurbsScatter.ScatterBezier(&_ArcBezierNode, _nDeflection, _vecScatterPoints));
+        ScatterBezier(&_ArcBezierNode, _nDeflection, _vecExpectPoints);
+        EXPECT_EQ(_vecScatterPoints.size(), _vecExpectPoints.size());
+        for (size_t i = 0; i < _vecScatterPoints.size() && i < _vecExpectPoints.size(); ++i) {
+            CheckDPoint3Equal(_vecScatterPoints[i], _vecExpectPoints[i], Precision::RealTolerance());
+        }
+
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsCurve, _nDeflection, _vecScatterNodes));
+        ScatterNurbs(&_NurbsCurve, _nDeflection, _vecExpectNodes);
+        EXPECT_EQ(_vecScatterNodes.size(), _vecExpectNodes.size());
+        for (size_t i = 0; i < _vecScatterNodes.size() && i < _vecExpectNodes.size(); ++i) {
+            CheckDPoint3Equal(_vecScatterNodes[i].ptPoint, _vecExpectNodes[i].ptPoint, Precision::RealTolerance());
+            CheckDPoint3Equal(_vecScatterNodes[i].ptDeriv1, _vecExpectNodes[i].ptDeriv1, Precision::RealTolerance());
+            CheckDPoint3Equal(_vecScatterNodes[i].ptDeriv2, _vecExpectNodes[i].ptDeriv2, Precision::RealTolerance());
+            EXPECT_NEAR(_vecScatterNodes[i].nKnot, _vecExpectNodes[i].nKnot, Precision::RealTolerance());
+        }
+
+        EXPECT_NO_THROW(_NurbsScatter.ScatterBezier(&_QuarticBezierNode, _nDeflection, _vecScatterNodes));
+        ScatterBezier(&_QuarticBezierNode, _nDeflection, _vecExpectNodes);
+        EXPECT_EQ(_vecScatterNodes.size(), _vecExpectNodes.size());
+        for (size_t i = 0; i < _vecScatterNodes.size() && i < _vecExpectNodes.size(); ++i) {
+            CheckDPoint3Equal(_vecScatterNodes[i].ptPoint, _vecExpectNodes[i].ptPoint, Precision::RealTolerance());
+            CheckDPoint3Equal(_vecScatterNodes[i].ptDeriv1, _vecExpectNodes[i].ptDeriv1, Precision::RealTolerance());
+            EXPECT_NEAR(_vecScatterNodes[i].nKnot, _vecExpectNodes[i].nKnot, Precision::RealTolerance());
+        }
+    }
+
+    // Two-dimensional scatter
+    std::vector<NurbsNode3D> _vecNurbsNodes(1, _NurbsNode);
+    std::vector<NurbsNode2D> _vecNurbsNodes2D;
+    for (auto& _ptPole : _vecNurbsNodes.front().vecPoles) {
+        _ptPole[axis::z] = 0.0;
+    }
+
+    EXPECT_TRUE(DowngradeNurbsNode(_vecNurbsNodes, _vecNurbsNodes2D));
+    CNurbsScatter2D _NurbsScatter2D;
+    VECDPOINT2 _vecScatterPoints2D, _vecExpectPoints2D;
+    for (int _nRound = 0; _nRound < 3; ++_nRound) {
+        EXPECT_NO_THROW(_NurbsScatter2D.ScatterNurbs(&_vecNurbsNodes2D.front(), _nDeflection, _vecScatterPoints2D));
+        ScatterNurbs(&_vecNurbsNodes2D.front(), _nDeflection, _vecExpectPoints2D);
+        EXPECT_EQ(_vecScatterPoints2D.size(), _vecExpectPoints2D.size());
+        for (size_t i = 0; i < _vecScatterPoints2D.size() && i < _vecExpectPoints2D.size(); ++i) {
+            CheckDPoint2Equal(_vecScatterPoints2D[i], _vecExpectPoints2D[i], Precision::RealTolerance());
+        }
+    }
+}
+
+TEST(NeatScatterUT, 3DParallelNurbsScatter)
+{
+    // Rational curve with many spans and a repeated inner knot
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 1500;
+    BuildCubicNurbsNode(_nPoleCount, 700, [](int i) { return DPOINT3(i * 2.0, (i % 7) * 3.0 + sin(i * 0.1), (i % 5) * 2.0); },
+        [](int i) { return 1.0 + 0.25 * (i % 3); }, _NurbsNode);
+
+    CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+    // The result of several threads must be the same as one thread
+    const double _nDeflection = 0.001;
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecExpectPoints, _vecScatterPoints;
+    std::vector<ScatterNode3D> _vecExpectNodes, _vecScatterNodes;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecExpectPoints));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsCurve, _nDeflection, _vecExpectNodes));
+    EXPECT_THROW(_NurbsScatter.SetThreadCount(0), std::exception);
+
+    int _nxThreadCounts[] = { 2, 3, 8 };
+    for (int i = 0; i < _countof(_nxThreadCounts); ++i) {
+        _NurbsScatter.SetThreadCount(_nxThreadCounts[i]);
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterPoints));
+        EXPECT_EQ(_vecScatterPoints.size(), _vecExpectPoints.size());
+        for (size_t j = 0; j < _vecScatterPoints.size() && j < _vecExpectPoints.size(); ++j) {
+            CheckDPoint3Equal(_vecScatterPoints[j], _vecExpectPoints[j], 0.0);
+        }
+
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsCurve, _nDeflection, _vecScatterNodes));
+        EXPECT_EQ(_vecScatterNodes.size(), _vecExpectNodes.size());
+        for (size_t j = 0; j < _vecScatterNodes.size() && j < _vecExpectNodes.size(); ++j) {
+            CheckDPoint3Equal(_vecScatterNodes[j].ptPoint, _vecExpectNodes[j].ptPoint, 0.0);
+            CheckDPoint3Equal(_vecScatterNodes[j].ptDeriv1, _vecExpectNodes[j].ptDeriv1, 0.0);
+            CheckDPoint3Equal(_vecScatterNodes[j].ptDeriv2, _vecExpectNodes[j].ptDeriv2, 0.0);
+            EXPECT_EQ(_vecScatterNodes[j].nKnot, _vecExpectNodes[j].nKnot);
+        }
+    }
+}
+
+TEST(NeatScatterUT, 3DBatchNurbsScatter)
+{
+    // The nurbs nodes of wildly different sizes
+    std::vector<NurbsNode3D> _vecNurbsNodes(60);
+    for (int i = 0; i < static_cast<int>(_vecNurbsNodes.size()); ++i) {
+        const int _nPoleCount = (i % 7 == 0) ? 300 : 4 + i % 5;
+        BuildCubicNurbsNode(_nPoleCount, 0, [i](int j) { return DPOINT3(i + j * 2.0, ((i + j) % 7) * 3.0, ((i * j) % 5) * 2.0); },
+            [i](int j) { return 1.0 + 0.25 * ((i + j) % 3); }, _vecNurbsNodes[i]);
+    }
+
+    // The batch result must be the same as scattering nurbs nodes one by one
+    const double _nDeflection = 0.001;
+    std::vector<VECDPOINT3> _vecExpectPoints(_vecNurbsNodes.size());
+    std::vector<std::vector<ScatterNode3D>> _vecExpectNodes(_vecNurbsNodes.size());
+    for (size_t i = 0; i < _vecNurbsNodes.size(); ++i) {
+        ScatterNurbs(&_vecNurbsNodes[i], _nDeflection, _vecExpectPoints[i]);
+        ScatterNurbs(&_vecNurbsNodes[i], _nDeflection, _vecExpectNodes[i]);
+    }
+
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints;
+    std::vector<ScatterNode3D> _vecScatterNodes;
+    std::vector<size_t> _vecOffsets;
+    int _nxThreadCounts[] = { 1, 3, 8 };
+    for (int _nThread = 0; _nThread < _countof(_nxThreadCounts); ++_nThread) {
+        _NurbsScatter.SetThreadCount(_nxThreadCounts[_nThread]);
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), _nDeflection, _vecScatterPoints, _vecOffsets));
+        EXPECT_EQ(_vecOffsets.size(), _vecNurbsNodes.size() + 1);
+        EXPECT_EQ(_vecOffsets.back(), _vecScatterPoints.size());
+        for (size_t i = 0; i + 1 < _vecOffsets.size() && i < _vecExpectPoints.size(); ++i) {
+            EXPECT_EQ(_vecOffsets[i + 1] - _vecOffsets[i], _vecExpectPoints[i].size());
+            for (size_t j = 0; j < _vecExpectPoints[i].size() && _vecOffsets[i] + j < _vecScatterPoints.size(); ++j) {
+                CheckDPoint3Equal(_vecScatterPoints[_vecOffsets[i] + j], _vecExpectPoints[i][j], 0.0);
+            }
+        }
+
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), _nDeflection, _vecScatterNodes, _vecOffsets));
+        EXPECT_EQ(_vecOffsets.back(), _vecScatterNodes.size());
+        for (size_t i = 0; i + 1 < _vecOffsets.size() && i < _vecExpectNodes.size(); ++i) {
+            EXPECT_EQ(_vecOffsets[i + 1] - _vecOffsets[i], _vecExpectNodes[i].size());
+            for (size_t j = 0; j < _vecExpectNodes[i].size() && _vecOffsets[i] + j < _vecScatterNodes.size(); ++j) {
+                CheckDPoint3Equal(_vecScatterNodes[_vecOffsets[i] + j].ptPoint, _vecExpectNodes[i][j].ptPoint, 0.0);
+                CheckDPoint3Equal(_vecScatterNodes[_vecOffsets[i] + j].ptDeriv2, _vecExpectNodes[i][j].ptDeriv2, 0.0);
+                EXPECT_EQ(_vecScatterNodes[_vecOffsets[i] + j].nKnot, _vecExpectNodes[i][j].nKnot);
+            }
+        }
+    }
+
+    // Empty batch and the error of any nurbs node
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), 0, _nDeflection, _vecScatterPoints, _vecOffsets));
+    EXPECT_TRUE(_vecScatterPoints.empty());
+    EXPECT_EQ(_vecOffsets.size(), 1);
+
+    _vecNurbsNodes[31].nDegree = 1;
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), _nDeflection, _vecScatterNodes, _vecOffsets),
+        std::exception);
+}
+
+TEST(NeatScatterUT, 3DSinkNurbsScatter)
+{
+    // Non rational curve with many spans, several poles are collinear
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 200;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) {
+        double _nHeight = (i / 20) % 2 == 0 ? 0.0 : (i % 5) * 4.0 + cos(i * 0.3);
+        return DPOINT3(i * 2.0, _nHeight, 0.5 * _nHeight);
+    }, nullptr, _NurbsNode);
+
+    CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+    BezierNode3D _BezierNode;
+    _BezierNode.nStartKnot = 0.0;
+    _BezierNode.nEndKnot = 1.0;
+    _BezierNode.vecPoles.push_back(DPOINT3(20.0, 0.0, 5.0));
+    _BezierNode.vecPoles.push_back(DPOINT3(20.0, 20.0, 5.0));
+    _BezierNode.vecPoles.push_back(DPOINT3(0.0, 20.0, 5.0));
+    _BezierNode.vecWeights.push_back(1.0);
+    _BezierNode.vecWeights.push_back(sqrt(2.0) / 2.0);
+    _BezierNode.vecWeights.push_back(1.0);
+
+    // The scatter nodes sent to sink must be the same as the scatter nodes in vector
+    const double _nDeflection = 0.001;
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecExpectNodes, _vecScatterNodes;
+    ScatterSink3D _ScatterSink = [&_vecScatterNodes](const ScatterNode3D& ScatterNode_) { _vecScatterNodes.push_back(ScatterNode_); };
+    for (int i = 0; i < 3; ++i) {
+        _vecScatterNodes.clear();
+        if (i == 0) {
+            EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecExpectNodes));
+            EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _ScatterSink));
+        }
+        else if (i == 1) {
+            EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsCurve, _nDeflection, _vecExpectNodes));
+            EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsCurve, _nDeflection, _ScatterSink));
+        }
+        else {
+            EXPECT_NO_THROW(_NurbsScatter.ScatterBezier(&_BezierNode, _nDeflection, _vecExpectNodes));
+            EXPECT_NO_THROW(_NurbsScatter.ScatterBezier(&_BezierNode, _nDeflection, _ScatterSink));
+        }
+
+        EXPECT_GT(_vecExpectNodes.size(), 2u);
+        EXPECT_EQ(_vecScatterNodes.size(), _vecExpectNodes.size());
+        for (size_t j = 0; j < _vecScatterNodes.size() && j < _vecExpectNodes.size(); ++j) {
+            CheckDPoint3Equal(_vecScatterNodes[j].ptPoint, _vecExpectNodes[j].ptPoint, 0.0);
+            CheckDPoint3Equal(_vecScatterNodes[j].ptDeriv1, _vecExpectNodes[j].ptDeriv1, 0.0);
+            CheckDPoint3Equal(_vecScatterNodes[j].ptDeriv2, _vecExpectNodes[j].ptDeriv2, 0.0);
+            EXPECT_EQ(_vecScatterNodes[j].nKnot, _vecExpectNodes[j].nKnot);
+        }
+    }
+
+    // empty sink
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, ScatterSink3D()), std::exception);
+}
+
+TEST(NeatScatterUT, 3DNurbsScatterIterator)
+{
+    // Rational curve with many spans and a repeated inner knot
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 100;
+    BuildCubicNurbsNode(_nPoleCount, 40, [](int i) { return DPOINT3(i * 2.0, (i % 7) * 3.0 + sin(i * 0.1), (i % 5) * 2.0); },
+        [](int i) { return 1.0 + 0.25 * (i % 3); }, _NurbsNode);
+
+    CNurbsCurve3D _NurbsCurve(&_NurbsNode);
+
+    BezierNode3D _BezierNode;
+    _BezierNode.nStartKnot = 0.0;
+    _BezierNode.nEndKnot = 1.0;
+    _BezierNode.vecPoles.push_back(DPOINT3(0.0, 0.0, 0.0));
+    _BezierNode.vecPoles.push_back(DPOINT3(10.0, 0.0, 0.0));
+    _BezierNode.vecPoles.push_back(DPOINT3(20.0, 0.0, 0.0));
+    _BezierNode.vecPoles.push_back(DPOINT3(30.0, 20.0, 5.0));
+    for (int i = 0; i < 4; ++i) {
+        _BezierNode.vecWeights.push_back(1.0);
+    }
+
+    // nothing is got before start
+    CNurbsScatterIterator3D _ScatterIterator;
+    ScatterNode3D _ScatterNode;
+    EXPECT_FALSE(_ScatterIterator.Next(_ScatterNode));
+
+    // The scatter nodes got one by one must be the same as the scatter nodes in vector
+    const double _nDeflection = 0.001;
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecExpectNodes, _vecScatterNodes;
+    for (int i = 0; i < 3; ++i) {
+        if (i == 0) {
+            EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecExpectNodes));
+            EXPECT_NO_THROW(_ScatterIterator.Start(&_NurbsNode, _nDeflection));
+        }
+        else if (i == 1) {
+            EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsCurve, _nDeflection, _vecExpectNodes));
+            EXPECT_NO_THROW(_ScatterIterator.Start(&_NurbsCurve, _nDeflection));
+        }
+        else {
+            EXPECT_NO_THROW(_NurbsScatter.ScatterBezier(&_BezierNode, _nDeflection, _vecExpectNodes));
+            EXPECT_NO_THROW(_ScatterIterator.Start(&_BezierNode, _nDeflection));
+        }
+
+        _vecScatterNodes.clear();
+        while (_ScatterIterator.Next(_ScatterNode)) {
+            _vecScatterNodes.push_back(_ScatterNode);
+        }
+
+        EXPECT_FALSE(_ScatterIterator.Next(_ScatterNode));
+        EXPECT_GT(_vecExpectNodes.size(), 2u);
+        EXPECT_EQ(_vecScatterNodes.size(), _vecExpectNodes.size());
+        for (size_t j = 0; j < _vecScatterNodes.size() && j < _vecExpectNodes.size(); ++j) {
+            CheckDPoint3Equal(_vecScatterNodes[j].ptPoint, _vecExpectNodes[j].ptPoint, 0.0);
+            CheckDPoint3Equal(_vecScatterNodes[j].ptDeriv1, _vecExpectNodes[j].ptDeriv1, 0.0);
+            CheckDPoint3Equal(_vecScatterNodes[j].ptDeriv2, _vecExpectNodes[j].ptDeriv2, 0.0);
+            EXPECT_EQ(_vecScatterNodes[j].nKnot, _vecExpectNodes[j].nKnot);
+        }
+    }
+
+    // restart before all scatter nodes are got
+    EXPECT_NO_THROW(_ScatterIterator.Start(&_NurbsNode, _nDeflection));
+    EXPECT_TRUE(_ScatterIterator.Next(_ScatterNode));
+    EXPECT_NO_THROW(_ScatterIterator.Start(&_BezierNode, _nDeflection));
+    EXPECT_TRUE(_ScatterIterator.Next(_ScatterNode));
+    CheckDPoint3Equal(_ScatterNode.ptPoint, _vecExpectNodes.front().ptPoint, 0.0);
+}
+
+TEST(NeatScatterUT, 3DStraightNurbsScatterIterator)
+{
+    // Long straight curve with unit knot intervals and uneven poles, every knot interval is evaluated by the scatter
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 1000;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i + 0.3 * (i % 2), 2.0 * (i + 0.3 * (i % 2)), 0.0); },
+        nullptr, _NurbsNode);
+
+    // Every Next() evaluates no more than 65 knot intervals, instead of evaluating the whole straight run before the end node
+    const double _nDeflection = 0.001;
+    CNurbsScatterIterator3D _ScatterIterator;
+    ScatterNode3D _ScatterNode;
+    std::vector<ScatterNode3D> _vecScatterNodes, _vecExpectNodes;
+    EXPECT_NO_THROW(_ScatterIterator.Start(&_NurbsNode, _nDeflection));
+    while (_ScatterIterator.Next(_ScatterNode)) {
+        if (!_vecScatterNodes.empty()) {
+            EXPECT_LE(_ScatterNode.nKnot - _vecScatterNodes.back().nKnot, 65.0);
+        }
+        _vecScatterNodes.push_back(_ScatterNode);
+    }
+
+    ASSERT_GT(_vecScatterNodes.size(), 2u);
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.back().nKnot, _nPoleCount - 3.0);
+
+    EXPECT_LT(MeasureChordError(&_NurbsNode, _vecScatterNodes), _nDeflection);
+
+    // The scatter nodes in vector combine the whole straight run as before
+    CNurbsScatter3D _NurbsScatter;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecExpectNodes));
+    ASSERT_EQ(_vecExpectNodes.size(), 2u);
+    CheckDPoint3Equal(_vecScatterNodes.front().ptPoint, _vecExpectNodes.front().ptPoint, 0.0);
+    CheckDPoint3Equal(_vecScatterNodes.back().ptPoint, _vecExpectNodes.back().ptPoint, 0.0);
+}
+
+TEST(NeatScatterUT, 3DSteadyStateAllocation)
+{
+    // Rational curve with several spans and a repeated inner knot
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 60;
+    BuildCubicNurbsNode(_nPoleCount, 30, [](int i) { return DPOINT3(i * 2.0, (i % 7) * 3.0 + sin(i * 0.1), (i % 5) * 2.0); },
+        [](int i) { return 1.0 + 0.25 * (i % 3); }, _NurbsNode);
+
+    BezierNode3D _BezierNode;
+    _BezierNode.nStartKnot = 0.0;
+    _BezierNode.nEndKnot = 1.0;
+    for (int i = 0; i <= 4; ++i) {
+        _BezierNode.vecPoles.push_back(DPOINT3(i * 10.0, (i % 2) * 20.0, i * 2.0));
+        _BezierNode.vecWeights.push_back(1.0 + 0.5 * (i % 2));
+    }
+
+    // The first round grows the buffers, and the next rounds of the same curves mustn't allocate memory.
+    // The allocations are counted by the tester, except the release configurations of MSVC.
+    const double _nDeflection = 0.0001;
+    CNurbsScatter3D _NurbsScatter;
+    CNurbsScatterIterator3D _ScatterIterator;
+    VECDPOINT3 _vecScatterPoints;
+    std::vector<ScatterNode3D> _vecScatterNodes;
+    ScatterNode3D _ScatterNode;
+    size_t _nNodeCount = 0;
+    ScatterSink3D _ScatterSink = [&_nNodeCount](const ScatterNode3D&) { ++_nNodeCount; };
+    for (int i = 0; i < 3; ++i) {
+        size_t _nAllocationCount = GetAllocationCount();
+        _NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterPoints);
+        _NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes);
+        _NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _ScatterSink);
+        _NurbsScatter.ScatterBezier(&_BezierNode, _nDeflection, _vecScatterPoints);
+        _NurbsScatter.ScatterBezier(&_BezierNode, _nDeflection, _vecScatterNodes);
+
+        _ScatterIterator.Start(&_NurbsNode, _nDeflection);
+        while (_ScatterIterator.Next(_ScatterNode)) {
+            ++_nNodeCount;
+        }
+
+        if (i > 0) {
+            EXPECT_EQ(GetAllocationCount(), _nAllocationCount);
+        }
+    }
+
+    EXPECT_GT(_nNodeCount, _vecScatterNodes.size());
+}
+
+TEST(NeatScatterUT, 3DSimplifyNurbsScatter)
+{
+    // Gentle non rational curve with many spans
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 60;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 5.0, 20.0 * sin(i * 0.15), 0.1 * i); },
+        nullptr, _NurbsNode);
+
+    const double _nDeflection = 0.01;
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecCombinedNodes, _vecSimplifiedNodes, _vecSinkNodes;
+    EXPECT_THROW(_NurbsScatter.SetSimplifyRatio(-0.1), std::exception);
+    EXPECT_THROW(_NurbsScatter.SetSimplifyRatio(1.0), std::exception);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecCombinedNodes));
+
+    // The simplified nodes are fewer, and the chord error is still within deflection
+    _NurbsScatter.SetSimplifyRatio(0.9);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecSimplifiedNodes));
+    EXPECT_LT(_vecSimplifiedNodes.size() * 10, _vecCombinedNodes.size() * 9);
+    EXPECT_LT(MeasureChordError(&_NurbsNode, _vecSimplifiedNodes), _nDeflection);
+    CheckDPoint3Equal(_vecSimplifiedNodes.front().ptPoint, _vecCombinedNodes.front().ptPoint, 0.0);
+    CheckDPoint3Equal(_vecSimplifiedNodes.back().ptPoint, _vecCombinedNodes.back().ptPoint, 0.0);
+
+    // The sink is simplified in the same way
+    ScatterSink3D _ScatterSink = [&_vecSinkNodes](const ScatterNode3D& ScatterNode_) { _vecSinkNodes.push_back(ScatterNode_); };
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _ScatterSink));
+    EXPECT_EQ(_vecSinkNodes.size(), _vecSimplifiedNodes.size());
+    for (size_t i = 0; i < _vecSinkNodes.size() && i < _vecSimplifiedNodes.size(); ++i) {
+        CheckDPoint3Equal(_vecSinkNodes[i].ptPoint, _vecSimplifiedNodes[i].ptPoint, 0.0);
+        EXPECT_EQ(_vecSinkNodes[i].nKnot, _vecSimplifiedNodes[i].nKnot);
+    }
+}
+
+TEST(NeatScatterUT, 3DFlatnessNurbsScatter)
+{
+    // Rational curve with a repeated inner knot
+    NurbsNode3D _NurbsNode;
+    _NurbsNode.nDegree = 3;
+    _NurbsNode.vecKnots = { 0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 2.0, 2.0, 3.0, 4.0, 5.0, 5.0, 5.0, 5.0 };
+    for (int i = 0; i < 10; ++i) {
+        _NurbsNode.vecPoles.push_back(DPOINT3(i * 3.0, 10.0 * sin(i * 0.9), (i % 3) * 1.0));
+        _NurbsNode.vecWeights.push_back(1.0 + 0.5 * (i % 2));
+    }
+
+    CNurbsParser3D _NurbsParser;
+    _NurbsParser.SetNurbsNode(&_NurbsNode);
+
+    CNurbsScatter3D _NurbsScatter;
+    _NurbsScatter.EnableFlatnessScatter(true);
+    ScatterSink3D _ScatterSink;
+    std::vector<ScatterNode3D> _vecScatterNodes, _vecSinkNodes;
+    _ScatterSink = [&_vecSinkNodes](const ScatterNode3D& ScatterNode_) { _vecSinkNodes.push_back(ScatterNode_); };
+    for (double _nDeflection : { 0.1, 0.01, 0.001 }) {
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+        ASSERT_GT(_vecScatterNodes.size(), 1);
+        EXPECT_DOUBLE_EQ(_vecScatterNodes.front().nKnot, 0.0);
+        EXPECT_DOUBLE_EQ(_vecScatterNodes.back().nKnot, 5.0);
+
+        // The chord error is certainly within deflection
+        EXPECT_LT(MeasureChordError(&_NurbsNode, _vecScatterNodes), _nDeflection);
+
+        // The points and derivatives are got from control points, which must be the same as the parser
+        DPOINT3 _ptPoint, _ptDeriv1, _ptDeriv2;
+        for (const auto& _ScatterNode : _vecScatterNodes) {
+            _NurbsParser.GetNurbsDeriv(_ScatterNode.nKnot, _ptPoint, _ptDeriv1, _ptDeriv2);
+            CheckDPoint3Equal(_ScatterNode.ptPoint, _ptPoint, 1e-9);
+            CheckDPoint3Equal(_ScatterNode.ptDeriv1, _ptDeriv1, 1e-6);
+            CheckDPoint3Equal(_ScatterNode.ptDeriv2, _ptDeriv2, 1e-6);
+        }
+
+        // The scatter nodes sent to sink are the same
+        _vecSinkNodes.clear();
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _ScatterSink));
+        EXPECT_EQ(_vecSinkNodes.size(), _vecScatterNodes.size());
+        for (size_t i = 0; i < _vecSinkNodes.size() && i < _vecScatterNodes.size(); ++i) {
+            CheckDPoint3Equal(_vecSinkNodes[i].ptPoint, _vecScatterNodes[i].ptPoint, 0.0);
+            EXPECT_EQ(_vecSinkNodes[i].nKnot, _vecScatterNodes[i].nKnot);
+        }
+    }
+
+    // The uniform pieces of polynomial curve are output by forward differencing if only the points are got
+    NurbsNode3D _PolynomialNode = _NurbsNode;
+    _PolynomialNode.vecWeights.assign(_PolynomialNode.vecWeights.size(), 1.0);
+    VECDPOINT3 _vecPolynomialPoints;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_PolynomialNode, 0.001, _vecScatterNodes));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_PolynomialNode, 0.001, _vecPolynomialPoints));
+    ASSERT_EQ(_vecPolynomialPoints.size(), _vecScatterNodes.size());
+    for (size_t i = 0; i < _vecPolynomialPoints.size(); ++i) {
+        CheckDPoint3Equal(_vecPolynomialPoints[i], _vecScatterNodes[i].ptPoint, 1e-9);
+    }
+
+    // The bezier node of quarter arc is scattered in the same way
+    BezierNode3D _BezierNode;
+    _BezierNode.nStartKnot = 0.0;
+    _BezierNode.nEndKnot = 1.0;
+    _BezierNode.vecPoles = { DPOINT3(20.0, 0.0, 5.0), DPOINT3(20.0, 20.0, 5.0), DPOINT3(0.0, 20.0, 5.0) };
+    _BezierNode.vecWeights = { 1.0, sqrt(2.0) / 2.0, 1.0 };
+
+    const double _nDeflection = 0.001;
+    VECDPOINT3 _vecScatterPoints;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterBezier(&_BezierNode, _nDeflection, _vecScatterPoints));
+    ASSERT_GT(_vecScatterPoints.size(), 2);
+    for (size_t i = 0; i < _vecScatterPoints.size(); ++i) {
+        DPOINT3 _ptVector = _vecScatterPoints[i] - DPOINT3(0.0, 0.0, 5.0);
+        EXPECT_NEAR(_ptVector.GetLength(), 20.0, 1e-9);
+        if (i > 0) {
+            DPOINT3 _ptMiddle = (_vecScatterPoints[i - 1] + _vecScatterPoints[i]) * 0.5 - DPOINT3(0.0, 0.0, 5.0);
+            EXPECT_LT(20.0 - _ptMiddle.GetLength(), _nDeflection);
+        }
+    }
+}
+
+TEST(NeatScatterUT, 3DBudgetNurbsScatter)
+{
+    // The nurbs nodes of different sizes and curvatures
+    std::vector<NurbsNode3D> _vecNurbsNodes(12);
+    for (int i = 0; i < static_cast<int>(_vecNurbsNodes.size()); ++i) {
+        const int _nPoleCount = 4 + i % 5 * 3;
+        BuildCubicNurbsNode(_nPoleCount, 0,
+            [i](int j) { return DPOINT3(j * 4.0, (1.0 + i % 4) * 5.0 * sin(j * 0.8), ((i + j) % 3) * 1.0); },
+            [i](int j) { return 1.0 + 0.25 * ((i + j) % 3); }, _vecNurbsNodes[i]);
+    }
+
+    // The larger point budget gets the smaller chord error, and the count of points is within budget.
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints;
+    std::vector<ScatterNode3D> _vecScatterNodes;
+    std::vector<size_t> _vecOffsets;
+    double _nPreChordError = 0.0;
+    for (size_t _nPointBudget : { 300, 600, 1200, 2400 }) {
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), _nPointBudget, 1e-9,
+            _vecScatterNodes, _vecOffsets));
+        ASSERT_EQ(_vecOffsets.size(), _vecNurbsNodes.size() + 1);
+        EXPECT_EQ(_vecOffsets.back(), _vecScatterNodes.size());
+        EXPECT_LE(_vecScatterNodes.size(), _nPointBudget);
+        EXPECT_GT(_vecScatterNodes.size() * 10, _nPointBudget * 9);
+
+        double _nChordError = 0.0;
+        for (size_t i = 0; i + 1 < _vecOffsets.size(); ++i) {
+            std::vector<ScatterNode3D> _vecNodeScatterNodes(_vecScatterNodes.begin() + _vecOffsets[i],
+                _vecScatterNodes.begin() + _vecOffsets[i + 1]);
+            ASSERT_GT(_vecNodeScatterNodes.size(), 1);
+            EXPECT_DOUBLE_EQ(_vecNodeScatterNodes.front().nKnot, _vecNurbsNodes[i].vecKnots.front());
+            EXPECT_DOUBLE_EQ(_vecNodeScatterNodes.back().nKnot, _vecNurbsNodes[i].vecKnots.back());
+            _nChordError = max(_nChordError, MeasureChordError(&_vecNurbsNodes[i], _vecNodeScatterNodes));
+        }
+
+        if (_nPreChordError > 0.0) {
+            EXPECT_LT(_nChordError, _nPreChordError);
+        }
+        _nPreChordError = _nChordError;
+
+        // The scatter points are the same as the scatter nodes except the rounding error
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), _nPointBudget, 1e-9,
+            _vecScatterPoints, _vecOffsets));
+        EXPECT_EQ(_vecScatterPoints.size(), _vecScatterNodes.size());
+        for (size_t i = 0; i < _vecScatterPoints.size() && i < _vecScatterNodes.size(); ++i) {
+            CheckDPoint3Equal(_vecScatterPoints[i], _vecScatterNodes[i].ptPoint, 1e-9);
+        }
+    }
+
+    // The large budget stops at the deflection
+    const double _nDeflection = 0.01;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), 1000000, _nDeflection,
+        _vecScatterNodes, _vecOffsets));
+    EXPECT_LT(_vecScatterNodes.size(), 1000000);
+    for (size_t i = 0; i + 1 < _vecOffsets.size(); ++i) {
+        std::vector<ScatterNode3D> _vecNodeScatterNodes(_vecScatterNodes.begin() + _vecOffsets[i],
+            _vecScatterNodes.begin() + _vecOffsets[i + 1]);
+        EXPECT_LT(MeasureChordError(&_vecNurbsNodes[i], _vecNodeScatterNodes), _nDeflection);
+    }
+
+    // The zero budget only scatters the knot intervals, and the errors are thrown
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), 0, _nDeflection, _vecScatterPoints,
+        _vecOffsets));
+    for (size_t i = 0; i + 1 < _vecOffsets.size(); ++i) {
+        EXPECT_GT(_vecOffsets[i + 1] - _vecOffsets[i], 1);
+    }
+
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), 0, 100, _nDeflection, _vecScatterPoints, _vecOffsets));
+    EXPECT_TRUE(_vecScatterPoints.empty());
+    EXPECT_EQ(_vecOffsets.size(), 1);
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), 100, 0.0, _vecScatterPoints, _vecOffsets),
+        std::exception);
+    _NurbsScatter.EnableFlatnessScatter(true);
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(_vecNurbsNodes.data(), _vecNurbsNodes.size(), 100, _nDeflection, _vecScatterPoints,
+        _vecOffsets), std::exception);
+}
+
+TEST(NeatScatterUT, 3DConstrainedNurbsScatter)
+{
+    // Smooth non rational curve with straight and curved spans
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 30;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 5.0, (i < 10 ? 0.0 : 15.0 * sin(i * 0.7)), 0.2 * i); },
+        nullptr, _NurbsNode);
+
+    const double _nDeflection = 0.01;
+    const double _nMaxSegmentLength = 2.0;
+    const double _nMaxTurningAngle = 2.0 * Precision::PIE() / 180.0;
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecFreeNodes, _vecScatterNodes, _vecParallelNodes;
+    EXPECT_THROW(_NurbsScatter.SetSegmentConstraints(-1.0, 0.0), std::exception);
+    EXPECT_THROW(_NurbsScatter.SetSegmentConstraints(0.0, -1.0), std::exception);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecFreeNodes));
+
+    // The straight part is divided by the length and the curved part by the angle, every chord is still within deflection
+    double _nMaxLength = 0.0, _nMaxAngle = 0.0;
+    MeasureSegments(_vecFreeNodes, _nMaxLength, _nMaxAngle);
+    EXPECT_GT(_nMaxLength, _nMaxSegmentLength);
+    EXPECT_GT(_nMaxAngle, _nMaxTurningAngle);
+
+    _NurbsScatter.SetSegmentConstraints(_nMaxSegmentLength, _nMaxTurningAngle);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    MeasureSegments(_vecScatterNodes, _nMaxLength, _nMaxAngle);
+    EXPECT_LE(_nMaxLength, _nMaxSegmentLength * (1.0 + 1e-9));
+    EXPECT_LE(_nMaxAngle, _nMaxTurningAngle * 1.1);
+    EXPECT_LT(MeasureChordError(&_NurbsNode, _vecScatterNodes), _nDeflection);
+    EXPECT_GT(_vecScatterNodes.size(), _vecFreeNodes.size());
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.back().nKnot, _nPoleCount - 3.0);
+
+    // The result of several threads is the same
+    _NurbsScatter.SetThreadCount(4);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecParallelNodes));
+    EXPECT_EQ(_vecParallelNodes.size(), _vecScatterNodes.size());
+    for (size_t i = 0; i < _vecParallelNodes.size() && i < _vecScatterNodes.size(); ++i) {
+        CheckDPoint3Equal(_vecParallelNodes[i].ptPoint, _vecScatterNodes[i].ptPoint, 0.0);
+    }
+
+    // The simplified nodes and the flatness scatter keep the max length
+    _NurbsScatter.SetThreadCount(1);
+    _NurbsScatter.SetSimplifyRatio(0.9);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    MeasureSegments(_vecScatterNodes, _nMaxLength, _nMaxAngle);
+    EXPECT_LE(_nMaxLength, _nMaxSegmentLength * (1.0 + 1e-9));
+    EXPECT_LT(MeasureChordError(&_NurbsNode, _vecScatterNodes), _nDeflection);
+
+    _NurbsScatter.SetSimplifyRatio(0.0);
+    _NurbsScatter.EnableFlatnessScatter(true);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    MeasureSegments(_vecScatterNodes, _nMaxLength, _nMaxAngle);
+    EXPECT_LE(_nMaxLength, _nMaxSegmentLength * (1.0 + 1e-9));
+    EXPECT_LE(_nMaxAngle, _nMaxTurningAngle * 1.1);
+    EXPECT_LT(MeasureChordError(&_NurbsNode, _vecScatterNodes), _nDeflection);
+
+    // The zero constraints are the same as no constraint
+    _NurbsScatter.EnableFlatnessScatter(false);
+    _NurbsScatter.SetSegmentConstraints(0.0, 0.0);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    EXPECT_EQ(_vecScatterNodes.size(), _vecFreeNodes.size());
+}
+
+TEST(NeatScatterUT, 3DScatterArraysNurbsScatter)
+{
+    // Rational curve with a repeated inner knot
+    NurbsNode3D _NurbsNode;
+    _NurbsNode.nDegree = 3;
+    _NurbsNode.vecKnots = { 0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 2.0, 2.0, 3.0, 4.0, 5.0, 5.0, 5.0, 5.0 };
+    for (int i = 0; i < 10; ++i) {
+        _NurbsNode.vecPoles.push_back(DPOINT3(i * 3.0, 10.0 * sin(i * 0.9), (i % 3) * 1.0));
+        _NurbsNode.vecWeights.push_back(1.0 + 0.5 * (i % 2));
+    }
+
+    const double _nDeflection = 0.001;
+    CNurbsScatter3D _NurbsScatter;
+    ScatterArrays3D _ScatterArrays;
+    VECDPOINT3 _vecScatterPoints;
+    std::vector<ScatterNode3D> _vecScatterNodes;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterPoints));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+
+    // The points and knots are the same as the scatter points, and the other arrays are cleared
+    _ScatterArrays.vecDeriv2s.resize(3);
+    _ScatterArrays.vecCurvatures.resize(3);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, scatter_field::point | scatter_field::knot, _ScatterArrays));
+    ASSERT_EQ(_ScatterArrays.vecPoints.size(), _vecScatterPoints.size());
+    ASSERT_EQ(_ScatterArrays.vecKnots.size(), _vecScatterPoints.size());
+    EXPECT_TRUE(_ScatterArrays.vecDeriv1s.empty() && _ScatterArrays.vecDeriv2s.empty());
+    EXPECT_TRUE(_ScatterArrays.vecCurvatures.empty() && _ScatterArrays.vecArcLengths.empty());
+    for (size_t i = 0; i < _vecScatterPoints.size(); ++i) {
+        CheckDPoint3Equal(_ScatterArrays.vecPoints[i], _vecScatterPoints[i], 0.0);
+    }
+    // The arrays of points and knots take less than half of the bytes of the scatter nodes
+    size_t _nArraysBytes = _ScatterArrays.vecPoints.size() * sizeof(DPOINT3) + _ScatterArrays.vecKnots.size() * sizeof(double);
+    size_t _nNodesBytes = _vecScatterNodes.size() * sizeof(ScatterNode3D);
+    EXPECT_EQ(_nArraysBytes, _vecScatterPoints.size() * (sizeof(DPOINT3) + sizeof(double)));
+    EXPECT_LT(_nArraysBytes * 2, _nNodesBytes);
+
+    // All fields are the same as the scatter nodes, and the curvatures and arc lengths are calculated from them
+    CNurbsParser3D _NurbsParser;
+    _NurbsParser.SetNurbsNode(&_NurbsNode);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, scatter_field::all, _ScatterArrays));
+    ASSERT_EQ(_ScatterArrays.vecPoints.size(), _vecScatterNodes.size());
+    ASSERT_EQ(_ScatterArrays.vecCurvatures.size(), _vecScatterNodes.size());
+    ASSERT_EQ(_ScatterArrays.vecArcLengths.size(), _vecScatterNodes.size());
+    double _nArcLength = 0.0;
+    for (size_t i = 0; i < _vecScatterNodes.size(); ++i) {
+        const ScatterNode3D& _ScatterNode = _vecScatterNodes[i];
+        CheckDPoint3Equal(_ScatterArrays.vecPoints[i], _ScatterNode.ptPoint, 0.0);
+        CheckDPoint3Equal(_ScatterArrays.vecDeriv1s[i], _ScatterNode.ptDeriv1, 0.0);
+        CheckDPoint3Equal(_ScatterArrays.vecDeriv2s[i], _ScatterNode.ptDeriv2, 0.0);
+        EXPECT_EQ(_ScatterArrays.vecKnots[i], _ScatterNode.nKnot);
+
+        DPOINT3 _ptCross = CrossProduct(_ScatterNode.ptDeriv1, _ScatterNode.ptDeriv2);
+        double _nLength1 = _ScatterNode.ptDeriv1.GetLength();
+        EXPECT_NEAR(_ScatterArrays.vecCurvatures[i], _ptCross.GetLength() / (_nLength1 * _nLength1 * _nLength1), 1e-9);
+
+        _nArcLength += (i > 0 ? (_ScatterNode.ptPoint - _vecScatterNodes[i - 1].ptPoint).GetLength() : 0.0);
+        EXPECT_NEAR(_ScatterArrays.vecArcLengths[i], _nArcLength, 1e-9);
+    }
+
+    // The curvature of arc is the reciprocal of radius, and the arc length is close to the length of arc
+    BezierNode3D _BezierNode;
+    _BezierNode.nStartKnot = 0.0;
+    _BezierNode.nEndKnot = 1.0;
+    _BezierNode.vecPoles = { DPOINT3(20.0, 0.0, 5.0), DPOINT3(20.0, 20.0, 5.0), DPOINT3(0.0, 20.0, 5.0) };
+    _BezierNode.vecWeights = { 1.0, sqrt(2.0) / 2.0, 1.0 };
+    EXPECT_NO_THROW(_NurbsScatter.ScatterBezier(&_BezierNode, _nDeflection, scatter_field::curvature | scatter_field::arc_length,
+        _ScatterArrays));
+    EXPECT_TRUE(_ScatterArrays.vecPoints.empty());
+    ASSERT_GT(_ScatterArrays.vecCurvatures.size(), 2);
+    for (double _nCurvature : _ScatterArrays.vecCurvatures) {
+        EXPECT_NEAR(_nCurvature, 1.0 / 20.0, 1e-9);
+    }
+    EXPECT_NEAR(_ScatterArrays.vecArcLengths.back(), 10.0 * Precision::PIE(), 0.01);
+
+    // The flatness scatter calculates the first-order derivatives if they are selected
+    _NurbsScatter.EnableFlatnessScatter(true);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, scatter_field::knot | scatter_field::deriv1, _ScatterArrays));
+    ASSERT_EQ(_ScatterArrays.vecDeriv1s.size(), _ScatterArrays.vecKnots.size());
+    DPOINT3 _ptPoint, _ptDeriv1;
+    for (size_t i = 0; i < _ScatterArrays.vecKnots.size(); ++i) {
+        _NurbsParser.GetNurbsDeriv(_ScatterArrays.vecKnots[i], _ptPoint, _ptDeriv1);
+        CheckDPoint3Equal(_ScatterArrays.vecDeriv1s[i], _ptDeriv1, 1e-6);
+    }
+
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, 0, _ScatterArrays), std::exception);
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, 0x40, _ScatterArrays), std::exception);
+}
+
+TEST(NeatScatterUT, 3DLevelNurbsScatter)
+{
+    // Rational curve with a repeated inner knot
+    NurbsNode3D _NurbsNode;
+    _NurbsNode.nDegree = 3;
+    _NurbsNode.vecKnots = { 0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 2.0, 2.0, 3.0, 4.0, 5.0, 5.0, 5.0, 5.0 };
+    for (int i = 0; i < 10; ++i) {
+        _NurbsNode.vecPoles.push_back(DPOINT3(i * 3.0, 10.0 * sin(i * 0.9), (i % 3) * 1.0));
+        _NurbsNode.vecWeights.push_back(1.0 + 0.5 * (i % 2));
+    }
+
+    const VECDOUBLE _vecDeflections = { 0.1, 0.01, 0.001 };
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints;
+    std::vector<ScatterNode3D> _vecScatterNodes;
+    std::vector<int> _vecLevels, _vecPointLevels;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _vecDeflections, _vecScatterNodes, _vecLevels));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _vecDeflections, _vecScatterPoints, _vecPointLevels));
+    ASSERT_EQ(_vecLevels.size(), _vecScatterNodes.size());
+    ASSERT_EQ(_vecPointLevels, _vecLevels);
+    ASSERT_EQ(_vecScatterPoints.size(), _vecScatterNodes.size());
+    for (size_t i = 0; i < _vecScatterPoints.size(); ++i) {
+        CheckDPoint3Equal(_vecScatterPoints[i], _vecScatterNodes[i].ptPoint, 1e-9);
+    }
+
+    // Every level is within its deflection, and the start and end nodes are in the first level
+    EXPECT_EQ(_vecLevels.front(), 0);
+    EXPECT_EQ(_vecLevels.back(), 0);
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.front().nKnot, 0.0);
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.back().nKnot, 5.0);
+    size_t _nLastSize = 0;
+    std::vector<ScatterNode3D> _vecLevelNodes;
+    for (int i = 0; i < static_cast<int>(_vecDeflections.size()); ++i) {
+        _vecLevelNodes.clear();
+        for (size_t j = 0; j < _vecScatterNodes.size(); ++j) {
+            EXPECT_TRUE(_vecLevels[j] >= 0 && _vecLevels[j] < static_cast<int>(_vecDeflections.size()));
+            if (_vecLevels[j] <= i) {
+                _vecLevelNodes.push_back(_vecScatterNodes[j]);
+            }
+        }
+        EXPECT_LT(MeasureChordError(&_NurbsNode, _vecLevelNodes), _vecDeflections[i]);
+        EXPECT_GT(_vecLevelNodes.size(), _nLastSize);
+        _nLastSize = _vecLevelNodes.size();
+    }
+    EXPECT_EQ(_nLastSize, _vecScatterNodes.size());
+
+    // The knots are ascending, and the finest level is not much more than the quasi uniform scatter
+    for (size_t i = 1; i < _vecScatterNodes.size(); ++i) {
+        EXPECT_LT(_vecScatterNodes[i - 1].nKnot, _vecScatterNodes[i].nKnot);
+    }
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _vecDeflections.back(), _vecScatterPoints));
+    EXPECT_LT(_vecScatterNodes.size(), _vecScatterPoints.size() * 2);
+
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, VECDOUBLE(), _vecScatterNodes, _vecLevels), std::exception);
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, VECDOUBLE{ 0.01, 0.1 }, _vecScatterNodes, _vecLevels), std::exception);
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, VECDOUBLE{ 0.1, 0.0 }, _vecScatterNodes, _vecLevels), std::exception);
+    _NurbsScatter.EnableFlatnessScatter(true);
+    EXPECT_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _vecDeflections, _vecScatterNodes, _vecLevels), std::exception);
+}
+
+TEST(NeatScatterUT, 3DLevelCollinearNurbsScatter)
+{
+    // Unclamped rectangle whose straight sides are divided by triple knots, and rational curve with a repeated inner knot
+    NurbsNode3D _RectangleNode;
+    BuildRectangleNurbsNode(_RectangleNode);
+
+    NurbsNode3D _CurveNode;
+    _CurveNode.nDegree = 3;
+    _CurveNode.vecKnots = { 0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 2.0, 2.0, 3.0, 4.0, 5.0, 5.0, 5.0, 5.0 };
+    for (int i = 0; i < 10; ++i) {
+        _CurveNode.vecPoles.push_back(DPOINT3(i * 3.0, 10.0 * sin(i * 0.9), (i % 3) * 1.0));
+        _CurveNode.vecWeights.push_back(1.0 + 0.5 * (i % 2));
+    }
+
+    // The collinear nodes of every level are combined, so every level is no more than 10% over the separate scatter by its deflection
+    const VECDOUBLE _vecDeflections = { 0.1, 0.01, 0.001 };
+    CNurbsScatter3D _NurbsScatter;
+    VECDPOINT3 _vecScatterPoints, _vecSeparatePoints;
+    std::vector<int> _vecLevels;
+    for (const NurbsNode3D* _pNurbsNode : { &_RectangleNode, &_CurveNode }) {
+        EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_pNurbsNode, _vecDeflections, _vecScatterPoints, _vecLevels));
+        for (int i = 0; i < static_cast<int>(_vecDeflections.size()); ++i) {
+            size_t _nLevelSize = std::count_if(_vecLevels.begin(), _vecLevels.end(), [i](int nLevel_) { return nLevel_ <= i; });
+            EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(_pNurbsNode, _vecDeflections[i], _vecSeparatePoints));
+            EXPECT_LE(_nLevelSize * 10, _vecSeparatePoints.size() * 11);
+        }
+    }
+}
+
+TEST(NeatScatterUT, 3DInterruptedNurbsScatter)
+{
+    // Long non rational curve with many spans
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 200;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 2.0, 10.0 * sin(i * 0.7), (i % 4) * 1.5); },
+        nullptr, _NurbsNode);
+
+    const double _nDeflection = 0.001;
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecFullNodes, _vecScatterNodes;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecFullNodes));
+    EXPECT_EQ(_NurbsScatter.GetScatterStatus(), scatter_status::finished);
+
+    // The token which is not interrupted doesn't change the result
+    ScatterToken _ScatterToken;
+    _NurbsScatter.SetScatterToken(&_ScatterToken);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    EXPECT_EQ(_NurbsScatter.GetScatterStatus(), scatter_status::finished);
+    EXPECT_EQ(_vecScatterNodes.size(), _vecFullNodes.size());
+
+    // The interrupted scatter outputs the front part of the full scatter
+    _ScatterToken.bCancelled = true;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    EXPECT_EQ(_NurbsScatter.GetScatterStatus(), scatter_status::cancelled);
+    ASSERT_GT(_vecScatterNodes.size(), 1);
+    ASSERT_LT(_vecScatterNodes.size(), _vecFullNodes.size());
+    for (size_t i = 0; i < _vecScatterNodes.size(); ++i) {
+        CheckDPoint3Equal(_vecScatterNodes[i].ptPoint, _vecFullNodes[i].ptPoint, 0.0);
+    }
+    EXPECT_LT(MeasureChordError(&_NurbsNode, _vecScatterNodes), _nDeflection);
+
+    // The blocks of several threads are joined until the first interrupted block
+    _NurbsScatter.SetThreadCount(4);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    EXPECT_EQ(_NurbsScatter.GetScatterStatus(), scatter_status::cancelled);
+    ASSERT_GT(_vecScatterNodes.size(), 1);
+    ASSERT_LT(_vecScatterNodes.size(), _vecFullNodes.size());
+    for (size_t i = 0; i < _vecScatterNodes.size(); ++i) {
+        CheckDPoint3Equal(_vecScatterNodes[i].ptPoint, _vecFullNodes[i].ptPoint, 0.0);
+    }
+
+    // The expired deadline interrupts the flatness scatter too
+    _NurbsScatter.SetThreadCount(1);
+    _NurbsScatter.EnableFlatnessScatter(true);
+    _ScatterToken.bCancelled = false;
+    _ScatterToken.tmDeadline = std::chrono::steady_clock::now();
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    EXPECT_EQ(_NurbsScatter.GetScatterStatus(), scatter_status::expired);
+    ASSERT_GT(_vecScatterNodes.size(), 1);
+    EXPECT_LT(_vecScatterNodes.back().nKnot, _nPoleCount - 3.0);
+    EXPECT_LT(MeasureChordError(&_NurbsNode, _vecScatterNodes), _nDeflection);
+
+    // The status is finished without token
+    _NurbsScatter.SetScatterToken(nullptr);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    EXPECT_EQ(_NurbsScatter.GetScatterStatus(), scatter_status::finished);
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.back().nKnot, _nPoleCount - 3.0);
+
+    // The conversion to polyline is interrupted before fitting the knot intervals
+    NurbsNode2D _NurbsNode2D;
+    _NurbsNode2D.nDegree = 3;
+    _NurbsNode2D.vecKnots = _NurbsNode.vecKnots;
+    for (const auto& _ptPole : _NurbsNode.vecPoles) {
+        _NurbsNode2D.vecPoles.push_back(DPOINT2(_ptPole[axis::x], _ptPole[axis::y]));
+    }
+    _NurbsNode2D.vecWeights = _NurbsNode.vecWeights;
+
+    Polyline2D _FullPolyline, _Polyline;
+    ScatterToken _PolylineToken;
+    EXPECT_NO_THROW(ScatterNurbs(&_NurbsNode2D, 0.01, _FullPolyline));
+    EXPECT_EQ(ScatterNurbs(&_NurbsNode2D, 0.01, _PolylineToken, _Polyline), scatter_status::finished);
+    EXPECT_EQ(_Polyline.vecNodes.size(), _FullPolyline.vecNodes.size());
+
+    _Polyline.vecNodes.clear();
+    _PolylineToken.bCancelled = true;
+    EXPECT_EQ(ScatterNurbs(&_NurbsNode2D, 0.01, _PolylineToken, _Polyline), scatter_status::cancelled);
+    EXPECT_LT(_Polyline.vecNodes.size(), _FullPolyline.vecNodes.size());
+
+    // The scatter before biarc fit is interrupted as well, even if the bezier node is approximated with a straight line
+    BezierNode2D _BezierNode2D;
+    _BezierNode2D.vecPoles = { DPOINT2(0.0, 0.0), DPOINT2(1.0, 0.0), DPOINT2(2.0, 0.0), DPOINT2(3.0, 0.0) };
+    _BezierNode2D.vecWeights = { 1.0, 1.0, 1.0, 1.0 };
+    _BezierNode2D.nEndKnot = 1.0;
+    _Polyline.vecNodes.clear();
+    EXPECT_EQ(ScatterBezier(&_BezierNode2D, 0.01, _PolylineToken, _Polyline), scatter_status::cancelled);
+    EXPECT_TRUE(_Polyline.vecNodes.empty());
+    _PolylineToken.bCancelled = false;
+    EXPECT_EQ(ScatterBezier(&_BezierNode2D, 0.01, _PolylineToken, _Polyline), scatter_status::finished);
+    EXPECT_EQ(_Polyline.vecNodes.size(), 1);
+}
+
+TEST(NeatScatterUT, 3DRescatterNurbsScatter)
+{
+    // Long curve with many spans
+    NurbsNode3D _NurbsNode;
+    const int _nPoleCount = 200;
+    BuildCubicNurbsNode(_nPoleCount, 0, [](int i) { return DPOINT3(i * 2.0, 3.0 * sin(i * 0.7), (i % 4) * 0.5); },
+        nullptr, _NurbsNode);
+
+    const double _nDeflection = 0.001;
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode3D> _vecPrevNodes, _vecScatterNodes, _vecFullNodes;
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecPrevNodes));
+
+    // Move an inner pole, the nodes out of its knot interval are the same as before
+    const int _nPoleIndex = 100;
+    _NurbsNode.vecPoles[_nPoleIndex] += DPOINT3(0.0, 0.0, 5.0);
+    _vecScatterNodes = _vecPrevNodes;
+    EXPECT_NO_THROW(_NurbsScatter.RescatterNurbs(&_NurbsNode, _nDeflection, { _nPoleIndex }, _vecScatterNodes));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecFullNodes));
+    EXPECT_LE(MeasureChordError(&_NurbsNode, _vecScatterNodes), MeasureChordError(&_NurbsNode, _vecFullNodes) + 1e-9);
+    EXPECT_NEAR(static_cast<double>(_vecScatterNodes.size()), static_cast<double>(_vecFullNodes.size()), 4.0);
+
+    const double _nStartKnot = _NurbsNode.vecKnots[_nPoleIndex];
+    const double _nEndKnot = _NurbsNode.vecKnots[_nPoleIndex + 4];
+    size_t _nFrontCount = 0;
+    while (_vecPrevNodes[_nFrontCount].nKnot < _nStartKnot - 1.0) {
+        EXPECT_EQ(_vecScatterNodes[_nFrontCount].nKnot, _vecPrevNodes[_nFrontCount].nKnot);
+        CheckDPoint3Equal(_vecScatterNodes[_nFrontCount].ptPoint, _vecPrevNodes[_nFrontCount].ptPoint, 0.0);
+        ++_nFrontCount;
+    }
+    EXPECT_GT(_nFrontCount, 0);
+    for (size_t i = 1; i < _vecPrevNodes.size() && _vecPrevNodes[_vecPrevNodes.size() - i].nKnot > _nEndKnot + 1.0; ++i) {
+        EXPECT_EQ(_vecScatterNodes[_vecScatterNodes.size() - i].nKnot, _vecPrevNodes[_vecPrevNodes.size() - i].nKnot);
+        CheckDPoint3Equal(_vecScatterNodes[_vecScatterNodes.size() - i].ptPoint, _vecPrevNodes[_vecPrevNodes.size() - i].ptPoint, 0.0);
+    }
+    for (size_t i = 1; i < _vecScatterNodes.size(); ++i) {
+        EXPECT_LT(_vecScatterNodes[i - 1].nKnot, _vecScatterNodes[i].nKnot);
+    }
+
+    // Modify the weights of the first and last poles, whose intervals contain the ends of nurbs node
+    _vecPrevNodes = _vecScatterNodes;
+    _NurbsNode.vecWeights.front() = 1.2;
+    _NurbsNode.vecWeights.back() = 0.8;
+    EXPECT_NO_THROW(_NurbsScatter.RescatterNurbs(&_NurbsNode, _nDeflection, { 0, _nPoleCount - 1 }, _vecScatterNodes));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecFullNodes));
+    EXPECT_LE(MeasureChordError(&_NurbsNode, _vecScatterNodes), MeasureChordError(&_NurbsNode, _vecFullNodes) + 1e-9);
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.front().nKnot, 0.0);
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.back().nKnot, _nPoleCount - 3.0);
+
+    CNurbsParser3D _NurbsParser;
+    _NurbsParser.SetNurbsNode(&_NurbsNode);
+    DPOINT3 _ptPoint, _ptDeriv1, _ptDeriv2;
+    for (const auto& _ScatterNode : _vecScatterNodes) {
+        _NurbsParser.GetNurbsDeriv(_ScatterNode.nKnot, _ptPoint, _ptDeriv1, _ptDeriv2);
+        CheckDPoint3Equal(_ScatterNode.ptPoint, _ptPoint, 1e-9);
+        CheckDPoint3Equal(_ScatterNode.ptDeriv1, _ptDeriv1, 1e-6);
+    }
+
+    // The simplified nodes are within deflection too
+    _NurbsScatter.SetSimplifyRatio(0.5);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecScatterNodes));
+    _NurbsNode.vecPoles[20] += DPOINT3(1.0, -2.0, 0.0);
+    _NurbsNode.vecPoles[21] += DPOINT3(1.0, -2.0, 0.0);
+    EXPECT_NO_THROW(_NurbsScatter.RescatterNurbs(&_NurbsNode, _nDeflection, { 21, 20 }, _vecScatterNodes));
+    EXPECT_LT(MeasureChordError(&_NurbsNode, _vecScatterNodes), _nDeflection);
+
+    EXPECT_THROW(_NurbsScatter.RescatterNurbs(&_NurbsNode, _nDeflection, {}, _vecScatterNodes), std::exception);
+    EXPECT_THROW(_NurbsScatter.RescatterNurbs(&_NurbsNode, _nDeflection, { _nPoleCount }, _vecScatterNodes), std::exception);
+    _NurbsScatter.EnableFlatnessScatter(true);
+    EXPECT_THROW(_NurbsScatter.RescatterNurbs(&_NurbsNode, _nDeflection, { 0 }, _vecScatterNodes), std::exception);
+    _NurbsScatter.EnableFlatnessScatter(false);
+    _vecScatterNodes.pop_back();
+    EXPECT_THROW(_NurbsScatter.RescatterNurbs(&_NurbsNode, _nDeflection, { 0 }, _vecScatterNodes), std::exception);
+
+    // Unclamped rectangle, whose knots are from -0.25 to 1.25 and scatter nodes are from 0 to 1
+    NurbsNode3D _RectangleNode;
+    BuildRectangleNurbsNode(_RectangleNode);
+
+    _NurbsScatter.SetSimplifyRatio(0.0);
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_RectangleNode, _nDeflection, _vecScatterNodes));
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.front().nKnot, 0.0);
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.back().nKnot, 1.0);
+    _RectangleNode.vecPoles.front() += DPOINT3(2.0, 0.0, 1.0);
+    _RectangleNode.vecPoles[5] += DPOINT3(0.0, 3.0, 0.0);
+    _RectangleNode.vecPoles.back() += DPOINT3(2.0, 0.0, 1.0);
+    EXPECT_NO_THROW(_NurbsScatter.RescatterNurbs(&_RectangleNode, _nDeflection, { 0, 5, 12 }, _vecScatterNodes));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_RectangleNode, _nDeflection, _vecFullNodes));
+    EXPECT_LE(MeasureChordError(&_RectangleNode, _vecScatterNodes), MeasureChordError(&_RectangleNode, _vecFullNodes) + 1e-9);
+    EXPECT_EQ(_vecScatterNodes.size(), _vecFullNodes.size());
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.front().nKnot, 0.0);
+    EXPECT_DOUBLE_EQ(_vecScatterNodes.back().nKnot, 1.0);
+    for (size_t i = 1; i < _vecScatterNodes.size(); ++i) {
+        EXPECT_LT(_vecScatterNodes[i - 1].nKnot, _vecScatterNodes[i].nKnot);
+    }
+}
+
+TEST(NeatScatterUT, 5DAxisNurbsScatter)
+{
+    // Rational curve of position and tool orientation
+    NurbsNode5D _NurbsNode;
+    _NurbsNode.nDegree = 3;
+    const int _nPoleCount = 40;
+    BuildCubicKnots(_nPoleCount, 0, _NurbsNode.vecKnots);
+
+    for (int i = 0; i < _nPoleCount; ++i) {
+        DPOINT5 _ptPole;
+        _ptPole[0] = i * 2.0;
+        _ptPole[1] = 3.0 * sin(i * 0.7);
+        _ptPole[2] = (i % 4) * 0.5;
+        _ptPole[3] = 0.5 * sin(i * 0.3);
+        _ptPole[4] = 0.1 * i;
+        _NurbsNode.vecPoles.push_back(_ptPole);
+        _NurbsNode.vecWeights.push_back(1.0 + 0.1 * (i % 2));
+    }
+
+    NurbsNode3D _PositionNode, _OrientationNode;
+    ProjectNurbsNode(_NurbsNode, { 0, 1, 2 }, _PositionNode);
+    ProjectNurbsNode(_NurbsNode, { 3, 4 }, _OrientationNode);
+
+    // The position is scattered like the position curve without combining collinear nodes, and the orientation is divided more
+    const double _nDeflection = 0.001;
+    CNurbsScatter5D _AxisScatter;
+    CNurbsScatter3D _NurbsScatter;
+    std::vector<ScatterNode5D> _vecAxisNodes;
+    std::vector<ScatterNode3D> _vecScatterNodes, _vecProjectedNodes;
+    EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecAxisNodes));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_PositionNode, _nDeflection, _vecScatterNodes));
+    ASSERT_GE(_vecAxisNodes.size(), _vecScatterNodes.size());
+    ProjectScatterNodes(_vecAxisNodes, { 0, 1, 2 }, _vecProjectedNodes);
+    EXPECT_LE(MeasureChordError(&_PositionNode, _vecProjectedNodes), MeasureChordError(&_PositionNode, _vecScatterNodes) + 1e-9);
+    ProjectScatterNodes(_vecAxisNodes, { 3, 4 }, _vecProjectedNodes);
+    EXPECT_LT(MeasureChordError(&_OrientationNode, _vecProjectedNodes), _nDeflection);
+
+    // All axes are evaluated at the same knots
+    CNurbsParser5D _NurbsParser;
+    _NurbsParser.SetNurbsNode(&_NurbsNode);
+    DPOINT5 _ptPoint, _ptDeriv1, _ptDeriv2;
+    for (size_t i = 0; i < _vecAxisNodes.size(); ++i) {
+        const ScatterNode5D& _AxisNode = _vecAxisNodes[i];
+        EXPECT_TRUE(i == 0 || _vecAxisNodes[i - 1].nKnot < _AxisNode.nKnot);
+        _NurbsParser.GetNurbsDeriv(_AxisNode.nKnot, _ptPoint, _ptDeriv1, _ptDeriv2);
+        EXPECT_NEAR((_AxisNode.ptPoint - _ptPoint).GetLength(), 0.0, 1e-9);
+        EXPECT_NEAR((_AxisNode.ptDeriv1 - _ptDeriv1).GetLength(), 0.0, 1e-6);
+        EXPECT_NEAR((_AxisNode.ptDeriv2 - _ptDeriv2).GetLength(), 0.0, 1e-5);
+    }
+
+    std::vector<DPOINT5> _vecAxisPoints;
+    EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecAxisPoints));
+    ASSERT_EQ(_vecAxisPoints.size(), _vecAxisNodes.size());
+    for (size_t i = 0; i < _vecAxisPoints.size(); ++i) {
+        EXPECT_NEAR((_vecAxisPoints[i] - _vecAxisNodes[i].ptPoint).GetLength(), 0.0, 1e-9);
+    }
+
+    // The orientation deflection is set separately
+    size_t _nNodeCount = _vecAxisNodes.size();
+    EXPECT_NO_THROW(_AxisScatter.SetOrientationDeflection(0.0001));
+    EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecAxisNodes));
+    EXPECT_GT(_vecAxisNodes.size(), _nNodeCount);
+    ProjectScatterNodes(_vecAxisNodes, { 3, 4 }, _vecProjectedNodes);
+    EXPECT_LT(MeasureChordError(&_OrientationNode, _vecProjectedNodes), 0.0001);
+
+    // The deflection is measured on x and y, and the z axis is measured as orientation
+    NurbsNode3D _PlaneNode;
+    ProjectNurbsNode(_NurbsNode, { 0, 1 }, _PlaneNode);
+    EXPECT_NO_THROW(_AxisScatter.SetOrientationDeflection(0.0));
+    EXPECT_NO_THROW(_AxisScatter.SetDeflectionAxes({ axis::x, axis::y }));
+    EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(&_NurbsNode, _nDeflection, _vecAxisNodes));
+    EXPECT_NO_THROW(_NurbsScatter.ScatterNurbs(&_PlaneNode, _nDeflection, _vecScatterNodes));
+    ProjectScatterNodes(_vecAxisNodes, { 0, 1 }, _vecProjectedNodes);
+    EXPECT_LE(MeasureChordError(&_PlaneNode, _vecProjectedNodes), MeasureChordError(&_PlaneNode, _vecScatterNodes) + 1e-9);
+    ProjectNurbsNode(_NurbsNode, { 2, 3, 4 }, _OrientationNode);
+    ProjectScatterNodes(_vecAxisNodes, { 2, 3, 4 }, _vecProjectedNodes);
+    EXPECT_LT(MeasureChordError(&_OrientationNode, _vecProjectedNodes), _nDeflection);
+
+    EXPECT_THROW(_AxisScatter.SetDeflectionAxes({ axis::x }), std::exception);
+    EXPECT_THROW(_AxisScatter.SetDeflectionAxes({ axis::x, axis::x }), std::exception);
+    EXPECT_THROW(_AxisScatter.SetDeflectionAxes({ axis::x, 5 }), std::exception);
+    EXPECT_THROW(_AxisScatter.SetDeflectionAxes({ 0, 1, 2, 3 }), std::exception);
+    EXPECT_THROW(_AxisScatter.SetOrientationDeflection(-0.1), std::exception);
+    EXPECT_THROW(_AxisScatter.ScatterNurbs(nullptr, _nDeflection, _vecAxisNodes), std::exception);
+}
+
+TEST(NeatScatterUT, 5DOrientationNurbsScatter)
+{
+    // The tool rotates without moving the position, and the A axis swings to 67.5 degrees while the position moves straight
+    NurbsNode5D _RotationNode, _SwingNode;
+    _RotationNode.nDegree = _SwingNode.nDegree = 3;
+    _RotationNode.vecKnots = _SwingNode.vecKnots = { 0.0, 0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0, 1.0 };
+    const double _vecAngles[] = { 0.0, 45.0, 90.0, 45.0, 0.0 };
+    for (int i = 0; i < 5; ++i) {
+        DPOINT5 _ptPole;
+        _ptPole[0] = 10.0;
+        _ptPole[1] = 20.0;
+        _ptPole[2] = 30.0;
+        _ptPole[3] = _vecAngles[i];
+        _ptPole[4] = 30.0 * i;
+        _RotationNode.vecPoles.push_back(_ptPole);
+
+        _ptPole[0] = 5.0 * i;
+        _ptPole[1] = 2.5 * i;
+        _ptPole[4] = 0.0;
+        _SwingNode.vecPoles.push_back(_ptPole);
+    }
+    _RotationNode.vecWeights.assign(5, 1.0);
+    _SwingNode.vecWeights.assign(5, 1.0);
+
+    // The orientation is within deflection in both cases
+    const double _nDeflection = 0.001;
+    CNurbsScatter5D _AxisScatter;
+    _AxisScatter.SetOrientationDeflection(0.01);
+    std::vector<ScatterNode5D> _vecAxisNodes;
+    std::vector<ScatterNode3D> _vecProjectedNodes;
+    NurbsNode3D _OrientationNode;
+    for (const NurbsNode5D* _pNurbsNode : { &_RotationNode, &_SwingNode }) {
+        EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(_pNurbsNode, _nDeflection, _vecAxisNodes));
+        ASSERT_GT(_vecAxisNodes.size(), 10u);
+        EXPECT_DOUBLE_EQ(_vecAxisNodes.front().nKnot, 0.0);
+        EXPECT_DOUBLE_EQ(_vecAxisNodes.back().nKnot, 1.0);
+        ProjectNurbsNode(*_pNurbsNode, { 3, 4 }, _OrientationNode);
+        ProjectScatterNodes(_vecAxisNodes, { 3, 4 }, _vecProjectedNodes);
+        EXPECT_LT(MeasureChordError(&_OrientationNode, _vecProjectedNodes), 0.01);
+    }
+
+    // The peak of A axis is kept
+    double _nMaxAngle = 0.0;
+    for (const auto& _AxisNode : _vecAxisNodes) {
+        _nMaxAngle = max(_nMaxAngle, _AxisNode.ptPoint[3]);
+    }
+    EXPECT_NEAR(_nMaxAngle, 67.5, 0.01);
+}
+
+TEST(NeatScatterUT, 5DLineAxisNurbsScatter)
+{
+    // One-degree rational nurbs node of position and tool orientation
+    NurbsNode5D _NurbsNode;
+    _NurbsNode.nDegree = 1;
+    _NurbsNode.vecKnots = { 0.0, 0.0, 1.0, 3.0, 4.0, 4.0 };
+    for (int i = 0; i < 4; ++i) {
+        DPOINT5 _ptPole;
+        _ptPole[0] = i * 2.0;
+        _ptPole[1] = (i % 2) * 3.0;
+        _ptPole[2] = 1.0;
+        _ptPole[3] = i * 10.0;
+        _ptPole[4] = -i * 5.0;
+        _NurbsNode.vecPoles.push_back(_ptPole);
+        _NurbsNode.vecWeights.push_back(1.0 + 0.5 * (i % 2));
+    }
+
+    // The poles are output directly, which are at the knots of valid range
+    CNurbsScatter5D _AxisScatter;
+    std::vector<DPOINT5> _vecAxisPoints;
+    std::vector<ScatterNode5D> _vecAxisNodes;
+    EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(&_NurbsNode, 0.001, _vecAxisPoints));
+    EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(&_NurbsNode, 0.001, _vecAxisNodes));
+    ASSERT_EQ(_vecAxisPoints.size(), _NurbsNode.vecPoles.size());
+    ASSERT_EQ(_vecAxisNodes.size(), _NurbsNode.vecPoles.size());
+    for (size_t i = 0; i < _vecAxisPoints.size(); ++i) {
+        EXPECT_NEAR((_vecAxisPoints[i] - _NurbsNode.vecPoles[i]).GetLength(), 0.0, 1e-12);
+        EXPECT_NEAR((_vecAxisNodes[i].ptPoint - _NurbsNode.vecPoles[i]).GetLength(), 0.0, 1e-9);
+        EXPECT_DOUBLE_EQ(_vecAxisNodes[i].nKnot, _NurbsNode.vecKnots[i + 1]);
+    }
+
+    // The pole at the repeated knot is skipped except the last one, so the knots are increasing
+    _NurbsNode.vecKnots = { 0.0, 0.0, 1.0, 1.0, 4.0, 4.0 };
+    EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(&_NurbsNode, 0.001, _vecAxisPoints));
+    EXPECT_NO_THROW(_AxisScatter.ScatterNurbs(&_NurbsNode, 0.001, _vecAxisNodes));
+    ASSERT_EQ(_vecAxisPoints.size(), 3u);
+    ASSERT_EQ(_vecAxisNodes.size(), 3u);
+    for (size_t i = 0; i < _vecAxisPoints.size(); ++i) {
+        EXPECT_NEAR((_vecAxisPoints[i] - _vecAxisNodes[i].ptPoint).GetLength(), 0.0, 1e-9);
+        EXPECT_TRUE(i == 0 || _vecAxisNodes[i - 1].nKnot < _vecAxisNodes[i].nKnot);
+    }
+    EXPECT_NEAR((_vecAxisPoints[1] - _NurbsNode.vecPoles[2]).GetLength(), 0.0, 1e-12);
+}
+
+//////////////////////////////////////////////////////////////////////////
+static double MeasureChordError(const NurbsNode3D* pNurbsNode_, const std::vector<ScatterNode3D>& vecScatterNodes_)
+{
+    CNurbsParser3D _NurbsParser;
+    _NurbsParser.SetNurbsNode(pNurbsNode_);
+
+    const int _nSampleCount = 16;
+    double _nMaxError = 0.0;
+    DPOINT3 _ptPoint;
+    for (size_t i = 1; i < vecScatterNodes_.size(); ++i) {
+        const ScatterNode3D& _StartNode = vecScatterNodes_[i - 1];
+        const ScatterNode3D& _EndNode = vecScatterNodes_[i];
+        DPOINT3 _ptChord = _EndNode.ptPoint - _StartNode.ptPoint;
+        double _nSquareLength = _ptChord.GetSquareLength();
+        for (int j = 1; j < _nSampleCount; ++j) {
+            _NurbsParser.GetNurbsPoint(_StartNode.nKnot + (_EndNode.nKnot - _StartNode.nKnot) * j / _nSampleCount, _ptPoint);
+            double _nRatio = _nSquareLength > 0.0 ? DotProduct(_ptPoint - _StartNode.ptPoint, _ptChord) / _nSquareLength : 0.0;
+            _nRatio = min(max(_nRatio, 0.0), 1.0);
+            _nMaxError = max(_nMaxError, (_ptPoint - (_StartNode.ptPoint + _ptChord * _nRatio)).GetLength());
+        }
+    }
+
+    return _nMaxError;
+}
+
+static void MeasureSegments(const std::vector<ScatterNode3D>& vecScatterNodes_, double& nMaxLength_, double& nMaxAngle_)
+{
+    nMaxLength_ = 0.0;
+    nMaxAngle_ = 0.0;
+    for (size_t i = 1; i < vecScatterNodes_.size(); ++i) {
+        DPOINT3 _ptChord = vecScatterNodes_[i].ptPoint - vecScatterNodes_[i - 1].ptPoint;
+        nMaxLength_ = max(nMaxLength_, _ptChord.GetLength());
+        if (i + 1 < vecScatterNodes_.size()) {
+            DPOINT3 _ptNextChord = vecScatterNodes_[i + 1].ptPoint - vecScatterNodes_[i].ptPoint;
+            double _nCosine = DotProduct(_ptChord, _ptNextChord) / (_ptChord.GetLength() * _ptNextChord.GetLength());
+            nMaxAngle_ = max(nMaxAngle_, acos(min(max(_nCosine, -1.0), 1.0)));
+        }
+    }
+}
+
+static void ProjectNurbsNode(const NurbsNode5D& NurbsNode_, const std::vector<int>& vecAxes_, NurbsNode3D& ProjectedNode_)
+{
+    ProjectedNode_.nDegree = NurbsNode_.nDegree;
+    ProjectedNode_.vecKnots = NurbsNode_.vecKnots;
+    ProjectedNode_.vecWeights = NurbsNode_.vecWeights;
+    ProjectedNode_.vecPoles.assign(NurbsNode_.vecPoles.size(), DPOINT3(0.0, 0.0, 0.0));
+    for (size_t i = 0; i < NurbsNode_.vecPoles.size(); ++i) {
+        for (size_t j = 0; j < vecAxes_.size(); ++j) {
+            ProjectedNode_.vecPoles[i][static_cast<int>(j)] = NurbsNode_.vecPoles[i][vecAxes_[j]];
+        }
+    }
+}
+
+static void ProjectScatterNodes(const std::vector<ScatterNode5D>& vecScatterNodes_, const std::vector<int>& vecAxes_,
+    std::vector<ScatterNode3D>& vecProjectedNodes_)
+{
+    vecProjectedNodes_.assign(vecScatterNodes_.size(), ScatterNode3D());
+    for (size_t i = 0; i < vecScatterNodes_.size(); ++i) {
+        vecProjectedNodes_[i].nKnot = vecScatterNodes_[i].nKnot;
+        for (size_t j = 0; j < vecAxes_.size(); ++j) {
+            vecProjectedNodes_[i].ptPoint[static_cast<int>(j)] = vecScatterNodes_[i].ptPoint[vecAxes_[j]];
+            vecProjectedNodes_[i].ptDeriv1[static_cast<int>(j)] = vecScatterNodes_[i].ptDeriv1[vecAxes_[j]];
+        }
+    }
 }
\ No newline at end of file
@@ -14,15 +14,80 @@
 #include <fstream>
 #include <sstream>
 #include <io.h>
+#include <atomic>
+#include <new>
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#endif
 
 using namespace neat;
 using namespace tester;
 
+#if !defined(_MSC_VER) || defined(_DEBUG)
+#define TESTER_ALLOCATION_COUNT
+static std::atomic<size_t> gs_nAllocationCount(0);
+#endif
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+/**
+ * The library shares the debug CRT with the tester, so the hook sees the allocations inside the library too.
+ */
+static int CountAllocation(int nAllocType_, void*, size_t, int, long, const unsigned char*, int)
+{
+    if (nAllocType_ == _HOOK_ALLOC || nAllocType_ == _HOOK_REALLOC) {
+        ++gs_nAllocationCount;
+    }
+    return TRUE;
+}
+#elif !defined(_MSC_VER)
+/**
+ * The global operators of executable replace the ones of shared libraries, so they count the allocations
+ * inside the library too.
+ */
+void* operator new(size_t nSize_)
+{
+    ++gs_nAllocationCount;
+    void* _pMemory = malloc(nSize_ == 0 ? 1 : nSize_);
+    if (_pMemory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return _pMemory;
+}
+
+void* operator new[](size_t nSize_)
+{
+    return operator new(nSize_);
+}
+
+void operator delete(void* pMemory_) noexcept
+{
+    free(pMemory_);
+}
+
+void operator delete[](void* pMemory_) noexcept
+{
+    free(pMemory_);
+}
+
+void operator delete(void* pMemory_, size_t) noexcept
+{
+    free(pMemory_);
+}
+
+void operator delete[](void* pMemory_, size_t) noexcept
+{
+    free(pMemory_);
+}
+#endif
+
 /**
  * This file contains the 'main' function. Program execution begins and ends there.
  */
 int main(int argc, char** argv)
 {
+#if defined(_MSC_VER) && defined(_DEBUG)
+    _CrtSetAllocHook(CountAllocation);
+#endif
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
@@ -353,6 +418,40 @@ bool tester::ReadNurbsFromFile(const std::string& strFilePath_, std::vector<neat
     return true;
 }
 
+void tester::BuildCubicKnots(int nPoleCount_, int nRepeatedKnot_, neat::VECDOUBLE& vecKnots_)
+{
+    vecKnots_.assign(4, 0.0);
+    for (int i = 1; i < nPoleCount_ - 3; ++i) {
+        vecKnots_.push_back(i == nRepeatedKnot_ ? vecKnots_.back() : static_cast<double>(i));
+    }
+    vecKnots_.insert(vecKnots_.end(), 4, static_cast<double>(nPoleCount_ - 3));
+}
+
+void tester::BuildCubicNurbsNode(int nPoleCount_, int nRepeatedKnot_, const std::function<neat::DPOINT3(int)>& funPole_,
+    const std::function<double(int)>& funWeight_, neat::NurbsNode3D& NurbsNode_)
+{
+    NurbsNode_.nDegree = 3;
+    BuildCubicKnots(nPoleCount_, nRepeatedKnot_, NurbsNode_.vecKnots);
+
+    NurbsNode_.vecPoles.clear();
+    NurbsNode_.vecWeights.clear();
+    for (int i = 0; i < nPoleCount_; ++i) {
+        NurbsNode_.vecPoles.push_back(funPole_(i));
+        NurbsNode_.vecWeights.push_back(funWeight_ ? funWeight_(i) : 1.0);
+    }
+}
+
+void tester::BuildRectangleNurbsNode(neat::NurbsNode3D& NurbsNode_)
+{
+    NurbsNode_.nDegree = 3;
+    NurbsNode_.vecKnots = { -0.25, 0.0, 0.0, 0.0, 0.25, 0.25, 0.25, 0.5, 0.5, 0.5, 0.75, 0.75, 0.75, 1.0, 1.0, 1.0, 1.25 };
+    NurbsNode_.vecPoles = { DPOINT3(0.0, 0.0, 0.0), DPOINT3(0.0, 60.0, 0.0), DPOINT3(0.0, 120.0, 0.0),
+        DPOINT3(0.0, 180.0, 0.0), DPOINT3(-7.5, 180.0, 0.0), DPOINT3(-15.0, 180.0, 0.0), DPOINT3(-22.5, 180.0, 0.0),
+        DPOINT3(-22.5, 120.0, 0.0), DPOINT3(-22.5, 60.0, 0.0), DPOINT3(-22.5, 0.0, 0.0), DPOINT3(-15.0, 0.0, 0.0),
+        DPOINT3(-7.5, 0.0, 0.0), DPOINT3(0.0, 0.0, 0.0) };
+    NurbsNode_.vecWeights.assign(NurbsNode_.vecPoles.size(), 1.0);
+}
+
 bool tester::WritePointsToFile(const std::string& strFilePath_, const neat::VECDPOINT3& vecPoints_)
 {
     if (strFilePath_.empty()) {
@@ -449,4 +548,25 @@ bool tester::WritePolylineToFile(const std::string& strFilePath_, const neat::Po
 
     fclose(_pFile);
     return true;
+}
+
+size_t tester::GetAllocationCount()
+{
+#ifdef TESTER_ALLOCATION_COUNT
+    return gs_nAllocationCount;
+#else
+    return 0;
+#endif
+}
+
+std::string tester::FormatAllocations(double nAllocations_, const std::string& strUnit_)
+{
+#ifdef TESTER_ALLOCATION_COUNT
+    std::ostringstream _Stream;
+    _Stream << nAllocations_ << " " << strUnit_;
+    return _Stream.str();
+#else
+    (void)nAllocations_;
+    return "- " + strUnit_;
+#endif
 }
\ No newline at end of file
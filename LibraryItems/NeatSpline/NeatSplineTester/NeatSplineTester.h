@@ -13,6 +13,7 @@
 #ifndef __NEAT_SPLINE_TESTER_H_20200201__
 #define __NEAT_SPLINE_TESTER_H_20200201__
 
+#include <functional>
 #include <list>
 
 namespace tester
@@ -60,6 +61,21 @@ namespace tester
      */
     bool ReadNurbsFromFile(const std::string& strFilePath_, std::vector<neat::NurbsNode3D>& vecNurbsNodes_);
 
+    /**
+     * Build the clamped cubic nurbs node whose inner knots are 1, 2, ... nPoleCount_ - 4, the poles and weights are given
+     * by their indexes, and the weights are 1 if funWeight_ is empty. The inner knot of index nRepeatedKnot_ is set to the
+     * previous one if positive, which makes a discontinuous span.
+     */
+    void BuildCubicKnots(int nPoleCount_, int nRepeatedKnot_, neat::VECDOUBLE& vecKnots_);
+    void BuildCubicNurbsNode(int nPoleCount_, int nRepeatedKnot_, const std::function<neat::DPOINT3(int)>& funPole_,
+        const std::function<double(int)>& funWeight_, neat::NurbsNode3D& NurbsNode_);
+
+    /**
+     * Build the unclamped cubic rectangle of 22.5 x 180, whose knots are from -0.25 to 1.25 and sides are divided by
+     * triple knots, so the valid knots are from 0 to 1.
+     */
+    void BuildRectangleNurbsNode(neat::NurbsNode3D& NurbsNode_);
+
     /**
      * Write polyline to file
      */
@@ -67,6 +83,17 @@ namespace tester
     bool WritePointsToFile(const std::string& strFilePath_, const neat::VECDPOINT2& vecPoints_);
     bool WritePolylineToFile(const std::string& strFilePath_, const neat::Polyline2D& Polyline2D_);
 
+    /**
+     * Returns the number of heap allocations of the tester process, including the ones inside the library.
+     * With MSVC they are only counted in the debug configurations by the hook of debug CRT, otherwise returns zero.
+     */
+    size_t GetAllocationCount();
+
+    /**
+     * Returns the heap allocations followed by the unit, or a dash if they aren't counted.
+     */
+    std::string FormatAllocations(double nAllocations_, const std::string& strUnit_);
+
 } // End namespace tester
 
 #endif // __NEAT_SPLINE_TESTER_H_20200201__
\ No newline at end of file